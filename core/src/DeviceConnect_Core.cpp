@@ -58,6 +58,7 @@ uint8_t * iotex_deviceconnect_sdk_core_init(iotex_gettime get_time_func, iotex_m
 
 #ifdef ARDUINO
     g_commClient = commClient;
+    iotex_dev_access_set_mqtt_stream_func(iotex_device_connect_mqtt_pub_begin, iotex_device_connect_mqtt_pub_write, iotex_device_connect_mqtt_pub_end);
 #else
     iotex_dev_access_set_time_func(get_time_func);
     iotex_dev_access_set_mqtt_func(mqtt_pub, mqtt_sub);
@@ -65,8 +66,6 @@ uint8_t * iotex_deviceconnect_sdk_core_init(iotex_gettime get_time_func, iotex_m
 
     iotex_export_public_key();
 
-    InitLowsCalc();
-
 #ifdef IOTEX_SIGN_VERIFY_TEST
     psa_status_t status;
     unsigned char inbuf[] = "iotex_ecdsa_test_only";
@@ -111,6 +110,28 @@ int iotex_device_connect_mqtt_pub(unsigned char *topic, unsigned char *buf, unsi
 
     return 1;
 }
-#endif
 
+int iotex_device_connect_mqtt_pub_begin(unsigned char *topic, unsigned int payload_len, int qos) {
+
+    if (NULL == g_commClient)
+        return 0;
+
+    return g_commClient->_mqttclient.beginPublish((const char *)topic, payload_len, false);
+}
+
+int iotex_device_connect_mqtt_pub_write(const unsigned char *buf, unsigned int buflen) {
+
+    if (NULL == g_commClient)
+        return 0;
+
+    return g_commClient->_mqttclient.writePayload(buf, buflen) == buflen;
+}
+
+int iotex_device_connect_mqtt_pub_end(void) {
 
+    if (NULL == g_commClient)
+        return 0;
+
+    return g_commClient->_mqttclient.endPublish();
+}
+#endif
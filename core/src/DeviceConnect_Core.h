@@ -3,7 +3,6 @@
    
 #include "include/psa/crypto.h"
 #include "include/utils/iotex_dev_access.h"
-#include "include/utils/LowerS/LowerS.h"
 
 
 #ifdef ARDUINO
@@ -17,6 +16,9 @@ extern "C"
 
 #ifdef ARDUINO
 int iotex_device_connect_mqtt_pub(unsigned char *topic, unsigned char *buf, unsigned int buflen, int qos);
+int iotex_device_connect_mqtt_pub_begin(unsigned char *topic, unsigned int payload_len, int qos);
+int iotex_device_connect_mqtt_pub_write(const unsigned char *buf, unsigned int buflen);
+int iotex_device_connect_mqtt_pub_end(void);
 uint8_t * iotex_deviceconnect_sdk_core_init(DevConn_Comm *commClient);
 #else
 uint8_t * iotex_deviceconnect_sdk_core_init(iotex_gettime get_time_func, iotex_mqtt_pub mqtt_pub, iotex_mqtt_sub mqtt_sub);
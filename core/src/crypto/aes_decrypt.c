@@ -34,6 +34,29 @@
 #include "include/backends/tinycryt/constants.h"
 #include "include/backends/tinycryt/utils.h"
 
+/* As in aes_encrypt.c */
+#if defined(__GNUC__) && defined(__x86_64__)
+#define TC_AES_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && \
+      (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#define TC_AES_ARMV8
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+typedef void (*decrypt_blocks_t)(uint8_t *out, const uint8_t *in,
+				 size_t blocks, const unsigned int *k);
+
+static void decrypt_resolve(uint8_t *out, const uint8_t *in, size_t blocks,
+			    const unsigned int *k);
+
+/* Replaced by the best backend that passes its self test on first use */
+static decrypt_blocks_t decrypt_blocks = decrypt_resolve;
 
 static const uint8_t inv_sbox[256] = {
 	0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e,
@@ -60,11 +83,6 @@ static const uint8_t inv_sbox[256] = {
 	0x55, 0x21, 0x0c, 0x7d
 };
 
-int tc_aes128_set_decrypt_key(TCAesKeySched_t s, const uint8_t *k)
-{
-	return tc_aes128_set_encrypt_key(s, k);
-}
-
 #define mult8(a)(_double_byte(_double_byte(_double_byte(a))))
 #define mult9(a)(mult8(a)^(a))
 #define multb(a)(mult8(a)^_double_byte(a)^(a))
@@ -79,6 +97,145 @@ static inline void mult_row_column(uint8_t *out, const uint8_t *in)
 	out[3] = multb(in[0]) ^ multd(in[1]) ^ mult9(in[2]) ^ multe(in[3]);
 }
 
+/*
+ * The equivalent inverse cipher of FIPS-197 Figure 15 runs the inverse rounds
+ * in the order of the forward ones, which needs InvMixColumns applied to the
+ * round keys of rounds 1 to Nr - 1.
+ */
+int tc_aes128_set_decrypt_key(TCAesKeySched_t s, const uint8_t *k)
+{
+	uint8_t col[Nb];
+	uint8_t t[Nb];
+	unsigned int i;
+	unsigned int w;
+
+	if (tc_aes128_set_encrypt_key(s, k) != TC_CRYPTO_SUCCESS) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	for (i = Nb; i < Nb * Nr; ++i) {
+		w = s->words[i];
+		col[0] = (uint8_t)(w >> 24); col[1] = (uint8_t)(w >> 16);
+		col[2] = (uint8_t)(w >> 8); col[3] = (uint8_t)(w);
+		mult_row_column(t, col);
+		s->words[i] = ((unsigned int)t[0] << 24) |
+			      ((unsigned int)t[1] << 16) |
+			      ((unsigned int)t[2] << 8) | (unsigned int)t[3];
+	}
+
+	_set(col, TC_ZERO_BYTE, sizeof(col));
+	_set(t, TC_ZERO_BYTE, sizeof(t));
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+#if TC_AES_TTABLE
+/*
+ * td[x] is the column (e, 9, d, b) * inv_sbox[x] of an inverse round as a
+ * big-endian word, the tables for the other three rows being its rotations.
+ */
+static const unsigned int td[256] = {
+	0x51f4a750, 0x7e416553, 0x1a17a4c3, 0x3a275e96, 0x3bab6bcb, 0x1f9d45f1,
+	0xacfa58ab, 0x4be30393, 0x2030fa55, 0xad766df6, 0x88cc7691, 0xf5024c25,
+	0x4fe5d7fc, 0xc52acbd7, 0x26354480, 0xb562a38f, 0xdeb15a49, 0x25ba1b67,
+	0x45ea0e98, 0x5dfec0e1, 0xc32f7502, 0x814cf012, 0x8d4697a3, 0x6bd3f9c6,
+	0x038f5fe7, 0x15929c95, 0xbf6d7aeb, 0x955259da, 0xd4be832d, 0x587421d3,
+	0x49e06929, 0x8ec9c844, 0x75c2896a, 0xf48e7978, 0x99583e6b, 0x27b971dd,
+	0xbee14fb6, 0xf088ad17, 0xc920ac66, 0x7dce3ab4, 0x63df4a18, 0xe51a3182,
+	0x97513360, 0x62537f45, 0xb16477e0, 0xbb6bae84, 0xfe81a01c, 0xf9082b94,
+	0x70486858, 0x8f45fd19, 0x94de6c87, 0x527bf8b7, 0xab73d323, 0x724b02e2,
+	0xe31f8f57, 0x6655ab2a, 0xb2eb2807, 0x2fb5c203, 0x86c57b9a, 0xd33708a5,
+	0x302887f2, 0x23bfa5b2, 0x02036aba, 0xed16825c, 0x8acf1c2b, 0xa779b492,
+	0xf307f2f0, 0x4e69e2a1, 0x65daf4cd, 0x0605bed5, 0xd134621f, 0xc4a6fe8a,
+	0x342e539d, 0xa2f355a0, 0x058ae132, 0xa4f6eb75, 0x0b83ec39, 0x4060efaa,
+	0x5e719f06, 0xbd6e1051, 0x3e218af9, 0x96dd063d, 0xdd3e05ae, 0x4de6bd46,
+	0x91548db5, 0x71c45d05, 0x0406d46f, 0x605015ff, 0x1998fb24, 0xd6bde997,
+	0x894043cc, 0x67d99e77, 0xb0e842bd, 0x07898b88, 0xe7195b38, 0x79c8eedb,
+	0xa17c0a47, 0x7c420fe9, 0xf8841ec9, 0x00000000, 0x09808683, 0x322bed48,
+	0x1e1170ac, 0x6c5a724e, 0xfd0efffb, 0x0f853856, 0x3daed51e, 0x362d3927,
+	0x0a0fd964, 0x685ca621, 0x9b5b54d1, 0x24362e3a, 0x0c0a67b1, 0x9357e70f,
+	0xb4ee96d2, 0x1b9b919e, 0x80c0c54f, 0x61dc20a2, 0x5a774b69, 0x1c121a16,
+	0xe293ba0a, 0xc0a02ae5, 0x3c22e043, 0x121b171d, 0x0e090d0b, 0xf28bc7ad,
+	0x2db6a8b9, 0x141ea9c8, 0x57f11985, 0xaf75074c, 0xee99ddbb, 0xa37f60fd,
+	0xf701269f, 0x5c72f5bc, 0x44663bc5, 0x5bfb7e34, 0x8b432976, 0xcb23c6dc,
+	0xb6edfc68, 0xb8e4f163, 0xd731dcca, 0x42638510, 0x13972240, 0x84c61120,
+	0x854a247d, 0xd2bb3df8, 0xaef93211, 0xc729a16d, 0x1d9e2f4b, 0xdcb230f3,
+	0x0d8652ec, 0x77c1e3d0, 0x2bb3166c, 0xa970b999, 0x119448fa, 0x47e96422,
+	0xa8fc8cc4, 0xa0f03f1a, 0x567d2cd8, 0x223390ef, 0x87494ec7, 0xd938d1c1,
+	0x8ccaa2fe, 0x98d40b36, 0xa6f581cf, 0xa57ade28, 0xdab78e26, 0x3fadbfa4,
+	0x2c3a9de4, 0x5078920d, 0x6a5fcc9b, 0x547e4662, 0xf68d13c2, 0x90d8b8e8,
+	0x2e39f75e, 0x82c3aff5, 0x9f5d80be, 0x69d0937c, 0x6fd52da9, 0xcf2512b3,
+	0xc8ac993b, 0x10187da7, 0xe89c636e, 0xdb3bbb7b, 0xcd267809, 0x6e5918f4,
+	0xec9ab701, 0x834f9aa8, 0xe6956e65, 0xaaffe67e, 0x21bccf08, 0xef15e8e6,
+	0xbae79bd9, 0x4a6f36ce, 0xea9f09d4, 0x29b07cd6, 0x31a4b2af, 0x2a3f2331,
+	0xc6a59430, 0x35a266c0, 0x744ebc37, 0xfc82caa6, 0xe090d0b0, 0x33a7d815,
+	0xf104984a, 0x41ecdaf7, 0x7fcd500e, 0x1791f62f, 0x764dd68d, 0x43efb04d,
+	0xccaa4d54, 0xe49604df, 0x9ed1b5e3, 0x4c6a881b, 0xc12c1fb8, 0x4665517f,
+	0x9d5eea04, 0x018c355d, 0xfa877473, 0xfb0b412e, 0xb3671d5a, 0x92dbd252,
+	0xe9105633, 0x6dd64713, 0x9ad7618c, 0x37a10c7a, 0x59f8148e, 0xeb133c89,
+	0xcea927ee, 0xb761c935, 0xe11ce5ed, 0x7a47b13c, 0x9cd2df59, 0x55f2733f,
+	0x1814ce79, 0x73c737bf, 0x53f7cdea, 0x5ffdaa5b, 0xdf3d6f14, 0x7844db86,
+	0xcaaff381, 0xb968c43e, 0x3824342c, 0xc2a3405f, 0x161dc372, 0xbce2250c,
+	0x283c498b, 0xff0d9541, 0x39a80171, 0x080cb3de, 0xd8b4e49c, 0x6456c190,
+	0x7bcb8461, 0xd532b670, 0x486c5c74, 0xd0b85742
+};
+
+#define ror8(a)(((a) >> 8) | ((a) << 24))
+#define td0(a)(td[(a) & 0xff])
+#define td1(a)(ror8(td[(a) & 0xff]))
+#define td2(a)(ror8(ror8(td[(a) & 0xff])))
+#define td3(a)(ror8(ror8(ror8(td[(a) & 0xff]))))
+#define inv_subbyte(a, o)((unsigned int)inv_sbox[((a) >> (o)) & 0xff] << (o))
+
+#define load_be32(p)(((unsigned int)(p)[0] << 24) | \
+		     ((unsigned int)(p)[1] << 16) | \
+		     ((unsigned int)(p)[2] << 8) | (unsigned int)(p)[3])
+
+static inline void store_be32(uint8_t *p, unsigned int a)
+{
+	p[0] = (uint8_t)(a >> 24); p[1] = (uint8_t)(a >> 16);
+	p[2] = (uint8_t)(a >> 8); p[3] = (uint8_t)(a);
+}
+
+static void decrypt_block(uint8_t *out, const uint8_t *in,
+			  const unsigned int *k)
+{
+	unsigned int s0, s1, s2, s3;
+	unsigned int t0, t1, t2, t3;
+	unsigned int i;
+
+	k += Nb * Nr;
+	s0 = load_be32(in) ^ k[0];
+	s1 = load_be32(in + 4) ^ k[1];
+	s2 = load_be32(in + 8) ^ k[2];
+	s3 = load_be32(in + 12) ^ k[3];
+
+	for (i = 1; i < Nr; ++i) {
+		k -= Nb;
+		t0 = td0(s0 >> 24) ^ td1(s3 >> 16) ^ td2(s2 >> 8) ^ td3(s1) ^ k[0];
+		t1 = td0(s1 >> 24) ^ td1(s0 >> 16) ^ td2(s3 >> 8) ^ td3(s2) ^ k[1];
+		t2 = td0(s2 >> 24) ^ td1(s1 >> 16) ^ td2(s0 >> 8) ^ td3(s3) ^ k[2];
+		t3 = td0(s3 >> 24) ^ td1(s2 >> 16) ^ td2(s1 >> 8) ^ td3(s0) ^ k[3];
+		s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+	}
+
+	/* the last round has no InvMixColumns */
+	k -= Nb;
+	t0 = inv_subbyte(s0, 24) | inv_subbyte(s3, 16) |
+	     inv_subbyte(s2, 8) | inv_subbyte(s1, 0);
+	t1 = inv_subbyte(s1, 24) | inv_subbyte(s0, 16) |
+	     inv_subbyte(s3, 8) | inv_subbyte(s2, 0);
+	t2 = inv_subbyte(s2, 24) | inv_subbyte(s1, 16) |
+	     inv_subbyte(s0, 8) | inv_subbyte(s3, 0);
+	t3 = inv_subbyte(s3, 24) | inv_subbyte(s2, 16) |
+	     inv_subbyte(s1, 8) | inv_subbyte(s0, 0);
+
+	store_be32(out, t0 ^ k[0]);
+	store_be32(out + 4, t1 ^ k[1]);
+	store_be32(out + 8, t2 ^ k[2]);
+	store_be32(out + 12, t3 ^ k[3]);
+}
+#else
 static inline void inv_mix_columns(uint8_t *s)
 {
 	uint8_t t[Nb*Nk];
@@ -127,39 +284,237 @@ static inline void inv_shift_rows(uint8_t *s)
 	(void)_copy(s, sizeof(t), t, sizeof(t));
 }
 
-int tc_aes_decrypt(uint8_t *out, const uint8_t *in, const TCAesKeySched_t s)
+static void decrypt_block(uint8_t *out, const uint8_t *in,
+			  const unsigned int *k)
 {
 	uint8_t state[Nk*Nb];
 	unsigned int i;
 
-	if (out == (uint8_t *) 0) {
-		return TC_CRYPTO_FAIL;
-	} else if (in == (const uint8_t *) 0) {
-		return TC_CRYPTO_FAIL;
-	} else if (s == (TCAesKeySched_t) 0) {
-		return TC_CRYPTO_FAIL;
-	}
-
 	(void)_copy(state, sizeof(state), in, sizeof(state));
 
-	add_round_key(state, s->words + Nb*Nr);
+	add_round_key(state, k + Nb*Nr);
 
 	for (i = Nr - 1; i > 0; --i) {
 		inv_shift_rows(state);
 		inv_sub_bytes(state);
-		add_round_key(state, s->words + Nb*i);
 		inv_mix_columns(state);
+		add_round_key(state, k + Nb*i);
 	}
 
 	inv_shift_rows(state);
 	inv_sub_bytes(state);
-	add_round_key(state, s->words);
+	add_round_key(state, k);
 
 	(void)_copy(out, sizeof(state), state, sizeof(state));
 
 	/*zeroing out the state buffer */
 	_set(state, TC_ZERO_BYTE, sizeof(state));
+}
+#endif /* TC_AES_TTABLE */
+
+static void decrypt_portable(uint8_t *out, const uint8_t *in, size_t blocks,
+			     const unsigned int *k)
+{
+	for (; blocks > 0; --blocks) {
+		decrypt_block(out, in, k);
+		in += TC_AES_BLOCK_SIZE;
+		out += TC_AES_BLOCK_SIZE;
+	}
+}
+
+#if defined(TC_AES_X86)
+/*
+ * AES-NI: aesdec is the equivalent inverse round, so it takes the schedule
+ * of tc_aes128_set_decrypt_key as is, last round key first.
+ */
+__attribute__((target("aes,ssse3")))
+static void decrypt_aesni(uint8_t *out, const uint8_t *in, size_t blocks,
+			  const unsigned int *k)
+{
+	const __m128i bswap = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11,
+					   4, 5, 6, 7, 0, 1, 2, 3);
+	__m128i rk[Nr + 1];
+	__m128i b[TC_AES_PARALLEL];
+	unsigned int i, j;
+
+	for (i = 0; i <= Nr; ++i) {
+		rk[i] = _mm_shuffle_epi8(
+			_mm_loadu_si128((const __m128i *) (k + Nb * i)), bswap);
+	}
+
+	for (; blocks >= TC_AES_PARALLEL; blocks -= TC_AES_PARALLEL) {
+		#pragma GCC unroll 16
+		for (j = 0; j < TC_AES_PARALLEL; ++j) {
+			b[j] = _mm_xor_si128(_mm_loadu_si128(
+				(const __m128i *) (in + 16 * j)), rk[Nr]);
+		}
+		for (i = Nr - 1; i > 0; --i) {
+			#pragma GCC unroll 16
+			for (j = 0; j < TC_AES_PARALLEL; ++j) {
+				b[j] = _mm_aesdec_si128(b[j], rk[i]);
+			}
+		}
+		#pragma GCC unroll 16
+		for (j = 0; j < TC_AES_PARALLEL; ++j) {
+			_mm_storeu_si128((__m128i *) (out + 16 * j),
+					 _mm_aesdeclast_si128(b[j], rk[0]));
+		}
+		in += TC_AES_PARALLEL * TC_AES_BLOCK_SIZE;
+		out += TC_AES_PARALLEL * TC_AES_BLOCK_SIZE;
+	}
+
+	for (; blocks > 0; --blocks) {
+		b[0] = _mm_xor_si128(_mm_loadu_si128((const __m128i *) in), rk[Nr]);
+		for (i = Nr - 1; i > 0; --i) {
+			b[0] = _mm_aesdec_si128(b[0], rk[i]);
+		}
+		_mm_storeu_si128((__m128i *) out, _mm_aesdeclast_si128(b[0], rk[0]));
+		in += TC_AES_BLOCK_SIZE;
+		out += TC_AES_BLOCK_SIZE;
+	}
+}
+
+static int cpu_has_aesni(void)
+{
+	unsigned int a, b, c, d;
+
+	if (!__get_cpuid(1, &a, &b, &c, &d)) {
+		return 0;
+	}
+	return (c & bit_AES) && (c & bit_SSSE3);
+}
+#endif /* TC_AES_X86 */
+
+#if defined(TC_AES_ARMV8)
+/*
+ * ARMv8 Cryptography Extensions: aesd is AddRoundKey, InvShiftRows and
+ * InvSubBytes, aesimc is InvMixColumns, so the first round key is added
+ * separately.
+ */
+static void decrypt_armv8(uint8_t *out, const uint8_t *in, size_t blocks,
+			  const unsigned int *k)
+{
+	uint8x16_t rk[Nr + 1];
+	uint8x16_t b[TC_AES_PARALLEL];
+	unsigned int i, j;
+
+	for (i = 0; i <= Nr; ++i) {
+		rk[i] = vrev32q_u8(vld1q_u8((const uint8_t *) (k + Nb * i)));
+	}
+
+	for (; blocks >= TC_AES_PARALLEL; blocks -= TC_AES_PARALLEL) {
+		#pragma GCC unroll 16
+		for (j = 0; j < TC_AES_PARALLEL; ++j) {
+			b[j] = vaesdq_u8(vld1q_u8(in + 16 * j), rk[Nr]);
+		}
+		for (i = Nr - 1; i > 0; --i) {
+			#pragma GCC unroll 16
+			for (j = 0; j < TC_AES_PARALLEL; ++j) {
+				b[j] = vaesdq_u8(vaesimcq_u8(b[j]), rk[i]);
+			}
+		}
+		#pragma GCC unroll 16
+		for (j = 0; j < TC_AES_PARALLEL; ++j) {
+			vst1q_u8(out + 16 * j, veorq_u8(b[j], rk[0]));
+		}
+		in += TC_AES_PARALLEL * TC_AES_BLOCK_SIZE;
+		out += TC_AES_PARALLEL * TC_AES_BLOCK_SIZE;
+	}
+
+	for (; blocks > 0; --blocks) {
+		b[0] = vaesdq_u8(vld1q_u8(in), rk[Nr]);
+		for (i = Nr - 1; i > 0; --i) {
+			b[0] = vaesdq_u8(vaesimcq_u8(b[0]), rk[i]);
+		}
+		vst1q_u8(out, veorq_u8(b[0], rk[0]));
+		in += TC_AES_BLOCK_SIZE;
+		out += TC_AES_BLOCK_SIZE;
+	}
+}
+
+static int cpu_has_armv8_aes(void)
+{
+#if defined(__linux__) && defined(HWCAP_AES)
+	return (getauxval(AT_HWCAP) & HWCAP_AES) != 0;
+#else
+	/* built for a CPU with the extension */
+	return 1;
+#endif
+}
+#endif /* TC_AES_ARMV8 */
+
+/*
+ * A backend is only used if it agrees with decrypt_portable() on a full
+ * interleaved batch and a tail block.
+ */
+static int decrypt_self_test(decrypt_blocks_t fn)
+{
+	struct tc_aes_key_sched_struct s;
+	uint8_t in[(TC_AES_PARALLEL + 1) * TC_AES_BLOCK_SIZE];
+	uint8_t a[sizeof(in)];
+	uint8_t b[sizeof(in)];
+	unsigned int i;
+
+	for (i = 0; i < sizeof(in); ++i) {
+		in[i] = (uint8_t)(i * 167 + 13);
+	}
+	(void)tc_aes128_set_decrypt_key(&s, in + TC_AES_BLOCK_SIZE);
+
+	decrypt_portable(a, in, TC_AES_PARALLEL + 1, s.words);
+	fn(b, in, TC_AES_PARALLEL + 1, s.words);
+
+	return _compare(a, b, sizeof(a)) == 0;
+}
 
+static void decrypt_resolve(uint8_t *out, const uint8_t *in, size_t blocks,
+			    const unsigned int *k)
+{
+	decrypt_blocks_t fn = decrypt_portable;
+
+#if defined(TC_AES_X86)
+	if (cpu_has_aesni() && decrypt_self_test(decrypt_aesni)) {
+		fn = decrypt_aesni;
+	}
+#elif defined(TC_AES_ARMV8)
+	if (cpu_has_armv8_aes() && decrypt_self_test(decrypt_armv8)) {
+		fn = decrypt_armv8;
+	}
+#endif
+
+	/* every thread that races here stores the same pointer */
+	decrypt_blocks = fn;
+	fn(out, in, blocks, k);
+}
+
+int tc_aes_decrypt(uint8_t *out, const uint8_t *in, const TCAesKeySched_t s)
+{
+	if (out == (uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (in == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (s == (TCAesKeySched_t) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	decrypt_blocks(out, in, 1, s->words);
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+int tc_aes_decrypt_blocks(uint8_t *out, const uint8_t *in, size_t blocks,
+			  const TCAesKeySched_t s)
+{
+	if (out == (uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (in == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (s == (TCAesKeySched_t) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	if (blocks > 0) {
+		decrypt_blocks(out, in, blocks, s->words);
+	}
 
 	return TC_CRYPTO_SUCCESS;
 }
@@ -34,6 +34,34 @@
 #include "include/backends/tinycryt/utils.h"
 #include "include/backends/tinycryt/constants.h"
 
+/*
+ * Hardware rounds are built with per-function target attributes and chosen
+ * at run time, so the library still runs on CPUs without the AES
+ * instructions.
+ */
+#if defined(__GNUC__) && defined(__x86_64__)
+#define TC_AES_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && \
+      (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#define TC_AES_ARMV8
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+typedef void (*encrypt_blocks_t)(uint8_t *out, const uint8_t *in,
+				 size_t blocks, const unsigned int *k);
+
+static void encrypt_resolve(uint8_t *out, const uint8_t *in, size_t blocks,
+			    const unsigned int *k);
+
+/* Replaced by the best backend that passes its self test on first use */
+static encrypt_blocks_t encrypt_blocks = encrypt_resolve;
+
 static const uint8_t sbox[256] = {
 	0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b,
 	0xfe, 0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0,
@@ -64,7 +92,7 @@ static inline unsigned int rotword(unsigned int a)
 	return (((a) >> 24)|((a) << 8));
 }
 
-#define subbyte(a, o)(sbox[((a) >> (o))&0xff] << (o))
+#define subbyte(a, o)((unsigned int)sbox[((a) >> (o))&0xff] << (o))
 #define subword(a)(subbyte(a, 24)|subbyte(a, 16)|subbyte(a, 8)|subbyte(a, 0))
 
 int tc_aes128_set_encrypt_key(TCAesKeySched_t s, const uint8_t *k)
@@ -98,6 +126,107 @@ int tc_aes128_set_encrypt_key(TCAesKeySched_t s, const uint8_t *k)
 	return TC_CRYPTO_SUCCESS;
 }
 
+#if TC_AES_TTABLE
+/*
+ * te[x] is the column (2, 1, 1, 3) * sbox[x] of a round as a big-endian word,
+ * the tables for the other three rows being its rotations.
+ */
+static const unsigned int te[256] = {
+	0xc66363a5, 0xf87c7c84, 0xee777799, 0xf67b7b8d, 0xfff2f20d, 0xd66b6bbd,
+	0xde6f6fb1, 0x91c5c554, 0x60303050, 0x02010103, 0xce6767a9, 0x562b2b7d,
+	0xe7fefe19, 0xb5d7d762, 0x4dababe6, 0xec76769a, 0x8fcaca45, 0x1f82829d,
+	0x89c9c940, 0xfa7d7d87, 0xeffafa15, 0xb25959eb, 0x8e4747c9, 0xfbf0f00b,
+	0x41adadec, 0xb3d4d467, 0x5fa2a2fd, 0x45afafea, 0x239c9cbf, 0x53a4a4f7,
+	0xe4727296, 0x9bc0c05b, 0x75b7b7c2, 0xe1fdfd1c, 0x3d9393ae, 0x4c26266a,
+	0x6c36365a, 0x7e3f3f41, 0xf5f7f702, 0x83cccc4f, 0x6834345c, 0x51a5a5f4,
+	0xd1e5e534, 0xf9f1f108, 0xe2717193, 0xabd8d873, 0x62313153, 0x2a15153f,
+	0x0804040c, 0x95c7c752, 0x46232365, 0x9dc3c35e, 0x30181828, 0x379696a1,
+	0x0a05050f, 0x2f9a9ab5, 0x0e070709, 0x24121236, 0x1b80809b, 0xdfe2e23d,
+	0xcdebeb26, 0x4e272769, 0x7fb2b2cd, 0xea75759f, 0x1209091b, 0x1d83839e,
+	0x582c2c74, 0x341a1a2e, 0x361b1b2d, 0xdc6e6eb2, 0xb45a5aee, 0x5ba0a0fb,
+	0xa45252f6, 0x763b3b4d, 0xb7d6d661, 0x7db3b3ce, 0x5229297b, 0xdde3e33e,
+	0x5e2f2f71, 0x13848497, 0xa65353f5, 0xb9d1d168, 0x00000000, 0xc1eded2c,
+	0x40202060, 0xe3fcfc1f, 0x79b1b1c8, 0xb65b5bed, 0xd46a6abe, 0x8dcbcb46,
+	0x67bebed9, 0x7239394b, 0x944a4ade, 0x984c4cd4, 0xb05858e8, 0x85cfcf4a,
+	0xbbd0d06b, 0xc5efef2a, 0x4faaaae5, 0xedfbfb16, 0x864343c5, 0x9a4d4dd7,
+	0x66333355, 0x11858594, 0x8a4545cf, 0xe9f9f910, 0x04020206, 0xfe7f7f81,
+	0xa05050f0, 0x783c3c44, 0x259f9fba, 0x4ba8a8e3, 0xa25151f3, 0x5da3a3fe,
+	0x804040c0, 0x058f8f8a, 0x3f9292ad, 0x219d9dbc, 0x70383848, 0xf1f5f504,
+	0x63bcbcdf, 0x77b6b6c1, 0xafdada75, 0x42212163, 0x20101030, 0xe5ffff1a,
+	0xfdf3f30e, 0xbfd2d26d, 0x81cdcd4c, 0x180c0c14, 0x26131335, 0xc3ecec2f,
+	0xbe5f5fe1, 0x359797a2, 0x884444cc, 0x2e171739, 0x93c4c457, 0x55a7a7f2,
+	0xfc7e7e82, 0x7a3d3d47, 0xc86464ac, 0xba5d5de7, 0x3219192b, 0xe6737395,
+	0xc06060a0, 0x19818198, 0x9e4f4fd1, 0xa3dcdc7f, 0x44222266, 0x542a2a7e,
+	0x3b9090ab, 0x0b888883, 0x8c4646ca, 0xc7eeee29, 0x6bb8b8d3, 0x2814143c,
+	0xa7dede79, 0xbc5e5ee2, 0x160b0b1d, 0xaddbdb76, 0xdbe0e03b, 0x64323256,
+	0x743a3a4e, 0x140a0a1e, 0x924949db, 0x0c06060a, 0x4824246c, 0xb85c5ce4,
+	0x9fc2c25d, 0xbdd3d36e, 0x43acacef, 0xc46262a6, 0x399191a8, 0x319595a4,
+	0xd3e4e437, 0xf279798b, 0xd5e7e732, 0x8bc8c843, 0x6e373759, 0xda6d6db7,
+	0x018d8d8c, 0xb1d5d564, 0x9c4e4ed2, 0x49a9a9e0, 0xd86c6cb4, 0xac5656fa,
+	0xf3f4f407, 0xcfeaea25, 0xca6565af, 0xf47a7a8e, 0x47aeaee9, 0x10080818,
+	0x6fbabad5, 0xf0787888, 0x4a25256f, 0x5c2e2e72, 0x381c1c24, 0x57a6a6f1,
+	0x73b4b4c7, 0x97c6c651, 0xcbe8e823, 0xa1dddd7c, 0xe874749c, 0x3e1f1f21,
+	0x964b4bdd, 0x61bdbddc, 0x0d8b8b86, 0x0f8a8a85, 0xe0707090, 0x7c3e3e42,
+	0x71b5b5c4, 0xcc6666aa, 0x904848d8, 0x06030305, 0xf7f6f601, 0x1c0e0e12,
+	0xc26161a3, 0x6a35355f, 0xae5757f9, 0x69b9b9d0, 0x17868691, 0x99c1c158,
+	0x3a1d1d27, 0x279e9eb9, 0xd9e1e138, 0xebf8f813, 0x2b9898b3, 0x22111133,
+	0xd26969bb, 0xa9d9d970, 0x078e8e89, 0x339494a7, 0x2d9b9bb6, 0x3c1e1e22,
+	0x15878792, 0xc9e9e920, 0x87cece49, 0xaa5555ff, 0x50282878, 0xa5dfdf7a,
+	0x038c8c8f, 0x59a1a1f8, 0x09898980, 0x1a0d0d17, 0x65bfbfda, 0xd7e6e631,
+	0x844242c6, 0xd06868b8, 0x824141c3, 0x299999b0, 0x5a2d2d77, 0x1e0f0f11,
+	0x7bb0b0cb, 0xa85454fc, 0x6dbbbbd6, 0x2c16163a
+};
+
+#define ror8(a)(((a) >> 8) | ((a) << 24))
+#define te0(a)(te[(a) & 0xff])
+#define te1(a)(ror8(te[(a) & 0xff]))
+#define te2(a)(ror8(ror8(te[(a) & 0xff])))
+#define te3(a)(ror8(ror8(ror8(te[(a) & 0xff]))))
+
+#define load_be32(p)(((unsigned int)(p)[0] << 24) | \
+		     ((unsigned int)(p)[1] << 16) | \
+		     ((unsigned int)(p)[2] << 8) | (unsigned int)(p)[3])
+
+static inline void store_be32(uint8_t *p, unsigned int a)
+{
+	p[0] = (uint8_t)(a >> 24); p[1] = (uint8_t)(a >> 16);
+	p[2] = (uint8_t)(a >> 8); p[3] = (uint8_t)(a);
+}
+
+static void encrypt_block(uint8_t *out, const uint8_t *in,
+			  const unsigned int *k)
+{
+	unsigned int s0, s1, s2, s3;
+	unsigned int t0, t1, t2, t3;
+	unsigned int i;
+
+	s0 = load_be32(in) ^ k[0];
+	s1 = load_be32(in + 4) ^ k[1];
+	s2 = load_be32(in + 8) ^ k[2];
+	s3 = load_be32(in + 12) ^ k[3];
+
+	for (i = 1; i < Nr; ++i) {
+		k += Nb;
+		t0 = te0(s0 >> 24) ^ te1(s1 >> 16) ^ te2(s2 >> 8) ^ te3(s3) ^ k[0];
+		t1 = te0(s1 >> 24) ^ te1(s2 >> 16) ^ te2(s3 >> 8) ^ te3(s0) ^ k[1];
+		t2 = te0(s2 >> 24) ^ te1(s3 >> 16) ^ te2(s0 >> 8) ^ te3(s1) ^ k[2];
+		t3 = te0(s3 >> 24) ^ te1(s0 >> 16) ^ te2(s1 >> 8) ^ te3(s2) ^ k[3];
+		s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+	}
+
+	/* the last round has no MixColumns */
+	k += Nb;
+	t0 = subbyte(s0, 24) | subbyte(s1, 16) | subbyte(s2, 8) | subbyte(s3, 0);
+	t1 = subbyte(s1, 24) | subbyte(s2, 16) | subbyte(s3, 8) | subbyte(s0, 0);
+	t2 = subbyte(s2, 24) | subbyte(s3, 16) | subbyte(s0, 8) | subbyte(s1, 0);
+	t3 = subbyte(s3, 24) | subbyte(s0, 16) | subbyte(s1, 8) | subbyte(s2, 0);
+
+	store_be32(out, t0 ^ k[0]);
+	store_be32(out + 4, t1 ^ k[1]);
+	store_be32(out + 8, t2 ^ k[2]);
+	store_be32(out + 12, t3 ^ k[3]);
+}
+#else
 static inline void add_round_key(uint8_t *s, const unsigned int *k)
 {
 	s[0] ^= (uint8_t)(k[0] >> 24); s[1] ^= (uint8_t)(k[0] >> 16);
@@ -155,37 +284,238 @@ static inline void shift_rows(uint8_t *s)
 	(void) _copy(s, sizeof(t), t, sizeof(t));
 }
 
-int tc_aes_encrypt(uint8_t *out, const uint8_t *in, const TCAesKeySched_t s)
+static void encrypt_block(uint8_t *out, const uint8_t *in,
+			  const unsigned int *k)
 {
 	uint8_t state[Nk*Nb];
 	unsigned int i;
 
-	if (out == (uint8_t *) 0) {
-		return TC_CRYPTO_FAIL;
-	} else if (in == (const uint8_t *) 0) {
-		return TC_CRYPTO_FAIL;
-	} else if (s == (TCAesKeySched_t) 0) {
-		return TC_CRYPTO_FAIL;
-	}
-
 	(void)_copy(state, sizeof(state), in, sizeof(state));
-	add_round_key(state, s->words);
+	add_round_key(state, k);
 
 	for (i = 0; i < (Nr - 1); ++i) {
 		sub_bytes(state);
 		shift_rows(state);
 		mix_columns(state);
-		add_round_key(state, s->words + Nb*(i+1));
+		add_round_key(state, k + Nb*(i+1));
 	}
 
 	sub_bytes(state);
 	shift_rows(state);
-	add_round_key(state, s->words + Nb*(i+1));
+	add_round_key(state, k + Nb*(i+1));
 
 	(void)_copy(out, sizeof(state), state, sizeof(state));
 
 	/* zeroing out the state buffer */
 	_set(state, TC_ZERO_BYTE, sizeof(state));
+}
+#endif /* TC_AES_TTABLE */
+
+static void encrypt_portable(uint8_t *out, const uint8_t *in, size_t blocks,
+			     const unsigned int *k)
+{
+	for (; blocks > 0; --blocks) {
+		encrypt_block(out, in, k);
+		in += TC_AES_BLOCK_SIZE;
+		out += TC_AES_BLOCK_SIZE;
+	}
+}
+
+#if defined(TC_AES_X86)
+/*
+ * AES-NI: the round keys are big-endian words, so each is byte swapped into
+ * a register once per call. TC_AES_PARALLEL blocks go through each round
+ * together to hide the latency of aesenc, the loops over them unrolled so
+ * the batch stays in registers.
+ */
+__attribute__((target("aes,ssse3")))
+static void encrypt_aesni(uint8_t *out, const uint8_t *in, size_t blocks,
+			  const unsigned int *k)
+{
+	const __m128i bswap = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11,
+					   4, 5, 6, 7, 0, 1, 2, 3);
+	__m128i rk[Nr + 1];
+	__m128i b[TC_AES_PARALLEL];
+	unsigned int i, j;
+
+	for (i = 0; i <= Nr; ++i) {
+		rk[i] = _mm_shuffle_epi8(
+			_mm_loadu_si128((const __m128i *) (k + Nb * i)), bswap);
+	}
+
+	for (; blocks >= TC_AES_PARALLEL; blocks -= TC_AES_PARALLEL) {
+		#pragma GCC unroll 16
+		for (j = 0; j < TC_AES_PARALLEL; ++j) {
+			b[j] = _mm_xor_si128(_mm_loadu_si128(
+				(const __m128i *) (in + 16 * j)), rk[0]);
+		}
+		for (i = 1; i < Nr; ++i) {
+			#pragma GCC unroll 16
+			for (j = 0; j < TC_AES_PARALLEL; ++j) {
+				b[j] = _mm_aesenc_si128(b[j], rk[i]);
+			}
+		}
+		#pragma GCC unroll 16
+		for (j = 0; j < TC_AES_PARALLEL; ++j) {
+			_mm_storeu_si128((__m128i *) (out + 16 * j),
+					 _mm_aesenclast_si128(b[j], rk[Nr]));
+		}
+		in += TC_AES_PARALLEL * TC_AES_BLOCK_SIZE;
+		out += TC_AES_PARALLEL * TC_AES_BLOCK_SIZE;
+	}
+
+	for (; blocks > 0; --blocks) {
+		b[0] = _mm_xor_si128(_mm_loadu_si128((const __m128i *) in), rk[0]);
+		for (i = 1; i < Nr; ++i) {
+			b[0] = _mm_aesenc_si128(b[0], rk[i]);
+		}
+		_mm_storeu_si128((__m128i *) out, _mm_aesenclast_si128(b[0], rk[Nr]));
+		in += TC_AES_BLOCK_SIZE;
+		out += TC_AES_BLOCK_SIZE;
+	}
+}
+
+static int cpu_has_aesni(void)
+{
+	unsigned int a, b, c, d;
+
+	if (!__get_cpuid(1, &a, &b, &c, &d)) {
+		return 0;
+	}
+	return (c & bit_AES) && (c & bit_SSSE3);
+}
+#endif /* TC_AES_X86 */
+
+#if defined(TC_AES_ARMV8)
+/*
+ * ARMv8 Cryptography Extensions: aese is AddRoundKey, SubBytes and ShiftRows,
+ * aesmc is MixColumns, so the last round key is added separately.
+ */
+static void encrypt_armv8(uint8_t *out, const uint8_t *in, size_t blocks,
+			  const unsigned int *k)
+{
+	uint8x16_t rk[Nr + 1];
+	uint8x16_t b[TC_AES_PARALLEL];
+	unsigned int i, j;
+
+	for (i = 0; i <= Nr; ++i) {
+		rk[i] = vrev32q_u8(vld1q_u8((const uint8_t *) (k + Nb * i)));
+	}
+
+	for (; blocks >= TC_AES_PARALLEL; blocks -= TC_AES_PARALLEL) {
+		#pragma GCC unroll 16
+		for (j = 0; j < TC_AES_PARALLEL; ++j) {
+			b[j] = vld1q_u8(in + 16 * j);
+		}
+		for (i = 0; i < Nr - 1; ++i) {
+			#pragma GCC unroll 16
+			for (j = 0; j < TC_AES_PARALLEL; ++j) {
+				b[j] = vaesmcq_u8(vaeseq_u8(b[j], rk[i]));
+			}
+		}
+		#pragma GCC unroll 16
+		for (j = 0; j < TC_AES_PARALLEL; ++j) {
+			vst1q_u8(out + 16 * j,
+				 veorq_u8(vaeseq_u8(b[j], rk[Nr - 1]), rk[Nr]));
+		}
+		in += TC_AES_PARALLEL * TC_AES_BLOCK_SIZE;
+		out += TC_AES_PARALLEL * TC_AES_BLOCK_SIZE;
+	}
+
+	for (; blocks > 0; --blocks) {
+		b[0] = vld1q_u8(in);
+		for (i = 0; i < Nr - 1; ++i) {
+			b[0] = vaesmcq_u8(vaeseq_u8(b[0], rk[i]));
+		}
+		vst1q_u8(out, veorq_u8(vaeseq_u8(b[0], rk[Nr - 1]), rk[Nr]));
+		in += TC_AES_BLOCK_SIZE;
+		out += TC_AES_BLOCK_SIZE;
+	}
+}
+
+static int cpu_has_armv8_aes(void)
+{
+#if defined(__linux__) && defined(HWCAP_AES)
+	return (getauxval(AT_HWCAP) & HWCAP_AES) != 0;
+#else
+	/* built for a CPU with the extension */
+	return 1;
+#endif
+}
+#endif /* TC_AES_ARMV8 */
+
+/*
+ * A backend is only used if it agrees with encrypt_portable() on a full
+ * interleaved batch and a tail block.
+ */
+static int encrypt_self_test(encrypt_blocks_t fn)
+{
+	struct tc_aes_key_sched_struct s;
+	uint8_t in[(TC_AES_PARALLEL + 1) * TC_AES_BLOCK_SIZE];
+	uint8_t a[sizeof(in)];
+	uint8_t b[sizeof(in)];
+	unsigned int i;
+
+	for (i = 0; i < sizeof(in); ++i) {
+		in[i] = (uint8_t)(i * 167 + 13);
+	}
+	(void)tc_aes128_set_encrypt_key(&s, in + TC_AES_BLOCK_SIZE);
+
+	encrypt_portable(a, in, TC_AES_PARALLEL + 1, s.words);
+	fn(b, in, TC_AES_PARALLEL + 1, s.words);
+
+	return _compare(a, b, sizeof(a)) == 0;
+}
+
+static void encrypt_resolve(uint8_t *out, const uint8_t *in, size_t blocks,
+			    const unsigned int *k)
+{
+	encrypt_blocks_t fn = encrypt_portable;
+
+#if defined(TC_AES_X86)
+	if (cpu_has_aesni() && encrypt_self_test(encrypt_aesni)) {
+		fn = encrypt_aesni;
+	}
+#elif defined(TC_AES_ARMV8)
+	if (cpu_has_armv8_aes() && encrypt_self_test(encrypt_armv8)) {
+		fn = encrypt_armv8;
+	}
+#endif
+
+	/* every thread that races here stores the same pointer */
+	encrypt_blocks = fn;
+	fn(out, in, blocks, k);
+}
+
+int tc_aes_encrypt(uint8_t *out, const uint8_t *in, const TCAesKeySched_t s)
+{
+	if (out == (uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (in == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (s == (TCAesKeySched_t) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	encrypt_blocks(out, in, 1, s->words);
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+int tc_aes_encrypt_blocks(uint8_t *out, const uint8_t *in, size_t blocks,
+			  const TCAesKeySched_t s)
+{
+	if (out == (uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (in == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (s == (TCAesKeySched_t) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	if (blocks > 0) {
+		encrypt_blocks(out, in, blocks, s->words);
+	}
 
 	return TC_CRYPTO_SUCCESS;
 }
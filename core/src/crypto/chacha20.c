@@ -0,0 +1,316 @@
+/* chacha20.c - TinyCrypt implementation of the ChaCha20 stream cipher */
+
+#include "include/backends/tinycryt/chacha20.h"
+#include "include/backends/tinycryt/constants.h"
+#include "include/backends/tinycryt/utils.h"
+
+/*
+ * SSE2 is part of x86-64 and NEON of the ARMv8 and most ARMv7-A application
+ * cores, so the four lane code is chosen at build time.
+ */
+#if defined(__SSE2__)
+#define TC_CHACHA20_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+#define TC_CHACHA20_NEON
+#include <arm_neon.h>
+#endif
+
+#define ROTL32(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+
+#define QUARTERROUND(a, b, c, d)					\
+	do {								\
+		a += b; d ^= a; d = ROTL32(d, 16);			\
+		c += d; b ^= c; b = ROTL32(b, 12);			\
+		a += b; d ^= a; d = ROTL32(d, 8);			\
+		c += d; b ^= c; b = ROTL32(b, 7);			\
+	} while (0)
+
+static uint32_t load_le32(const uint8_t *p)
+{
+	return (uint32_t) p[0] | ((uint32_t) p[1] << 8) |
+	       ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+static void store_le32(uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)(v);
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+
+/* the key stream block of state, whose counter is then incremented */
+static void chacha20_block(uint8_t *ks, uint32_t *state)
+{
+	uint32_t x[16];
+	unsigned int i;
+
+	for (i = 0; i < 16; ++i) {
+		x[i] = state[i];
+	}
+
+	for (i = 0; i < 10; ++i) {
+		QUARTERROUND(x[0], x[4], x[8], x[12]);
+		QUARTERROUND(x[1], x[5], x[9], x[13]);
+		QUARTERROUND(x[2], x[6], x[10], x[14]);
+		QUARTERROUND(x[3], x[7], x[11], x[15]);
+		QUARTERROUND(x[0], x[5], x[10], x[15]);
+		QUARTERROUND(x[1], x[6], x[11], x[12]);
+		QUARTERROUND(x[2], x[7], x[8], x[13]);
+		QUARTERROUND(x[3], x[4], x[9], x[14]);
+	}
+
+	for (i = 0; i < 16; ++i) {
+		store_le32(ks + 4 * i, x[i] + state[i]);
+	}
+
+	state[12]++;
+	_set(x, TC_ZERO_BYTE, sizeof(x));
+}
+
+#if defined(TC_CHACHA20_SSE2)
+/*
+ * Lane j of x[i] is word i of block j, so the rounds are the scalar ones on
+ * vectors and the blocks come out after a 4x4 transpose of each row.
+ */
+#define ROTL32_SSE2(v, n)						\
+	_mm_or_si128(_mm_slli_epi32(v, n), _mm_srli_epi32(v, 32 - (n)))
+
+#define QUARTERROUND_SSE2(a, b, c, d)					\
+	do {								\
+		a = _mm_add_epi32(a, b);				\
+		d = ROTL32_SSE2(_mm_xor_si128(d, a), 16);		\
+		c = _mm_add_epi32(c, d);				\
+		b = ROTL32_SSE2(_mm_xor_si128(b, c), 12);		\
+		a = _mm_add_epi32(a, b);				\
+		d = ROTL32_SSE2(_mm_xor_si128(d, a), 8);		\
+		c = _mm_add_epi32(c, d);				\
+		b = ROTL32_SSE2(_mm_xor_si128(b, c), 7);		\
+	} while (0)
+
+static void chacha20_xor4(uint8_t *out, const uint8_t *in, uint32_t *state)
+{
+	__m128i x[16];
+	__m128i t0, t1, t2, t3;
+	unsigned int i, j;
+
+	for (i = 0; i < 16; ++i) {
+		x[i] = _mm_set1_epi32((int) state[i]);
+	}
+	x[12] = _mm_add_epi32(x[12], _mm_set_epi32(3, 2, 1, 0));
+
+	for (i = 0; i < 10; ++i) {
+		QUARTERROUND_SSE2(x[0], x[4], x[8], x[12]);
+		QUARTERROUND_SSE2(x[1], x[5], x[9], x[13]);
+		QUARTERROUND_SSE2(x[2], x[6], x[10], x[14]);
+		QUARTERROUND_SSE2(x[3], x[7], x[11], x[15]);
+		QUARTERROUND_SSE2(x[0], x[5], x[10], x[15]);
+		QUARTERROUND_SSE2(x[1], x[6], x[11], x[12]);
+		QUARTERROUND_SSE2(x[2], x[7], x[8], x[13]);
+		QUARTERROUND_SSE2(x[3], x[4], x[9], x[14]);
+	}
+
+	for (i = 0; i < 16; ++i) {
+		x[i] = _mm_add_epi32(x[i], _mm_set1_epi32((int) state[i]));
+	}
+	x[12] = _mm_add_epi32(x[12], _mm_set_epi32(3, 2, 1, 0));
+
+	for (i = 0; i < 16; i += 4) {
+		t0 = _mm_unpacklo_epi32(x[i], x[i + 1]);
+		t1 = _mm_unpacklo_epi32(x[i + 2], x[i + 3]);
+		t2 = _mm_unpackhi_epi32(x[i], x[i + 1]);
+		t3 = _mm_unpackhi_epi32(x[i + 2], x[i + 3]);
+		x[i] = _mm_unpacklo_epi64(t0, t1);
+		x[i + 1] = _mm_unpackhi_epi64(t0, t1);
+		x[i + 2] = _mm_unpacklo_epi64(t2, t3);
+		x[i + 3] = _mm_unpackhi_epi64(t2, t3);
+	}
+
+	for (j = 0; j < 4; ++j) {
+		for (i = 0; i < 4; ++i) {
+			const uint8_t *p = in + 64 * j + 16 * i;
+
+			_mm_storeu_si128((__m128i *) (out + 64 * j + 16 * i),
+					 _mm_xor_si128(_mm_loadu_si128((const __m128i *) p),
+						       x[4 * i + j]));
+		}
+	}
+
+	state[12] += 4;
+}
+#endif /* TC_CHACHA20_SSE2 */
+
+#if defined(TC_CHACHA20_NEON)
+/* as the SSE2 code, with shift-right-insert rotations */
+#define ROTL32_NEON(v, n) vsriq_n_u32(vshlq_n_u32(v, n), v, 32 - (n))
+
+#define ROTL16_NEON(v)							\
+	vreinterpretq_u32_u16(vrev32q_u16(vreinterpretq_u16_u32(v)))
+
+#define QUARTERROUND_NEON(a, b, c, d)					\
+	do {								\
+		a = vaddq_u32(a, b);					\
+		d = veorq_u32(d, a);					\
+		d = ROTL16_NEON(d);					\
+		c = vaddq_u32(c, d);					\
+		b = veorq_u32(b, c);					\
+		b = ROTL32_NEON(b, 12);					\
+		a = vaddq_u32(a, b);					\
+		d = veorq_u32(d, a);					\
+		d = ROTL32_NEON(d, 8);					\
+		c = vaddq_u32(c, d);					\
+		b = veorq_u32(b, c);					\
+		b = ROTL32_NEON(b, 7);					\
+	} while (0)
+
+static void chacha20_xor4(uint8_t *out, const uint8_t *in, uint32_t *state)
+{
+	static const uint32_t lanes[4] = { 0, 1, 2, 3 };
+	uint32x4_t x[16];
+	uint32x4x2_t t01, t23;
+	uint32x4_t inc = vld1q_u32(lanes);
+	unsigned int i, j;
+
+	for (i = 0; i < 16; ++i) {
+		x[i] = vdupq_n_u32(state[i]);
+	}
+	x[12] = vaddq_u32(x[12], inc);
+
+	for (i = 0; i < 10; ++i) {
+		QUARTERROUND_NEON(x[0], x[4], x[8], x[12]);
+		QUARTERROUND_NEON(x[1], x[5], x[9], x[13]);
+		QUARTERROUND_NEON(x[2], x[6], x[10], x[14]);
+		QUARTERROUND_NEON(x[3], x[7], x[11], x[15]);
+		QUARTERROUND_NEON(x[0], x[5], x[10], x[15]);
+		QUARTERROUND_NEON(x[1], x[6], x[11], x[12]);
+		QUARTERROUND_NEON(x[2], x[7], x[8], x[13]);
+		QUARTERROUND_NEON(x[3], x[4], x[9], x[14]);
+	}
+
+	for (i = 0; i < 16; ++i) {
+		x[i] = vaddq_u32(x[i], vdupq_n_u32(state[i]));
+	}
+	x[12] = vaddq_u32(x[12], inc);
+
+	for (i = 0; i < 16; i += 4) {
+		t01 = vtrnq_u32(x[i], x[i + 1]);
+		t23 = vtrnq_u32(x[i + 2], x[i + 3]);
+		x[i] = vcombine_u32(vget_low_u32(t01.val[0]),
+				    vget_low_u32(t23.val[0]));
+		x[i + 1] = vcombine_u32(vget_low_u32(t01.val[1]),
+					vget_low_u32(t23.val[1]));
+		x[i + 2] = vcombine_u32(vget_high_u32(t01.val[0]),
+					vget_high_u32(t23.val[0]));
+		x[i + 3] = vcombine_u32(vget_high_u32(t01.val[1]),
+					vget_high_u32(t23.val[1]));
+	}
+
+	for (j = 0; j < 4; ++j) {
+		for (i = 0; i < 4; ++i) {
+			vst1q_u8(out + 64 * j + 16 * i,
+				 veorq_u8(vld1q_u8(in + 64 * j + 16 * i),
+					  vreinterpretq_u8_u32(x[4 * i + j])));
+		}
+	}
+
+	state[12] += 4;
+}
+#endif /* TC_CHACHA20_NEON */
+
+int tc_chacha20_set_key(TCChaCha20State_t s, const uint8_t *key)
+{
+	unsigned int i;
+
+	if (s == (TCChaCha20State_t) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (key == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	/* "expand 32-byte k" */
+	s->state[0] = 0x61707865;
+	s->state[1] = 0x3320646e;
+	s->state[2] = 0x79622d32;
+	s->state[3] = 0x6b206574;
+
+	for (i = 0; i < 8; ++i) {
+		s->state[4 + i] = load_le32(key + 4 * i);
+	}
+
+	s->state[12] = 0;
+	s->state[13] = 0;
+	s->state[14] = 0;
+	s->state[15] = 0;
+	s->keystream_used = TC_CHACHA20_BLOCK_SIZE;
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+int tc_chacha20_start(TCChaCha20State_t s, const uint8_t *nonce,
+		      uint32_t counter)
+{
+	if (s == (TCChaCha20State_t) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (nonce == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	s->state[12] = counter;
+	s->state[13] = load_le32(nonce);
+	s->state[14] = load_le32(nonce + 4);
+	s->state[15] = load_le32(nonce + 8);
+
+	_set(s->keystream, TC_ZERO_BYTE, sizeof(s->keystream));
+	s->keystream_used = TC_CHACHA20_BLOCK_SIZE;
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+int tc_chacha20_crypt(TCChaCha20State_t s, uint8_t *out, const uint8_t *in,
+		      size_t len)
+{
+	unsigned int i;
+
+	if (s == (TCChaCha20State_t) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (len == 0) {
+		return TC_CRYPTO_SUCCESS;
+	} else if (out == (uint8_t *) 0 || in == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	/* the rest of the block left partial by the previous call */
+	while (len > 0 && s->keystream_used < TC_CHACHA20_BLOCK_SIZE) {
+		*out++ = *in++ ^ s->keystream[s->keystream_used++];
+		--len;
+	}
+
+#if defined(TC_CHACHA20_SSE2) || defined(TC_CHACHA20_NEON)
+	for (; len >= 4 * TC_CHACHA20_BLOCK_SIZE;
+	     len -= 4 * TC_CHACHA20_BLOCK_SIZE) {
+		chacha20_xor4(out, in, s->state);
+		in += 4 * TC_CHACHA20_BLOCK_SIZE;
+		out += 4 * TC_CHACHA20_BLOCK_SIZE;
+	}
+#endif
+
+	for (; len >= TC_CHACHA20_BLOCK_SIZE; len -= TC_CHACHA20_BLOCK_SIZE) {
+		chacha20_block(s->keystream, s->state);
+		for (i = 0; i < TC_CHACHA20_BLOCK_SIZE; ++i) {
+			out[i] = in[i] ^ s->keystream[i];
+		}
+		in += TC_CHACHA20_BLOCK_SIZE;
+		out += TC_CHACHA20_BLOCK_SIZE;
+	}
+
+	if (len > 0) {
+		chacha20_block(s->keystream, s->state);
+		for (i = 0; i < len; ++i) {
+			out[i] = in[i] ^ s->keystream[i];
+		}
+		s->keystream_used = (unsigned int) len;
+	}
+
+	return TC_CRYPTO_SUCCESS;
+}
@@ -272,8 +272,8 @@ static void muladd(uECC_word_t a, uECC_word_t b, uECC_word_t *r0,
 }
 
 /* Computes result = left * right. Result must be 2 * num_words long. */
-static void uECC_vli_mult(uECC_word_t *result, const uECC_word_t *left,
-			  const uECC_word_t *right, wordcount_t num_words)
+void uECC_vli_mult(uECC_word_t *result, const uECC_word_t *left,
+		   const uECC_word_t *right, wordcount_t num_words)
 {
 
 	uECC_word_t r0 = 0;
@@ -386,6 +386,42 @@ void uECC_vli_modMult(uECC_word_t *result, const uECC_word_t *left,
 	uECC_vli_mmod(result, product, mod, num_words);
 }
 
+/*
+ * Barrett's reduction, HAC 14.42: with k words and b = 2^uECC_WORD_BITS,
+ * q = floor(floor(x / b^(k-1)) * mu / b^(k+1)) is at most 2 below x / n, so
+ * x - q*n computed modulo b^(k+1) needs at most two subtractions of n. Both
+ * are always computed.
+ */
+void uECC_vli_modMult_n(uECC_word_t *result, const uECC_word_t *left,
+			const uECC_word_t *right, uECC_Curve curve)
+{
+	uECC_word_t product[2 * NUM_ECC_WORDS];
+	uECC_word_t q[2 * NUM_ECC_WORDS + 2];
+	uECC_word_t qn[2 * NUM_ECC_WORDS + 2];
+	uECC_word_t n[NUM_ECC_WORDS + 1];
+	uECC_word_t t[NUM_ECC_WORDS + 1];
+	wordcount_t num_words = curve->num_words;
+	uECC_word_t mask;
+	wordcount_t i, j;
+
+	uECC_vli_mult(product, left, right, num_words);
+	uECC_vli_mult(q, product + num_words - 1, curve->mu, num_words + 1);
+
+	uECC_vli_set(n, curve->n, num_words);
+	n[num_words] = 0;
+	uECC_vli_mult(qn, q + num_words + 1, n, num_words + 1);
+	uECC_vli_sub(t, product, qn, num_words + 1);
+
+	for (i = 0; i < 2; ++i) {
+		mask = uECC_vli_sub(q, t, n, num_words + 1) - 1;
+		for (j = 0; j <= num_words; ++j) {
+			t[j] = (t[j] & ~mask) | (q[j] & mask);
+		}
+	}
+
+	uECC_vli_set(result, t, num_words);
+}
+
 void uECC_vli_modMult_fast(uECC_word_t *result, const uECC_word_t *left,
 			   const uECC_word_t *right, uECC_Curve curve)
 {
@@ -577,9 +613,133 @@ uECC_Curve uECC_secp256k1(void)
 	return &curve_secp256k1;
 }
 
-void vli_mmod_fast_secp256r1(unsigned int *result, unsigned int*product)
+#if (uECC_WORD_SIZE == 8)
+/*
+ * Same NIST reduction as the 32-bits code below, with every 32-bits word c[i]
+ * of the product taken out of the high or low half of product[i / 2].
+ */
+void vli_mmod_fast_secp256r1(uECC_word_t *result, uECC_word_t *product)
+{
+	uECC_word_t tmp[NUM_ECC_WORDS];
+	int carry;
+
+	/* t */
+	uECC_vli_set(result, product, NUM_ECC_WORDS);
+
+	/* s1 */
+	tmp[0] = 0;
+	tmp[1] = product[5] & 0xffffffff00000000ull;
+	tmp[2] = product[6];
+	tmp[3] = product[7];
+	carry = uECC_vli_add(tmp, tmp, tmp, NUM_ECC_WORDS);
+	carry += uECC_vli_add(result, result, tmp, NUM_ECC_WORDS);
+
+	/* s2 */
+	tmp[1] = product[6] << 32;
+	tmp[2] = (product[6] >> 32) | (product[7] << 32);
+	tmp[3] = product[7] >> 32;
+	carry += uECC_vli_add(tmp, tmp, tmp, NUM_ECC_WORDS);
+	carry += uECC_vli_add(result, result, tmp, NUM_ECC_WORDS);
+
+	/* s3 */
+	tmp[0] = product[4];
+	tmp[1] = product[5] & 0xffffffff;
+	tmp[2] = 0;
+	tmp[3] = product[7];
+	carry += uECC_vli_add(result, result, tmp, NUM_ECC_WORDS);
+
+	/* s4 */
+	tmp[0] = (product[4] >> 32) | (product[5] << 32);
+	tmp[1] = (product[5] >> 32) | (product[6] & 0xffffffff00000000ull);
+	tmp[2] = product[7];
+	tmp[3] = (product[6] >> 32) | (product[4] << 32);
+	carry += uECC_vli_add(result, result, tmp, NUM_ECC_WORDS);
+
+	/* d1 */
+	tmp[0] = (product[5] >> 32) | (product[6] << 32);
+	tmp[1] = product[6] >> 32;
+	tmp[2] = 0;
+	tmp[3] = (product[4] & 0xffffffff) | (product[5] << 32);
+	carry -= uECC_vli_sub(result, result, tmp, NUM_ECC_WORDS);
+
+	/* d2 */
+	tmp[0] = product[6];
+	tmp[1] = product[7];
+	tmp[2] = 0;
+	tmp[3] = (product[4] >> 32) | (product[5] & 0xffffffff00000000ull);
+	carry -= uECC_vli_sub(result, result, tmp, NUM_ECC_WORDS);
+
+	/* d3 */
+	tmp[0] = (product[6] >> 32) | (product[7] << 32);
+	tmp[1] = (product[7] >> 32) | (product[4] << 32);
+	tmp[2] = (product[4] >> 32) | (product[5] << 32);
+	tmp[3] = product[6] << 32;
+	carry -= uECC_vli_sub(result, result, tmp, NUM_ECC_WORDS);
+
+	/* d4 */
+	tmp[0] = product[7];
+	tmp[1] = product[4] & 0xffffffff00000000ull;
+	tmp[2] = product[5];
+	tmp[3] = product[6] & 0xffffffff00000000ull;
+	carry -= uECC_vli_sub(result, result, tmp, NUM_ECC_WORDS);
+
+	if (carry < 0) {
+		do {
+			carry += uECC_vli_add(result, result, curve_secp256r1.p, NUM_ECC_WORDS);
+		}
+		while (carry < 0);
+	} else  {
+		while (carry || 
+		       uECC_vli_cmp_unsafe(curve_secp256r1.p, result, NUM_ECC_WORDS) != 1) {
+			carry -= uECC_vli_sub(result, result, curve_secp256r1.p, NUM_ECC_WORDS);
+		}
+	}
+}
+
+/*
+ * p = 2^256 - c with c = 2^32 + 0x3D1, so c1 * 2^256 + c0 = c1 * c + c0 (mod p).
+ * The high half is folded in once, the few bits left above 2^256 once more.
+ */
+void vli_mmod_fast_secp256k1(uECC_word_t *result, uECC_word_t *product)
 {
-	unsigned int tmp[NUM_ECC_WORDS];
+	const uECC_word_t c = 0x1000003D1ull;
+	uECC_word_t tmp[NUM_ECC_WORDS + 1];
+	uECC_dword_t acc = 0;
+	uECC_word_t carry;
+	wordcount_t i;
+
+	/* tmp = c1 * c, at most 289 bits */
+	for (i = 0; i < NUM_ECC_WORDS; ++i) {
+		acc += (uECC_dword_t)product[NUM_ECC_WORDS + i] * c;
+		tmp[i] = (uECC_word_t)acc;
+		acc >>= uECC_WORD_BITS;
+	}
+	tmp[NUM_ECC_WORDS] = (uECC_word_t)acc;
+
+	carry = uECC_vli_add(result, product, tmp, NUM_ECC_WORDS);
+
+	/* (tmp[4] + carry) * c, at most 67 bits */
+	acc = (uECC_dword_t)(tmp[NUM_ECC_WORDS] + carry) * c;
+	tmp[0] = (uECC_word_t)acc;
+	tmp[1] = (uECC_word_t)(acc >> uECC_WORD_BITS);
+	tmp[2] = tmp[3] = 0;
+	carry = uECC_vli_add(result, result, tmp, NUM_ECC_WORDS);
+
+	/* A carry leaves result below 2^67, adding c cannot overflow again */
+	if (carry) {
+		tmp[0] = c;
+		tmp[1] = 0;
+		uECC_vli_add(result, result, tmp, NUM_ECC_WORDS);
+	}
+
+	if (uECC_vli_cmp_unsafe(curve_secp256k1.p, result, NUM_ECC_WORDS) != 1) {
+		uECC_vli_sub(result, result, curve_secp256k1.p, NUM_ECC_WORDS);
+	}
+}
+#else
+void vli_mmod_fast_secp256r1(uECC_word_t *result, uECC_word_t *product)
+{
+	uECC_word_t tmp[NUM_ECC_WORDS];
 	int carry;
 
 	/* t */
@@ -678,10 +838,10 @@ void vli_mmod_fast_secp256r1(unsigned int *result, unsigned int*product)
 	}
 }
 
-void vli_mmod_fast_secp256k1(unsigned int *result, unsigned int *product)
+void vli_mmod_fast_secp256k1(uECC_word_t *result, uECC_word_t *product)
 {
-	unsigned int tmp[NUM_ECC_WORDS];
-	unsigned int carry;
+	uECC_word_t tmp[NUM_ECC_WORDS];
+	uECC_word_t carry;
 
 	//w0 = c0
 	uECC_vli_set(result, product, NUM_ECC_WORDS);
@@ -829,6 +989,7 @@ void vli_mmod_fast_secp256k1(unsigned int *result, unsigned int *product)
         *(result + 1) |= 0x1;
 	}  
 }
+#endif
 
 uECC_word_t EccPoint_isZero(const uECC_word_t *point, uECC_Curve curve)
 {
@@ -982,6 +1143,245 @@ void EccPoint_mult(uECC_word_t * result, const uECC_word_t * point,
 	uECC_vli_set(result + num_words, Ry[0], num_words);
 }
 
+int EccPoint_check_x(const uECC_word_t * X, const uECC_word_t * Z,
+		     const uECC_word_t * r, uECC_Curve curve)
+{
+	uECC_word_t z2[NUM_ECC_WORDS];
+	uECC_word_t t[NUM_ECC_WORDS];
+	wordcount_t num_words = curve->num_words;
+
+	if (uECC_vli_isZero(Z, num_words)) {
+		return 0;
+	}
+
+	/* x = X / Z^2 is r, or r + n when that is below p */
+	uECC_vli_modSquare_fast(z2, Z, curve);
+	uECC_vli_modMult_fast(t, r, z2, curve);
+	if (uECC_vli_equal(t, X, num_words) == 0) {
+		return 1;
+	}
+
+	uECC_vli_modAdd(t, r, curve->n, curve->p, num_words);
+	if (uECC_vli_cmp_unsafe(t, r, num_words) > 0) {
+		uECC_vli_modMult_fast(t, t, z2, curve);
+		if (uECC_vli_equal(t, X, num_words) == 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * (X1, Y1, Z1) += (x2, y2) with the right-hand point in affine coordinates.
+ * The special cases only arise when the partial sum meets the table point
+ * itself, which for a scalar below n has negligible probability, and when
+ * the sum starts from the point at infinity (Z1 == 0).
+ */
+void EccPoint_add_mixed(uECC_word_t * X1, uECC_word_t * Y1,
+			uECC_word_t * Z1, const uECC_word_t * x2,
+			const uECC_word_t * y2, uECC_Curve curve)
+{
+	uECC_word_t t1[NUM_ECC_WORDS];
+	uECC_word_t t2[NUM_ECC_WORDS];
+	uECC_word_t t3[NUM_ECC_WORDS];
+	uECC_word_t t4[NUM_ECC_WORDS];
+	wordcount_t num_words = curve->num_words;
+
+	if (uECC_vli_isZero(Z1, num_words)) {
+		uECC_vli_set(X1, x2, num_words);
+		uECC_vli_set(Y1, y2, num_words);
+		uECC_vli_clear(Z1, num_words);
+		Z1[0] = 1;
+		return;
+	}
+
+	uECC_vli_modSquare_fast(t1, Z1, curve);        /* t1 = z1^2 */
+	uECC_vli_modMult_fast(t2, t1, Z1, curve);      /* t2 = z1^3 */
+	uECC_vli_modMult_fast(t1, t1, x2, curve);      /* t1 = x2*z1^2 = U2 */
+	uECC_vli_modMult_fast(t2, t2, y2, curve);      /* t2 = y2*z1^3 = S2 */
+	uECC_vli_modSub(t1, t1, X1, curve->p, num_words); /* t1 = U2 - x1 = H */
+	uECC_vli_modSub(t2, t2, Y1, curve->p, num_words); /* t2 = S2 - y1 = r */
+
+	if (uECC_vli_isZero(t1, num_words)) {
+		if (uECC_vli_isZero(t2, num_words)) {
+			curve->double_jacobian(X1, Y1, Z1, curve);
+		} else {
+			uECC_vli_clear(Z1, num_words);
+		}
+		return;
+	}
+
+	uECC_vli_modMult_fast(Z1, Z1, t1, curve);      /* z3 = z1*H */
+	uECC_vli_modSquare_fast(t3, t1, curve);        /* t3 = H^2 */
+	uECC_vli_modMult_fast(t4, t3, t1, curve);      /* t4 = H^3 */
+	uECC_vli_modMult_fast(t3, t3, X1, curve);      /* t3 = x1*H^2 = V */
+
+	uECC_vli_modSquare_fast(X1, t2, curve);        /* x3 = r^2 */
+	uECC_vli_modSub(X1, X1, t4, curve->p, num_words); /* x3 = r^2 - H^3 */
+	uECC_vli_modSub(X1, X1, t3, curve->p, num_words);
+	uECC_vli_modSub(X1, X1, t3, curve->p, num_words); /* x3 = r^2 - H^3 - 2V */
+
+	uECC_vli_modSub(t3, t3, X1, curve->p, num_words); /* t3 = V - x3 */
+	uECC_vli_modMult_fast(t3, t3, t2, curve);      /* t3 = r*(V - x3) */
+	uECC_vli_modMult_fast(t4, t4, Y1, curve);      /* t4 = y1*H^3 */
+	uECC_vli_modSub(Y1, t3, t4, curve->p, num_words); /* y3 = r*(V - x3) - y1*H^3 */
+}
+
+#if uECC_SECP256R1_COMB_TEETH || uECC_SECP256K1_COMB_TEETH
+
+/* Columns of the narrowest comb, plus one for the final carry */
+#define uECC_COMB_MAX_DIGITS ((256 + 4 - 1) / 4 + 1)
+
+/* All ones if a == b, 0 otherwise, without branching on either */
+static uECC_word_t ct_mask_equal(uECC_word_t a, uECC_word_t b)
+{
+	uECC_word_t diff = a ^ b;
+
+	return ((diff | (0 - diff)) >> (uECC_WORD_BITS - 1)) - 1;
+}
+
+static void ct_vli_select(uECC_word_t *dest, const uECC_word_t *src,
+			  uECC_word_t mask, wordcount_t num_words)
+{
+	wordcount_t i;
+
+	for (i = 0; i < num_words; ++i) {
+		dest[i] = (dest[i] & ~mask) | (src[i] & mask);
+	}
+}
+
+/*
+ * Load the comb entry for a signed odd digit: bits 0-6 hold the odd magnitude,
+ * bit 7 the sign. Every entry is read so the access pattern does not depend
+ * on the digit.
+ */
+static void comb_select(uECC_word_t *X, uECC_word_t *Y, uint8_t digit,
+			uECC_Curve curve)
+{
+	uECC_word_t neg[NUM_ECC_WORDS];
+	uECC_word_t index = (digit & 0x7F) >> 1;
+	uECC_word_t size = (uECC_word_t)1 << (curve->comb_teeth - 1);
+	wordcount_t num_words = curve->num_words;
+	const uECC_word_t *entry = curve->comb;
+	uECC_word_t i;
+
+	uECC_vli_clear(X, num_words);
+	uECC_vli_clear(Y, num_words);
+
+	for (i = 0; i < size; ++i, entry += 2 * num_words) {
+		uECC_word_t mask = ct_mask_equal(i, index);
+		ct_vli_select(X, entry, mask, num_words);
+		ct_vli_select(Y, entry + num_words, mask, num_words);
+	}
+
+	uECC_vli_sub(neg, curve->p, Y, num_words);
+	ct_vli_select(Y, neg, 0 - (uECC_word_t)(digit >> 7), num_words);
+}
+
+/*
+ * Fixed-base comb over the table in curve->comb, after the signed comb of
+ * Hedabou, Pinel and Beneteau as used by mbed TLS. The scalar is made odd by
+ * replacing an even k with n - k and negating the result, then recoded so
+ * that every column is a nonzero odd digit. Each of the d columns then costs
+ * one doubling and one mixed addition regardless of the scalar.
+ */
+static void EccPoint_mult_comb(uECC_word_t * result, const uECC_word_t * scalar,
+			       uECC_Curve curve)
+{
+	uECC_word_t m[NUM_ECC_WORDS];
+	uECC_word_t X[NUM_ECC_WORDS];
+	uECC_word_t Y[NUM_ECC_WORDS];
+	uECC_word_t Z[NUM_ECC_WORDS];
+	uECC_word_t tx[NUM_ECC_WORDS];
+	uECC_word_t ty[NUM_ECC_WORDS];
+	uint8_t digit[uECC_COMB_MAX_DIGITS];
+	wordcount_t num_words = curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+	bitcount_t num_n_bits = curve->num_n_bits;
+	unsigned teeth = curve->comb_teeth;
+	unsigned d = (num_n_bits + teeth - 1) / teeth;
+	uECC_word_t even;
+	uint8_t carry, adjust, c;
+	unsigned i, j;
+
+	/* m = k if k is odd, n - k otherwise; n is odd so m always is */
+	even = (scalar[0] & 1) ^ 1;
+	uECC_vli_clear(m, num_words);
+	uECC_vli_sub(m, curve->n, scalar, num_n_words);
+	ct_vli_select(m, scalar, even - 1, num_n_words);
+
+	/* Classical comb columns: bit j of digit i is bit i + j*d of m */
+	for (i = 0; i <= d; ++i) {
+		digit[i] = 0;
+	}
+	for (i = 0; i < d; ++i) {
+		for (j = 0; j < teeth; ++j) {
+			bitcount_t bit = (bitcount_t)(i + d * j);
+			if (bit < num_n_bits) {
+				digit[i] |= (uint8_t)(!!uECC_vli_testBit(m, bit) << j);
+			}
+		}
+	}
+
+	/* Make digits 1 .. d odd by borrowing from the previous column */
+	carry = 0;
+	for (i = 1; i <= d; ++i) {
+		c = digit[i] & carry;
+		digit[i] ^= carry;
+		carry = c;
+
+		adjust = 1 - (digit[i] & 0x01);
+		carry |= digit[i] & (digit[i - 1] * adjust);
+		digit[i] ^= digit[i - 1] * adjust;
+		digit[i - 1] |= adjust << 7;
+	}
+
+	comb_select(X, Y, digit[d], curve);
+	uECC_vli_clear(Z, num_words);
+	Z[0] = 1;
+
+	for (i = d; i-- > 0; ) {
+		curve->double_jacobian(X, Y, Z, curve);
+		comb_select(tx, ty, digit[i], curve);
+		EccPoint_add_mixed(X, Y, Z, tx, ty, curve);
+	}
+
+	/* Back to affine, then undo the n - k substitution */
+	uECC_vli_modInv(Z, Z, curve->p, num_words);
+	apply_z(X, Y, Z, curve);
+
+	uECC_vli_sub(ty, curve->p, Y, num_words);
+	ct_vli_select(Y, ty, 0 - even, num_words);
+
+	uECC_vli_set(result, X, num_words);
+	uECC_vli_set(result + num_words, Y, num_words);
+}
+
+#endif
+
+void EccPoint_mult_base(uECC_word_t * result, const uECC_word_t * scalar,
+			uECC_Curve curve)
+{
+	uECC_word_t tmp1[NUM_ECC_WORDS];
+	uECC_word_t tmp2[NUM_ECC_WORDS];
+	uECC_word_t *p2[2] = {tmp1, tmp2};
+	uECC_word_t carry;
+
+#if uECC_SECP256R1_COMB_TEETH || uECC_SECP256K1_COMB_TEETH
+	if (curve->comb) {
+		EccPoint_mult_comb(result, scalar, curve);
+		return;
+	}
+#endif
+
+	/* Regularize the bitcount for the scalar so that attackers cannot
+	 * use a side channel attack to learn the number of leading zeros. */
+	carry = regularize_k(scalar, tmp1, tmp2, curve);
+
+	EccPoint_mult(result, curve->G, p2[!carry], 0, curve->num_n_bits + 1, curve);
+}
+
 uECC_word_t regularize_k(const uECC_word_t * const k, uECC_word_t *k0,
 			 uECC_word_t *k1, uECC_Curve curve)
 {
@@ -1004,16 +1404,7 @@ uECC_word_t EccPoint_compute_public_key(uECC_word_t *result,
 					uECC_Curve curve)
 {
 
-	uECC_word_t tmp1[NUM_ECC_WORDS];
- 	uECC_word_t tmp2[NUM_ECC_WORDS];
-	uECC_word_t *p2[2] = {tmp1, tmp2};
-	uECC_word_t carry;
-
-	/* Regularize the bitcount for the private key so that attackers cannot
-	 * use a side channel attack to learn the number of leading zeros. */
-	carry = regularize_k(private_key, tmp1, tmp2, curve);
-
-	EccPoint_mult(result, curve->G, p2[!carry], 0, curve->num_n_bits + 1, curve);
+	EccPoint_mult_base(result, private_key, curve);
 
 	if (EccPoint_isZero(result, curve)) {
 		return 0;
@@ -1023,7 +1414,7 @@ uECC_word_t EccPoint_compute_public_key(uECC_word_t *result,
 
 /* Converts an integer in uECC native format to big-endian bytes. */
 void uECC_vli_nativeToBytes(uint8_t *bytes, int num_bytes,
-			    const unsigned int *native)
+			    const uECC_word_t *native)
 {
 	wordcount_t i;
 	for (i = 0; i < num_bytes; ++i) {
@@ -1033,7 +1424,7 @@ void uECC_vli_nativeToBytes(uint8_t *bytes, int num_bytes,
 }
 
 /* Converts big-endian bytes to an integer in uECC native format. */
-void uECC_vli_bytesToNative(unsigned int *native, const uint8_t *bytes,
+void uECC_vli_bytesToNative(uECC_word_t *native, const uint8_t *bytes,
 			    int num_bytes)
 {
 	wordcount_t i;
@@ -56,6 +56,7 @@
 #include "include/backends/tinycryt/constants.h"
 #include "include/backends/tinycryt/ecc.h"
 #include "include/backends/tinycryt/ecc_dsa.h"
+#include "include/backends/tinycryt/utils.h"
 
 
 static void bits2int(uECC_word_t *native, const uint8_t *bits,
@@ -91,19 +92,30 @@ static void bits2int(uECC_word_t *native, const uint8_t *bits,
 	}
 }
 
-int uECC_sign_with_k(const uint8_t *private_key, const uint8_t *message_hash,
-		     unsigned hash_size, uECC_word_t *k, uint8_t *signature,
-		     uECC_Curve curve)
+/* s = min(s, n - s), selected with a mask so the timing does not depend on s */
+static void vli_low_s(uECC_word_t *s, uECC_Curve curve, wordcount_t num_n_words)
+{
+	uECC_word_t neg[NUM_ECC_WORDS];
+	uECC_word_t diff[NUM_ECC_WORDS];
+	uECC_word_t mask;
+	wordcount_t i;
+
+	uECC_vli_sub(neg, curve->n, s, num_n_words);	/* neg = n - s */
+	/* s > n / 2 exactly when n - s < s */
+	mask = 0 - uECC_vli_sub(diff, neg, s, num_n_words);
+	for (i = 0; i < num_n_words; ++i) {
+		s[i] = (neg[i] & mask) | (s[i] & ~mask);
+	}
+}
+
+/* r = x(kG) and kinv = 1 / k, k is overwritten */
+static int nonce_from_k(uECC_word_t *k, uECC_sign_nonce *nonce, uECC_Curve curve)
 {
 
 	uECC_word_t tmp[NUM_ECC_WORDS];
-	uECC_word_t s[NUM_ECC_WORDS];
-	uECC_word_t *k2[2] = {tmp, s};
 	uECC_word_t p[NUM_ECC_WORDS * 2];
-	uECC_word_t carry;
 	wordcount_t num_words = curve->num_words;
 	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
-	bitcount_t num_n_bits = curve->num_n_bits;
 
 	/* Make sure 0 < k < curve_n */
   	if (uECC_vli_isZero(k, num_words) ||
@@ -111,8 +123,7 @@ int uECC_sign_with_k(const uint8_t *private_key, const uint8_t *message_hash,
 		return 0;
 	}
 
-	carry = regularize_k(k, tmp, s, curve);
-	EccPoint_mult(p, curve->G, k2[!carry], 0, num_n_bits + 1, curve);
+	EccPoint_mult_base(p, k, curve);
 	if (uECC_vli_isZero(p, num_words)) {
 		return 0;
 	}
@@ -129,56 +140,156 @@ int uECC_sign_with_k(const uint8_t *private_key, const uint8_t *message_hash,
 
 	/* Prevent side channel analysis of uECC_vli_modInv() to determine
 	bits of k / the private key by premultiplying by a random number */
-	uECC_vli_modMult(k, k, tmp, curve->n, num_n_words); /* k' = rand * k */
+	uECC_vli_modMult_n(k, k, tmp, curve); /* k' = rand * k */
 	uECC_vli_modInv(k, k, curve->n, num_n_words);       /* k = 1 / k' */
-	uECC_vli_modMult(k, k, tmp, curve->n, num_n_words); /* k = 1 / k */
+	uECC_vli_modMult_n(nonce->kinv, k, tmp, curve); /* 1 / k */
 
-	uECC_vli_nativeToBytes(signature, curve->num_bytes, p); /* store r */
+	uECC_vli_set(nonce->r, p, num_words);
+	nonce->curve = curve;
+	return 1;
+}
+
+/* s = (e + r*d) / k from a nonce of nonce_from_k() */
+static int sign_with_nonce(const uint8_t *private_key,
+			   const uint8_t *message_hash, unsigned hash_size,
+			   const uECC_sign_nonce *nonce, uint8_t *signature,
+			   int low_s, uECC_Curve curve)
+{
+
+	uECC_word_t tmp[NUM_ECC_WORDS];
+	uECC_word_t s[NUM_ECC_WORDS];
+	wordcount_t num_words = curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	uECC_vli_nativeToBytes(signature, curve->num_bytes, nonce->r); /* store r */
 
 	/* tmp = d: */
 	uECC_vli_bytesToNative(tmp, private_key, BITS_TO_BYTES(curve->num_n_bits));
 
 	s[num_n_words - 1] = 0;
-	uECC_vli_set(s, p, num_words);
-	uECC_vli_modMult(s, tmp, s, curve->n, num_n_words); /* s = r*d */
+	uECC_vli_set(s, nonce->r, num_words);
+	uECC_vli_modMult_n(s, tmp, s, curve); /* s = r*d */
 
 	bits2int(tmp, message_hash, hash_size, curve);
 	uECC_vli_modAdd(s, tmp, s, curve->n, num_n_words); /* s = e + r*d */
-	uECC_vli_modMult(s, s, k, curve->n, num_n_words);  /* s = (e + r*d) / k */
+	uECC_vli_modMult_n(s, s, nonce->kinv, curve);  /* s = (e + r*d) / k */
 	if (uECC_vli_numBits(s, num_n_words) > (bitcount_t)curve->num_bytes * 8) {
 		return 0;
 	}
 
+	if (low_s) {
+		vli_low_s(s, curve, num_n_words);
+	}
+
 	uECC_vli_nativeToBytes(signature + curve->num_bytes, curve->num_bytes, s);
 	return 1;
 }
 
-int uECC_sign(const uint8_t *private_key, const uint8_t *message_hash,
-	      unsigned hash_size, uint8_t *signature, uECC_Curve curve)
+static int sign_with_k(const uint8_t *private_key, const uint8_t *message_hash,
+		       unsigned hash_size, uECC_word_t *k, uint8_t *signature,
+		       int low_s, uECC_Curve curve)
+{
+	uECC_sign_nonce nonce;
+	int ret;
+
+	ret = nonce_from_k(k, &nonce, curve) &&
+	      sign_with_nonce(private_key, message_hash, hash_size, &nonce,
+			      signature, low_s, curve);
+
+	_set_secure(&nonce, 0, sizeof(nonce));
+	return ret;
+}
+
+int uECC_sign_with_k(const uint8_t *private_key, const uint8_t *message_hash,
+		     unsigned hash_size, uECC_word_t *k, uint8_t *signature,
+		     uECC_Curve curve)
+{
+	return sign_with_k(private_key, message_hash, hash_size, k, signature, 0,
+			   curve);
+}
+
+/* A uniformly random 0 < k < n, see FIPS 186.4 B.5.1 */
+static int random_k(uECC_word_t *k, uECC_Curve curve)
+{
+	uECC_word_t _random[2*NUM_ECC_WORDS];
+	uECC_RNG_Function rng_function = uECC_get_rng();
+
+	if (!rng_function ||
+	    !rng_function((uint8_t *)_random, 2*NUM_ECC_WORDS*uECC_WORD_SIZE)) {
+		return 0;
+	}
+
+	// computing k as modular reduction of _random (see FIPS 186.4 B.5.1):
+	uECC_vli_mmod(k, _random, curve->n, BITS_TO_WORDS(curve->num_n_bits));
+	_set_secure(_random, 0, sizeof(_random));
+	return 1;
+}
+
+static int sign(const uint8_t *private_key, const uint8_t *message_hash,
+		unsigned hash_size, uint8_t *signature, int low_s,
+		uECC_Curve curve)
 {
-	      uECC_word_t _random[2*NUM_ECC_WORDS];
 	      uECC_word_t k[NUM_ECC_WORDS];
 	      uECC_word_t tries;
 
 	for (tries = 0; tries < uECC_RNG_MAX_TRIES; ++tries) {
-		/* Generating _random uniformly at random: */
-		uECC_RNG_Function rng_function = uECC_get_rng();
-		if (!rng_function ||
-		    !rng_function((uint8_t *)_random, 2*NUM_ECC_WORDS*uECC_WORD_SIZE)) {
+		if (!random_k(k, curve)) {
 			return 0;
 		}
 
-		// computing k as modular reduction of _random (see FIPS 186.4 B.5.1):
-		uECC_vli_mmod(k, _random, curve->n, BITS_TO_WORDS(curve->num_n_bits));
-
-		if (uECC_sign_with_k(private_key, message_hash, hash_size, k, signature, 
-		    curve)) {
+		if (sign_with_k(private_key, message_hash, hash_size, k, signature,
+		    low_s, curve)) {
 			return 1;
 		}
 	}
 	return 0;
 }
 
+int uECC_sign(const uint8_t *private_key, const uint8_t *message_hash,
+	      unsigned hash_size, uint8_t *signature, uECC_Curve curve)
+{
+	return sign(private_key, message_hash, hash_size, signature, 0, curve);
+}
+
+int uECC_sign_low_s(const uint8_t *private_key, const uint8_t *message_hash,
+		    unsigned hash_size, uint8_t *signature, uECC_Curve curve)
+{
+	return sign(private_key, message_hash, hash_size, signature, 1, curve);
+}
+
+int uECC_sign_precompute(uECC_sign_nonce *nonce, uECC_Curve curve)
+{
+	uECC_word_t k[NUM_ECC_WORDS];
+	uECC_word_t tries;
+	int ret = 0;
+
+	for (tries = 0; tries < uECC_RNG_MAX_TRIES && !ret; ++tries) {
+		if (!random_k(k, curve)) {
+			break;
+		}
+		ret = nonce_from_k(k, nonce, curve);
+	}
+
+	_set_secure(k, 0, sizeof(k));
+	return ret;
+}
+
+int uECC_sign_with_nonce(const uint8_t *private_key,
+			 const uint8_t *message_hash, unsigned hash_size,
+			 uECC_sign_nonce *nonce, uint8_t *signature, int low_s,
+			 uECC_Curve curve)
+{
+	int ret = 0;
+
+	if (nonce->curve == curve) {
+		ret = sign_with_nonce(private_key, message_hash, hash_size,
+				      nonce, signature, low_s, curve);
+	}
+
+	_set_secure(nonce, 0, sizeof(*nonce));
+	return ret;
+}
+
 static bitcount_t smax(bitcount_t a, bitcount_t b)
 {
 	return (a > b ? a : b);
@@ -188,32 +299,29 @@ int uECC_verify(const uint8_t *public_key, const uint8_t *message_hash,
 		unsigned hash_size, const uint8_t *signature,
 	        uECC_Curve curve)
 {
+	uECC_word_t _public[NUM_ECC_WORDS * 2];
 
-	uECC_word_t u1[NUM_ECC_WORDS], u2[NUM_ECC_WORDS];
-	uECC_word_t z[NUM_ECC_WORDS];
-	uECC_word_t sum[NUM_ECC_WORDS * 2];
-	uECC_word_t rx[NUM_ECC_WORDS];
-	uECC_word_t ry[NUM_ECC_WORDS];
-	uECC_word_t tx[NUM_ECC_WORDS];
-	uECC_word_t ty[NUM_ECC_WORDS];
-	uECC_word_t tz[NUM_ECC_WORDS];
-	const uECC_word_t *points[4];
-	const uECC_word_t *point;
-	bitcount_t num_bits;
-	bitcount_t i;
+	uECC_vli_bytesToNative(_public, public_key, curve->num_bytes);
+	uECC_vli_bytesToNative(_public + curve->num_words,
+			       public_key + curve->num_bytes, curve->num_bytes);
 
-	uECC_word_t _public[NUM_ECC_WORDS * 2];
-	uECC_word_t r[NUM_ECC_WORDS], s[NUM_ECC_WORDS];
+	return uECC_verify_native(_public, message_hash, hash_size, signature,
+				  curve);
+}
+
+/*
+ * Reads r and s from the signature and checks that 0 < r, s < n. Returns 0
+ * if the signature is out of range.
+ */
+static int verify_parse(uECC_word_t *r, uECC_word_t *s,
+			const uint8_t *signature, uECC_Curve curve)
+{
 	wordcount_t num_words = curve->num_words;
 	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
 
-	rx[num_n_words - 1] = 0;
 	r[num_n_words - 1] = 0;
 	s[num_n_words - 1] = 0;
 
-	uECC_vli_bytesToNative(_public, public_key, curve->num_bytes);
-	uECC_vli_bytesToNative(_public + num_words, public_key + curve->num_bytes,
-			       curve->num_bytes);
 	uECC_vli_bytesToNative(r, signature, curve->num_bytes);
 	uECC_vli_bytesToNative(s, signature + curve->num_bytes, curve->num_bytes);
 
@@ -228,22 +336,82 @@ int uECC_verify(const uint8_t *public_key, const uint8_t *message_hash,
 		return 0;
 	}
 
-	/* Calculate u1 and u2. */
-	uECC_vli_modInv(z, s, curve->n, num_n_words); /* z = 1/s */
+	return 1;
+}
+
+/* Computes u1 = e/s and u2 = r/s from z = 1/s. */
+static void verify_u(uECC_word_t *u1, uECC_word_t *u2, const uECC_word_t *r,
+		     const uECC_word_t *z, const uint8_t *message_hash,
+		     unsigned hash_size, uECC_Curve curve)
+{
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
 	u1[num_n_words - 1] = 0;
 	bits2int(u1, message_hash, hash_size, curve);
-	uECC_vli_modMult(u1, u1, z, curve->n, num_n_words); /* u1 = e/s */
-	uECC_vli_modMult(u2, r, z, curve->n, num_n_words); /* u2 = r/s */
+	uECC_vli_modMult_n(u1, u1, z, curve); /* u1 = e/s */
+	uECC_vli_modMult_n(u2, r, z, curve); /* u2 = r/s */
+}
+
+/*
+ * Reads r and s from the signature, checks that 0 < r, s < n and computes
+ * u1 = e/s and u2 = r/s. Returns 0 if the signature is out of range.
+ */
+static int verify_scalars(uECC_word_t *u1, uECC_word_t *u2, uECC_word_t *r,
+			  const uint8_t *message_hash, unsigned hash_size,
+			  const uint8_t *signature, uECC_Curve curve)
+{
+	uECC_word_t s[NUM_ECC_WORDS];
+	uECC_word_t z[NUM_ECC_WORDS];
+
+	if (!verify_parse(r, s, signature, curve)) {
+		return 0;
+	}
+
+	uECC_vli_modInv(z, s, curve->n, BITS_TO_WORDS(curve->num_n_bits)); /* z = 1/s */
+	verify_u(u1, u2, r, z, message_hash, hash_size, curve);
+
+	return 1;
+}
+
+/*
+ * Computes G + Q for Shamir's trick, with a co-Z addition that leaves
+ * sum = ((x, y) of G + Q) * (z^2, z^3). Returns z, zero if Q = +-G.
+ */
+static void shamir_sum(uECC_word_t *sum, uECC_word_t *z,
+		       const uECC_word_t *_public, uECC_Curve curve)
+{
+	uECC_word_t tx[NUM_ECC_WORDS];
+	uECC_word_t ty[NUM_ECC_WORDS];
+	wordcount_t num_words = curve->num_words;
 
-	/* Calculate sum = G + Q. */
 	uECC_vli_set(sum, _public, num_words);
 	uECC_vli_set(sum + num_words, _public + num_words, num_words);
 	uECC_vli_set(tx, curve->G, num_words);
 	uECC_vli_set(ty, curve->G + num_words, num_words);
 	uECC_vli_modSub(z, sum, tx, curve->p, num_words); /* z = x2 - x1 */
 	XYcZ_add(tx, ty, sum, sum + num_words, curve);
-	uECC_vli_modInv(z, z, curve->p, num_words); /* z = 1/z */
-	apply_z(sum, sum + num_words, z, curve);
+}
+
+/*
+ * Checks u1*G + u2*Q against r with Shamir's trick, sum being G + Q in affine
+ * coordinates.
+ */
+static int verify_shamir(const uECC_word_t *_public, const uECC_word_t *sum,
+			 const uECC_word_t *u1, const uECC_word_t *u2,
+			 const uECC_word_t *r, uECC_Curve curve)
+{
+	uECC_word_t z[NUM_ECC_WORDS];
+	uECC_word_t rx[NUM_ECC_WORDS];
+	uECC_word_t ry[NUM_ECC_WORDS];
+	uECC_word_t tx[NUM_ECC_WORDS];
+	uECC_word_t ty[NUM_ECC_WORDS];
+	uECC_word_t tz[NUM_ECC_WORDS];
+	const uECC_word_t *points[4];
+	const uECC_word_t *point;
+	bitcount_t num_bits;
+	bitcount_t i;
+	wordcount_t num_words = curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
 
 	/* Use Shamir's trick to calculate u1*G + u2*Q */
 	points[0] = 0;
@@ -276,15 +444,238 @@ int uECC_verify(const uint8_t *public_key, const uint8_t *message_hash,
 		}
   	}
 
-	uECC_vli_modInv(z, z, curve->p, num_words); /* Z = 1/Z */
-	apply_z(rx, ry, z, curve);
+	/* Accept only if x1 (mod n) == r, without the inversion of Z. */
+	return EccPoint_check_x(rx, z, r, curve);
+}
+
+/*
+ * Checks u1*G + u2*Q against r when Q = +-G, where Shamir's trick has no G + Q
+ * to add: the sum is (u1 +- u2)*G.
+ */
+static int verify_degenerate(const uECC_word_t *_public, const uECC_word_t *u1,
+			     const uECC_word_t *u2, const uECC_word_t *r,
+			     uECC_Curve curve)
+{
+	uECC_word_t u[NUM_ECC_WORDS];
+	uECC_word_t point[NUM_ECC_WORDS * 2];
+	uECC_word_t z[NUM_ECC_WORDS];
+	wordcount_t num_words = curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	if (uECC_vli_equal(_public + num_words, curve->G + num_words,
+			   num_words) == 0) {
+		uECC_vli_modAdd(u, u1, u2, curve->n, num_n_words); /* Q = G */
+	} else {
+		uECC_vli_modSub(u, u1, u2, curve->n, num_n_words); /* Q = -G */
+	}
+
+	/* The sum is the point at infinity */
+	if (uECC_vli_isZero(u, num_n_words)) {
+		return 0;
+	}
+
+	EccPoint_mult_base(point, u, curve);
+
+	uECC_vli_clear(z, num_words);
+	z[0] = 1;
+
+	return EccPoint_check_x(point, z, r, curve);
+}
+
+int uECC_verify_native(const uECC_word_t *_public, const uint8_t *message_hash,
+		       unsigned hash_size, const uint8_t *signature,
+		       uECC_Curve curve)
+{
+	uECC_word_t u1[NUM_ECC_WORDS], u2[NUM_ECC_WORDS];
+	uECC_word_t r[NUM_ECC_WORDS];
+	uECC_word_t z[NUM_ECC_WORDS];
+	uECC_word_t sum[NUM_ECC_WORDS * 2];
+
+#if uECC_SECP256K1_GLV
+	if (uECC_get_curve_type(curve) == uECC_CURVE_TYPE_SECP256K1) {
+		return uECC_verify_glv(_public, message_hash, hash_size,
+				       signature, NULL);
+	}
+#endif
+
+	if (!verify_scalars(u1, u2, r, message_hash, hash_size, signature,
+			    curve)) {
+		return 0;
+	}
+
+	shamir_sum(sum, z, _public, curve);
+	if (uECC_vli_isZero(z, curve->num_words)) {
+		return verify_degenerate(_public, u1, u2, r, curve);
+	}
+	uECC_vli_modInv(z, z, curve->p, curve->num_words); /* z = 1/z */
+	apply_z(sum, sum + curve->num_words, z, curve);
+
+	return verify_shamir(_public, sum, u1, u2, r, curve);
+}
+
+#if uECC_SECP256K1_GLV
+/* Returns table, or local if it is NULL, holding the multiples of _public */
+static uECC_glv_table *glv_table(uECC_glv_table *table, uECC_glv_table *local,
+				 const uECC_word_t *_public)
+{
+	if (NULL == table) {
+		table = local;
+		table->valid = 0;
+	}
+
+	if (!table->valid ||
+	    uECC_vli_cmp_unsafe(table->key, _public, 2 * NUM_ECC_WORDS) != 0) {
+		uECC_glv_table_init(table, _public);
+	}
+
+	return table;
+}
 
-	/* v = x1 (mod n) */
-	if (uECC_vli_cmp_unsafe(curve->n, rx, num_n_words) != 1) {
-		uECC_vli_sub(rx, rx, curve->n, num_n_words);
+int uECC_verify_glv(const uECC_word_t *_public, const uint8_t *message_hash,
+		    unsigned hash_size, const uint8_t *signature,
+		    uECC_glv_table *table)
+{
+	uECC_Curve curve = uECC_secp256k1();
+	uECC_word_t u1[NUM_ECC_WORDS], u2[NUM_ECC_WORDS];
+	uECC_word_t r[NUM_ECC_WORDS];
+	uECC_glv_table local;
+
+	if (!verify_scalars(u1, u2, r, message_hash, hash_size, signature,
+			    curve)) {
+		return 0;
 	}
 
-	/* Accept only if v == r. */
-	return (int)(uECC_vli_equal(rx, r, num_words) == 0);
+	return EccPoint_verify_glv(u1, u2, r, glv_table(table, &local, _public));
 }
+#endif
+
+/* (left * right) % mod, mod being p or n */
+static void mod_mult(uECC_word_t *result, const uECC_word_t *left,
+		     const uECC_word_t *right, const uECC_word_t *mod,
+		     uECC_Curve curve)
+{
+	if (mod == curve->p) {
+		uECC_vli_modMult_fast(result, left, right, curve);
+	} else {
+		uECC_vli_modMult_n(result, left, right, curve);
+	}
+}
+
+/*
+ * In place inversion of the nonzero v[0 .. count - 1] modulo p or n with a
+ * single uECC_vli_modInv(), after Montgomery: with a[i] = v[0] * .. * v[i],
+ * 1/v[i] is a[i - 1] / a[i] and 1/a[i - 1] is v[i] / a[i].
+ */
+static void batch_inverse(uECC_word_t (*v)[NUM_ECC_WORDS],
+			  uECC_word_t (*a)[NUM_ECC_WORDS], unsigned count,
+			  const uECC_word_t *mod, uECC_Curve curve)
+{
+	uECC_word_t inv[NUM_ECC_WORDS];
+	uECC_word_t t[NUM_ECC_WORDS];
+	wordcount_t num_words = curve->num_words;
+	unsigned i;
+
+	uECC_vli_set(a[0], v[0], num_words);
+	for (i = 1; i < count; ++i) {
+		mod_mult(a[i], a[i - 1], v[i], mod, curve);
+	}
+
+	uECC_vli_modInv(inv, a[count - 1], mod, num_words);
 
+	for (i = count - 1; i > 0; --i) {
+		mod_mult(t, inv, a[i - 1], mod, curve);
+		mod_mult(inv, inv, v[i], mod, curve);
+		uECC_vli_set(v[i], t, num_words);
+	}
+	uECC_vli_set(v[0], inv, num_words);
+}
+
+static void verify_batch_chunk(uECC_verify_item *items, unsigned count,
+			       uECC_Curve curve)
+{
+	uECC_word_t r[uECC_VERIFY_BATCH_CHUNK][NUM_ECC_WORDS];
+	uECC_word_t s[uECC_VERIFY_BATCH_CHUNK][NUM_ECC_WORDS];
+	uECC_word_t z[uECC_VERIFY_BATCH_CHUNK][NUM_ECC_WORDS];
+	uECC_word_t a[uECC_VERIFY_BATCH_CHUNK][NUM_ECC_WORDS];
+	uECC_word_t sum[uECC_VERIFY_BATCH_CHUNK][NUM_ECC_WORDS * 2];
+	uECC_word_t u1[NUM_ECC_WORDS], u2[NUM_ECC_WORDS];
+	uint8_t ok[uECC_VERIFY_BATCH_CHUNK];
+	wordcount_t num_words = curve->num_words;
+	int glv = 0;
+	unsigned i;
+
+#if uECC_SECP256K1_GLV
+	glv = (uECC_get_curve_type(curve) == uECC_CURVE_TYPE_SECP256K1);
+#endif
+
+	/* Out of range signatures are rejected now, 1 keeps their place */
+	for (i = 0; i < count; ++i) {
+		ok[i] = (uint8_t)verify_parse(r[i], s[i], items[i].signature,
+					      curve);
+		if (!ok[i]) {
+			uECC_vli_clear(s[i], num_words);
+			s[i][0] = 1;
+		}
+	}
+	batch_inverse(s, a, count, curve->n, curve);
+
+	/* Shamir's trick wants G + Q in affine coordinates. When its z is
+	 * zero the item is left out of the batch and simply re-checked on
+	 * its own with uECC_verify_native() */
+	if (!glv) {
+		for (i = 0; i < count; ++i) {
+			shamir_sum(sum[i], z[i], items[i].public_key, curve);
+			if (uECC_vli_isZero(z[i], num_words)) {
+				z[i][0] = 1;
+				ok[i] = ok[i] ? 2 : 0;
+			}
+		}
+		batch_inverse(z, a, count, curve->p, curve);
+	}
+
+	for (i = 0; i < count; ++i) {
+		if (!ok[i]) {
+			items[i].result = 0;
+			continue;
+		}
+
+		if (2 == ok[i]) {
+			items[i].result = uECC_verify_native(items[i].public_key,
+							     items[i].message_hash,
+							     items[i].hash_size,
+							     items[i].signature,
+							     curve);
+			continue;
+		}
+
+		verify_u(u1, u2, r[i], s[i], items[i].message_hash,
+			 items[i].hash_size, curve);
+
+#if uECC_SECP256K1_GLV
+		if (glv) {
+			uECC_glv_table local;
+
+			items[i].result = EccPoint_verify_glv(u1, u2, r[i],
+				glv_table(items[i].table, &local, items[i].public_key));
+			continue;
+		}
+#endif
+
+		apply_z(sum[i], sum[i] + num_words, z[i], curve);
+		items[i].result = verify_shamir(items[i].public_key, sum[i],
+						u1, u2, r[i], curve);
+	}
+}
+
+void uECC_verify_batch(uECC_verify_item *items, unsigned count,
+		       uECC_Curve curve)
+{
+	unsigned n;
+
+	while (count > 0) {
+		n = count < uECC_VERIFY_BATCH_CHUNK ? count : uECC_VERIFY_BATCH_CHUNK;
+		verify_batch_chunk(items, n, curve);
+		items += n;
+		count -= n;
+	}
+}
@@ -0,0 +1,304 @@
+/* ecc_glv.c - secp256k1 ECDSA verification with the GLV endomorphism */
+
+/*
+ * secp256k1 has the endomorphism lambda * (x, y) = (beta * x, y), with
+ * lambda^3 = 1 mod n and beta^3 = 1 mod p. After Gallant, Lambert and
+ * Vanstone, each scalar k of u1 * G + u2 * Q is split into k1 + k2 * lambda
+ * with k1 and k2 of at most 128 bits. The verification becomes a sum of four
+ * half-length products that share their 128 doublings. The half scalars are
+ * recoded in width-w NAF, so that about one digit in w + 1 is nonzero and
+ * costs one mixed addition of a precomputed odd multiple: 64 of G from
+ * ecc_glv_table.c, 8 of Q from a uECC_glv_table.
+ *
+ * The split constants are the ones of libsecp256k1. Everything here branches
+ * on its inputs, which are public in a signature verification; none of it
+ * may be used with secret scalars.
+ */
+
+#include <string.h>
+
+#include "include/backends/tinycryt/ecc.h"
+
+#if uECC_SECP256K1_GLV
+
+/* Width of the wNAF digits of the G half scalars, matches ecc_glv_table.c */
+#define GLV_G_WINDOW 8
+
+/* Enough wNAF digits for a half scalar below 2^128 and the final carry */
+#define GLV_NAF_DIGITS (128 + GLV_G_WINDOW + 1)
+
+/* round(2^384 * b2 / n) and round(2^384 * -b1 / n) */
+static const uECC_word_t glv_g1[NUM_ECC_WORDS] = {
+	BYTES_TO_WORDS_8(31, B0, DB, 45, 9A, 20, 93, E8),
+	BYTES_TO_WORDS_8(7F, CA, E8, 71, 14, 8A, AA, 3D),
+	BYTES_TO_WORDS_8(15, EB, 84, 92, E4, 90, 6C, E8),
+	BYTES_TO_WORDS_8(CD, 6B, D4, A7, 21, D2, 86, 30)
+};
+static const uECC_word_t glv_g2[NUM_ECC_WORDS] = {
+	BYTES_TO_WORDS_8(71, 7F, C4, 8A, AE, B4, 71, 15),
+	BYTES_TO_WORDS_8(C6, 06, F5, 9D, AC, 08, 12, 22),
+	BYTES_TO_WORDS_8(C4, E4, BF, 0A, A9, 7F, 54, 6F),
+	BYTES_TO_WORDS_8(28, 88, 0E, 01, D6, 7E, 43, E4)
+};
+
+/* -b1 and -b2 mod n, for the lattice basis (a1, b1), (a2, b2) of the split */
+static const uECC_word_t glv_minus_b1[NUM_ECC_WORDS] = {
+	BYTES_TO_WORDS_8(C3, E4, BF, 0A, A9, 7F, 54, 6F),
+	BYTES_TO_WORDS_8(28, 88, 0E, 01, D6, 7E, 43, E4),
+	BYTES_TO_WORDS_8(00, 00, 00, 00, 00, 00, 00, 00),
+	BYTES_TO_WORDS_8(00, 00, 00, 00, 00, 00, 00, 00)
+};
+static const uECC_word_t glv_minus_b2[NUM_ECC_WORDS] = {
+	BYTES_TO_WORDS_8(2C, 56, B1, 3D, A8, CD, 65, D7),
+	BYTES_TO_WORDS_8(6D, 34, 74, 07, C5, 0A, 28, 8A),
+	BYTES_TO_WORDS_8(FE, FF, FF, FF, FF, FF, FF, FF),
+	BYTES_TO_WORDS_8(FF, FF, FF, FF, FF, FF, FF, FF)
+};
+
+/* n - lambda */
+static const uECC_word_t glv_minus_lambda[NUM_ECC_WORDS] = {
+	BYTES_TO_WORDS_8(CF, 83, 12, B5, 10, C8, CF, E0),
+	BYTES_TO_WORDS_8(C2, 39, C7, 8E, FC, B9, 80, A8),
+	BYTES_TO_WORDS_8(A4, 9B, ED, 77, FD, E3, D9, 5A),
+	BYTES_TO_WORDS_8(1F, CF, A3, 3F, B3, 52, 9C, AC)
+};
+
+/* beta, the cube root of unity mod p matching lambda */
+static const uECC_word_t glv_beta[NUM_ECC_WORDS] = {
+	BYTES_TO_WORDS_8(EE, 01, 95, 71, 28, 6C, 39, C1),
+	BYTES_TO_WORDS_8(95, 89, F5, 12, 75, 49, F0, 9C),
+	BYTES_TO_WORDS_8(E9, 34, 34, AC, 9E, 47, 64, 6E),
+	BYTES_TO_WORDS_8(10, 07, 7C, 65, 2B, 6A, E9, 7A)
+};
+
+/* result = round(k * g / 2^384), which is below 2^128 */
+static void glv_mul_shift_384(uECC_word_t *result, const uECC_word_t *k,
+			      const uECC_word_t *g)
+{
+	uECC_word_t product[2 * NUM_ECC_WORDS];
+	wordcount_t shift = 384 / uECC_WORD_BITS;
+	wordcount_t i;
+
+	uECC_vli_mult(product, k, g, NUM_ECC_WORDS);
+
+	uECC_vli_clear(result, NUM_ECC_WORDS);
+	for (i = 0; i < 2 * NUM_ECC_WORDS - shift; ++i) {
+		result[i] = product[shift + i];
+	}
+
+	if (uECC_vli_testBit(product, 383)) {
+		for (i = 0; i < NUM_ECC_WORDS; ++i) {
+			if (++result[i] != 0) {
+				break;
+			}
+		}
+	}
+}
+
+/* Replaces k by n - k when that is smaller, returns -1 if it did, 1 otherwise */
+static int glv_abs(uECC_word_t *k, uECC_Curve curve)
+{
+	uECC_word_t neg[NUM_ECC_WORDS];
+
+	uECC_vli_sub(neg, curve->n, k, NUM_ECC_WORDS);
+	if (uECC_vli_cmp_unsafe(neg, k, NUM_ECC_WORDS) < 0) {
+		uECC_vli_set(k, neg, NUM_ECC_WORDS);
+		return -1;
+	}
+
+	return 1;
+}
+
+/*
+ * Splits k into k1 + k2 * lambda mod n. k1 and k2 receive the magnitudes,
+ * below 2^128, and sign their signs.
+ */
+static void glv_split(uECC_word_t *k1, uECC_word_t *k2, int *sign,
+		      const uECC_word_t *k, uECC_Curve curve)
+{
+	uECC_word_t c1[NUM_ECC_WORDS];
+	uECC_word_t c2[NUM_ECC_WORDS];
+
+	glv_mul_shift_384(c1, k, glv_g1);
+	glv_mul_shift_384(c2, k, glv_g2);
+
+	/* k2 = -(c1 * b1 + c2 * b2), k1 = k - k2 * lambda */
+	uECC_vli_modMult_n(c1, c1, glv_minus_b1, curve);
+	uECC_vli_modMult_n(c2, c2, glv_minus_b2, curve);
+	uECC_vli_modAdd(k2, c1, c2, curve->n, NUM_ECC_WORDS);
+	uECC_vli_modMult_n(k1, k2, glv_minus_lambda, curve);
+	uECC_vli_modAdd(k1, k1, k, curve->n, NUM_ECC_WORDS);
+
+	sign[0] = glv_abs(k1, curve);
+	sign[1] = glv_abs(k2, curve);
+}
+
+/*
+ * Width-w NAF of sign * k: every nonzero digit is odd, below 2^(w-1) in
+ * magnitude and followed by at least w - 1 zero digits. Returns the number
+ * of digits up to the last nonzero one.
+ */
+static int glv_wnaf(int8_t *naf, const uECC_word_t *k, int sign, unsigned w)
+{
+	unsigned carry = 0;
+	unsigned word;
+	unsigned i;
+	int bit = 0;
+	int len = 0;
+
+	memset(naf, 0, GLV_NAF_DIGITS);
+
+	while (bit < GLV_NAF_DIGITS) {
+		if ((unsigned)!!uECC_vli_testBit(k, (bitcount_t)bit) == carry) {
+			++bit;
+			continue;
+		}
+
+		word = carry;
+		for (i = 0; i < w; ++i) {
+			word += (unsigned)!!uECC_vli_testBit(k, (bitcount_t)(bit + i)) << i;
+		}
+		carry = (word >> (w - 1)) & 1;
+
+		naf[bit] = (int8_t)(sign * ((int)word - (int)(carry << w)));
+		len = bit + 1;
+		bit += w;
+	}
+
+	return len;
+}
+
+/* (X, Y, Z) += digit * P, or digit * lambda * P, from the odd multiples of P */
+static void glv_add(uECC_word_t *X, uECC_word_t *Y, uECC_word_t *Z,
+		    const uECC_word_t *odd, int digit, int lambda,
+		    uECC_Curve curve)
+{
+	const uECC_word_t *entry;
+	uECC_word_t x[NUM_ECC_WORDS];
+	uECC_word_t y[NUM_ECC_WORDS];
+
+	entry = odd + 2 * NUM_ECC_WORDS * ((digit < 0 ? -digit : digit) >> 1);
+
+	if (lambda) {
+		uECC_vli_modMult_fast(x, entry, glv_beta, curve);
+	} else {
+		uECC_vli_set(x, entry, NUM_ECC_WORDS);
+	}
+
+	if (digit < 0) {
+		uECC_vli_sub(y, curve->p, entry + NUM_ECC_WORDS, NUM_ECC_WORDS);
+	} else {
+		uECC_vli_set(y, entry + NUM_ECC_WORDS, NUM_ECC_WORDS);
+	}
+
+	EccPoint_add_mixed(X, Y, Z, x, y, curve);
+}
+
+void uECC_glv_table_init(uECC_glv_table *table, const uECC_word_t *point)
+{
+	uECC_Curve curve = uECC_secp256k1();
+	uECC_word_t dx[NUM_ECC_WORDS];
+	uECC_word_t dy[NUM_ECC_WORDS];
+	uECC_word_t X[NUM_ECC_WORDS];
+	uECC_word_t Y[NUM_ECC_WORDS];
+	uECC_word_t Z[1 << (uECC_GLV_KEY_WINDOW - 2)][NUM_ECC_WORDS];
+	uECC_word_t acc[1 << (uECC_GLV_KEY_WINDOW - 2)][NUM_ECC_WORDS];
+	uECC_word_t inv[NUM_ECC_WORDS];
+	int size = 1 << (uECC_GLV_KEY_WINDOW - 2);
+	int i;
+
+	uECC_vli_set(table->key, point, 2 * NUM_ECC_WORDS);
+	uECC_vli_set(table->odd[0], point, 2 * NUM_ECC_WORDS);
+
+	/* 2Q, made affine for the mixed additions */
+	uECC_vli_set(dx, point, NUM_ECC_WORDS);
+	uECC_vli_set(dy, point + NUM_ECC_WORDS, NUM_ECC_WORDS);
+	uECC_vli_clear(inv, NUM_ECC_WORDS);
+	inv[0] = 1;
+	curve->double_jacobian(dx, dy, inv, curve);
+	uECC_vli_modInv(inv, inv, curve->p, NUM_ECC_WORDS);
+	apply_z(dx, dy, inv, curve);
+
+	/* (2i + 1)Q = (2i - 1)Q + 2Q, in jacobian coordinates */
+	uECC_vli_set(X, point, NUM_ECC_WORDS);
+	uECC_vli_set(Y, point + NUM_ECC_WORDS, NUM_ECC_WORDS);
+	uECC_vli_clear(Z[0], NUM_ECC_WORDS);
+	Z[0][0] = 1;
+	for (i = 1; i < size; ++i) {
+		uECC_vli_set(Z[i], Z[i - 1], NUM_ECC_WORDS);
+		EccPoint_add_mixed(X, Y, Z[i], dx, dy, curve);
+		uECC_vli_set(table->odd[i], X, NUM_ECC_WORDS);
+		uECC_vli_set(table->odd[i] + NUM_ECC_WORDS, Y, NUM_ECC_WORDS);
+	}
+
+	/* Montgomery's trick: acc[i] = Z[1] * .. * Z[i], one inversion for all */
+	uECC_vli_set(acc[1], Z[1], NUM_ECC_WORDS);
+	for (i = 2; i < size; ++i) {
+		uECC_vli_modMult_fast(acc[i], acc[i - 1], Z[i], curve);
+	}
+	uECC_vli_modInv(inv, acc[size - 1], curve->p, NUM_ECC_WORDS);
+
+	for (i = size - 1; i > 0; --i) {
+		/* inv = 1 / (Z[1] * .. * Z[i]) here */
+		if (i > 1) {
+			uECC_vli_modMult_fast(acc[i], inv, acc[i - 1], curve);
+			uECC_vli_modMult_fast(inv, inv, Z[i], curve);
+		} else {
+			uECC_vli_set(acc[i], inv, NUM_ECC_WORDS);
+		}
+		apply_z(table->odd[i], table->odd[i] + NUM_ECC_WORDS, acc[i], curve);
+	}
+
+	table->valid = 1;
+}
+
+int EccPoint_verify_glv(const uECC_word_t *u1, const uECC_word_t *u2,
+			const uECC_word_t *r, const uECC_glv_table *table)
+{
+	uECC_Curve curve = uECC_secp256k1();
+	const uECC_word_t *odd[4];
+	unsigned window[4];
+	uECC_word_t k[4][NUM_ECC_WORDS];
+	int8_t naf[4][GLV_NAF_DIGITS];
+	int sign[4];
+	int len;
+	uECC_word_t X[NUM_ECC_WORDS];
+	uECC_word_t Y[NUM_ECC_WORDS];
+	uECC_word_t Z[NUM_ECC_WORDS];
+	int i, j, top;
+
+	/* u1 * G + u2 * Q = k0 * G + k1 * lambda * G + k2 * Q + k3 * lambda * Q */
+	odd[0] = odd[1] = uECC_secp256k1_glv_table;
+	odd[2] = odd[3] = table->odd[0];
+	window[0] = window[1] = GLV_G_WINDOW;
+	window[2] = window[3] = uECC_GLV_KEY_WINDOW;
+
+	glv_split(k[0], k[1], sign, u1, curve);
+	glv_split(k[2], k[3], sign + 2, u2, curve);
+
+	top = 0;
+	for (j = 0; j < 4; ++j) {
+		len = glv_wnaf(naf[j], k[j], sign[j], window[j]);
+		if (len > top) {
+			top = len;
+		}
+	}
+
+	/* Start from the point at infinity, Z = 0 */
+	uECC_vli_clear(X, NUM_ECC_WORDS);
+	uECC_vli_clear(Y, NUM_ECC_WORDS);
+	uECC_vli_clear(Z, NUM_ECC_WORDS);
+
+	for (i = top - 1; i >= 0; --i) {
+		curve->double_jacobian(X, Y, Z, curve);
+		for (j = 0; j < 4; ++j) {
+			if (naf[j][i]) {
+				glv_add(X, Y, Z, odd[j], naf[j][i], j & 1, curve);
+			}
+		}
+	}
+
+	return EccPoint_check_x(X, Z, r, curve);
+}
+
+#endif
@@ -0,0 +1,593 @@
+/* ecc_glv_table.c - odd multiples of the secp256k1 generator for uECC_verify_glv() */
+
+/*
+ * Generated table, do not edit. Entry i holds (2i + 1) * G in affine
+ * coordinates, x followed by y, in the word order of curve->G. The images
+ * under the endomorphism, lambda * (2i + 1) * G = (beta * x, y), are not
+ * stored: uECC_verify_glv() multiplies x by beta when it needs them.
+ */
+
+#include "include/backends/tinycryt/ecc.h"
+
+#if uECC_SECP256K1_GLV
+
+const uECC_word_t uECC_secp256k1_glv_table[64 * 2 * NUM_ECC_WORDS] = {
+	/* 1 * G */
+	BYTES_TO_WORDS_8(98, 17, F8, 16, 5B, 81, F2, 59),
+	BYTES_TO_WORDS_8(D9, 28, CE, 2D, DB, FC, 9B, 02),
+	BYTES_TO_WORDS_8(07, 0B, 87, CE, 95, 62, A0, 55),
+	BYTES_TO_WORDS_8(AC, BB, DC, F9, 7E, 66, BE, 79),
+	BYTES_TO_WORDS_8(B8, D4, 10, FB, 8F, D0, 47, 9C),
+	BYTES_TO_WORDS_8(19, 54, 85, A6, 48, B4, 17, FD),
+	BYTES_TO_WORDS_8(A8, 08, 11, 0E, FC, FB, A4, 5D),
+	BYTES_TO_WORDS_8(65, C4, A3, 26, 77, DA, 3A, 48),
+	/* 3 * G */
+	BYTES_TO_WORDS_8(F9, 36, E0, BC, 13, F1, 01, 86),
+	BYTES_TO_WORDS_8(B0, 99, 6F, 83, 45, C8, 31, B5),
+	BYTES_TO_WORDS_8(29, 52, 9D, F8, 85, 4F, 34, 49),
+	BYTES_TO_WORDS_8(10, C3, 58, 92, 01, 8A, 30, F9),
+	BYTES_TO_WORDS_8(72, E6, B8, 84, 75, FD, B9, 6C),
+	BYTES_TO_WORDS_8(1B, 23, C2, 34, 99, A9, 00, 65),
+	BYTES_TO_WORDS_8(56, F3, 37, 2A, E6, 37, E3, 0F),
+	BYTES_TO_WORDS_8(14, E8, 2D, 63, 0F, 7B, 8F, 38),
+	/* 5 * G */
+	BYTES_TO_WORDS_8(E4, EF, 40, B2, 69, D5, A8, CB),
+	BYTES_TO_WORDS_8(B7, 9A, 61, DC, BD, 84, 8B, E8),
+	BYTES_TO_WORDS_8(28, 51, 5C, 0A, 25, A7, B4, 55),
+	BYTES_TO_WORDS_8(93, 20, 07, 1A, 4D, DE, 8B, 2F),
+	BYTES_TO_WORDS_8(D6, 62, AC, A6, 3A, 7D, A8, DC),
+	BYTES_TO_WORDS_8(40, 68, 0D, AB, 1B, 27, 88, F7),
+	BYTES_TO_WORDS_8(26, C4, C9, A6, DD, A9, DB, D4),
+	BYTES_TO_WORDS_8(D6, E3, E5, 36, 26, 22, AC, D8),
+	/* 7 * G */
+	BYTES_TO_WORDS_8(BC, F9, C4, CA, ED, DD, 2B, E9),
+	BYTES_TO_WORDS_8(9C, E3, 30, 03, 7E, 9B, 41, 3D),
+	BYTES_TO_WORDS_8(0E, 7A, EA, F2, 65, F3, 98, A3),
+	BYTES_TO_WORDS_8(EA, B4, 5D, 6E, 64, F0, BD, 5C),
+	BYTES_TO_WORDS_8(DA, 64, 72, 08, 28, 26, 08, A5),
+	BYTES_TO_WORDS_8(B5, E7, FD, 13, B8, D0, 13, A8),
+	BYTES_TO_WORDS_8(DB, 54, 1A, 86, 6D, 8D, 17, A3),
+	BYTES_TO_WORDS_8(60, 59, 25, BA, 40, CA, EB, 6A),
+	/* 9 * G */
+	BYTES_TO_WORDS_8(BE, CC, 27, FC, 0D, 11, 5F, C3),
+	BYTES_TO_WORDS_8(14, E7, 57, 4C, 97, 96, 97, E0),
+	BYTES_TO_WORDS_8(BD, 9A, 55, 9F, 8A, 17, AD, 09),
+	BYTES_TO_WORDS_8(53, F6, C7, F0, E2, 84, D4, AC),
+	BYTES_TO_WORDS_8(37, 9C, 4F, C6, 2A, 26, CC, 05),
+	BYTES_TO_WORDS_8(0F, 8E, 5F, 37, A4, 88, D8, AD),
+	BYTES_TO_WORDS_8(E9, 61, 3B, 76, 71, 09, 38, 64),
+	BYTES_TO_WORDS_8(FD, D9, A7, B0, 21, 89, 33, CC),
+	/* 11 * G */
+	BYTES_TO_WORDS_8(CB, 08, A0, 5D, 89, 17, EC, BB),
+	BYTES_TO_WORDS_8(91, 78, C1, E5, 0B, 98, 49, 56),
+	BYTES_TO_WORDS_8(AC, 5A, C6, 70, 6B, 24, F4, 5E),
+	BYTES_TO_WORDS_8(1E, 41, A9, 58, F8, E7, 4A, 77),
+	BYTES_TO_WORDS_8(1B, C6, 53, C9, C9, 74, 1D, 30),
+	BYTES_TO_WORDS_8(A8, D6, F9, DF, E2, B1, 2D, 37),
+	BYTES_TO_WORDS_8(65, B3, B7, D7, 56, DD, 43, 02),
+	BYTES_TO_WORDS_8(19, 5E, 6B, EB, 32, A0, 84, D9),
+	/* 13 * G */
+	BYTES_TO_WORDS_8(A8, 5A, 40, 19, 8F, DF, ED, DE),
+	BYTES_TO_WORDS_8(CD, 58, 0E, 61, C6, FB, 75, B0),
+	BYTES_TO_WORDS_8(51, 86, 74, C3, 05, D2, D1, C7),
+	BYTES_TO_WORDS_8(8B, 28, 75, D9, C2, 73, 87, F2),
+	BYTES_TO_WORDS_8(81, ED, 03, DB, 52, CB, B5, 29),
+	BYTES_TO_WORDS_8(1F, A9, 1F, 52, DA, 06, 1A, 3A),
+	BYTES_TO_WORDS_8(47, AF, CD, 65, EB, 12, 82, 75),
+	BYTES_TO_WORDS_8(89, 0A, 88, 8D, 2E, 90, B0, 0A),
+	/* 15 * G */
+	BYTES_TO_WORDS_8(0E, 08, 7E, E2, F8, BC, AD, 44),
+	BYTES_TO_WORDS_8(9E, F7, 85, 3C, 6F, 94, E5, 31),
+	BYTES_TO_WORDS_8(11, F4, 5F, 09, E3, 5A, 46, 5A),
+	BYTES_TO_WORDS_8(96, EA, 43, 7D, 4F, 4D, 92, D7),
+	BYTES_TO_WORDS_8(58, 6B, A2, F6, 9F, DC, 04, C5),
+	BYTES_TO_WORDS_8(A5, D3, 96, D8, 2B, AF, 40, EA),
+	BYTES_TO_WORDS_8(EF, 6D, CC, 28, C2, 2E, 84, 83),
+	BYTES_TO_WORDS_8(A6, 72, 6C, A8, 72, 28, 1E, 58),
+	/* 17 * G */
+	BYTES_TO_WORDS_8(34, 4A, 2D, 4A, A0, FA, E4, 66),
+	BYTES_TO_WORDS_8(87, 76, B9, 79, AE, 98, 98, EB),
+	BYTES_TO_WORDS_8(21, CF, EA, 07, E8, FE, 20, A4),
+	BYTES_TO_WORDS_8(50, 77, 67, DB, 4C, EA, FD, DE),
+	BYTES_TO_WORDS_8(77, EB, 56, 9E, F6, 99, B1, CF),
+	BYTES_TO_WORDS_8(F6, C0, 95, 4A, A0, F4, D1, CE),
+	BYTES_TO_WORDS_8(AE, 3D, A9, D2, EA, B0, 97, E9),
+	BYTES_TO_WORDS_8(68, 51, 63, 94, 06, AB, 11, 42),
+	/* 19 * G */
+	BYTES_TO_WORDS_8(6C, 5B, 38, 38, 61, 65, 75, 74),
+	BYTES_TO_WORDS_8(27, 6D, E8, D7, EB, CF, 6A, F0),
+	BYTES_TO_WORDS_8(79, 49, 4F, 44, FF, 5C, EF, 93),
+	BYTES_TO_WORDS_8(D2, 43, A4, 97, A7, A0, 4E, 2B),
+	BYTES_TO_WORDS_8(7A, 9B, C0, E5, 54, C8, 70, B5),
+	BYTES_TO_WORDS_8(63, 97, 26, 50, 0C, F6, 01, 1A),
+	BYTES_TO_WORDS_8(13, 86, 1C, 5A, 3B, 08, 43, B3),
+	BYTES_TO_WORDS_8(93, 5D, 94, 37, C0, 9B, E8, 85),
+	/* 21 * G */
+	BYTES_TO_WORDS_8(D5, 59, BE, 25, EF, 0A, 34, 81),
+	BYTES_TO_WORDS_8(71, 10, F8, 71, 02, D4, 9A, 1D),
+	BYTES_TO_WORDS_8(30, 33, E3, 2C, 33, FA, 93, 4F),
+	BYTES_TO_WORDS_8(56, 12, DD, 4C, 4A, BF, 2B, 35),
+	BYTES_TO_WORDS_8(8C, 99, 81, CF, 8B, 3D, BD, 67),
+	BYTES_TO_WORDS_8(9C, 03, B1, 71, 2E, 3B, 1B, 4A),
+	BYTES_TO_WORDS_8(1F, 3E, DA, 9D, 25, 18, 9C, D5),
+	BYTES_TO_WORDS_8(34, F5, 48, 53, 07, B4, 1E, 32),
+	/* 23 * G */
+	BYTES_TO_WORDS_8(3F, CC, CA, 4E, DD, DA, 9C, DC),
+	BYTES_TO_WORDS_8(29, FF, F5, EF, DF, B8, 2A, E4),
+	BYTES_TO_WORDS_8(24, 91, 87, 59, 05, 01, 30, 02),
+	BYTES_TO_WORDS_8(1B, D1, 38, 6B, 4D, 10, A2, 2F),
+	BYTES_TO_WORDS_8(67, 7D, 2B, 53, 6B, A7, 3B, 42),
+	BYTES_TO_WORDS_8(48, 26, 88, FC, EC, 70, 1D, 18),
+	BYTES_TO_WORDS_8(80, DD, D5, 5B, 33, 69, 45, B6),
+	BYTES_TO_WORDS_8(65, D8, 5D, 29, 68, 10, DE, 02),
+	/* 25 * G */
+	BYTES_TO_WORDS_8(14, 37, 45, F5, D7, 0C, CA, 69),
+	BYTES_TO_WORDS_8(E2, 72, 95, E0, 84, 3D, 3C, 26),
+	BYTES_TO_WORDS_8(83, DA, ED, 66, B0, A9, 21, AB),
+	BYTES_TO_WORDS_8(8D, D6, B4, 09, 9B, 27, 48, 92),
+	BYTES_TO_WORDS_8(02, 34, CB, 97, CE, 32, 4A, E5),
+	BYTES_TO_WORDS_8(FF, 12, 79, 88, 2A, DE, C0, 3F),
+	BYTES_TO_WORDS_8(FF, B1, A2, DE, 1B, A7, 1A, 5D),
+	BYTES_TO_WORDS_8(DE, AA, 34, F2, 7B, 6F, 01, 73),
+	/* 27 * G */
+	BYTES_TO_WORDS_8(29, 87, EE, 3D, 44, 6D, 99, 7E),
+	BYTES_TO_WORDS_8(C0, 15, F6, 4B, 14, 0E, 57, 2F),
+	BYTES_TO_WORDS_8(52, B7, BE, B0, 2F, 13, 70, 8E),
+	BYTES_TO_WORDS_8(27, BF, A8, E3, 2B, 4F, ED, DA),
+	BYTES_TO_WORDS_8(55, 1C, BE, 90, 22, E5, 40, AB),
+	BYTES_TO_WORDS_8(26, A7, AF, F3, 30, C2, 83, 3F),
+	BYTES_TO_WORDS_8(00, D7, F8, 7E, A8, AC, A1, D4),
+	BYTES_TO_WORDS_8(E8, 98, 6C, 7D, 4A, CE, 9D, A6),
+	/* 29 * G */
+	BYTES_TO_WORDS_8(DB, E7, 22, 7D, E8, B5, A3, E6),
+	BYTES_TO_WORDS_8(B0, 81, F2, FD, E9, D9, EC, 11),
+	BYTES_TO_WORDS_8(90, 9F, B1, CB, D7, 28, CF, 8A),
+	BYTES_TO_WORDS_8(2E, 81, 5D, 06, C7, 12, 4D, C4),
+	BYTES_TO_WORDS_8(82, 64, 0E, 0E, 3F, 06, 39, A0),
+	BYTES_TO_WORDS_8(C5, 61, DF, 1E, 86, 6E, 10, 0E),
+	BYTES_TO_WORDS_8(AC, FD, 82, C9, 26, 59, C4, 76),
+	BYTES_TO_WORDS_8(DC, 6C, 32, CE, 60, A4, 19, 21),
+	/* 31 * G */
+	BYTES_TO_WORDS_8(B4, E6, 69, D2, CB, 65, 1C, B6),
+	BYTES_TO_WORDS_8(63, 80, C2, 36, 53, 69, 2B, 15),
+	BYTES_TO_WORDS_8(53, 08, D6, DE, CF, 20, 9A, C8),
+	BYTES_TO_WORDS_8(04, 85, 69, DC, F6, 5B, 24, 6A),
+	BYTES_TO_WORDS_8(82, 8A, 0D, 10, 48, 63, 5E, FD),
+	BYTES_TO_WORDS_8(6E, 3B, 42, D0, 48, BA, 33, 8B),
+	BYTES_TO_WORDS_8(AD, 24, 6A, F1, 26, 51, 3F, 8B),
+	BYTES_TO_WORDS_8(70, 4A, BD, C2, 42, CF, 22, E0),
+	/* 33 * G */
+	BYTES_TO_WORDS_8(A5, D6, 0B, 0D, 7F, E5, 5A, F9),
+	BYTES_TO_WORDS_8(46, 11, EC, 0B, 0B, 30, 13, CE),
+	BYTES_TO_WORDS_8(84, 10, 54, FE, D2, E3, 77, C0),
+	BYTES_TO_WORDS_8(27, E6, 9D, FD, A6, FF, 97, 16),
+	BYTES_TO_WORDS_8(96, 23, 1B, D0, 63, 9D, EE, AD),
+	BYTES_TO_WORDS_8(E7, 8A, 49, 9E, 00, 15, CF, A2),
+	BYTES_TO_WORDS_8(33, 74, 55, E4, 06, 15, 56, 27),
+	BYTES_TO_WORDS_8(5D, 6F, 80, 86, F1, 98, C3, B9),
+	/* 35 * G */
+	BYTES_TO_WORDS_8(79, 74, 7A, F2, 5E, 34, 82, F9),
+	BYTES_TO_WORDS_8(1D, F6, B7, FF, 60, 83, EB, 9D),
+	BYTES_TO_WORDS_8(0D, CB, 34, E8, 07, 0F, 6D, 98),
+	BYTES_TO_WORDS_8(8B, 71, 81, 99, 01, DB, 5B, 60),
+	BYTES_TO_WORDS_8(49, 8C, 6B, 05, E9, E1, 01, 3B),
+	BYTES_TO_WORDS_8(B4, 4D, B1, 4F, E8, FA, 6B, C2),
+	BYTES_TO_WORDS_8(23, FE, 96, EC, 93, 8D, A7, 81),
+	BYTES_TO_WORDS_8(06, D2, F8, E4, 2D, 2D, 97, 02),
+	/* 37 * G */
+	BYTES_TO_WORDS_8(3D, F3, 7F, D8, E9, C7, 31, FE),
+	BYTES_TO_WORDS_8(0C, B1, 59, 49, 35, 1C, B0, DC),
+	BYTES_TO_WORDS_8(10, 5E, 21, 5A, C4, FD, 02, 74),
+	BYTES_TO_WORDS_8(49, BF, 50, 41, AB, 4D, D1, 62),
+	BYTES_TO_WORDS_8(AF, 5E, B2, 83, 24, 64, F5, 35),
+	BYTES_TO_WORDS_8(22, 47, AB, 67, 29, 13, AA, 01),
+	BYTES_TO_WORDS_8(DB, D0, EE, 50, 19, 8A, 08, 98),
+	BYTES_TO_WORDS_8(10, B0, C5, 8C, BD, 06, FC, 80),
+	/* 39 * G */
+	BYTES_TO_WORDS_8(6F, 8B, 30, 86, 2F, 5C, 55, 5E),
+	BYTES_TO_WORDS_8(42, 8B, 9B, 6B, F5, E9, 50, 2C),
+	BYTES_TO_WORDS_8(6B, E5, 08, C4, 06, 4B, 5B, DE),
+	BYTES_TO_WORDS_8(DA, 27, 0F, 04, D0, 0A, C6, 80),
+	BYTES_TO_WORDS_8(7A, D5, 0B, 43, 56, 1F, A0, 1A),
+	BYTES_TO_WORDS_8(EB, 24, 70, BE, 4C, ED, 5E, A6),
+	BYTES_TO_WORDS_8(70, 2F, E7, 7F, AD, 6B, E6, 26),
+	BYTES_TO_WORDS_8(0F, C3, C5, 1C, 3F, 30, 38, 1C),
+	/* 41 * G */
+	BYTES_TO_WORDS_8(FB, C8, 03, FA, B0, AB, 5E, 9D),
+	BYTES_TO_WORDS_8(04, 47, D8, 87, 94, DC, C5, 4C),
+	BYTES_TO_WORDS_8(34, 4D, C5, 8C, 34, C6, 74, AA),
+	BYTES_TO_WORDS_8(54, AD, 67, 61, AD, 75, 93, 7A),
+	BYTES_TO_WORDS_8(F7, C7, 4D, 22, EC, 99, D4, 02),
+	BYTES_TO_WORDS_8(2B, CE, 70, 0C, A1, 9E, C5, BD),
+	BYTES_TO_WORDS_8(46, 90, 26, 79, 0D, 9E, 55, 09),
+	BYTES_TO_WORDS_8(69, 72, A8, EC, A9, 3F, 0E, 0D),
+	/* 43 * G */
+	BYTES_TO_WORDS_8(C9, FF, C3, 9B, 45, 1F, B5, 4B),
+	BYTES_TO_WORDS_8(50, DF, 68, 9B, C3, 8E, 40, BB),
+	BYTES_TO_WORDS_8(79, 7A, 44, 45, D0, 9E, 7A, 90),
+	BYTES_TO_WORDS_8(4C, B5, 96, B6, D9, EC, 28, D5),
+	BYTES_TO_WORDS_8(33, 99, 40, 21, B5, 65, 34, 06),
+	BYTES_TO_WORDS_8(BC, 0D, 52, 5C, 40, 45, 43, BC),
+	BYTES_TO_WORDS_8(6E, 65, FD, 81, 18, F2, 66, 99),
+	BYTES_TO_WORDS_8(F9, E5, 36, 31, 25, 41, CF, EE),
+	/* 45 * G */
+	BYTES_TO_WORDS_8(63, 59, B4, F8, 08, 18, 23, 87),
+	BYTES_TO_WORDS_8(13, CB, 7E, 4A, 5E, 11, 66, 52),
+	BYTES_TO_WORDS_8(D0, DA, EC, E8, 14, F5, 25, EA),
+	BYTES_TO_WORDS_8(12, 34, F4, B5, A4, 70, 93, 04),
+	BYTES_TO_WORDS_8(9A, 9C, 94, 12, 2A, 05, 53, B6),
+	BYTES_TO_WORDS_8(64, 67, 5B, BB, AF, F3, C3, 54),
+	BYTES_TO_WORDS_8(2A, D6, 2F, 51, B0, 81, 30, 8B),
+	BYTES_TO_WORDS_8(42, ED, D6, AF, 41, 3F, 8F, 75),
+	/* 47 * G */
+	BYTES_TO_WORDS_8(74, 5D, 34, FC, B1, 3E, C1, F1),
+	BYTES_TO_WORDS_8(E2, 98, 14, 0E, 1E, 81, 1D, 88),
+	BYTES_TO_WORDS_8(EF, 02, 47, D6, 30, F9, 3D, D7),
+	BYTES_TO_WORDS_8(BB, 8C, E8, 6E, 93, 30, F2, 77),
+	BYTES_TO_WORDS_8(D6, 60, 1C, 67, C7, B3, 8E, BE),
+	BYTES_TO_WORDS_8(CB, 77, 70, D9, 30, 53, C9, 96),
+	BYTES_TO_WORDS_8(78, B3, A1, 9B, 6E, 26, 08, 0A),
+	BYTES_TO_WORDS_8(40, B6, 86, 78, 2A, F4, 8E, 95),
+	/* 49 * G */
+	BYTES_TO_WORDS_8(30, F5, 39, 77, 1B, 53, 28, EB),
+	BYTES_TO_WORDS_8(BA, 4D, 9D, AB, 74, 00, C8, 58),
+	BYTES_TO_WORDS_8(CE, 0B, 7C, 5C, 7E, 88, 44, EA),
+	BYTES_TO_WORDS_8(B9, E4, 4C, CC, 91, C9, DA, F2),
+	BYTES_TO_WORDS_8(37, 3C, 3A, 70, BA, 7D, 11, 1A),
+	BYTES_TO_WORDS_8(FD, E4, 98, 05, EB, FB, B5, 9E),
+	BYTES_TO_WORDS_8(DF, 31, 25, EC, 2D, F3, A1, 4D),
+	BYTES_TO_WORDS_8(AD, 8D, 2F, 3B, 9B, DC, DE, E0),
+	/* 51 * G */
+	BYTES_TO_WORDS_8(5B, D4, 90, C6, 50, 48, BA, BC),
+	BYTES_TO_WORDS_8(DE, E3, DA, C9, DF, 6C, 21, 5A),
+	BYTES_TO_WORDS_8(12, 20, 25, BE, FB, E8, 4B, 1B),
+	BYTES_TO_WORDS_8(FB, 21, 26, 66, 9F, 3D, 3B, 46),
+	BYTES_TO_WORDS_8(7E, 30, F7, 1A, B0, 77, B3, 1C),
+	BYTES_TO_WORDS_8(E3, 1D, 0A, 97, 7C, E2, 22, C6),
+	BYTES_TO_WORDS_8(D7, 22, 86, DD, 06, 43, 11, 43),
+	BYTES_TO_WORDS_8(35, 6C, 29, 8C, D7, 30, D4, 5E),
+	/* 53 * G */
+	BYTES_TO_WORDS_8(47, F2, 98, 99, B4, 96, 24, A3),
+	BYTES_TO_WORDS_8(D1, A2, 28, 43, C1, FA, 98, 6B),
+	BYTES_TO_WORDS_8(97, 59, 3B, FF, 4A, 2D, 23, 09),
+	BYTES_TO_WORDS_8(2A, 6E, E4, 44, 42, 80, 6F, F1),
+	BYTES_TO_WORDS_8(F6, 1D, E3, C4, 62, 99, 57, D6),
+	BYTES_TO_WORDS_8(26, CE, 5C, 6E, C2, 53, 6C, 2A),
+	BYTES_TO_WORDS_8(D9, 33, 4E, DF, FC, 06, D2, 13),
+	BYTES_TO_WORDS_8(7E, 3F, 20, 82, 9B, BD, DA, CE),
+	/* 55 * G */
+	BYTES_TO_WORDS_8(D1, 41, 1D, 15, F7, 15, 9E, 36),
+	BYTES_TO_WORDS_8(65, 7C, E2, AC, 15, 53, 24, 5D),
+	BYTES_TO_WORDS_8(F5, 1A, 31, 14, 7A, 2B, 35, B0),
+	BYTES_TO_WORDS_8(63, 45, C8, 2D, 27, 54, F7, CA),
+	BYTES_TO_WORDS_8(76, 44, A0, 18, 83, 90, 2F, C3),
+	BYTES_TO_WORDS_8(A5, 32, 22, 96, B7, A9, 4F, 5F),
+	BYTES_TO_WORDS_8(57, 60, E4, A5, 3F, 64, 1B, A4),
+	BYTES_TO_WORDS_8(F2, F5, 35, EF, 60, 46, 47, CB),
+	/* 57 * G */
+	BYTES_TO_WORDS_8(20, 21, 08, 6F, C8, 7B, 49, 24),
+	BYTES_TO_WORDS_8(C1, D7, 86, CB, 07, 9C, A0, 44),
+	BYTES_TO_WORDS_8(8B, 9D, 97, 09, 17, 0F, 5D, F8),
+	BYTES_TO_WORDS_8(86, B9, 2C, 28, 4B, CA, 00, 26),
+	BYTES_TO_WORDS_8(40, 4B, 7E, 5A, 47, E9, 0B, 4B),
+	BYTES_TO_WORDS_8(F4, 0E, 5F, AB, 74, BE, C6, 5A),
+	BYTES_TO_WORDS_8(5D, B4, DB, CD, 3F, B0, 93, A6),
+	BYTES_TO_WORDS_8(D6, 5B, C1, 53, 87, B8, 19, 41),
+	/* 59 * G */
+	BYTES_TO_WORDS_8(35, E4, 98, 69, 74, A7, 02, C6),
+	BYTES_TO_WORDS_8(C8, 7D, 4F, E2, 85, 86, C4, 01),
+	BYTES_TO_WORDS_8(BC, 20, 22, D1, 3C, C5, 8E, 33),
+	BYTES_TO_WORDS_8(2C, 43, E8, D7, 72, CA, 35, 76),
+	BYTES_TO_WORDS_8(61, 9C, 5B, 2C, 30, 6F, E7, D9),
+	BYTES_TO_WORDS_8(BA, 48, 70, D5, 61, C0, CF, 4E),
+	BYTES_TO_WORDS_8(D7, E6, 78, 0F, 59, 5E, 1D, 3D),
+	BYTES_TO_WORDS_8(61, 9D, 48, 09, 96, 64, 1B, 09),
+	/* 61 * G */
+	BYTES_TO_WORDS_8(18, CC, 56, BF, 43, 07, A5, C1),
+	BYTES_TO_WORDS_8(FB, 68, D4, 79, 34, B3, F2, B7),
+	BYTES_TO_WORDS_8(66, 8A, EE, DE, 87, 4A, BF, DB),
+	BYTES_TO_WORDS_8(0C, 57, 25, F3, 39, 32, 4E, 75),
+	BYTES_TO_WORDS_8(83, 66, 53, 3C, 09, 98, 5D, 0C),
+	BYTES_TO_WORDS_8(5D, 69, 7A, 19, D0, 33, EE, 23),
+	BYTES_TO_WORDS_8(A0, 49, EA, 04, D3, 0E, CD, B3),
+	BYTES_TO_WORDS_8(0F, A3, BD, E5, 86, FB, 73, 06),
+	/* 63 * G */
+	BYTES_TO_WORDS_8(E8, B9, D9, 91, 46, 69, E2, 9F),
+	BYTES_TO_WORDS_8(2F, 95, 1C, 1D, 66, 00, 08, 33),
+	BYTES_TO_WORDS_8(F0, 70, D5, 82, 9C, 85, 57, FF),
+	BYTES_TO_WORDS_8(6A, E9, A1, 71, 10, BD, E6, E3),
+	BYTES_TO_WORDS_8(F5, 37, 0E, 92, F4, 2A, 00, 67),
+	BYTES_TO_WORDS_8(41, 0C, E9, 93, 39, 28, A2, A5),
+	BYTES_TO_WORDS_8(B6, 3C, 9A, 37, 58, AA, C0, 40),
+	BYTES_TO_WORDS_8(6F, E7, 94, A3, BB, E0, C9, 59),
+	/* 65 * G */
+	BYTES_TO_WORDS_8(EB, A6, 4A, F0, DC, 7F, C4, 4C),
+	BYTES_TO_WORDS_8(4B, 5F, A3, 2B, F3, B1, CC, C4),
+	BYTES_TO_WORDS_8(85, 29, 73, 8F, D8, 73, AE, 26),
+	BYTES_TO_WORDS_8(38, 03, 6A, 05, 3D, 48, 6B, 18),
+	BYTES_TO_WORDS_8(8B, 88, 80, 6E, F8, 97, A7, A4),
+	BYTES_TO_WORDS_8(B4, 38, 51, 89, 90, 80, FB, 21),
+	BYTES_TO_WORDS_8(AB, 80, 41, 20, 6E, 44, 17, 2E),
+	BYTES_TO_WORDS_8(7E, F7, 7C, C6, 32, 2D, 95, 3B),
+	/* 67 * G */
+	BYTES_TO_WORDS_8(3F, 96, E0, 4C, 72, 21, 83, 1A),
+	BYTES_TO_WORDS_8(C9, D9, 37, B7, D2, E6, 42, 54),
+	BYTES_TO_WORDS_8(72, 4F, BE, F4, 61, 85, C9, 44),
+	BYTES_TO_WORDS_8(E5, 6C, 87, B9, A6, 70, 9D, DF),
+	BYTES_TO_WORDS_8(17, 24, BA, F2, 5C, C4, B8, 17),
+	BYTES_TO_WORDS_8(A2, 9D, EF, 20, 27, 22, 57, B1),
+	BYTES_TO_WORDS_8(4A, 9D, C3, 5D, 78, 2B, 86, 5F),
+	BYTES_TO_WORDS_8(CD, 6C, 4D, D8, AF, 2D, EB, 55),
+	/* 69 * G */
+	BYTES_TO_WORDS_8(43, 71, CE, 34, 5F, 4C, E6, 5D),
+	BYTES_TO_WORDS_8(99, D8, 9E, 84, 4F, 55, 52, AB),
+	BYTES_TO_WORDS_8(F8, E0, DC, D5, 15, A8, 7C, 49),
+	BYTES_TO_WORDS_8(7A, E8, 51, 3C, C2, 5C, DD, 5E),
+	BYTES_TO_WORDS_8(68, A8, 99, 73, AB, 06, C7, CD),
+	BYTES_TO_WORDS_8(05, 29, 7A, D1, C0, 66, 3C, C1),
+	BYTES_TO_WORDS_8(D0, 9A, C8, 30, C0, CE, E8, 61),
+	BYTES_TO_WORDS_8(06, 13, 14, BC, 8D, 9C, AE, EF),
+	/* 71 * G */
+	BYTES_TO_WORDS_8(BA, 4F, 61, 84, 2F, 36, 2D, 72),
+	BYTES_TO_WORDS_8(7A, B1, 55, C3, A1, FB, A3, 7A),
+	BYTES_TO_WORDS_8(77, 9E, 7E, 28, 02, FE, 12, DA),
+	BYTES_TO_WORDS_8(30, 68, 47, B6, C2, 98, 07, 29),
+	BYTES_TO_WORDS_8(7A, 3E, 94, 41, FD, 3A, 00, 6D),
+	BYTES_TO_WORDS_8(14, 23, 2A, DB, 94, C0, 29, 5B),
+	BYTES_TO_WORDS_8(5D, F2, 9A, F7, BC, 00, 8D, 98),
+	BYTES_TO_WORDS_8(21, 06, 44, CD, 6D, A7, 8D, E3),
+	/* 73 * G */
+	BYTES_TO_WORDS_8(45, 3B, 05, F4, CE, DE, DF, 62),
+	BYTES_TO_WORDS_8(73, 25, 60, E3, 2F, 55, 29, CD),
+	BYTES_TO_WORDS_8(39, AC, 50, A1, EF, 54, 47, 05),
+	BYTES_TO_WORDS_8(B3, F5, D9, 95, 3A, 42, 3C, AF),
+	BYTES_TO_WORDS_8(C6, D9, 8F, 49, ED, ED, 2F, BC),
+	BYTES_TO_WORDS_8(81, 55, A1, 67, A6, 5A, CD, C8),
+	BYTES_TO_WORDS_8(40, FB, 5C, F3, E6, B0, 93, 9A),
+	BYTES_TO_WORDS_8(74, 2B, EB, 31, D8, 3F, 8A, F9),
+	/* 75 * G */
+	BYTES_TO_WORDS_8(9A, 24, 84, D8, 50, ED, 2F, 8D),
+	BYTES_TO_WORDS_8(DF, 98, CF, 6D, B2, 66, BB, 06),
+	BYTES_TO_WORDS_8(49, 27, BF, 99, 8C, A2, CA, CC),
+	BYTES_TO_WORDS_8(45, E7, 34, D1, 24, BB, 6D, 76),
+	BYTES_TO_WORDS_8(96, 59, AC, CB, 97, 4F, 92, 2C),
+	BYTES_TO_WORDS_8(DD, CE, 06, FA, 65, 4A, 58, 97),
+	BYTES_TO_WORDS_8(B8, 38, DA, 80, 79, 88, CC, 8D),
+	BYTES_TO_WORDS_8(E3, E5, CB, EA, 52, 11, 4B, 74),
+	/* 77 * G */
+	BYTES_TO_WORDS_8(3E, BE, 1A, 19, 66, E6, 92, CE),
+	BYTES_TO_WORDS_8(58, 6A, 59, 6C, 4F, B4, F7, 45),
+	BYTES_TO_WORDS_8(16, F4, 84, 37, C3, 77, 12, A2),
+	BYTES_TO_WORDS_8(9B, 75, 94, 8C, 6F, F4, DB, 59),
+	BYTES_TO_WORDS_8(6E, 7F, 30, 4A, 6C, 21, 5E, D8),
+	BYTES_TO_WORDS_8(8C, 79, 19, 79, 9A, 73, CE, 42),
+	BYTES_TO_WORDS_8(A0, 09, 83, 64, CE, A6, 4E, 0F),
+	BYTES_TO_WORDS_8(30, BC, 5F, 17, 44, AD, 34, C5),
+	/* 79 * G */
+	BYTES_TO_WORDS_8(B8, 87, FD, 8C, 01, C6, 2D, B6),
+	BYTES_TO_WORDS_8(3C, E7, 95, 1A, 71, 7E, 64, DD),
+	BYTES_TO_WORDS_8(A8, A4, E9, 74, 1E, 69, 5E, 30),
+	BYTES_TO_WORDS_8(37, 45, 3C, 10, 95, DA, 3A, F1),
+	BYTES_TO_WORDS_8(3D, 73, F5, DA, 9B, 41, 78, 07),
+	BYTES_TO_WORDS_8(57, C2, 75, 6A, 1A, E2, 49, 69),
+	BYTES_TO_WORDS_8(32, 1F, 34, 08, C8, 4B, BF, 63),
+	BYTES_TO_WORDS_8(E6, 4D, E1, 4E, B4, 17, 38, E1),
+	/* 81 * G */
+	BYTES_TO_WORDS_8(2C, 52, 88, 5A, 01, 50, 85, 48),
+	BYTES_TO_WORDS_8(B6, DF, BA, 6E, C0, 69, 18, DA),
+	BYTES_TO_WORDS_8(4C, CA, 9C, C5, A2, 67, 41, 6D),
+	BYTES_TO_WORDS_8(D0, CE, 8A, 0E, FA, B4, 54, 77),
+	BYTES_TO_WORDS_8(A2, 63, 11, 84, 57, 8B, A4, 37),
+	BYTES_TO_WORDS_8(C5, BC, 6C, 0B, 35, 4E, 1E, 8D),
+	BYTES_TO_WORDS_8(FA, B8, 20, 30, 7C, 96, 4B, 22),
+	BYTES_TO_WORDS_8(82, 9D, 66, 4E, 86, 3E, E9, 30),
+	/* 83 * G */
+	BYTES_TO_WORDS_8(19, 25, 26, E2, 99, 8C, 82, A6),
+	BYTES_TO_WORDS_8(D2, 41, 80, DE, 95, 8F, 85, 01),
+	BYTES_TO_WORDS_8(D7, F9, BE, 6A, D4, 74, 38, AA),
+	BYTES_TO_WORDS_8(48, E0, 90, 59, DF, CA, 8D, 94),
+	BYTES_TO_WORDS_8(7E, D5, 47, 53, AE, 2C, BA, CB),
+	BYTES_TO_WORDS_8(D2, F1, 2E, BD, EF, 54, 91, DF),
+	BYTES_TO_WORDS_8(25, BC, B1, 24, 32, 8A, D2, D5),
+	BYTES_TO_WORDS_8(97, E5, F6, 37, 25, A4, 91, E4),
+	/* 85 * G */
+	BYTES_TO_WORDS_8(AB, 77, 7C, 3D, 8A, 8A, 32, 70),
+	BYTES_TO_WORDS_8(15, FA, 0B, AC, F5, 4C, 22, FB),
+	BYTES_TO_WORDS_8(37, EC, 02, 82, 8F, B4, C7, 89),
+	BYTES_TO_WORDS_8(16, 6C, C7, 50, 44, 41, 62, 79),
+	BYTES_TO_WORDS_8(37, 34, B8, 9D, B2, A5, AF, 60),
+	BYTES_TO_WORDS_8(57, AC, 04, 1F, 05, 7A, 50, 12),
+	BYTES_TO_WORDS_8(6B, 6F, EF, 33, C1, 1F, 5C, 0D),
+	BYTES_TO_WORDS_8(76, B4, FF, C4, 0E, 61, 0B, 10),
+	/* 87 * G */
+	BYTES_TO_WORDS_8(CA, 47, EC, 37, 51, 08, DD, B0),
+	BYTES_TO_WORDS_8(7B, 84, B8, 25, 72, 97, 16, 5A),
+	BYTES_TO_WORDS_8(48, 15, D9, 44, 06, 16, 5B, B1),
+	BYTES_TO_WORDS_8(54, 4B, 96, 34, 78, 08, 14, 35),
+	BYTES_TO_WORDS_8(11, 33, 29, DE, A0, 15, 7D, 7E),
+	BYTES_TO_WORDS_8(8B, 37, C2, 15, 7C, E7, 39, 60),
+	BYTES_TO_WORDS_8(FC, 27, 81, 8E, C4, 52, 16, 8E),
+	BYTES_TO_WORDS_8(44, 05, 62, 05, B2, FB, 0A, EF),
+	/* 89 * G */
+	BYTES_TO_WORDS_8(AF, 7E, 52, 7B, 3F, 3D, 94, 42),
+	BYTES_TO_WORDS_8(B4, 87, F7, 8D, EB, 47, E9, 93),
+	BYTES_TO_WORDS_8(49, C5, 8B, DD, C9, E2, 9C, C7),
+	BYTES_TO_WORDS_8(4B, 3E, 48, 6B, AD, 30, CC, D3),
+	BYTES_TO_WORDS_8(A4, E0, ED, 4E, B0, 4D, B3, AF),
+	BYTES_TO_WORDS_8(30, 86, 35, 90, 62, D4, 2A, 3C),
+	BYTES_TO_WORDS_8(AE, 08, 95, 8F, BE, E9, C5, 89),
+	BYTES_TO_WORDS_8(8D, 27, 27, D8, 22, 8A, 37, 8B),
+	/* 91 * G */
+	BYTES_TO_WORDS_8(10, 76, 84, F4, 0F, BA, 75, 39),
+	BYTES_TO_WORDS_8(49, F6, 13, B9, 3D, 82, 29, 2B),
+	BYTES_TO_WORDS_8(8B, E0, EF, BF, FC, 78, 1C, CE),
+	BYTES_TO_WORDS_8(60, 28, 73, 80, 47, D8, 24, 16),
+	BYTES_TO_WORDS_8(75, 85, 07, 04, A4, E2, 06, CC),
+	BYTES_TO_WORDS_8(C8, E4, 2B, 28, F5, 78, 68, 89),
+	BYTES_TO_WORDS_8(CA, D4, D9, 6C, 8C, 44, 14, 09),
+	BYTES_TO_WORDS_8(3E, 90, DA, B6, F9, 1C, 65, 68),
+	/* 93 * G */
+	BYTES_TO_WORDS_8(D4, 1C, C6, 5F, FD, B4, F7, 6D),
+	BYTES_TO_WORDS_8(DA, 07, F2, 5A, 4B, 47, 92, 51),
+	BYTES_TO_WORDS_8(98, 2A, E6, 33, 56, C9, 02, 69),
+	BYTES_TO_WORDS_8(A2, A8, 55, A9, 0D, E8, 3C, 73),
+	BYTES_TO_WORDS_8(1D, EA, C5, 1D, BC, 73, 46, C5),
+	BYTES_TO_WORDS_8(78, 45, 1E, 20, E0, F8, 1E, 3E),
+	BYTES_TO_WORDS_8(CE, FC, B9, 8D, 8B, 4D, 5A, 48),
+	BYTES_TO_WORDS_8(7D, DF, BA, D2, 2B, 5A, 43, F5),
+	/* 95 * G */
+	BYTES_TO_WORDS_8(5C, 04, 1C, B8, FA, 8D, 25, EF),
+	BYTES_TO_WORDS_8(99, E6, 71, 21, 09, C5, 66, 89),
+	BYTES_TO_WORDS_8(9F, B4, D3, BB, 33, 1C, 1A, CF),
+	BYTES_TO_WORDS_8(64, 50, 94, 54, 12, 44, D9, 15),
+	BYTES_TO_WORDS_8(0D, 07, E4, EF, E9, BB, 37, FC),
+	BYTES_TO_WORDS_8(85, C6, BF, CE, BA, 00, 48, 43),
+	BYTES_TO_WORDS_8(77, 41, B8, 73, 7B, 13, F5, 34),
+	BYTES_TO_WORDS_8(72, 3E, 46, 69, 0B, B3, 6E, D5),
+	/* 97 * G */
+	BYTES_TO_WORDS_8(40, 79, 71, D0, 99, 85, 13, AC),
+	BYTES_TO_WORDS_8(AA, 8A, 2B, 9D, 7C, 41, 21, 1C),
+	BYTES_TO_WORDS_8(27, 0D, E7, 5C, 6E, 13, 12, B6),
+	BYTES_TO_WORDS_8(75, E6, 9D, EC, F2, FC, D0, A1),
+	BYTES_TO_WORDS_8(29, A6, 97, C1, 39, 2D, 21, 19),
+	BYTES_TO_WORDS_8(D5, F3, 70, 40, A5, 62, 14, 64),
+	BYTES_TO_WORDS_8(F2, 67, 96, 30, 37, 07, E9, B2),
+	BYTES_TO_WORDS_8(CA, A3, B5, BC, 50, 7F, D7, ED),
+	/* 99 * G */
+	BYTES_TO_WORDS_8(80, 69, B3, 1C, 33, 37, CA, C7),
+	BYTES_TO_WORDS_8(06, 5C, 24, E8, DE, BA, 90, A7),
+	BYTES_TO_WORDS_8(E9, DB, 84, 5F, 73, C0, 80, 57),
+	BYTES_TO_WORDS_8(CC, 8C, AF, C0, 15, BE, 2F, E2),
+	BYTES_TO_WORDS_8(06, DA, 31, 7D, D7, 06, 3D, E4),
+	BYTES_TO_WORDS_8(9B, 79, 64, 49, 15, 89, 82, A3),
+	BYTES_TO_WORDS_8(A7, A1, 53, 9F, A6, 30, B4, 88),
+	BYTES_TO_WORDS_8(0C, D6, 5C, AD, AB, 5B, 85, 0A),
+	/* 101 * G */
+	BYTES_TO_WORDS_8(B3, A9, CF, 46, 22, 45, 09, 40),
+	BYTES_TO_WORDS_8(A7, EA, 04, 47, 39, 5E, 63, 69),
+	BYTES_TO_WORDS_8(5F, 5F, 15, C1, 73, 34, E1, 0E),
+	BYTES_TO_WORDS_8(E2, E8, 60, 98, DD, 91, 10, 31),
+	BYTES_TO_WORDS_8(74, 83, 6D, 28, B1, F0, 80, BD),
+	BYTES_TO_WORDS_8(85, E6, EE, 4F, A6, C5, 1E, 87),
+	BYTES_TO_WORDS_8(30, 68, C0, 88, 47, F0, D1, FF),
+	BYTES_TO_WORDS_8(4F, F0, D1, 87, 6F, 65, DB, 66),
+	/* 103 * G */
+	BYTES_TO_WORDS_8(DF, DB, C2, 2E, 23, D4, 67, 18),
+	BYTES_TO_WORDS_8(78, 40, 93, 5A, B4, 28, 39, 88),
+	BYTES_TO_WORDS_8(24, AC, E6, D3, 42, 04, 1C, B3),
+	BYTES_TO_WORDS_8(89, BE, 01, D3, 04, FD, C1, 34),
+	BYTES_TO_WORDS_8(EE, AB, 73, BA, 57, 18, 32, C5),
+	BYTES_TO_WORDS_8(3D, 44, 87, B4, EE, 1C, 7F, D5),
+	BYTES_TO_WORDS_8(36, 41, 17, 30, F7, 46, BD, 54),
+	BYTES_TO_WORDS_8(59, 1B, 7B, E9, 85, 46, 41, 09),
+	/* 105 * G */
+	BYTES_TO_WORDS_8(63, 8D, 9B, 04, 6B, 5E, 2A, CC),
+	BYTES_TO_WORDS_8(FF, 8A, D0, BC, AB, F3, 13, 8D),
+	BYTES_TO_WORDS_8(2A, B4, 7E, 55, 5B, DE, 14, 1C),
+	BYTES_TO_WORDS_8(1C, 70, 54, 6B, 5D, EA, 19, F2),
+	BYTES_TO_WORDS_8(D1, 66, 07, 40, 2A, 96, C2, D8),
+	BYTES_TO_WORDS_8(B8, 7F, B2, 07, 3C, 8D, B0, F4),
+	BYTES_TO_WORDS_8(B1, F6, CC, 4C, 54, F4, 3A, F7),
+	BYTES_TO_WORDS_8(B0, 40, 3D, E8, 57, 59, B9, 4C),
+	/* 107 * G */
+	BYTES_TO_WORDS_8(48, B4, A0, 69, 24, 91, 36, 72),
+	BYTES_TO_WORDS_8(08, 27, A6, BC, 90, 54, 3A, 54),
+	BYTES_TO_WORDS_8(26, DE, 45, 8F, DB, 83, F6, B1),
+	BYTES_TO_WORDS_8(AA, FB, A8, 74, 0F, 74, B8, D7),
+	BYTES_TO_WORDS_8(3B, 59, A4, EA, 15, 03, 1E, 41),
+	BYTES_TO_WORDS_8(B3, 49, C0, D3, 5E, DB, 15, FF),
+	BYTES_TO_WORDS_8(7E, 71, D4, 7A, 33, 0F, 01, E1),
+	BYTES_TO_WORDS_8(2E, C9, D9, 28, 81, 96, 77, FA),
+	/* 109 * G */
+	BYTES_TO_WORDS_8(BF, 24, A8, 1A, 09, D3, E4, 9F),
+	BYTES_TO_WORDS_8(28, 94, DD, AB, 32, CD, 5B, AD),
+	BYTES_TO_WORDS_8(5E, 33, A3, D3, 98, 7C, 6F, F8),
+	BYTES_TO_WORDS_8(0E, 6F, 8F, 2F, 22, 1C, D3, 32),
+	BYTES_TO_WORDS_8(61, 16, 2E, 46, B8, 14, 8D, 11),
+	BYTES_TO_WORDS_8(61, E9, 26, 6F, 9E, AC, 6D, 2E),
+	BYTES_TO_WORDS_8(DA, E1, B9, 15, 79, 3D, CD, 9C),
+	BYTES_TO_WORDS_8(E3, 56, 21, 89, F5, 32, 30, 5F),
+	/* 111 * G */
+	BYTES_TO_WORDS_8(B5, 47, 83, C1, CB, 86, 0F, 34),
+	BYTES_TO_WORDS_8(C4, 92, 95, D5, 7C, D7, 93, 87),
+	BYTES_TO_WORDS_8(EA, 31, 98, 5D, 15, 5A, 04, 71),
+	BYTES_TO_WORDS_8(26, B3, 4A, 91, 71, F3, 61, 74),
+	BYTES_TO_WORDS_8(F6, 2F, 09, CC, B3, 47, 98, B3),
+	BYTES_TO_WORDS_8(A6, 6E, 98, 0C, F5, 1F, EE, 2E),
+	BYTES_TO_WORDS_8(54, 42, A4, 0A, AE, DC, DD, CB),
+	BYTES_TO_WORDS_8(C0, BE, 96, 8B, 23, BA, C0, 8E),
+	/* 113 * G */
+	BYTES_TO_WORDS_8(D6, B2, B2, D7, BA, 98, 76, 28),
+	BYTES_TO_WORDS_8(3D, 45, 67, 3E, 2C, 6B, 71, 6D),
+	BYTES_TO_WORDS_8(6A, 20, 38, AA, 25, 6A, 35, 74),
+	BYTES_TO_WORDS_8(00, 86, F1, 1D, DB, 9A, 07, EE),
+	BYTES_TO_WORDS_8(1E, 8C, 1C, EC, 79, C4, AA, EB),
+	BYTES_TO_WORDS_8(25, 4E, 4C, F0, 9A, 98, 46, A4),
+	BYTES_TO_WORDS_8(F6, F9, C5, EC, E0, 37, 5F, 4C),
+	BYTES_TO_WORDS_8(5C, BE, E3, AF, 2A, 41, C2, 8D),
+	/* 115 * G */
+	BYTES_TO_WORDS_8(B5, A6, 9D, BA, 16, 86, FD, 2B),
+	BYTES_TO_WORDS_8(C7, 9D, 4C, 87, 31, E3, 5D, E6),
+	BYTES_TO_WORDS_8(F7, 20, E6, 2E, 30, 18, 7B, 46),
+	BYTES_TO_WORDS_8(F0, 83, EC, 47, E4, 93, EC, 16),
+	BYTES_TO_WORDS_8(4D, 67, B0, 25, 8E, 77, 26, 96),
+	BYTES_TO_WORDS_8(13, 97, E4, 50, 6A, 18, 58, 9D),
+	BYTES_TO_WORDS_8(A3, 04, 58, CA, A7, C2, E8, D0),
+	BYTES_TO_WORDS_8(40, FB, 62, 0E, 15, 31, 46, 5E),
+	/* 117 * G */
+	BYTES_TO_WORDS_8(99, BD, 37, D5, 65, 60, B9, 85),
+	BYTES_TO_WORDS_8(A4, 6A, 8B, F9, 97, 58, 85, D8),
+	BYTES_TO_WORDS_8(6B, 0B, A7, AF, 90, 82, 97, 38),
+	BYTES_TO_WORDS_8(F0, F6, 45, C2, 80, F9, A5, EA),
+	BYTES_TO_WORDS_8(DC, 07, DC, 4E, 02, 41, 80, B1),
+	BYTES_TO_WORDS_8(7F, A6, 6E, 7E, 9D, 86, 84, D7),
+	BYTES_TO_WORDS_8(24, 46, 99, 1C, 39, 28, A5, 19),
+	BYTES_TO_WORDS_8(08, 2E, 2C, 29, 3E, 5D, 5F, F6),
+	/* 119 * G */
+	BYTES_TO_WORDS_8(51, 9F, A4, 35, 6B, 4B, 6C, A9),
+	BYTES_TO_WORDS_8(2E, 34, 51, 71, 87, 04, AE, 58),
+	BYTES_TO_WORDS_8(99, 43, 02, 0A, 91, E1, 2E, 69),
+	BYTES_TO_WORDS_8(32, C1, 4A, 54, 07, 94, 8C, 07),
+	BYTES_TO_WORDS_8(B4, DD, A3, 94, F1, 75, B6, 62),
+	BYTES_TO_WORDS_8(24, 4D, 06, 3C, 58, BD, 1F, FA),
+	BYTES_TO_WORDS_8(68, 5E, 9A, 53, 95, 47, 40, D5),
+	BYTES_TO_WORDS_8(85, 9B, EB, 69, 91, 31, E0, F3),
+	/* 121 * G */
+	BYTES_TO_WORDS_8(A5, 57, 28, 70, D9, 78, 65, 72),
+	BYTES_TO_WORDS_8(88, C6, 6F, 7A, AE, C8, CD, 01),
+	BYTES_TO_WORDS_8(00, EA, 1A, 43, 38, D8, DC, 16),
+	BYTES_TO_WORDS_8(70, A7, A1, 19, E2, 4B, 4F, 49),
+	BYTES_TO_WORDS_8(2C, 56, 0D, 88, 31, B0, F4, 55),
+	BYTES_TO_WORDS_8(6E, ED, 67, D7, 30, CE, 25, F9),
+	BYTES_TO_WORDS_8(2A, BA, 36, 5E, 07, 7F, BA, 39),
+	BYTES_TO_WORDS_8(F3, A5, 83, 92, 96, 2A, 24, 42),
+	/* 123 * G */
+	BYTES_TO_WORDS_8(B5, E9, 1F, 5C, 66, 1E, 4C, BF),
+	BYTES_TO_WORDS_8(0E, A7, FA, 58, EA, 11, 82, D2),
+	BYTES_TO_WORDS_8(49, A5, 4E, 14, F5, F2, C7, 6B),
+	BYTES_TO_WORDS_8(6C, D8, A6, 0D, 03, A8, 98, A5),
+	BYTES_TO_WORDS_8(6B, 4E, 86, 2D, BD, 6D, 02, 10),
+	BYTES_TO_WORDS_8(6A, F8, 35, 5B, B6, 63, FC, 23),
+	BYTES_TO_WORDS_8(EC, 7A, 73, 40, 71, 4A, 4B, 7E),
+	BYTES_TO_WORDS_8(30, 2C, 82, 84, 6F, 5D, 4B, 20),
+	/* 125 * G */
+	BYTES_TO_WORDS_8(97, 59, 59, 58, 3E, DC, BA, 4D),
+	BYTES_TO_WORDS_8(18, 0A, 57, 12, 0F, 02, 8F, 20),
+	BYTES_TO_WORDS_8(EC, AF, BE, 2D, 5F, 2F, 19, 09),
+	BYTES_TO_WORDS_8(5D, 2B, BB, 5A, 36, 16, 19, C4),
+	BYTES_TO_WORDS_8(13, 99, FA, 58, 6B, E9, 16, ED),
+	BYTES_TO_WORDS_8(C0, BF, 34, 0F, 45, F9, CA, D5),
+	BYTES_TO_WORDS_8(89, 49, 98, 28, B3, 45, D2, 49),
+	BYTES_TO_WORDS_8(FA, 7E, 08, D0, 51, 43, F1, 04),
+	/* 127 * G */
+	BYTES_TO_WORDS_8(81, 28, 74, 14, 55, 3A, C7, E4),
+	BYTES_TO_WORDS_8(CF, 6A, A3, E0, D2, E0, A2, 92),
+	BYTES_TO_WORDS_8(5B, BC, 03, DA, 04, 46, 72, 5A),
+	BYTES_TO_WORDS_8(47, FA, 86, A5, 63, 60, 1D, 84),
+	BYTES_TO_WORDS_8(54, 61, 8D, 1A, E0, 6D, A3, E7),
+	BYTES_TO_WORDS_8(9C, 16, 4C, 74, D6, 62, 25, E6),
+	BYTES_TO_WORDS_8(98, 36, 54, C7, A1, F9, 04, 19),
+	BYTES_TO_WORDS_8(E8, 59, 06, 9C, F5, 67, 38, 07)
+};
+
+#endif
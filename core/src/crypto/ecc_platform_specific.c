@@ -64,18 +64,21 @@
 #include <sys/types.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <string.h>
 
 #include <stdint.h>
 
+#include "include/backends/tinycryt/constants.h"
+#include "include/backends/tinycryt/ctr_prng.h"
+#include "include/backends/tinycryt/ecc_platform_specific.h"
+
 #ifndef O_CLOEXEC
 #define O_CLOEXEC 0
 #endif
 
-int default_CSPRNG(uint8_t *dest, unsigned int size) {
-
-  /* input sanity check: */
-  if (dest == (uint8_t *) 0 || (size <= 0))
-    return 0;
+/* Reads size bytes of entropy from the OS */
+static int os_entropy(uint8_t *dest, unsigned int size) {
 
   int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
   if (fd == -1) {
@@ -101,6 +104,121 @@ int default_CSPRNG(uint8_t *dest, unsigned int size) {
   return 1;
 }
 
+#define RNG_UNSEEDED  0
+#define RNG_RESEED    1   /* seeded, but fresh entropy is due */
+#define RNG_READY     2
+
+static struct {
+  TCCtrPrng_t ctx;
+  uint8_t buf[uECC_RNG_BUFFER_SIZE];
+  unsigned int avail;       /* unread bytes at the end of buf */
+  unsigned long generated;  /* bytes since the last (re)seed */
+  int state;
+} rng;
+
+static pthread_mutex_t rng_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t rng_once = PTHREAD_ONCE_INIT;
+
+/* Hold the lock across fork() so the child gets a consistent state, then
+ * make the child drop what it shares with the parent */
+static void rng_prepare(void) {
+  pthread_mutex_lock(&rng_lock);
+}
+
+static void rng_parent(void) {
+  pthread_mutex_unlock(&rng_lock);
+}
+
+static void rng_child(void) {
+  memset(rng.buf, 0, sizeof(rng.buf));
+  rng.avail = 0;
+  if (rng.state == RNG_READY)
+    rng.state = RNG_RESEED;
+  pthread_mutex_unlock(&rng_lock);
+}
+
+static void rng_register(void) {
+  pthread_atfork(rng_prepare, rng_parent, rng_child);
+}
+
+static int rng_seed(void) {
+
+  uint8_t entropy[TC_AES_KEY_SIZE + TC_AES_BLOCK_SIZE];
+  int ret;
+
+  if (!os_entropy(entropy, sizeof(entropy)))
+    return 0;
+
+  if (rng.state == RNG_UNSEEDED)
+    ret = tc_ctr_prng_init(&rng.ctx, entropy, sizeof(entropy), 0, 0);
+  else
+    ret = tc_ctr_prng_reseed(&rng.ctx, entropy, sizeof(entropy), 0, 0);
+
+  memset(entropy, 0, sizeof(entropy));
+
+  if (ret != TC_CRYPTO_SUCCESS)
+    return 0;
+
+  rng.state = RNG_READY;
+  rng.generated = 0;
+  return 1;
+}
+
+static int rng_refill(void) {
+
+  int ret;
+
+  if (rng.state != RNG_READY || rng.generated >= uECC_RNG_RESEED_INTERVAL) {
+    if (!rng_seed())
+      return 0;
+  }
+
+  ret = tc_ctr_prng_generate(&rng.ctx, 0, 0, rng.buf, sizeof(rng.buf));
+  if (ret == TC_CTR_PRNG_RESEED_REQ) {
+    if (!rng_seed())
+      return 0;
+    ret = tc_ctr_prng_generate(&rng.ctx, 0, 0, rng.buf, sizeof(rng.buf));
+  }
+
+  if (ret != TC_CRYPTO_SUCCESS)
+    return 0;
+
+  rng.avail = sizeof(rng.buf);
+  rng.generated += sizeof(rng.buf);
+  return 1;
+}
+
+int default_CSPRNG(uint8_t *dest, unsigned int size) {
+
+  /* input sanity check: */
+  if (dest == (uint8_t *) 0 || (size <= 0))
+    return 0;
+
+  pthread_once(&rng_once, rng_register);
+  pthread_mutex_lock(&rng_lock);
+
+  while (size > 0) {
+    if (rng.avail == 0 && !rng_refill()) {
+      pthread_mutex_unlock(&rng_lock);
+      return 0;
+    }
+
+    unsigned int n = size < rng.avail ? size : rng.avail;
+    uint8_t *src = rng.buf + sizeof(rng.buf) - rng.avail;
+
+    /* Bytes handed out do not stay behind */
+    memcpy(dest, src, n);
+    memset(src, 0, n);
+
+    dest += n;
+    size -= n;
+    rng.avail -= n;
+  }
+
+  pthread_mutex_unlock(&rng_lock);
+  return 1;
+}
+
 #else
 
 #include <stdlib.h>
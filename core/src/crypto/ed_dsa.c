@@ -1,7 +1,13 @@
+#include <string.h>
+
+#include "include/iotex/build_info.h"
 #include "include/backends/tinycryt/constants.h"
 #include "include/backends/tinycryt/sha512.h"
 #include "include/backends/tinycryt/ge.h"
 #include "include/backends/tinycryt/sc.h"
+#include "include/backends/tinycryt/ecc.h"
+#include "include/backends/tinycryt/ed_dsa.h"
+#include "include/backends/tinycryt/utils.h"
 
 static int consttime_equal(const unsigned char *x, const unsigned char *y) 
 {
@@ -74,23 +80,19 @@ int uECC_ed25519_sign(const uint8_t *private_key, const uint8_t *public_key, con
 	return 1;	
 }
 
-int uECC_ed25519_verify(const uint8_t *public_key, const uint8_t *message, unsigned message_len, const uint8_t *signature) 
+/* Verifies against the odd multiples of -A, public_key being the encoding of A */
+static int ed25519_verify_cached(const uint8_t *public_key, const ge_cached *Ai, const uint8_t *message, unsigned message_len, const uint8_t *signature)
 {
 	struct tc_sha512_state_struct s;
 
     unsigned char h[64];
     unsigned char checker[32];
-    ge_p3 A;
     ge_p2 R;
 
     if (signature[63] & 224) {
         return 0;
     }
 
-    if (ge_frombytes_negate_vartime(&A, public_key) != 0) {
-        return 0;
-    }
-
     tc_sha512_init(&s);
     tc_sha512_update(&s, signature, 32);
     tc_sha512_update(&s, public_key, 32);
@@ -98,7 +100,7 @@ int uECC_ed25519_verify(const uint8_t *public_key, const uint8_t *message, unsig
     tc_sha512_final(&s, h);
     
     sc_reduce(h);
-    ge_double_scalarmult_vartime(&R, h, &A, signature + 32);
+    ge_double_scalarmult_vartime_cached(&R, h, Ai, signature + 32);
     ge_tobytes(checker, &R);
 
     if (!consttime_equal(checker, signature)) {
@@ -108,3 +110,238 @@ int uECC_ed25519_verify(const uint8_t *public_key, const uint8_t *message, unsig
     return 1;
 }
 
+int uECC_ed25519_verify(const uint8_t *public_key, const uint8_t *message, unsigned message_len, const uint8_t *signature) 
+{
+    ge_cached Ai[GE_DSM_TABLE_SIZE];
+    ge_p3 A;
+
+    if (signature[63] & 224) {
+        return 0;
+    }
+
+    if (ge_frombytes_negate_vartime(&A, public_key) != 0) {
+        return 0;
+    }
+
+    ge_double_scalarmult_precompute(Ai, &A);
+
+    return ed25519_verify_cached(public_key, Ai, message, message_len, signature);
+}
+
+void uECC_ed25519_expand(const uint8_t *seed, uint8_t *expanded)
+{
+    tc_sha512(seed, 32, expanded);
+
+    expanded[0]  &= 248;
+    expanded[31] &= 63;
+    expanded[31] |= 64;
+}
+
+int uECC_ed25519_public_key(const uint8_t *seed, uint8_t *public_key)
+{
+    unsigned char expanded[64];
+    ge_p3 A;
+
+    uECC_ed25519_expand(seed, expanded);
+    ge_scalarmult_base(&A, expanded);
+    ge_p3_tobytes(public_key, &A);
+
+    _set_secure(expanded, 0, sizeof(expanded));
+
+    return 1;
+}
+
+int uECC_ed25519_key_init(uECC_ed25519_key *key, const uint8_t *seed, const uint8_t *public_key)
+{
+    ge_p3 A;
+
+    _set(key, 0, sizeof(*key));
+
+    if (seed) {
+        uECC_ed25519_expand(seed, key->expanded);
+        ge_scalarmult_base(&A, key->expanded);
+        ge_p3_tobytes(key->public_key, &A);
+        key->has_secret = 1;
+    } else {
+        memcpy(key->public_key, public_key, 32);
+    }
+
+    /* Verification adds multiples of -A, decoded once here */
+    if (ge_frombytes_negate_vartime(&A, key->public_key) != 0) {
+        _set_secure(key, 0, sizeof(*key));
+        return 0;
+    }
+
+    ge_double_scalarmult_precompute(key->neg_A, &A);
+
+    return 1;
+}
+
+int uECC_ed25519_sign_with_key(const uECC_ed25519_key *key, const uint8_t *message, unsigned message_len, uint8_t *signature)
+{
+    if (!key->has_secret) {
+        return 0;
+    }
+
+    return uECC_ed25519_sign(key->expanded, key->public_key, message, message_len, signature);
+}
+
+int uECC_ed25519_verify_with_key(const uECC_ed25519_key *key, const uint8_t *message, unsigned message_len, const uint8_t *signature)
+{
+    return ed25519_verify_cached(key->public_key, key->neg_A, message, message_len, signature);
+}
+
+/* Whether s encodes y < p, with the sign bit clear when x = 0 (y = 1 or p - 1) */
+static int ed25519_canonical(const unsigned char *s)
+{
+    unsigned char sign = s[31] >> 7;
+    unsigned char top = s[31] & 0x7f;
+    unsigned char ones = 0xff;
+    int i;
+
+    for (i = 1; i < 31; i++) {
+        ones &= s[i];
+    }
+
+    /* y >= p = 2^255 - 19 */
+    if (top == 0x7f && ones == 0xff && s[0] >= 0xed) {
+        return 0;
+    }
+
+    /* y = p - 1 */
+    if (top == 0x7f && ones == 0xff && s[0] == 0xec) {
+        return !sign;
+    }
+
+    /* y = 1 */
+    if (sign && s[0] == 1 && top == 0) {
+        for (i = 1; i < 31; i++) {
+            if (s[i]) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    return 1;
+}
+
+/* Ed25519 base point B, y = 4/5 with x positive */
+static const unsigned char ed25519_base[32] = {
+    0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66
+};
+
+/*
+Checks [S]B - sum of [z h]A - sum of [z]R = 0 for random 128 bit z, with
+S = sum of z s, over the items of a chunk. result is 1 for the items that
+pass, and 0 for the items rejected while decoding. Returns whether the
+equation holds for the remaining items, which are then left at -1.
+*/
+static int ed25519_verify_chunk(uECC_ed25519_batch_item *items, unsigned count)
+{
+    static const unsigned char zero[32] = { 0 };
+    uECC_RNG_Function rng = uECC_get_rng();
+    struct tc_sha512_state_struct s;
+    ge_cached P[2 * ED25519_BATCH_CHUNK + 1];
+    unsigned char a[2 * ED25519_BATCH_CHUNK + 1][32];
+    unsigned char h[64];
+    ge_p3 A;
+    unsigned i;
+    unsigned n = 0;
+
+    memset(a[0], 0, sizeof(a[0]));
+
+    for (i = 0; i < count; i++) {
+        uECC_ed25519_batch_item *item = &items[i];
+        unsigned char *z = a[n + 2];
+
+        item->result = 0;
+
+        /* As uECC_ed25519_verify(), whose R is always canonical */
+        if ((item->signature[63] & 224) || !ed25519_canonical(item->signature)) {
+            continue;
+        }
+
+        if (ge_frombytes_negate_vartime(&A, item->public_key) != 0) {
+            continue;
+        }
+
+        ge_p3_to_cached(&P[n + 1], &A);
+
+        if (ge_frombytes_negate_vartime(&A, item->signature) != 0) {
+            continue;
+        }
+
+        ge_p3_to_cached(&P[n + 2], &A);
+
+        memset(z, 0, 32);
+        if (NULL == rng || !rng(z, 16)) {
+            return 0;
+        }
+
+        tc_sha512_init(&s);
+        tc_sha512_update(&s, item->signature, 32);
+        tc_sha512_update(&s, item->public_key, 32);
+        tc_sha512_update(&s, item->message, item->message_len);
+        tc_sha512_final(&s, h);
+
+        sc_reduce(h);
+        sc_muladd(a[n + 1], z, h, zero);
+        sc_muladd(a[0], z, item->signature + 32, a[0]);
+
+        item->result = -1;
+        n += 2;
+    }
+
+    if (0 == n) {
+        return 1;
+    }
+
+    /* [S]B, B is decoded negated */
+    ge_frombytes_negate_vartime(&A, ed25519_base);
+    fe_neg(A.X, A.X);
+    fe_neg(A.T, A.T);
+    ge_p3_to_cached(&P[0], &A);
+
+    ge_multi_scalarmult_vartime(&A, a[0], P, n + 1);
+
+    fe_sub(A.Y, A.Y, A.Z);
+
+    if (fe_isnonzero(A.X) || fe_isnonzero(A.Y)) {
+        return 0;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (items[i].result < 0) {
+            items[i].result = 1;
+        }
+    }
+
+    return 1;
+}
+
+int uECC_ed25519_verify_batch(uECC_ed25519_batch_item *items, unsigned count)
+{
+    unsigned i;
+    unsigned n;
+    int ret = 1;
+
+    for (; count; items += n, count -= n) {
+        n = count < ED25519_BATCH_CHUNK ? count : ED25519_BATCH_CHUNK;
+
+        /* One at a time below the break-even size, or to find the culprits */
+        if (n < ED25519_BATCH_MIN || !ed25519_verify_chunk(items, n)) {
+            for (i = 0; i < n; i++) {
+                items[i].result = uECC_ed25519_verify(items[i].public_key, items[i].message,
+                                                      items[i].message_len, items[i].signature);
+            }
+        }
+
+        for (i = 0; i < n; i++) {
+            ret &= items[i].result;
+        }
+    }
+
+    return ret;
+}
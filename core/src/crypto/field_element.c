@@ -2,6 +2,8 @@
 #include "include/backends/tinycryt/fe.h"
 
 
+#if !FE_RADIX51
+
 /*
     helper functions
 */
@@ -359,6 +361,8 @@ void fe_frombytes(fe h, const unsigned char *s) {
     h[9] = (int32_t) h9;
 }
 
+#endif /* !FE_RADIX51 */
+
 
 
 void fe_invert(fe out, const fe z) {
@@ -521,6 +525,8 @@ int fe_isnonzero(const fe f) {
 
 
 
+#if !FE_RADIX51
+
 /*
     h = f * g
     Can overlap h with f or g.
@@ -877,6 +883,8 @@ void fe_neg(fe h, const fe f) {
     h[9] = h9;
 }
 
+#endif /* !FE_RADIX51 */
+
 
 void fe_pow22523(fe out, const fe z) {
     fe t0;
@@ -964,6 +972,8 @@ void fe_pow22523(fe out, const fe z) {
 }
 
 
+#if !FE_RADIX51
+
 /*
 h = f * f
 Can overlap h with f.
@@ -1489,3 +1499,309 @@ void fe_tobytes(unsigned char *s, const fe h) {
     s[30] = (unsigned char) (h9 >> 10);
     s[31] = (unsigned char) (h9 >> 18);
 }
+
+#endif /* !FE_RADIX51 */
+
+
+
+#if FE_RADIX51
+
+/*
+    Five 51 bit limbs, the products are accumulated in 128 bits.
+
+    Unless stated otherwise inputs are bounded by 2^54, and outputs of
+    the carried operations by 2^51 + 2^13.
+*/
+
+__extension__ typedef unsigned __int128 fe_uint128;
+
+#define FE_MASK51 ((((uint64_t) 1) << 51) - 1)
+
+static uint64_t load_8(const unsigned char *in) {
+    uint64_t result;
+
+    result = (uint64_t) in[0];
+    result |= ((uint64_t) in[1]) << 8;
+    result |= ((uint64_t) in[2]) << 16;
+    result |= ((uint64_t) in[3]) << 24;
+    result |= ((uint64_t) in[4]) << 32;
+    result |= ((uint64_t) in[5]) << 40;
+    result |= ((uint64_t) in[6]) << 48;
+    result |= ((uint64_t) in[7]) << 56;
+
+    return result;
+}
+
+static void fe_carry(fe h, fe_uint128 h0, fe_uint128 h1, fe_uint128 h2, fe_uint128 h3, fe_uint128 h4) {
+    h1 += h0 >> 51;
+    h2 += h1 >> 51;
+    h3 += h2 >> 51;
+    h4 += h3 >> 51;
+    h0 = ((uint64_t) h0 & FE_MASK51) + (h4 >> 51) * 19;
+
+    h[0] = (uint64_t) h0 & FE_MASK51;
+    h[1] = ((uint64_t) h1 & FE_MASK51) + (uint64_t) (h0 >> 51);
+    h[2] = (uint64_t) h2 & FE_MASK51;
+    h[3] = (uint64_t) h3 & FE_MASK51;
+    h[4] = (uint64_t) h4 & FE_MASK51;
+}
+
+
+
+void fe_0(fe h) {
+    h[0] = 0;
+    h[1] = 0;
+    h[2] = 0;
+    h[3] = 0;
+    h[4] = 0;
+}
+
+
+
+void fe_1(fe h) {
+    h[0] = 1;
+    h[1] = 0;
+    h[2] = 0;
+    h[3] = 0;
+    h[4] = 0;
+}
+
+
+
+/*
+    h = f + g, not carried.
+    Outputs of fe_add are only used as inputs of the carried operations.
+*/
+
+void fe_add(fe h, const fe f, const fe g) {
+    h[0] = f[0] + g[0];
+    h[1] = f[1] + g[1];
+    h[2] = f[2] + g[2];
+    h[3] = f[3] + g[3];
+    h[4] = f[4] + g[4];
+}
+
+
+
+/*
+    h = f - g, computed as f + 4p - g.
+
+    Preconditions:
+       g bounded by 2^53 - 76.
+*/
+
+void fe_sub(fe h, const fe f, const fe g) {
+    fe_carry(h,
+             (f[0] + UINT64_C(0x1fffffffffffb4)) - g[0],
+             (f[1] + UINT64_C(0x1ffffffffffffc)) - g[1],
+             (f[2] + UINT64_C(0x1ffffffffffffc)) - g[2],
+             (f[3] + UINT64_C(0x1ffffffffffffc)) - g[3],
+             (f[4] + UINT64_C(0x1ffffffffffffc)) - g[4]);
+}
+
+
+
+void fe_neg(fe h, const fe f) {
+    fe zero;
+
+    fe_0(zero);
+    fe_sub(h, zero, f);
+}
+
+
+
+void fe_cmov(fe f, const fe g, unsigned int b) {
+    uint64_t mask = (uint64_t) 0 - (uint64_t) b;
+
+    f[0] ^= (f[0] ^ g[0]) & mask;
+    f[1] ^= (f[1] ^ g[1]) & mask;
+    f[2] ^= (f[2] ^ g[2]) & mask;
+    f[3] ^= (f[3] ^ g[3]) & mask;
+    f[4] ^= (f[4] ^ g[4]) & mask;
+}
+
+
+
+void fe_cswap(fe f, fe g, unsigned int b) {
+    uint64_t mask = (uint64_t) 0 - (uint64_t) b;
+    uint64_t x;
+    int i;
+
+    for (i = 0; i < 5; i++) {
+        x = (f[i] ^ g[i]) & mask;
+        f[i] ^= x;
+        g[i] ^= x;
+    }
+}
+
+
+
+void fe_copy(fe h, const fe f) {
+    h[0] = f[0];
+    h[1] = f[1];
+    h[2] = f[2];
+    h[3] = f[3];
+    h[4] = f[4];
+}
+
+
+
+/*
+    Ignores top bit of h.
+*/
+
+void fe_frombytes(fe h, const unsigned char *s) {
+    uint64_t w0 = load_8(s);
+    uint64_t w1 = load_8(s + 8);
+    uint64_t w2 = load_8(s + 16);
+    uint64_t w3 = load_8(s + 24);
+
+    h[0] = w0 & FE_MASK51;
+    h[1] = ((w0 >> 51) | (w1 << 13)) & FE_MASK51;
+    h[2] = ((w1 >> 38) | (w2 << 26)) & FE_MASK51;
+    h[3] = ((w2 >> 25) | (w3 << 39)) & FE_MASK51;
+    h[4] = (w3 >> 12) & FE_MASK51;
+}
+
+
+
+/*
+    The canonical encoding of h, as fe_tobytes() of the 32-bit code.
+*/
+
+void fe_tobytes(unsigned char *s, const fe h) {
+    uint64_t t[5];
+    uint64_t q;
+    int i;
+
+    fe_carry(t, h[0], h[1], h[2], h[3], h[4]);
+
+    /* t < 2^255 + 2^13, q = 1 if t >= p */
+    q = (t[0] + 19) >> 51;
+    q = (t[1] + q) >> 51;
+    q = (t[2] + q) >> 51;
+    q = (t[3] + q) >> 51;
+    q = (t[4] + q) >> 51;
+
+    /* t + 19q - 2^255 q, carrying the 2^255 out of the top limb */
+    t[0] += 19 * q;
+    t[1] += t[0] >> 51;
+    t[0] &= FE_MASK51;
+    t[2] += t[1] >> 51;
+    t[1] &= FE_MASK51;
+    t[3] += t[2] >> 51;
+    t[2] &= FE_MASK51;
+    t[4] += t[3] >> 51;
+    t[3] &= FE_MASK51;
+    t[4] &= FE_MASK51;
+
+    t[0] |= t[1] << 51;
+    t[1] = (t[1] >> 13) | (t[2] << 38);
+    t[2] = (t[2] >> 26) | (t[3] << 25);
+    t[3] = (t[3] >> 39) | (t[4] << 12);
+
+    for (i = 0; i < 32; i++) {
+        s[i] = (unsigned char) (t[i >> 3] >> ((i & 7) << 3));
+    }
+}
+
+
+
+/*
+    h = f * g
+    Can overlap h with f or g.
+*/
+
+void fe_mul(fe h, const fe f, const fe g) {
+    uint64_t f0 = f[0];
+    uint64_t f1 = f[1];
+    uint64_t f2 = f[2];
+    uint64_t f3 = f[3];
+    uint64_t f4 = f[4];
+    uint64_t g0 = g[0];
+    uint64_t g1 = g[1];
+    uint64_t g2 = g[2];
+    uint64_t g3 = g[3];
+    uint64_t g4 = g[4];
+    uint64_t g1_19 = 19 * g1;
+    uint64_t g2_19 = 19 * g2;
+    uint64_t g3_19 = 19 * g3;
+    uint64_t g4_19 = 19 * g4;
+    fe_uint128 h0, h1, h2, h3, h4;
+
+    h0 = (fe_uint128) f0 * g0 + (fe_uint128) f1 * g4_19 + (fe_uint128) f2 * g3_19 + (fe_uint128) f3 * g2_19 + (fe_uint128) f4 * g1_19;
+    h1 = (fe_uint128) f0 * g1 + (fe_uint128) f1 * g0 + (fe_uint128) f2 * g4_19 + (fe_uint128) f3 * g3_19 + (fe_uint128) f4 * g2_19;
+    h2 = (fe_uint128) f0 * g2 + (fe_uint128) f1 * g1 + (fe_uint128) f2 * g0 + (fe_uint128) f3 * g4_19 + (fe_uint128) f4 * g3_19;
+    h3 = (fe_uint128) f0 * g3 + (fe_uint128) f1 * g2 + (fe_uint128) f2 * g1 + (fe_uint128) f3 * g0 + (fe_uint128) f4 * g4_19;
+    h4 = (fe_uint128) f0 * g4 + (fe_uint128) f1 * g3 + (fe_uint128) f2 * g2 + (fe_uint128) f3 * g1 + (fe_uint128) f4 * g0;
+
+    fe_carry(h, h0, h1, h2, h3, h4);
+}
+
+
+
+/*
+    h = f * 121666
+    Can overlap h with f.
+*/
+
+void fe_mul121666(fe h, fe f) {
+    fe_carry(h,
+             (fe_uint128) f[0] * 121666,
+             (fe_uint128) f[1] * 121666,
+             (fe_uint128) f[2] * 121666,
+             (fe_uint128) f[3] * 121666,
+             (fe_uint128) f[4] * 121666);
+}
+
+
+
+/*
+    h = f * f, with the cross products doubled once, scaled by 2^shift
+*/
+
+static void fe_sq_shift(fe h, const fe f, int shift) {
+    uint64_t f0 = f[0];
+    uint64_t f1 = f[1];
+    uint64_t f2 = f[2];
+    uint64_t f3 = f[3];
+    uint64_t f4 = f[4];
+    uint64_t f0_2 = 2 * f0;
+    uint64_t f1_2 = 2 * f1;
+    uint64_t f2_2 = 2 * f2;
+    uint64_t f3_19 = 19 * f3;
+    uint64_t f4_19 = 19 * f4;
+    fe_uint128 h0, h1, h2, h3, h4;
+
+    h0 = (fe_uint128) f0 * f0 + (fe_uint128) f1_2 * f4_19 + (fe_uint128) f2_2 * f3_19;
+    h1 = (fe_uint128) f0_2 * f1 + (fe_uint128) f2_2 * f4_19 + (fe_uint128) f3 * f3_19;
+    h2 = (fe_uint128) f0_2 * f2 + (fe_uint128) f1 * f1 + (fe_uint128) (2 * f3) * f4_19;
+    h3 = (fe_uint128) f0_2 * f3 + (fe_uint128) f1_2 * f2 + (fe_uint128) f4 * f4_19;
+    h4 = (fe_uint128) f0_2 * f4 + (fe_uint128) f1_2 * f3 + (fe_uint128) f2 * f2;
+
+    fe_carry(h, h0 << shift, h1 << shift, h2 << shift, h3 << shift, h4 << shift);
+}
+
+
+
+/*
+    h = f * f
+    Can overlap h with f.
+*/
+
+void fe_sq(fe h, const fe f) {
+    fe_sq_shift(h, f, 0);
+}
+
+
+
+/*
+    h = 2 * f * f
+    Can overlap h with f.
+*/
+
+void fe_sq2(fe h, const fe f) {
+    fe_sq_shift(h, f, 1);
+}
+
+#endif /* FE_RADIX51 */
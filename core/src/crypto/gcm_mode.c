@@ -0,0 +1,732 @@
+/* gcm_mode.c - TinyCrypt implementation of GCM mode */
+
+#include "include/backends/tinycryt/gcm_mode.h"
+#include "include/backends/tinycryt/constants.h"
+#include "include/backends/tinycryt/utils.h"
+
+/*
+ * Carry-less multiplication is built with per-function target attributes and
+ * chosen at run time, so the library still runs on CPUs without it.
+ */
+#if defined(__GNUC__) && defined(__x86_64__)
+#define TC_GCM_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && \
+      (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#define TC_GCM_ARMV8
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+/*
+ * A backend keeps what it needs to multiply by H in the 256 byte htable of
+ * the state, so a table can only be used with the backend that built it.
+ */
+struct ghash_backend {
+	void (*init)(uint64_t *htable, const uint8_t *h);
+	/* x = (x ^ in) * H for each block of in */
+	void (*blocks)(uint8_t *x, const uint64_t *htable, const uint8_t *in,
+		       size_t blocks);
+};
+
+static const struct ghash_backend *ghash_resolve(void);
+
+/* The best backend that passes its self test, set by the first key setup */
+static const struct ghash_backend *ghash = (const struct ghash_backend *) 0;
+
+static uint64_t load_be64(const uint8_t *p)
+{
+	return ((uint64_t) p[0] << 56) | ((uint64_t) p[1] << 48) |
+	       ((uint64_t) p[2] << 40) | ((uint64_t) p[3] << 32) |
+	       ((uint64_t) p[4] << 24) | ((uint64_t) p[5] << 16) |
+	       ((uint64_t) p[6] << 8) | (uint64_t) p[7];
+}
+
+static void store_be64(uint8_t *p, uint64_t v)
+{
+	p[0] = (uint8_t)(v >> 56);
+	p[1] = (uint8_t)(v >> 48);
+	p[2] = (uint8_t)(v >> 40);
+	p[3] = (uint8_t)(v >> 32);
+	p[4] = (uint8_t)(v >> 24);
+	p[5] = (uint8_t)(v >> 16);
+	p[6] = (uint8_t)(v >> 8);
+	p[7] = (uint8_t)(v);
+}
+
+/*
+ * Shoup's 4-bit tables: hl/hh[i] is i * H for the 16 values of a nibble,
+ * last4[r] the reduction of the 4 bits shifted out of the low end.
+ */
+static const uint64_t last4[16] = {
+	0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+	0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+static void ghash_init_4bit(uint64_t *htable, const uint8_t *h)
+{
+	uint64_t *hl = htable;
+	uint64_t *hh = htable + 16;
+	uint64_t vh = load_be64(h);
+	uint64_t vl = load_be64(h + 8);
+	uint64_t t;
+	unsigned int i, j;
+
+	hl[0] = 0;
+	hh[0] = 0;
+	hl[8] = vl;
+	hh[8] = vh;
+
+	/* 4, 2 and 1 are H times x, x^2 and x^3 in the reflected bit order */
+	for (i = 4; i > 0; i >>= 1) {
+		t = (vl & 1) * 0xe1000000U;
+		vl = (vh << 63) | (vl >> 1);
+		vh = (vh >> 1) ^ (t << 32);
+		hl[i] = vl;
+		hh[i] = vh;
+	}
+
+	for (i = 2; i <= 8; i *= 2) {
+		vh = hh[i];
+		vl = hl[i];
+		for (j = 1; j < i; ++j) {
+			hh[i + j] = vh ^ hh[j];
+			hl[i + j] = vl ^ hl[j];
+		}
+	}
+}
+
+static void ghash_4bit(uint8_t *x, const uint64_t *htable, const uint8_t *in,
+		       size_t blocks)
+{
+	const uint64_t *hl = htable;
+	const uint64_t *hh = htable + 16;
+	uint8_t y[TC_AES_BLOCK_SIZE];
+	uint64_t zh, zl;
+	unsigned int i, lo, hi, rem;
+
+	for (; blocks > 0; --blocks, in += TC_AES_BLOCK_SIZE) {
+		for (i = 0; i < TC_AES_BLOCK_SIZE; ++i) {
+			y[i] = x[i] ^ in[i];
+		}
+
+		lo = y[15] & 0xf;
+		zh = hh[lo];
+		zl = hl[lo];
+
+		for (i = TC_AES_BLOCK_SIZE; i-- > 0;) {
+			lo = y[i] & 0xf;
+			hi = y[i] >> 4;
+
+			if (i != 15) {
+				rem = (unsigned int)(zl & 0xf);
+				zl = (zh << 60) | (zl >> 4);
+				zh = (zh >> 4) ^ (last4[rem] << 48);
+				zh ^= hh[lo];
+				zl ^= hl[lo];
+			}
+
+			rem = (unsigned int)(zl & 0xf);
+			zl = (zh << 60) | (zl >> 4);
+			zh = (zh >> 4) ^ (last4[rem] << 48);
+			zh ^= hh[hi];
+			zl ^= hl[hi];
+		}
+
+		store_be64(x, zh);
+		store_be64(x + 8, zl);
+	}
+}
+
+static const struct ghash_backend ghash_portable = {
+	ghash_init_4bit, ghash_4bit
+};
+
+#if defined(TC_GCM_X86)
+/*
+ * PCLMULQDQ, following Intel's "Carry-Less Multiplication Instruction and its
+ * Usage for Computing the GCM Mode": the blocks are byte reversed so that the
+ * 128-bit lanes hold the bit reflected polynomials, the product is shifted
+ * left by one and reduced with shifts. Four blocks are multiplied by H^4..H
+ * and summed before a single reduction.
+ */
+__attribute__((target("pclmul,ssse3")))
+static inline void clmul_acc(__m128i *lo, __m128i *mid, __m128i *hi,
+			     __m128i a, __m128i b)
+{
+	*lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+	*hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+	*mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x10));
+	*mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x01));
+}
+
+__attribute__((target("pclmul,ssse3")))
+static inline __m128i clmul_reduce(__m128i lo, __m128i mid, __m128i hi)
+{
+	__m128i t7, t8, t9;
+
+	lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+	hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+	/* shift the 256-bit product hi:lo left by one */
+	t7 = _mm_srli_epi32(lo, 31);
+	t8 = _mm_srli_epi32(hi, 31);
+	lo = _mm_slli_epi32(lo, 1);
+	hi = _mm_slli_epi32(hi, 1);
+	t9 = _mm_srli_si128(t7, 12);
+	t8 = _mm_slli_si128(t8, 4);
+	t7 = _mm_slli_si128(t7, 4);
+	lo = _mm_or_si128(lo, t7);
+	hi = _mm_or_si128(hi, t8);
+	hi = _mm_or_si128(hi, t9);
+
+	/* reduce modulo x^128 + x^7 + x^2 + x + 1 */
+	t7 = _mm_slli_epi32(lo, 31);
+	t8 = _mm_slli_epi32(lo, 30);
+	t9 = _mm_slli_epi32(lo, 25);
+	t7 = _mm_xor_si128(t7, _mm_xor_si128(t8, t9));
+	t8 = _mm_srli_si128(t7, 4);
+	t7 = _mm_slli_si128(t7, 12);
+	lo = _mm_xor_si128(lo, t7);
+	t9 = _mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2));
+	t9 = _mm_xor_si128(t9, _mm_srli_epi32(lo, 7));
+	t9 = _mm_xor_si128(t9, t8);
+	lo = _mm_xor_si128(lo, t9);
+
+	return _mm_xor_si128(hi, lo);
+}
+
+__attribute__((target("pclmul,ssse3")))
+static inline __m128i clmul_mul(__m128i a, __m128i b)
+{
+	__m128i lo = _mm_setzero_si128();
+	__m128i mid = _mm_setzero_si128();
+	__m128i hi = _mm_setzero_si128();
+
+	clmul_acc(&lo, &mid, &hi, a, b);
+	return clmul_reduce(lo, mid, hi);
+}
+
+/* htable holds H, H^2, H^3 and H^4, byte reversed */
+__attribute__((target("pclmul,ssse3")))
+static void ghash_init_clmul(uint64_t *htable, const uint8_t *h)
+{
+	const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+					   8, 9, 10, 11, 12, 13, 14, 15);
+	__m128i *ht = (__m128i *) htable;
+	__m128i h1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) h),
+				      bswap);
+	__m128i hn = h1;
+	unsigned int i;
+
+	_mm_storeu_si128(ht, h1);
+	for (i = 1; i < 4; ++i) {
+		hn = clmul_mul(hn, h1);
+		_mm_storeu_si128(ht + i, hn);
+	}
+}
+
+__attribute__((target("pclmul,ssse3")))
+static void ghash_clmul(uint8_t *x, const uint64_t *htable, const uint8_t *in,
+			size_t blocks)
+{
+	const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+					   8, 9, 10, 11, 12, 13, 14, 15);
+	const __m128i *ht = (const __m128i *) htable;
+	const __m128i h1 = _mm_loadu_si128(ht);
+	const __m128i h2 = _mm_loadu_si128(ht + 1);
+	const __m128i h3 = _mm_loadu_si128(ht + 2);
+	const __m128i h4 = _mm_loadu_si128(ht + 3);
+	__m128i acc = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) x),
+				       bswap);
+	__m128i lo, mid, hi, c0, c1, c2, c3;
+
+	for (; blocks >= 4; blocks -= 4, in += 4 * TC_AES_BLOCK_SIZE) {
+		c0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) in),
+				      bswap);
+		c1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) in + 1),
+				      bswap);
+		c2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) in + 2),
+				      bswap);
+		c3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) in + 3),
+				      bswap);
+		lo = _mm_setzero_si128();
+		mid = _mm_setzero_si128();
+		hi = _mm_setzero_si128();
+		clmul_acc(&lo, &mid, &hi, _mm_xor_si128(acc, c0), h4);
+		clmul_acc(&lo, &mid, &hi, c1, h3);
+		clmul_acc(&lo, &mid, &hi, c2, h2);
+		clmul_acc(&lo, &mid, &hi, c3, h1);
+		acc = clmul_reduce(lo, mid, hi);
+	}
+
+	for (; blocks > 0; --blocks, in += TC_AES_BLOCK_SIZE) {
+		c0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) in),
+				      bswap);
+		acc = clmul_mul(_mm_xor_si128(acc, c0), h1);
+	}
+
+	_mm_storeu_si128((__m128i *) x, _mm_shuffle_epi8(acc, bswap));
+}
+
+static const struct ghash_backend ghash_pclmul = {
+	ghash_init_clmul, ghash_clmul
+};
+
+static int cpu_has_pclmul(void)
+{
+	unsigned int a, b, c, d;
+
+	if (!__get_cpuid(1, &a, &b, &c, &d)) {
+		return 0;
+	}
+	return (c & bit_PCLMUL) && (c & bit_SSSE3);
+}
+#endif /* TC_GCM_X86 */
+
+#if defined(TC_GCM_ARMV8)
+/*
+ * PMULL: the bits of each byte are reversed, which turns the reflected GCM
+ * polynomials into plain little-endian ones. The 256-bit product is folded
+ * down with x^128 = x^7 + x^2 + x + 1, 64 bits at a time. Four blocks are
+ * multiplied by H^4..H and summed before a single reduction.
+ */
+static inline uint64x2_t pmull_lo(uint64x2_t a, uint64x2_t b)
+{
+	return vreinterpretq_u64_p128(
+		vmull_p64((poly64_t) vgetq_lane_u64(a, 0),
+			  (poly64_t) vgetq_lane_u64(b, 0)));
+}
+
+static inline uint64x2_t pmull_hi(uint64x2_t a, uint64x2_t b)
+{
+	return vreinterpretq_u64_p128(
+		vmull_high_p64(vreinterpretq_p64_u64(a),
+			       vreinterpretq_p64_u64(b)));
+}
+
+static inline void pmull_acc(uint64x2_t *lo, uint64x2_t *mid, uint64x2_t *hi,
+			     uint64x2_t a, uint64x2_t b)
+{
+	uint64x2_t bs = vextq_u64(b, b, 1);
+
+	*lo = veorq_u64(*lo, pmull_lo(a, b));
+	*hi = veorq_u64(*hi, pmull_hi(a, b));
+	*mid = veorq_u64(*mid, veorq_u64(pmull_lo(a, bs), pmull_hi(a, bs)));
+}
+
+static inline uint64x2_t pmull_reduce(uint64x2_t lo, uint64x2_t mid,
+				      uint64x2_t hi)
+{
+	const uint64x2_t zero = vdupq_n_u64(0);
+	const uint64x2_t poly = vdupq_n_u64(0x87);
+	uint64x2_t t;
+
+	lo = veorq_u64(lo, vextq_u64(zero, mid, 1));
+	hi = veorq_u64(hi, vextq_u64(mid, zero, 1));
+
+	/* bits 192..255 into 64..198, then 128..191 into 0..134 */
+	t = pmull_hi(hi, poly);
+	lo = veorq_u64(lo, vextq_u64(zero, t, 1));
+	hi = veorq_u64(hi, vextq_u64(t, zero, 1));
+
+	return veorq_u64(lo, pmull_lo(hi, poly));
+}
+
+static inline uint64x2_t pmull_mul(uint64x2_t a, uint64x2_t b)
+{
+	uint64x2_t lo = vdupq_n_u64(0);
+	uint64x2_t mid = vdupq_n_u64(0);
+	uint64x2_t hi = vdupq_n_u64(0);
+
+	pmull_acc(&lo, &mid, &hi, a, b);
+	return pmull_reduce(lo, mid, hi);
+}
+
+static inline uint64x2_t pmull_load(const uint8_t *p)
+{
+	return vreinterpretq_u64_u8(vrbitq_u8(vld1q_u8(p)));
+}
+
+static inline void pmull_store(uint8_t *p, uint64x2_t v)
+{
+	vst1q_u8(p, vrbitq_u8(vreinterpretq_u8_u64(v)));
+}
+
+/* htable holds H, H^2, H^3 and H^4, bit reversed */
+static void ghash_init_pmull(uint64_t *htable, const uint8_t *h)
+{
+	uint64x2_t h1 = pmull_load(h);
+	uint64x2_t hn = h1;
+	unsigned int i;
+
+	vst1q_u64(htable, h1);
+	for (i = 1; i < 4; ++i) {
+		hn = pmull_mul(hn, h1);
+		vst1q_u64(htable + 2 * i, hn);
+	}
+}
+
+static void ghash_pmull(uint8_t *x, const uint64_t *htable, const uint8_t *in,
+			size_t blocks)
+{
+	const uint64x2_t h1 = vld1q_u64(htable);
+	const uint64x2_t h2 = vld1q_u64(htable + 2);
+	const uint64x2_t h3 = vld1q_u64(htable + 4);
+	const uint64x2_t h4 = vld1q_u64(htable + 6);
+	uint64x2_t acc = pmull_load(x);
+	uint64x2_t lo, mid, hi;
+
+	for (; blocks >= 4; blocks -= 4, in += 4 * TC_AES_BLOCK_SIZE) {
+		lo = vdupq_n_u64(0);
+		mid = vdupq_n_u64(0);
+		hi = vdupq_n_u64(0);
+		pmull_acc(&lo, &mid, &hi, veorq_u64(acc, pmull_load(in)), h4);
+		pmull_acc(&lo, &mid, &hi, pmull_load(in + 16), h3);
+		pmull_acc(&lo, &mid, &hi, pmull_load(in + 32), h2);
+		pmull_acc(&lo, &mid, &hi, pmull_load(in + 48), h1);
+		acc = pmull_reduce(lo, mid, hi);
+	}
+
+	for (; blocks > 0; --blocks, in += TC_AES_BLOCK_SIZE) {
+		acc = pmull_mul(veorq_u64(acc, pmull_load(in)), h1);
+	}
+
+	pmull_store(x, acc);
+}
+
+static const struct ghash_backend ghash_pmull_backend = {
+	ghash_init_pmull, ghash_pmull
+};
+
+static int cpu_has_pmull(void)
+{
+#if defined(__linux__) && defined(HWCAP_PMULL)
+	return (getauxval(AT_HWCAP) & HWCAP_PMULL) != 0;
+#else
+	/* built for a CPU with the extension */
+	return 1;
+#endif
+}
+#endif /* TC_GCM_ARMV8 */
+
+/*
+ * A backend is only used if it agrees with the 4-bit tables over two four
+ * block batches and a tail block.
+ */
+static int ghash_self_test(const struct ghash_backend *b)
+{
+	uint64_t ta[32];
+	uint64_t tb[32];
+	uint8_t in[9 * TC_AES_BLOCK_SIZE];
+	uint8_t xa[TC_AES_BLOCK_SIZE];
+	uint8_t xb[TC_AES_BLOCK_SIZE];
+	unsigned int i;
+
+	for (i = 0; i < sizeof(in); ++i) {
+		in[i] = (uint8_t)(i * 167 + 13);
+	}
+	ghash_init_4bit(ta, in);
+	b->init(tb, in);
+
+	for (i = 0; i < TC_AES_BLOCK_SIZE; ++i) {
+		xa[i] = xb[i] = in[sizeof(in) - 1 - i];
+	}
+	ghash_4bit(xa, ta, in, 9);
+	b->blocks(xb, tb, in, 9);
+
+	return _compare(xa, xb, sizeof(xa)) == 0;
+}
+
+static const struct ghash_backend *ghash_resolve(void)
+{
+	const struct ghash_backend *b = &ghash_portable;
+
+#if defined(TC_GCM_X86)
+	if (cpu_has_pclmul() && ghash_self_test(&ghash_pclmul)) {
+		b = &ghash_pclmul;
+	}
+#elif defined(TC_GCM_ARMV8)
+	if (cpu_has_pmull() && ghash_self_test(&ghash_pmull_backend)) {
+		b = &ghash_pmull_backend;
+	}
+#endif
+
+	return b;
+}
+
+/* increments the low 32 bits of the counter block */
+static void gcm_inc32(uint8_t *ctr)
+{
+	unsigned int i;
+
+	for (i = TC_AES_BLOCK_SIZE; i-- > TC_AES_BLOCK_SIZE - 4;) {
+		if (++ctr[i] != 0) {
+			break;
+		}
+	}
+}
+
+/* hashes the zero padded partial block of associated data once data starts */
+static void gcm_flush_aad(TCGcmState_t s)
+{
+	unsigned int off = (unsigned int)(s->aad_len % TC_AES_BLOCK_SIZE);
+
+	if (s->len == 0 && off != 0) {
+		_set(s->buf + off, TC_ZERO_BYTE, TC_AES_BLOCK_SIZE - off);
+		ghash->blocks(s->x, s->htable, s->buf, 1);
+	}
+}
+
+/* len bytes from offset off of the block whose key stream is in s->ks */
+static void gcm_crypt_partial(TCGcmState_t s, uint8_t *out, const uint8_t *in,
+			      unsigned int off, size_t len, int encrypt)
+{
+	uint8_t b, c;
+
+	for (; len > 0; ++off, --len) {
+		b = *in++;
+		c = b ^ s->ks[off];
+		s->buf[off] = encrypt ? c : b;
+		*out++ = c;
+	}
+
+	if (off == TC_AES_BLOCK_SIZE) {
+		ghash->blocks(s->x, s->htable, s->buf, 1);
+	}
+}
+
+static int gcm_crypt(TCGcmState_t s, uint8_t *out, const uint8_t *in,
+		     size_t len, int encrypt)
+{
+	uint8_t ks[TC_AES_PARALLEL * TC_AES_BLOCK_SIZE];
+	unsigned int off;
+	size_t n, i;
+
+	if (s == (TCGcmState_t) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (len == 0) {
+		return TC_CRYPTO_SUCCESS;
+	} else if (out == (uint8_t *) 0 || in == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if ((uint64_t) len > TC_GCM_MAX_DATA_SIZE - s->len) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	gcm_flush_aad(s);
+	off = (unsigned int)(s->len % TC_AES_BLOCK_SIZE);
+	s->len += len;
+
+	/* the rest of the block left partial by the previous call */
+	if (off != 0) {
+		n = TC_AES_BLOCK_SIZE - off;
+		if (n > len) {
+			n = len;
+		}
+		gcm_crypt_partial(s, out, in, off, n, encrypt);
+		in += n;
+		out += n;
+		len -= n;
+	}
+
+	/* the key stream of a batch of counters is generated in one call */
+	while (len >= TC_AES_BLOCK_SIZE) {
+		n = len / TC_AES_BLOCK_SIZE;
+		if (n > TC_AES_PARALLEL) {
+			n = TC_AES_PARALLEL;
+		}
+		for (i = 0; i < n; ++i) {
+			(void)_copy(ks + i * TC_AES_BLOCK_SIZE, TC_AES_BLOCK_SIZE,
+				    s->ctr, TC_AES_BLOCK_SIZE);
+			gcm_inc32(s->ctr);
+		}
+		(void)tc_aes_encrypt_blocks(ks, ks, n, &s->sched);
+
+		if (!encrypt) {
+			ghash->blocks(s->x, s->htable, in, n);
+		}
+		for (i = 0; i < n * TC_AES_BLOCK_SIZE; ++i) {
+			out[i] = in[i] ^ ks[i];
+		}
+		if (encrypt) {
+			ghash->blocks(s->x, s->htable, out, n);
+		}
+
+		n *= TC_AES_BLOCK_SIZE;
+		in += n;
+		out += n;
+		len -= n;
+	}
+
+	if (len > 0) {
+		(void)tc_aes_encrypt(s->ks, s->ctr, &s->sched);
+		gcm_inc32(s->ctr);
+		gcm_crypt_partial(s, out, in, 0, len, encrypt);
+	}
+
+	_set(ks, TC_ZERO_BYTE, sizeof(ks));
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+int tc_gcm_set_key(TCGcmState_t s, const uint8_t *key)
+{
+	uint8_t h[TC_AES_BLOCK_SIZE];
+
+	if (s == (TCGcmState_t) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (key == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	if (ghash == (const struct ghash_backend *) 0) {
+		/* every thread that races here stores the same pointer */
+		ghash = ghash_resolve();
+	}
+
+	_set(s, TC_ZERO_BYTE, sizeof(*s));
+	(void)tc_aes128_set_encrypt_key(&s->sched, key);
+
+	_set(h, TC_ZERO_BYTE, sizeof(h));
+	(void)tc_aes_encrypt(h, h, &s->sched);
+	ghash->init(s->htable, h);
+	_set(h, TC_ZERO_BYTE, sizeof(h));
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+int tc_gcm_start(TCGcmState_t s, const uint8_t *nonce, size_t nonce_len)
+{
+	uint8_t block[TC_AES_BLOCK_SIZE];
+	size_t full;
+
+	if (s == (TCGcmState_t) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (nonce == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (nonce_len == 0 || ((uint64_t) nonce_len >> 61) != 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	_set(s->x, TC_ZERO_BYTE, sizeof(s->x));
+	s->aad_len = 0;
+	s->len = 0;
+
+	if (nonce_len == TC_GCM_NONCE_SIZE) {
+		/* J0 = nonce || 0^31 || 1 */
+		(void)_copy(s->ctr, TC_GCM_NONCE_SIZE, nonce, TC_GCM_NONCE_SIZE);
+		s->ctr[12] = s->ctr[13] = s->ctr[14] = 0;
+		s->ctr[15] = 1;
+	} else {
+		/* J0 = GHASH(nonce || 0^s || [0]64 || [len(nonce)]64) */
+		_set(s->ctr, TC_ZERO_BYTE, sizeof(s->ctr));
+		full = nonce_len / TC_AES_BLOCK_SIZE;
+		ghash->blocks(s->ctr, s->htable, nonce, full);
+		if (nonce_len % TC_AES_BLOCK_SIZE != 0) {
+			_set(block, TC_ZERO_BYTE, sizeof(block));
+			(void)_copy(block, sizeof(block),
+				    nonce + full * TC_AES_BLOCK_SIZE,
+				    (unsigned int)(nonce_len % TC_AES_BLOCK_SIZE));
+			ghash->blocks(s->ctr, s->htable, block, 1);
+		}
+		store_be64(block, 0);
+		store_be64(block + 8, (uint64_t) nonce_len * 8);
+		ghash->blocks(s->ctr, s->htable, block, 1);
+	}
+
+	(void)tc_aes_encrypt(s->ek0, s->ctr, &s->sched);
+	gcm_inc32(s->ctr);
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+int tc_gcm_update_aad(TCGcmState_t s, const uint8_t *aad, size_t aad_len)
+{
+	unsigned int off;
+	size_t n;
+
+	if (s == (TCGcmState_t) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (aad_len == 0) {
+		return TC_CRYPTO_SUCCESS;
+	} else if (aad == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (s->len != 0) {
+		return TC_CRYPTO_FAIL;
+	} else if ((uint64_t) aad_len > (UINT64_MAX >> 3) - s->aad_len) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	off = (unsigned int)(s->aad_len % TC_AES_BLOCK_SIZE);
+	s->aad_len += aad_len;
+
+	if (off != 0) {
+		n = TC_AES_BLOCK_SIZE - off;
+		if (n > aad_len) {
+			n = aad_len;
+		}
+		(void)_copy(s->buf + off, (unsigned int) n, aad, (unsigned int) n);
+		if (off + n < TC_AES_BLOCK_SIZE) {
+			return TC_CRYPTO_SUCCESS;
+		}
+		ghash->blocks(s->x, s->htable, s->buf, 1);
+		aad += n;
+		aad_len -= n;
+	}
+
+	n = aad_len / TC_AES_BLOCK_SIZE;
+	ghash->blocks(s->x, s->htable, aad, n);
+	aad += n * TC_AES_BLOCK_SIZE;
+	aad_len -= n * TC_AES_BLOCK_SIZE;
+
+	(void)_copy(s->buf, TC_AES_BLOCK_SIZE, aad, (unsigned int) aad_len);
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+int tc_gcm_encrypt_update(TCGcmState_t s, uint8_t *out, const uint8_t *in,
+			  size_t len)
+{
+	return gcm_crypt(s, out, in, len, 1);
+}
+
+int tc_gcm_decrypt_update(TCGcmState_t s, uint8_t *out, const uint8_t *in,
+			  size_t len)
+{
+	return gcm_crypt(s, out, in, len, 0);
+}
+
+int tc_gcm_final(TCGcmState_t s, uint8_t *tag)
+{
+	uint8_t block[TC_AES_BLOCK_SIZE];
+	unsigned int off;
+	unsigned int i;
+
+	if (s == (TCGcmState_t) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (tag == (uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	gcm_flush_aad(s);
+
+	off = (unsigned int)(s->len % TC_AES_BLOCK_SIZE);
+	if (off != 0) {
+		_set(s->buf + off, TC_ZERO_BYTE, TC_AES_BLOCK_SIZE - off);
+		ghash->blocks(s->x, s->htable, s->buf, 1);
+	}
+
+	store_be64(block, s->aad_len * 8);
+	store_be64(block + 8, s->len * 8);
+	ghash->blocks(s->x, s->htable, block, 1);
+
+	for (i = 0; i < TC_GCM_TAG_SIZE; ++i) {
+		tag[i] = s->x[i] ^ s->ek0[i];
+	}
+
+	return TC_CRYPTO_SUCCESS;
+}
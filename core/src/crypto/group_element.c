@@ -56,23 +56,12 @@ static void slide(signed char *r, const unsigned char *a) {
         }
 }
 
-/*
-r = a * A + b * B
-where a = a[0]+256*a[1]+...+256^31 a[31].
-and b = b[0]+256*b[1]+...+256^31 b[31].
-B is the Ed25519 base point (x,4/5) with x positive.
-*/
+/* Ai = A, 3A, 5A, ..., 15A for ge_double_scalarmult_vartime_cached() */
 
-void ge_double_scalarmult_vartime(ge_p2 *r, const unsigned char *a, const ge_p3 *A, const unsigned char *b) {
-    signed char aslide[256];
-    signed char bslide[256];
-    ge_cached Ai[8]; /* A,3A,5A,7A,9A,11A,13A,15A */
+void ge_double_scalarmult_precompute(ge_cached *Ai, const ge_p3 *A) {
     ge_p1p1 t;
     ge_p3 u;
     ge_p3 A2;
-    int i;
-    slide(aslide, a);
-    slide(bslide, b);
     ge_p3_to_cached(&Ai[0], A);
     ge_p3_dbl(&t, A);
     ge_p1p1_to_p3(&A2, &t);
@@ -97,6 +86,32 @@ void ge_double_scalarmult_vartime(ge_p2 *r, const unsigned char *a, const ge_p3
     ge_add(&t, &A2, &Ai[6]);
     ge_p1p1_to_p3(&u, &t);
     ge_p3_to_cached(&Ai[7], &u);
+}
+
+/*
+r = a * A + b * B
+where a = a[0]+256*a[1]+...+256^31 a[31].
+and b = b[0]+256*b[1]+...+256^31 b[31].
+B is the Ed25519 base point (x,4/5) with x positive.
+*/
+
+void ge_double_scalarmult_vartime(ge_p2 *r, const unsigned char *a, const ge_p3 *A, const unsigned char *b) {
+    ge_cached Ai[GE_DSM_TABLE_SIZE];
+
+    ge_double_scalarmult_precompute(Ai, A);
+    ge_double_scalarmult_vartime_cached(r, a, Ai, b);
+}
+
+/* The same with the multiples of A from ge_double_scalarmult_precompute() */
+
+void ge_double_scalarmult_vartime_cached(ge_p2 *r, const unsigned char *a, const ge_cached *Ai, const unsigned char *b) {
+    signed char aslide[256];
+    signed char bslide[256];
+    ge_p1p1 t;
+    ge_p3 u;
+    int i;
+    slide(aslide, a);
+    slide(bslide, b);
     ge_p2_0(r);
 
     for (i = 255; i >= 0; --i) {
@@ -129,13 +144,13 @@ void ge_double_scalarmult_vartime(ge_p2 *r, const unsigned char *a, const ge_p3
 }
 
 
-static const fe d = {
+static const fe d = FE_CONST(
     -10913610, 13857413, -15372611, 6949391, 114729, -8787816, -6275908, -3247719, -18696448, -12055116
-};
+);
 
-static const fe sqrtm1 = {
+static const fe sqrtm1 = FE_CONST(
     -32595792, -7943725, 9377950, 3500415, 12389472, -272473, -25146209, -2005654, 326686, 11406482
-};
+);
 
 int ge_frombytes_negate_vartime(ge_p3 *h, const unsigned char *s) {
     fe u;
@@ -294,9 +309,9 @@ void ge_p3_dbl(ge_p1p1 *r, const ge_p3 *p) {
 r = p
 */
 
-static const fe d2 = {
+static const fe d2 = FE_CONST(
     -21827239, -5839606, -30745221, 13898782, 229458, 15978800, -12551817, -6495438, 29715968, 9444199
-};
+);
 
 void ge_p3_to_cached(ge_cached *r, const ge_p3 *p) {
     fe_add(r->YplusX, p->Y, p->X);
@@ -464,3 +479,151 @@ void ge_tobytes(unsigned char *s, const ge_p2 *h) {
     fe_tobytes(s, y);
     s[31] ^= fe_isnegative(x) << 7;
 }
+
+
+/*
+Signed radix 2^w digit of a at bit pos, Booth recoded: bits pos - 1 to
+pos + w - 1, the top one counting negatively. Every digit is in
+[-2^(w-1), 2^(w-1)] and depends on no other digit.
+*/
+
+static int booth_digit(const unsigned char *a, int pos, int w) {
+    int v = 0;
+    int i;
+
+    for (i = pos - 1; i < pos + w; ++i) {
+        if (i >= 0 && i < 256) {
+            v |= ((a[i >> 3] >> (i & 7)) & 1) << (i - pos + 1);
+        }
+    }
+
+    return (v >> 1) + (v & 1) - ((v >> w) << w);
+}
+
+/*
+r = p, or -p if neg
+from (Y+X, Y-X, Z, 2dT) to (2dX, 2dY, 2dZ, 2dT), every coordinate a product
+*/
+
+static void cached_to_p3(ge_p3 *r, const ge_cached *p, int neg) {
+    fe t;
+
+    fe_sub(t, p->YplusX, p->YminusX);
+    fe_mul(r->X, t, d);
+    fe_add(t, p->YplusX, p->YminusX);
+    fe_mul(r->Y, t, d);
+    fe_add(t, p->Z, p->Z);
+    fe_mul(r->Z, t, d);
+    fe_copy(r->T, p->T2d);
+
+    if (neg) {
+        fe_neg(r->X, r->X);
+        fe_neg(r->T, r->T);
+    }
+}
+
+/*
+r = a[0] * P[0] + a[1] * P[1] + ... + a[count-1] * P[count-1]
+where a[i] is the 32 byte scalar at a + 32 * i.
+
+Pippenger's bucket method: for every window of w bits the points are added
+into 2^(w-1) buckets by the digit of their scalar, and the buckets are
+summed with their weights by a running sum. w is picked from count.
+
+Preconditions:
+  a[i][31] <= 127
+*/
+
+void ge_multi_scalarmult_vartime(ge_p3 *r, const unsigned char *a, const ge_cached *P, unsigned count) {
+    ge_p3 bucket[1 << (GE_MSM_MAX_WINDOW - 1)];
+    unsigned char used[1 << (GE_MSM_MAX_WINDOW - 1)];
+    ge_p3 sum;
+    ge_p3 total;
+    ge_cached c;
+    ge_p1p1 t;
+    ge_p2 q;
+    int w = 3;
+    int started = 0;
+    int pos;
+    int b;
+    int digit;
+    unsigned i;
+
+    /* Window minimizing (count + 2^w) * 256 / w */
+    while (w < GE_MSM_MAX_WINDOW &&
+           (count + (2u << w)) * (unsigned) w < (count + (1u << w)) * (unsigned) (w + 1)) {
+        ++w;
+    }
+
+    ge_p3_0(r);
+
+    for (pos = ((256 + w - 1) / w - 1) * w; pos >= 0; pos -= w) {
+        if (started) {
+            ge_p3_to_p2(&q, r);
+
+            for (b = 1; b < w; ++b) {
+                ge_p2_dbl(&t, &q);
+                ge_p1p1_to_p2(&q, &t);
+            }
+
+            ge_p2_dbl(&t, &q);
+            ge_p1p1_to_p3(r, &t);
+        }
+
+        for (b = 0; b < (1 << (w - 1)); ++b) {
+            used[b] = 0;
+        }
+
+        for (i = 0; i < count; ++i) {
+            digit = booth_digit(a + 32 * i, pos, w);
+
+            if (digit == 0) {
+                continue;
+            }
+
+            b = (digit > 0 ? digit : -digit) - 1;
+
+            if (!used[b]) {
+                cached_to_p3(&bucket[b], &P[i], digit < 0);
+                used[b] = 1;
+                continue;
+            }
+
+            if (digit > 0) {
+                ge_add(&t, &bucket[b], &P[i]);
+            } else {
+                ge_sub(&t, &bucket[b], &P[i]);
+            }
+
+            ge_p1p1_to_p3(&bucket[b], &t);
+        }
+
+        /* total = sum of (b + 1) * bucket[b] */
+        for (b = (1 << (w - 1)) - 1; b >= 0 && !used[b]; --b) {
+        }
+
+        if (b < 0) {
+            continue;
+        }
+
+        sum = bucket[b];
+        total = bucket[b];
+
+        while (--b >= 0) {
+            if (used[b]) {
+                ge_p3_to_cached(&c, &bucket[b]);
+                ge_add(&t, &sum, &c);
+                ge_p1p1_to_p3(&sum, &t);
+            }
+
+            ge_p3_to_cached(&c, &sum);
+            ge_add(&t, &total, &c);
+            ge_p1p1_to_p3(&total, &t);
+        }
+
+        ge_p3_to_cached(&c, &total);
+        ge_add(&t, r, &c);
+        ge_p1p1_to_p3(r, &t);
+        started = 1;
+    }
+}
@@ -0,0 +1,411 @@
+/* poly1305.c - TinyCrypt implementation of the Poly1305 authenticator */
+
+/*
+ * The arithmetic follows Andrew Moon's poly1305-donna, public domain: the
+ * 32-bit code multiplies five 26 bit limbs into 64-bit sums, the 64-bit code
+ * three 44 bit limbs into 128-bit sums. 2^130 = 5 modulo p, so the limbs
+ * above 2^130 fold back multiplied by 5.
+ */
+
+#include "include/backends/tinycryt/poly1305.h"
+#include "include/backends/tinycryt/constants.h"
+#include "include/backends/tinycryt/utils.h"
+
+static uint32_t load_le32(const uint8_t *p)
+{
+	return (uint32_t) p[0] | ((uint32_t) p[1] << 8) |
+	       ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+static void store_le32(uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)(v);
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+
+#if TC_POLY1305_RADIX44
+
+typedef unsigned __int128 uint128_t;
+
+#define MASK44 ((uint64_t) 0xfffffffffff)
+#define MASK42 ((uint64_t) 0x3ffffffffff)
+
+static uint64_t load_le64(const uint8_t *p)
+{
+	return (uint64_t) load_le32(p) | ((uint64_t) load_le32(p + 4) << 32);
+}
+
+static void poly1305_set_r(TCPoly1305State_t s, const uint8_t *key)
+{
+	uint64_t t0 = load_le64(key);
+	uint64_t t1 = load_le64(key + 8);
+
+	/* r &= 0x0ffffffc0ffffffc0ffffffc0fffffff */
+	s->r[0] = t0 & 0xffc0fffffff;
+	s->r[1] = ((t0 >> 44) | (t1 << 20)) & 0xfffffc0ffff;
+	s->r[2] = (t1 >> 24) & 0x00ffffffc0f;
+}
+
+/* h = (h + m) * r for each 16 byte block, hibit being 2^128 for full blocks */
+static void poly1305_blocks(TCPoly1305State_t s, const uint8_t *m,
+			    size_t blocks, uint64_t hibit)
+{
+	const uint64_t r0 = s->r[0];
+	const uint64_t r1 = s->r[1];
+	const uint64_t r2 = s->r[2];
+	const uint64_t s1 = r1 * (5 << 2);
+	const uint64_t s2 = r2 * (5 << 2);
+	uint64_t h0 = s->h[0];
+	uint64_t h1 = s->h[1];
+	uint64_t h2 = s->h[2];
+	uint64_t t0, t1, c;
+	uint128_t d0, d1, d2;
+
+	hibit <<= 40;
+
+	for (; blocks > 0; --blocks, m += TC_POLY1305_BLOCK_SIZE) {
+		t0 = load_le64(m);
+		t1 = load_le64(m + 8);
+
+		h0 += t0 & MASK44;
+		h1 += ((t0 >> 44) | (t1 << 20)) & MASK44;
+		h2 += ((t1 >> 24) & MASK42) | hibit;
+
+		d0 = (uint128_t) h0 * r0 + (uint128_t) h1 * s2 +
+		     (uint128_t) h2 * s1;
+		d1 = (uint128_t) h0 * r1 + (uint128_t) h1 * r0 +
+		     (uint128_t) h2 * s2;
+		d2 = (uint128_t) h0 * r2 + (uint128_t) h1 * r1 +
+		     (uint128_t) h2 * r0;
+
+		c = (uint64_t)(d0 >> 44);
+		h0 = (uint64_t) d0 & MASK44;
+		d1 += c;
+		c = (uint64_t)(d1 >> 44);
+		h1 = (uint64_t) d1 & MASK44;
+		d2 += c;
+		c = (uint64_t)(d2 >> 42);
+		h2 = (uint64_t) d2 & MASK42;
+		h0 += c * 5;
+		c = h0 >> 44;
+		h0 &= MASK44;
+		h1 += c;
+	}
+
+	s->h[0] = h0;
+	s->h[1] = h1;
+	s->h[2] = h2;
+}
+
+static void poly1305_finish(TCPoly1305State_t s, uint8_t *tag)
+{
+	uint64_t h0 = s->h[0];
+	uint64_t h1 = s->h[1];
+	uint64_t h2 = s->h[2];
+	uint64_t g0, g1, g2, c, t0, t1;
+
+	/* fully carry h */
+	c = h1 >> 44;
+	h1 &= MASK44;
+	h2 += c;
+	c = h2 >> 42;
+	h2 &= MASK42;
+	h0 += c * 5;
+	c = h0 >> 44;
+	h0 &= MASK44;
+	h1 += c;
+	c = h1 >> 44;
+	h1 &= MASK44;
+	h2 += c;
+	c = h2 >> 42;
+	h2 &= MASK42;
+	h0 += c * 5;
+	c = h0 >> 44;
+	h0 &= MASK44;
+	h1 += c;
+
+	/* g = h + -p */
+	g0 = h0 + 5;
+	c = g0 >> 44;
+	g0 &= MASK44;
+	g1 = h1 + c;
+	c = g1 >> 44;
+	g1 &= MASK44;
+	g2 = h2 + c - ((uint64_t) 1 << 42);
+
+	/* h = g if h >= p, without a branch */
+	c = (g2 >> 63) - 1;
+	g0 &= c;
+	g1 &= c;
+	g2 &= c;
+	c = ~c;
+	h0 = (h0 & c) | g0;
+	h1 = (h1 & c) | g1;
+	h2 = (h2 & c) | g2;
+
+	/* tag = (h + s) % 2^128 */
+	t0 = (uint64_t) s->pad[0] | ((uint64_t) s->pad[1] << 32);
+	t1 = (uint64_t) s->pad[2] | ((uint64_t) s->pad[3] << 32);
+	h0 += t0 & MASK44;
+	c = h0 >> 44;
+	h0 &= MASK44;
+	h1 += (((t0 >> 44) | (t1 << 20)) & MASK44) + c;
+	c = h1 >> 44;
+	h1 &= MASK44;
+	h2 += ((t1 >> 24) & MASK42) + c;
+	h2 &= MASK42;
+
+	h0 = h0 | (h1 << 44);
+	h1 = (h1 >> 20) | (h2 << 24);
+
+	store_le32(tag, (uint32_t) h0);
+	store_le32(tag + 4, (uint32_t)(h0 >> 32));
+	store_le32(tag + 8, (uint32_t) h1);
+	store_le32(tag + 12, (uint32_t)(h1 >> 32));
+}
+
+#else /* !TC_POLY1305_RADIX44 */
+
+#define MASK26 ((uint32_t) 0x3ffffff)
+
+static void poly1305_set_r(TCPoly1305State_t s, const uint8_t *key)
+{
+	/* r &= 0x0ffffffc0ffffffc0ffffffc0fffffff */
+	s->r[0] = load_le32(key) & 0x3ffffff;
+	s->r[1] = (load_le32(key + 3) >> 2) & 0x3ffff03;
+	s->r[2] = (load_le32(key + 6) >> 4) & 0x3ffc0ff;
+	s->r[3] = (load_le32(key + 9) >> 6) & 0x3f03fff;
+	s->r[4] = (load_le32(key + 12) >> 8) & 0x00fffff;
+}
+
+/* h = (h + m) * r for each 16 byte block, hibit being 2^128 for full blocks */
+static void poly1305_blocks(TCPoly1305State_t s, const uint8_t *m,
+			    size_t blocks, uint32_t hibit)
+{
+	const uint32_t r0 = s->r[0];
+	const uint32_t r1 = s->r[1];
+	const uint32_t r2 = s->r[2];
+	const uint32_t r3 = s->r[3];
+	const uint32_t r4 = s->r[4];
+	const uint32_t s1 = r1 * 5;
+	const uint32_t s2 = r2 * 5;
+	const uint32_t s3 = r3 * 5;
+	const uint32_t s4 = r4 * 5;
+	uint32_t h0 = s->h[0];
+	uint32_t h1 = s->h[1];
+	uint32_t h2 = s->h[2];
+	uint32_t h3 = s->h[3];
+	uint32_t h4 = s->h[4];
+	uint64_t d0, d1, d2, d3, d4;
+	uint32_t c;
+
+	hibit <<= 24;
+
+	for (; blocks > 0; --blocks, m += TC_POLY1305_BLOCK_SIZE) {
+		h0 += load_le32(m) & MASK26;
+		h1 += (load_le32(m + 3) >> 2) & MASK26;
+		h2 += (load_le32(m + 6) >> 4) & MASK26;
+		h3 += (load_le32(m + 9) >> 6) & MASK26;
+		h4 += (load_le32(m + 12) >> 8) | hibit;
+
+		d0 = (uint64_t) h0 * r0 + (uint64_t) h1 * s4 +
+		     (uint64_t) h2 * s3 + (uint64_t) h3 * s2 +
+		     (uint64_t) h4 * s1;
+		d1 = (uint64_t) h0 * r1 + (uint64_t) h1 * r0 +
+		     (uint64_t) h2 * s4 + (uint64_t) h3 * s3 +
+		     (uint64_t) h4 * s2;
+		d2 = (uint64_t) h0 * r2 + (uint64_t) h1 * r1 +
+		     (uint64_t) h2 * r0 + (uint64_t) h3 * s4 +
+		     (uint64_t) h4 * s3;
+		d3 = (uint64_t) h0 * r3 + (uint64_t) h1 * r2 +
+		     (uint64_t) h2 * r1 + (uint64_t) h3 * r0 +
+		     (uint64_t) h4 * s4;
+		d4 = (uint64_t) h0 * r4 + (uint64_t) h1 * r3 +
+		     (uint64_t) h2 * r2 + (uint64_t) h3 * r1 +
+		     (uint64_t) h4 * r0;
+
+		c = (uint32_t)(d0 >> 26);
+		h0 = (uint32_t) d0 & MASK26;
+		d1 += c;
+		c = (uint32_t)(d1 >> 26);
+		h1 = (uint32_t) d1 & MASK26;
+		d2 += c;
+		c = (uint32_t)(d2 >> 26);
+		h2 = (uint32_t) d2 & MASK26;
+		d3 += c;
+		c = (uint32_t)(d3 >> 26);
+		h3 = (uint32_t) d3 & MASK26;
+		d4 += c;
+		c = (uint32_t)(d4 >> 26);
+		h4 = (uint32_t) d4 & MASK26;
+		h0 += c * 5;
+		c = h0 >> 26;
+		h0 &= MASK26;
+		h1 += c;
+	}
+
+	s->h[0] = h0;
+	s->h[1] = h1;
+	s->h[2] = h2;
+	s->h[3] = h3;
+	s->h[4] = h4;
+}
+
+static void poly1305_finish(TCPoly1305State_t s, uint8_t *tag)
+{
+	uint32_t h0 = s->h[0];
+	uint32_t h1 = s->h[1];
+	uint32_t h2 = s->h[2];
+	uint32_t h3 = s->h[3];
+	uint32_t h4 = s->h[4];
+	uint32_t g0, g1, g2, g3, g4, c, mask;
+	uint64_t f;
+
+	/* fully carry h */
+	c = h1 >> 26;
+	h1 &= MASK26;
+	h2 += c;
+	c = h2 >> 26;
+	h2 &= MASK26;
+	h3 += c;
+	c = h3 >> 26;
+	h3 &= MASK26;
+	h4 += c;
+	c = h4 >> 26;
+	h4 &= MASK26;
+	h0 += c * 5;
+	c = h0 >> 26;
+	h0 &= MASK26;
+	h1 += c;
+
+	/* g = h + -p */
+	g0 = h0 + 5;
+	c = g0 >> 26;
+	g0 &= MASK26;
+	g1 = h1 + c;
+	c = g1 >> 26;
+	g1 &= MASK26;
+	g2 = h2 + c;
+	c = g2 >> 26;
+	g2 &= MASK26;
+	g3 = h3 + c;
+	c = g3 >> 26;
+	g3 &= MASK26;
+	g4 = h4 + c - (1U << 26);
+
+	/* h = g if h >= p, without a branch */
+	mask = (g4 >> 31) - 1;
+	g0 &= mask;
+	g1 &= mask;
+	g2 &= mask;
+	g3 &= mask;
+	g4 &= mask;
+	mask = ~mask;
+	h0 = (h0 & mask) | g0;
+	h1 = (h1 & mask) | g1;
+	h2 = (h2 & mask) | g2;
+	h3 = (h3 & mask) | g3;
+	h4 = (h4 & mask) | g4;
+
+	/* h = h % 2^128 */
+	h0 = h0 | (h1 << 26);
+	h1 = (h1 >> 6) | (h2 << 20);
+	h2 = (h2 >> 12) | (h3 << 14);
+	h3 = (h3 >> 18) | (h4 << 8);
+
+	/* tag = (h + s) % 2^128 */
+	f = (uint64_t) h0 + s->pad[0];
+	store_le32(tag, (uint32_t) f);
+	f = (uint64_t) h1 + s->pad[1] + (f >> 32);
+	store_le32(tag + 4, (uint32_t) f);
+	f = (uint64_t) h2 + s->pad[2] + (f >> 32);
+	store_le32(tag + 8, (uint32_t) f);
+	f = (uint64_t) h3 + s->pad[3] + (f >> 32);
+	store_le32(tag + 12, (uint32_t) f);
+}
+
+#endif /* TC_POLY1305_RADIX44 */
+
+int tc_poly1305_init(TCPoly1305State_t s, const uint8_t *key)
+{
+	unsigned int i;
+
+	if (s == (TCPoly1305State_t) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (key == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	_set(s, TC_ZERO_BYTE, sizeof(*s));
+	poly1305_set_r(s, key);
+
+	for (i = 0; i < 4; ++i) {
+		s->pad[i] = load_le32(key + 16 + 4 * i);
+	}
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+int tc_poly1305_update(TCPoly1305State_t s, const uint8_t *data, size_t len)
+{
+	size_t n;
+
+	if (s == (TCPoly1305State_t) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (len == 0) {
+		return TC_CRYPTO_SUCCESS;
+	} else if (data == (const uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	if (s->leftover != 0) {
+		n = TC_POLY1305_BLOCK_SIZE - s->leftover;
+		if (n > len) {
+			n = len;
+		}
+		(void)_copy(s->buf + s->leftover, (unsigned int) n, data,
+			    (unsigned int) n);
+		s->leftover += (unsigned int) n;
+		data += n;
+		len -= n;
+		if (s->leftover < TC_POLY1305_BLOCK_SIZE) {
+			return TC_CRYPTO_SUCCESS;
+		}
+		poly1305_blocks(s, s->buf, 1, 1);
+		s->leftover = 0;
+	}
+
+	n = len / TC_POLY1305_BLOCK_SIZE;
+	poly1305_blocks(s, data, n, 1);
+	data += n * TC_POLY1305_BLOCK_SIZE;
+	len -= n * TC_POLY1305_BLOCK_SIZE;
+
+	(void)_copy(s->buf, TC_POLY1305_BLOCK_SIZE, data, (unsigned int) len);
+	s->leftover = (unsigned int) len;
+
+	return TC_CRYPTO_SUCCESS;
+}
+
+int tc_poly1305_final(TCPoly1305State_t s, uint8_t *tag)
+{
+	if (s == (TCPoly1305State_t) 0) {
+		return TC_CRYPTO_FAIL;
+	} else if (tag == (uint8_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+
+	/* a partial block is padded with 1 and zeros instead of 2^128 */
+	if (s->leftover != 0) {
+		s->buf[s->leftover] = 1;
+		_set(s->buf + s->leftover + 1, TC_ZERO_BYTE,
+		     TC_POLY1305_BLOCK_SIZE - s->leftover - 1);
+		poly1305_blocks(s, s->buf, 1, 0);
+	}
+
+	poly1305_finish(s, tag);
+	_set(s, TC_ZERO_BYTE, sizeof(*s));
+
+	return TC_CRYPTO_SUCCESS;
+}
@@ -1,6 +1,8 @@
 #include "include/backends/tinycryt/fixedint.h"
 #include "include/backends/tinycryt/sc.h"
 
+#if !SC_RADIX64
+
 static uint64_t load_3(const unsigned char *in) {
     uint64_t result;
 
@@ -807,3 +809,243 @@ void sc_muladd(unsigned char *s, const unsigned char *a, const unsigned char *b,
     s[30] = (unsigned char) (s11 >> 9);
     s[31] = (unsigned char) (s11 >> 17);
 }
+
+#endif /* !SC_RADIX64 */
+
+
+
+#if SC_RADIX64
+
+/*
+Scalars as little endian 64 bit words, reduced with Barrett's method
+(HAC 14.42) for b = 2^64 and k = 4. All loops run a fixed number of
+times and the final subtractions are masked, the scalars are secret.
+*/
+
+__extension__ typedef unsigned __int128 sc_uint128;
+
+/* l */
+static const uint64_t sc_l[4] = {
+    UINT64_C(0x5812631a5cf5d3ed), UINT64_C(0x14def9dea2f79cd6),
+    UINT64_C(0x0000000000000000), UINT64_C(0x1000000000000000)
+};
+
+/* floor(2^512 / l) */
+static const uint64_t sc_mu[5] = {
+    UINT64_C(0xed9ce5a30a2c131b), UINT64_C(0x2106215d086329a7),
+    UINT64_C(0xffffffffffffffeb), UINT64_C(0xffffffffffffffff),
+    UINT64_C(0x000000000000000f)
+};
+
+static uint64_t load_8(const unsigned char *in) {
+    uint64_t result;
+
+    result = (uint64_t) in[0];
+    result |= ((uint64_t) in[1]) << 8;
+    result |= ((uint64_t) in[2]) << 16;
+    result |= ((uint64_t) in[3]) << 24;
+    result |= ((uint64_t) in[4]) << 32;
+    result |= ((uint64_t) in[5]) << 40;
+    result |= ((uint64_t) in[6]) << 48;
+    result |= ((uint64_t) in[7]) << 56;
+
+    return result;
+}
+
+static void store_8(unsigned char *out, uint64_t x) {
+    out[0] = (unsigned char) x;
+    out[1] = (unsigned char) (x >> 8);
+    out[2] = (unsigned char) (x >> 16);
+    out[3] = (unsigned char) (x >> 24);
+    out[4] = (unsigned char) (x >> 32);
+    out[5] = (unsigned char) (x >> 40);
+    out[6] = (unsigned char) (x >> 48);
+    out[7] = (unsigned char) (x >> 56);
+}
+
+/* Adds the product x y to the three word column accumulator (c0, c1, c2) */
+#define SC_MAC(x, y) do { \
+    sc_uint128 p_ = (sc_uint128) (x) * (y); \
+    sc_uint128 s_ = (sc_uint128) c0 + (uint64_t) p_; \
+    c0 = (uint64_t) s_; \
+    s_ = (sc_uint128) c1 + (uint64_t) (p_ >> 64) + (uint64_t) (s_ >> 64); \
+    c1 = (uint64_t) s_; \
+    c2 += (uint64_t) (s_ >> 64); \
+} while (0)
+
+/* Ends column k, shifting the accumulator by a word */
+#define SC_COL(r, k) do { (r)[k] = c0; c0 = c1; c1 = c2; c2 = 0; } while (0)
+
+/* r[0..9] = a * b, column by column */
+static void sc_mul_5x5(uint64_t r[10], const uint64_t a[5], const uint64_t b[5]) {
+    uint64_t c0 = 0, c1 = 0, c2 = 0;
+
+    SC_MAC(a[0], b[0]); SC_COL(r, 0);
+    SC_MAC(a[0], b[1]); SC_MAC(a[1], b[0]); SC_COL(r, 1);
+    SC_MAC(a[0], b[2]); SC_MAC(a[1], b[1]); SC_MAC(a[2], b[0]); SC_COL(r, 2);
+    SC_MAC(a[0], b[3]); SC_MAC(a[1], b[2]); SC_MAC(a[2], b[1]); SC_MAC(a[3], b[0]); SC_COL(r, 3);
+    SC_MAC(a[0], b[4]); SC_MAC(a[1], b[3]); SC_MAC(a[2], b[2]); SC_MAC(a[3], b[1]); SC_MAC(a[4], b[0]); SC_COL(r, 4);
+    SC_MAC(a[1], b[4]); SC_MAC(a[2], b[3]); SC_MAC(a[3], b[2]); SC_MAC(a[4], b[1]); SC_COL(r, 5);
+    SC_MAC(a[2], b[4]); SC_MAC(a[3], b[3]); SC_MAC(a[4], b[2]); SC_COL(r, 6);
+    SC_MAC(a[3], b[4]); SC_MAC(a[4], b[3]); SC_COL(r, 7);
+    SC_MAC(a[4], b[4]); SC_COL(r, 8);
+    r[9] = c0;
+}
+
+/* r[0..7] = a * b */
+static void sc_mul_4x4(uint64_t r[8], const uint64_t a[4], const uint64_t b[4]) {
+    uint64_t c0 = 0, c1 = 0, c2 = 0;
+
+    SC_MAC(a[0], b[0]); SC_COL(r, 0);
+    SC_MAC(a[0], b[1]); SC_MAC(a[1], b[0]); SC_COL(r, 1);
+    SC_MAC(a[0], b[2]); SC_MAC(a[1], b[1]); SC_MAC(a[2], b[0]); SC_COL(r, 2);
+    SC_MAC(a[0], b[3]); SC_MAC(a[1], b[2]); SC_MAC(a[2], b[1]); SC_MAC(a[3], b[0]); SC_COL(r, 3);
+    SC_MAC(a[1], b[3]); SC_MAC(a[2], b[2]); SC_MAC(a[3], b[1]); SC_COL(r, 4);
+    SC_MAC(a[2], b[3]); SC_MAC(a[3], b[2]); SC_COL(r, 5);
+    SC_MAC(a[3], b[3]); SC_COL(r, 6);
+    r[7] = c0;
+}
+
+/* r = q l mod b^5, l being l0 + l1 b + 2^252 */
+static void sc_mul_l(uint64_t r[5], const uint64_t q[5]) {
+    uint64_t c0 = 0, c1 = 0, c2 = 0;
+
+    SC_MAC(q[0], sc_l[0]); SC_COL(r, 0);
+    SC_MAC(q[0], sc_l[1]); SC_MAC(q[1], sc_l[0]); SC_COL(r, 1);
+    SC_MAC(q[1], sc_l[1]); SC_MAC(q[2], sc_l[0]); SC_COL(r, 2);
+    SC_MAC(q[2], sc_l[1]); SC_MAC(q[3], sc_l[0]); SC_MAC(q[0], UINT64_C(1) << 60); SC_COL(r, 3);
+    r[4] = c0 + q[3] * sc_l[1] + q[4] * sc_l[0] + (q[1] << 60);
+}
+
+/* Subtracts y and the borrow from x into r, updating the borrow */
+#define SC_SBB(r, x, y) do { \
+    sc_uint128 d_ = (sc_uint128) (x) - (y) - borrow; \
+    (r) = (uint64_t) d_; \
+    borrow = (uint64_t) (d_ >> 127); \
+} while (0)
+
+/* r = r - l if r >= l, r below 2^320 */
+static void sc_sub_l(uint64_t r[5]) {
+    uint64_t t0, t1, t2, t3, t4;
+    uint64_t borrow = 0;
+    uint64_t mask;
+
+    SC_SBB(t0, r[0], sc_l[0]);
+    SC_SBB(t1, r[1], sc_l[1]);
+    SC_SBB(t2, r[2], sc_l[2]);
+    SC_SBB(t3, r[3], sc_l[3]);
+    SC_SBB(t4, r[4], 0);
+
+    /* Keep t without a borrow */
+    mask = borrow - 1;
+    r[0] ^= (r[0] ^ t0) & mask;
+    r[1] ^= (r[1] ^ t1) & mask;
+    r[2] ^= (r[2] ^ t2) & mask;
+    r[3] ^= (r[3] ^ t3) & mask;
+    r[4] ^= (r[4] ^ t4) & mask;
+}
+
+/* s = x mod l for x below 2^512 */
+static void sc_barrett(unsigned char *s, const uint64_t x[8]) {
+    uint64_t q2[10];
+    uint64_t r2[5];
+    uint64_t r[5];
+    uint64_t borrow = 0;
+
+    /* q3 = floor(floor(x / b^3) * mu / b^5) */
+    sc_mul_5x5(q2, x + 3, sc_mu);
+
+    /* r = (x - q3 l) mod b^5, below 3l */
+    sc_mul_l(r2, q2 + 5);
+    SC_SBB(r[0], x[0], r2[0]);
+    SC_SBB(r[1], x[1], r2[1]);
+    SC_SBB(r[2], x[2], r2[2]);
+    SC_SBB(r[3], x[3], r2[3]);
+    SC_SBB(r[4], x[4], r2[4]);
+
+    sc_sub_l(r);
+    sc_sub_l(r);
+
+    store_8(s, r[0]);
+    store_8(s + 8, r[1]);
+    store_8(s + 16, r[2]);
+    store_8(s + 24, r[3]);
+}
+
+/*
+Input:
+  s[0]+256*s[1]+...+256^63*s[63] = s
+
+Output:
+  s[0]+256*s[1]+...+256^31*s[31] = s mod l
+  where l = 2^252 + 27742317777372353535851937790883648493.
+  Overwrites s in place.
+*/
+
+void sc_reduce(unsigned char *s) {
+    uint64_t x[8];
+
+    x[0] = load_8(s);
+    x[1] = load_8(s + 8);
+    x[2] = load_8(s + 16);
+    x[3] = load_8(s + 24);
+    x[4] = load_8(s + 32);
+    x[5] = load_8(s + 40);
+    x[6] = load_8(s + 48);
+    x[7] = load_8(s + 56);
+
+    sc_barrett(s, x);
+}
+
+/*
+Input:
+  a[0]+256*a[1]+...+256^31*a[31] = a
+  b[0]+256*b[1]+...+256^31*b[31] = b
+  c[0]+256*c[1]+...+256^31*c[31] = c
+
+Output:
+  s[0]+256*s[1]+...+256^31*s[31] = (ab+c) mod l
+  where l = 2^252 + 27742317777372353535851937790883648493.
+*/
+
+void sc_muladd(unsigned char *s, const unsigned char *a, const unsigned char *b, const unsigned char *c) {
+    uint64_t x[8];
+    uint64_t aw[4];
+    uint64_t bw[4];
+    uint64_t c0 = load_8(c);
+    uint64_t c1 = load_8(c + 8);
+    uint64_t c2 = load_8(c + 16);
+    uint64_t c3 = load_8(c + 24);
+    sc_uint128 t;
+
+    aw[0] = load_8(a);
+    aw[1] = load_8(a + 8);
+    aw[2] = load_8(a + 16);
+    aw[3] = load_8(a + 24);
+    bw[0] = load_8(b);
+    bw[1] = load_8(b + 8);
+    bw[2] = load_8(b + 16);
+    bw[3] = load_8(b + 24);
+
+    /* ab + c < 2^512 */
+    sc_mul_4x4(x, aw, bw);
+    t = (sc_uint128) x[0] + c0;
+    x[0] = (uint64_t) t;
+    t = (sc_uint128) x[1] + c1 + (uint64_t) (t >> 64);
+    x[1] = (uint64_t) t;
+    t = (sc_uint128) x[2] + c2 + (uint64_t) (t >> 64);
+    x[2] = (uint64_t) t;
+    t = (sc_uint128) x[3] + c3 + (uint64_t) (t >> 64);
+    x[3] = (uint64_t) t;
+    t = (sc_uint128) x[4] + (uint64_t) (t >> 64);
+    x[4] = (uint64_t) t;
+    t = (sc_uint128) x[5] + (uint64_t) (t >> 64);
+    x[5] = (uint64_t) t;
+    t = (sc_uint128) x[6] + (uint64_t) (t >> 64);
+    x[6] = (uint64_t) t;
+    x[7] += (uint64_t) (t >> 64);
+
+    sc_barrett(s, x);
+}
+
+#endif /* SC_RADIX64 */
@@ -34,7 +34,34 @@
 #include "include/backends/tinycryt/constants.h"
 #include "include/backends/tinycryt/utils.h"
 
+/*
+ * Hardware compression functions are built with per-function target
+ * attributes and chosen at run time, so the library still runs on CPUs
+ * without the SHA extensions.
+ */
+#if defined(__GNUC__) && defined(__x86_64__)
+#define TC_SHA256_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && \
+      (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define TC_SHA256_ARMV8
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+typedef void (*compress_blocks_t)(unsigned int *iv, const uint8_t *data,
+				  size_t blocks);
+
 static void compress(unsigned int *iv, const uint8_t *data);
+static void compress_resolve(unsigned int *iv, const uint8_t *data,
+			     size_t blocks);
+
+/* Replaced by the best backend that passes its self test on first use */
+static compress_blocks_t compress_blocks = compress_resolve;
 
 int tc_sha256_init(TCSha256State_t s)
 {
@@ -72,15 +99,39 @@ int tc_sha256_update(TCSha256State_t s, const uint8_t *data, size_t datalen)
 		return TC_CRYPTO_SUCCESS;
 	}
 
-	while (datalen-- > 0) {
-		s->leftover[s->leftover_offset++] = *(data++);
-		if (s->leftover_offset >= TC_SHA256_BLOCK_SIZE) {
-			compress(s->iv, s->leftover);
-			s->leftover_offset = 0;
-			s->bits_hashed += (TC_SHA256_BLOCK_SIZE << 3);
+	/* top up a partial block first */
+	if (s->leftover_offset > 0) {
+		size_t n = TC_SHA256_BLOCK_SIZE - s->leftover_offset;
+
+		if (n > datalen) {
+			n = datalen;
 		}
+		_copy(s->leftover + s->leftover_offset, n, data, n);
+		s->leftover_offset += n;
+		data += n;
+		datalen -= n;
+
+		if (s->leftover_offset < TC_SHA256_BLOCK_SIZE) {
+			return TC_CRYPTO_SUCCESS;
+		}
+		compress_blocks(s->iv, s->leftover, 1);
+		s->leftover_offset = 0;
+		s->bits_hashed += (TC_SHA256_BLOCK_SIZE << 3);
 	}
 
+	/* whole blocks are compressed straight from the input */
+	if (datalen >= TC_SHA256_BLOCK_SIZE) {
+		size_t blocks = datalen / TC_SHA256_BLOCK_SIZE;
+
+		compress_blocks(s->iv, data, blocks);
+		s->bits_hashed += (uint64_t)blocks * (TC_SHA256_BLOCK_SIZE << 3);
+		data += blocks * TC_SHA256_BLOCK_SIZE;
+		datalen -= blocks * TC_SHA256_BLOCK_SIZE;
+	}
+
+	_copy(s->leftover, datalen, data, datalen);
+	s->leftover_offset = datalen;
+
 	return TC_CRYPTO_SUCCESS;
 }
 
@@ -101,7 +152,7 @@ int tc_sha256_final(uint8_t *digest, TCSha256State_t s)
 		/* there is not room for all the padding in this block */
 		_set(s->leftover + s->leftover_offset, 0x00,
 		     sizeof(s->leftover) - s->leftover_offset);
-		compress(s->iv, s->leftover);
+		compress_blocks(s->iv, s->leftover, 1);
 		s->leftover_offset = 0;
 	}
 
@@ -118,7 +169,7 @@ int tc_sha256_final(uint8_t *digest, TCSha256State_t s)
 	s->leftover[sizeof(s->leftover) - 8] = (uint8_t)(s->bits_hashed >> 56);
 
 	/* hash the padding and length */
-	compress(s->iv, s->leftover);
+	compress_blocks(s->iv, s->leftover, 1);
 
 	/* copy the iv out to digest */
 	for (i = 0; i < TC_SHA256_STATE_BLOCKS; ++i) {
@@ -215,3 +266,435 @@ static void compress(unsigned int *iv, const uint8_t *data)
 	iv[0] += a; iv[1] += b; iv[2] += c; iv[3] += d;
 	iv[4] += e; iv[5] += f; iv[6] += g; iv[7] += h;
 }
+
+static void compress_portable(unsigned int *iv, const uint8_t *data,
+			      size_t blocks)
+{
+	while (blocks-- > 0) {
+		compress(iv, data);
+		data += TC_SHA256_BLOCK_SIZE;
+	}
+}
+
+#if defined(TC_SHA256_X86)
+/*
+ * SHA extensions: the state is kept as ABEF/CDGH and each sha256rnds2 does
+ * two rounds, the message schedule for four rounds is one msg1/msg2 pair.
+ */
+__attribute__((target("sha,sse4.1")))
+static void compress_shani(unsigned int *iv, const uint8_t *data,
+			   size_t blocks)
+{
+	const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+					    0x0405060700010203ULL);
+	__m128i state0, state1, abef, cdgh, msg, tmp;
+	__m128i w[4];
+	unsigned int i;
+
+	tmp = _mm_loadu_si128((const __m128i *) &iv[0]);
+	state1 = _mm_loadu_si128((const __m128i *) &iv[4]);
+	tmp = _mm_shuffle_epi32(tmp, 0xB1);		/* CDAB */
+	state1 = _mm_shuffle_epi32(state1, 0x1B);	/* EFGH */
+	state0 = _mm_alignr_epi8(tmp, state1, 8);	/* ABEF */
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);	/* CDGH */
+
+	while (blocks-- > 0) {
+		abef = state0;
+		cdgh = state1;
+
+		for (i = 0; i < 4; ++i) {
+			w[i] = _mm_shuffle_epi8(_mm_loadu_si128(
+				(const __m128i *) (data + 16 * i)), mask);
+		}
+
+		for (i = 0; i < 16; ++i) {
+			msg = _mm_add_epi32(w[i & 3], _mm_loadu_si128(
+				(const __m128i *) &k256[4 * i]));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			msg = _mm_shuffle_epi32(msg, 0x0E);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+			/* w[i] becomes the words of rounds 4i + 16 .. 4i + 19 */
+			if (i < 12) {
+				tmp = _mm_alignr_epi8(w[(i + 3) & 3],
+						      w[(i + 2) & 3], 4);
+				w[i & 3] = _mm_sha256msg1_epu32(w[i & 3],
+								w[(i + 1) & 3]);
+				w[i & 3] = _mm_add_epi32(w[i & 3], tmp);
+				w[i & 3] = _mm_sha256msg2_epu32(w[i & 3],
+								w[(i + 3) & 3]);
+			}
+		}
+
+		state0 = _mm_add_epi32(state0, abef);
+		state1 = _mm_add_epi32(state1, cdgh);
+		data += TC_SHA256_BLOCK_SIZE;
+	}
+
+	tmp = _mm_shuffle_epi32(state0, 0x1B);		/* FEBA */
+	state1 = _mm_shuffle_epi32(state1, 0xB1);	/* DCHG */
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0);	/* DCBA */
+	state1 = _mm_alignr_epi8(state1, tmp, 8);	/* HGFE */
+
+	_mm_storeu_si128((__m128i *) &iv[0], state0);
+	_mm_storeu_si128((__m128i *) &iv[4], state1);
+}
+
+static unsigned int xgetbv0(void)
+{
+	unsigned int eax, edx;
+
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return eax;
+}
+
+static int cpu_has_shani(void)
+{
+	unsigned int a, b, c, d;
+
+	if (!__get_cpuid(1, &a, &b, &c, &d) ||
+	    !(c & bit_SSSE3) || !(c & bit_SSE4_1)) {
+		return 0;
+	}
+	if (!__get_cpuid_count(7, 0, &a, &b, &c, &d)) {
+		return 0;
+	}
+	return (b & (1u << 29)) != 0;
+}
+
+static int cpu_has_avx2(void)
+{
+	unsigned int a, b, c, d;
+
+	/* the OS must save the YMM registers as well */
+	if (!__get_cpuid(1, &a, &b, &c, &d) || !(c & bit_OSXSAVE) ||
+	    (xgetbv0() & 0x6) != 0x6) {
+		return 0;
+	}
+	if (!__get_cpuid_count(7, 0, &a, &b, &c, &d)) {
+		return 0;
+	}
+	return (b & bit_AVX2) != 0;
+}
+#endif /* TC_SHA256_X86 */
+
+#if defined(TC_SHA256_ARMV8)
+/*
+ * ARMv8 Cryptography Extensions: sha256h/sha256h2 do four rounds on the
+ * ABCD and EFGH halves, sha256su0/su1 extend the message schedule.
+ */
+static void compress_armv8(unsigned int *iv, const uint8_t *data,
+			   size_t blocks)
+{
+	uint32x4_t abcd = vld1q_u32((const uint32_t *) &iv[0]);
+	uint32x4_t efgh = vld1q_u32((const uint32_t *) &iv[4]);
+	uint32x4_t abcd0, efgh0, msg, tmp;
+	uint32x4_t w[4];
+	unsigned int i;
+
+	while (blocks-- > 0) {
+		abcd0 = abcd;
+		efgh0 = efgh;
+
+		for (i = 0; i < 4; ++i) {
+			w[i] = vreinterpretq_u32_u8(vrev32q_u8(
+				vld1q_u8(data + 16 * i)));
+		}
+
+		for (i = 0; i < 16; ++i) {
+			msg = vaddq_u32(w[i & 3],
+					vld1q_u32((const uint32_t *) &k256[4 * i]));
+			if (i < 12) {
+				w[i & 3] = vsha256su1q_u32(
+					vsha256su0q_u32(w[i & 3], w[(i + 1) & 3]),
+					w[(i + 2) & 3], w[(i + 3) & 3]);
+			}
+			tmp = abcd;
+			abcd = vsha256hq_u32(abcd, efgh, msg);
+			efgh = vsha256h2q_u32(efgh, tmp, msg);
+		}
+
+		abcd = vaddq_u32(abcd, abcd0);
+		efgh = vaddq_u32(efgh, efgh0);
+		data += TC_SHA256_BLOCK_SIZE;
+	}
+
+	vst1q_u32((uint32_t *) &iv[0], abcd);
+	vst1q_u32((uint32_t *) &iv[4], efgh);
+}
+
+static int cpu_has_armv8_sha2(void)
+{
+#if defined(__linux__) && defined(HWCAP_SHA2)
+	return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+	/* built for a CPU with the extension */
+	return 1;
+#endif
+}
+#endif /* TC_SHA256_ARMV8 */
+
+/*
+ * A backend is only used if it agrees with compress() on two blocks, so a
+ * miscompiled or misdetected extension falls back to the portable code.
+ */
+static int compress_self_test(compress_blocks_t fn)
+{
+	uint8_t block[2 * TC_SHA256_BLOCK_SIZE];
+	unsigned int a[TC_SHA256_STATE_BLOCKS];
+	unsigned int b[TC_SHA256_STATE_BLOCKS];
+	unsigned int i;
+
+	for (i = 0; i < sizeof(block); ++i) {
+		block[i] = (uint8_t)(i * 167 + 13);
+	}
+	for (i = 0; i < TC_SHA256_STATE_BLOCKS; ++i) {
+		a[i] = b[i] = k256[i];
+	}
+
+	compress_portable(a, block, 2);
+	fn(b, block, 2);
+
+	return _compare((const uint8_t *) a, (const uint8_t *) b, sizeof(a)) == 0;
+}
+
+static void compress_resolve(unsigned int *iv, const uint8_t *data,
+			     size_t blocks)
+{
+	compress_blocks_t fn = compress_portable;
+
+#if defined(TC_SHA256_X86)
+	if (cpu_has_shani() && compress_self_test(compress_shani)) {
+		fn = compress_shani;
+	}
+#elif defined(TC_SHA256_ARMV8)
+	if (cpu_has_armv8_sha2() && compress_self_test(compress_armv8)) {
+		fn = compress_armv8;
+	}
+#endif
+
+	/* every thread that races here stores the same pointer */
+	compress_blocks = fn;
+	fn(iv, data, blocks);
+}
+
+static int sha256_one(uint8_t *digest, const uint8_t *data, size_t datalen)
+{
+	struct tc_sha256_state_struct s;
+
+	(void)tc_sha256_init(&s);
+	if (datalen > 0 && !tc_sha256_update(&s, data, datalen)) {
+		return TC_CRYPTO_FAIL;
+	}
+	return tc_sha256_final(digest, &s);
+}
+
+#if defined(TC_SHA256_X86)
+#define MB_LANES 8
+
+#define MB_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), \
+				      _mm256_slli_epi32((x), 32 - (n)))
+#define MB_SIGMA0(a) _mm256_xor_si256(_mm256_xor_si256(MB_ROTR((a), 2), \
+				      MB_ROTR((a), 13)), MB_ROTR((a), 22))
+#define MB_SIGMA1(a) _mm256_xor_si256(_mm256_xor_si256(MB_ROTR((a), 6), \
+				      MB_ROTR((a), 11)), MB_ROTR((a), 25))
+#define MB_sigma0(a) _mm256_xor_si256(_mm256_xor_si256(MB_ROTR((a), 7), \
+				      MB_ROTR((a), 18)), _mm256_srli_epi32((a), 3))
+#define MB_sigma1(a) _mm256_xor_si256(_mm256_xor_si256(MB_ROTR((a), 17), \
+				      MB_ROTR((a), 19)), _mm256_srli_epi32((a), 10))
+
+/* Turns r[i] = words 0..7 of lane i into r[j] = word j of lanes 0..7 */
+__attribute__((target("avx2")))
+static void mb_transpose(__m256i *r)
+{
+	__m256i t[8], u[8];
+	unsigned int i;
+
+	for (i = 0; i < 8; i += 2) {
+		t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+		t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+	}
+	for (i = 0; i < 8; i += 4) {
+		u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+		u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+		u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+		u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+	}
+	for (i = 0; i < 4; ++i) {
+		r[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+		r[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+	}
+}
+
+/*
+ * One block of each of the eight lanes, st[j] holding word j of the eight
+ * states. Lanes whose bit in active is clear keep their state.
+ */
+__attribute__((target("avx2")))
+static void compress_x8_avx2(__m256i *st, const uint8_t * const *block,
+			     __m256i active)
+{
+	const __m256i bswap = _mm256_set_epi8(
+		12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+		12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+	__m256i w[16], v[8], t1, t2;
+	unsigned int i;
+
+	for (i = 0; i < MB_LANES; ++i) {
+		w[i] = _mm256_loadu_si256((const __m256i *) block[i]);
+		w[i + 8] = _mm256_loadu_si256((const __m256i *) (block[i] + 32));
+	}
+	mb_transpose(w);
+	mb_transpose(w + 8);
+	for (i = 0; i < 16; ++i) {
+		w[i] = _mm256_shuffle_epi8(w[i], bswap);
+	}
+
+	for (i = 0; i < 8; ++i) {
+		v[i] = st[i];
+	}
+
+	for (i = 0; i < 64; ++i) {
+		if (i >= 16) {
+			w[i & 15] = _mm256_add_epi32(w[i & 15], _mm256_add_epi32(
+				_mm256_add_epi32(MB_sigma0(w[(i + 1) & 15]),
+						 MB_sigma1(w[(i + 14) & 15])),
+				w[(i + 9) & 15]));
+		}
+
+		/* t1 = h + Sigma1(e) + Ch(e, f, g) + k256[i] + w[i] */
+		t1 = _mm256_xor_si256(_mm256_and_si256(v[4], v[5]),
+				      _mm256_andnot_si256(v[4], v[6]));
+		t1 = _mm256_add_epi32(t1, _mm256_add_epi32(v[7], MB_SIGMA1(v[4])));
+		t1 = _mm256_add_epi32(t1, _mm256_add_epi32(w[i & 15],
+				      _mm256_set1_epi32((int)k256[i])));
+		/* t2 = Sigma0(a) + Maj(a, b, c) */
+		t2 = _mm256_or_si256(_mm256_and_si256(v[0], v[1]),
+				     _mm256_and_si256(v[2], _mm256_or_si256(v[0], v[1])));
+		t2 = _mm256_add_epi32(t2, MB_SIGMA0(v[0]));
+
+		v[7] = v[6]; v[6] = v[5]; v[5] = v[4];
+		v[4] = _mm256_add_epi32(v[3], t1);
+		v[3] = v[2]; v[2] = v[1]; v[1] = v[0];
+		v[0] = _mm256_add_epi32(t1, t2);
+	}
+
+	for (i = 0; i < 8; ++i) {
+		st[i] = _mm256_add_epi32(st[i], _mm256_and_si256(v[i], active));
+	}
+}
+
+/* Hashes up to MB_LANES messages, the shorter ones idle once padded */
+__attribute__((target("avx2")))
+static void sha256_x8(uint8_t * const *digest, const uint8_t * const *data,
+		      const size_t *datalen, unsigned int count)
+{
+	static const uint8_t idle[TC_SHA256_BLOCK_SIZE];
+	uint8_t tail[MB_LANES][2 * TC_SHA256_BLOCK_SIZE];
+	unsigned int words[MB_LANES];
+	struct tc_sha256_state_struct s;
+	const uint8_t *block[MB_LANES];
+	size_t full[MB_LANES] = {0}, total[MB_LANES] = {0};
+	size_t blocks = 0, b;
+	__m256i st[8];
+	unsigned int i, j;
+
+	for (i = 0; i < count; ++i) {
+		size_t rem = datalen[i] % TC_SHA256_BLOCK_SIZE;
+		size_t end;
+		uint64_t bits = (uint64_t)datalen[i] << 3;
+
+		full[i] = datalen[i] / TC_SHA256_BLOCK_SIZE;
+		total[i] = full[i] + (rem + 9 > TC_SHA256_BLOCK_SIZE ? 2 : 1);
+		end = (total[i] - full[i]) * TC_SHA256_BLOCK_SIZE;
+
+		_set(tail[i], 0x00, end);
+		_copy(tail[i], rem, data[i] + full[i] * TC_SHA256_BLOCK_SIZE, rem);
+		tail[i][rem] = 0x80;
+		for (j = 0; j < 8; ++j) {
+			tail[i][end - 1 - j] = (uint8_t)(bits >> (8 * j));
+		}
+
+		if (total[i] > blocks) {
+			blocks = total[i];
+		}
+	}
+
+	(void)tc_sha256_init(&s);
+	for (j = 0; j < 8; ++j) {
+		st[j] = _mm256_set1_epi32((int)s.iv[j]);
+	}
+
+	for (b = 0; b < blocks; ++b) {
+		for (i = 0; i < MB_LANES; ++i) {
+			if (b < full[i]) {
+				block[i] = data[i] + b * TC_SHA256_BLOCK_SIZE;
+			} else if (b < total[i]) {
+				block[i] = tail[i] + (b - full[i]) * TC_SHA256_BLOCK_SIZE;
+			} else {
+				block[i] = idle;
+			}
+			words[i] = b < total[i] ? 0xffffffff : 0;
+		}
+		compress_x8_avx2(st, block,
+				 _mm256_loadu_si256((const __m256i *) words));
+	}
+
+	for (j = 0; j < 8; ++j) {
+		_mm256_storeu_si256((__m256i *) words, st[j]);
+		for (i = 0; i < count; ++i) {
+			digest[i][4 * j] = (uint8_t)(words[i] >> 24);
+			digest[i][4 * j + 1] = (uint8_t)(words[i] >> 16);
+			digest[i][4 * j + 2] = (uint8_t)(words[i] >> 8);
+			digest[i][4 * j + 3] = (uint8_t)(words[i]);
+		}
+	}
+
+	_set_secure(tail, 0, sizeof(tail));
+	_set_secure(st, 0, sizeof(st));
+}
+#endif /* TC_SHA256_X86 */
+
+int tc_sha256_multi(uint8_t * const *digest, const uint8_t * const *data,
+		    const size_t *datalen, size_t count)
+{
+	size_t i;
+
+	/* input sanity check: */
+	if (digest == (uint8_t * const *) 0 || data == (const uint8_t * const *) 0 ||
+	    datalen == (const size_t *) 0) {
+		return TC_CRYPTO_FAIL;
+	}
+	for (i = 0; i < count; ++i) {
+		if (digest[i] == (uint8_t *) 0 || data[i] == (const uint8_t *) 0) {
+			return TC_CRYPTO_FAIL;
+		}
+	}
+
+	i = 0;
+#if defined(TC_SHA256_X86)
+	{
+		static int avx2 = -1;
+
+		/* one SHA-NI stream keeps up with eight AVX2 lanes */
+		if (avx2 < 0) {
+			avx2 = cpu_has_avx2() && !cpu_has_shani();
+		}
+
+		while (avx2 && count - i >= TC_SHA256_MULTI_MIN) {
+			unsigned int n = count - i < MB_LANES ? count - i : MB_LANES;
+
+			sha256_x8(digest + i, data + i, datalen + i, n);
+			i += n;
+		}
+	}
+#endif
+
+	for (; i < count; ++i) {
+		if (!sha256_one(digest[i], data[i], datalen[i])) {
+			return TC_CRYPTO_FAIL;
+		}
+	}
+
+	return TC_CRYPTO_SUCCESS;
+}
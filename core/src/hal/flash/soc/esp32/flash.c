@@ -1,5 +1,6 @@
 #ifdef ESP_PLATFORM
 #include "nvs_flash.h"
+#include "esp_partition.h"
 #include "include/hal/flash/flash_common.h"
 #include "include/hal/flash/soc/esp32/flash.h"
 
@@ -37,4 +38,50 @@ flash_drv esp32_flash = {ESP32_FLASH_START_ADDRESS, ESP32_FLASH_SIZE, ESP32_FLAS
                                 esp32_hal_flash_read, 
                                 esp32_hal_flash_protect};
 
+static const esp_partition_t *esp32_spool_partition = NULL;
+
+static int esp32_hal_spool_init(void) {
+
+    if (NULL == esp32_spool_partition)
+        esp32_spool_partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, ESP32_SPOOL_PARTITION_LABEL);
+
+    if (NULL == esp32_spool_partition)
+        return -1;
+
+    esp32_spool_flash.flash_size = esp32_spool_partition->size;
+
+    return 0;
+}
+
+static int esp32_hal_spool_earse(unsigned int address) {
+
+    if (NULL == esp32_spool_partition)
+        return -1;
+
+    return esp_partition_erase_range(esp32_spool_partition, address - address % ESP32_SPOOL_BLOCK_SIZE, ESP32_SPOOL_BLOCK_SIZE);
+}
+
+static int esp32_hal_spool_write(unsigned int address, unsigned int offset, unsigned char *buf, int len) {
+
+    if (NULL == esp32_spool_partition || NULL == buf)
+        return -1;
+
+    return (ESP_OK == esp_partition_write(esp32_spool_partition, address + offset, buf, len) ? len : -2);
+}
+
+static int esp32_hal_spool_read(unsigned int address, unsigned int offset, unsigned char *buf, int len) {
+
+    if (NULL == esp32_spool_partition || NULL == buf)
+        return -1;
+
+    return (ESP_OK == esp_partition_read(esp32_spool_partition, address + offset, buf, len) ? len : -2);
+}
+
+flash_drv esp32_spool_flash = {0, 0, ESP32_SPOOL_BLOCK_SIZE,
+                                esp32_hal_spool_init,
+                                esp32_hal_spool_earse,
+                                esp32_hal_spool_write,
+                                esp32_hal_spool_read,
+                                esp32_hal_flash_protect};
+
 #endif
@@ -0,0 +1,129 @@
+#if defined(__linux__) && !defined(ESP_PLATFORM)
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "include/hal/flash/flash_common.h"
+#include "include/hal/flash/soc/linux/flash.h"
+
+/* Flash emulated by a file of LINUX_FLASH_SIZE bytes, erased blocks read back as 0xFF */
+static FILE *linux_flash_file = NULL;
+
+/* fflush only hands data to the kernel, fsync makes it durable before the caller moves on */
+static int linux_hal_flash_sync(void) {
+
+    if (fflush(linux_flash_file) || fsync(fileno(linux_flash_file)))
+        return -1;
+
+    return 0;
+}
+
+static int linux_hal_flash_init(void) {
+
+    unsigned char erased[256];
+    long size = 0;
+
+    if (linux_flash_file)
+        return 0;
+
+    linux_flash_file = fopen(LINUX_FLASH_FILE, "r+b");
+    if (NULL == linux_flash_file)
+        linux_flash_file = fopen(LINUX_FLASH_FILE, "w+b");
+
+    if (NULL == linux_flash_file)
+        return -1;
+
+    fseek(linux_flash_file, 0, SEEK_END);
+    size = ftell(linux_flash_file);
+    if (size < 0)
+        return -1;
+
+    memset(erased, 0xFF, sizeof(erased));
+
+    while (size < LINUX_FLASH_SIZE) {
+
+        size_t n = (size_t)(LINUX_FLASH_SIZE - size);
+
+        if (n > sizeof(erased))
+            n = sizeof(erased);
+
+        if (fwrite(erased, 1, n, linux_flash_file) != n)
+            return -2;
+
+        size += n;
+    }
+
+    return linux_hal_flash_sync();
+}
+
+static int linux_hal_flash_earse(unsigned int address) {
+
+    unsigned char erased[256];
+    unsigned int block = address - address % LINUX_FLASH_BLOCK_SIZE;
+
+    if (NULL == linux_flash_file || block + LINUX_FLASH_BLOCK_SIZE > LINUX_FLASH_START_ADDRESS + LINUX_FLASH_SIZE)
+        return -1;
+
+    memset(erased, 0xFF, sizeof(erased));
+
+    fseek(linux_flash_file, block - LINUX_FLASH_START_ADDRESS, SEEK_SET);
+
+    for (unsigned int i = 0; i < LINUX_FLASH_BLOCK_SIZE; i += sizeof(erased)) {
+        if (fwrite(erased, 1, sizeof(erased), linux_flash_file) != sizeof(erased))
+            return -2;
+    }
+
+    if (linux_hal_flash_sync())
+        return -3;
+
+    return 0;
+}
+
+static int linux_hal_flash_write(unsigned int address, unsigned int offset, unsigned char *buf, int len) {
+
+    if (NULL == linux_flash_file || address + offset + len > LINUX_FLASH_START_ADDRESS + LINUX_FLASH_SIZE)
+        return -1;
+
+    if (NULL == buf)
+        return -2;
+
+    fseek(linux_flash_file, address + offset - LINUX_FLASH_START_ADDRESS, SEEK_SET);
+
+    if (fwrite(buf, 1, len, linux_flash_file) != (size_t)len)
+        return -3;
+
+    /* Every write reaches the disk before returning, the spool relies on write ordering for power-fail safety */
+    if (linux_hal_flash_sync())
+        return -4;
+
+    return len;
+}
+
+static int linux_hal_flash_read(unsigned int address, unsigned int offset, unsigned char *buf, int len) {
+
+    if (NULL == linux_flash_file || address + offset + len > LINUX_FLASH_START_ADDRESS + LINUX_FLASH_SIZE)
+        return -1;
+
+    if (NULL == buf)
+        return -2;
+
+    fseek(linux_flash_file, address + offset - LINUX_FLASH_START_ADDRESS, SEEK_SET);
+
+    return (int)fread(buf, 1, len, linux_flash_file);
+}
+
+static int linux_hal_flash_protect(unsigned int protection) {
+
+    (void)protection;
+
+    return 0;
+}
+
+flash_drv linux_flash = {LINUX_FLASH_START_ADDRESS, LINUX_FLASH_SIZE, LINUX_FLASH_BLOCK_SIZE,
+                                linux_hal_flash_init,
+                                linux_hal_flash_earse,
+                                linux_hal_flash_write,
+                                linux_hal_flash_read,
+                                linux_hal_flash_protect};
+
+#endif
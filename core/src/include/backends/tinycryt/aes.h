@@ -43,12 +43,19 @@
  *
  *  Usage:      1) call tc_aes128_set_encrypt/decrypt_key to set the key.
  *
- *              2) call tc_aes_encrypt/decrypt to process the data.
+ *              2) call tc_aes_encrypt/decrypt to process the data, or
+ *              tc_aes_encrypt/decrypt_blocks for several independent blocks.
+ *
+ *  Backends:   The rounds are table driven (TC_AES_TTABLE) unless built with
+ *              TC_AES_TTABLE 0 for the smaller byte-wise code. On x86-64 and
+ *              ARMv8 the AES instructions are used instead when the CPU has
+ *              them, chosen at run time.
  */
 
 #ifndef __TC_AES_H__
 #define __TC_AES_H__
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -61,6 +68,19 @@ extern "C" {
 #define TC_AES_BLOCK_SIZE (Nb*Nk)
 #define TC_AES_KEY_SIZE (Nb*Nk)
 
+/*
+ * 1 for the 32-bit T-table rounds (1KB of tables per direction), 0 for the
+ * byte-wise rounds
+ */
+#ifndef TC_AES_TTABLE
+#define TC_AES_TTABLE (1)
+#endif
+
+/* number of blocks the hardware backends keep in flight */
+#ifndef TC_AES_PARALLEL
+#define TC_AES_PARALLEL (8)
+#endif
+
 typedef struct tc_aes_key_sched_struct {
 	unsigned int words[Nb*(Nr+1)];
 } *TCAesKeySched_t;
@@ -93,14 +113,32 @@ int tc_aes128_set_encrypt_key(TCAesKeySched_t s, const uint8_t *k);
 int tc_aes_encrypt(uint8_t *out, const uint8_t *in, 
 		   const TCAesKeySched_t s);
 
+/**
+ *  @brief AES-128 Encryption of several blocks
+ *  Encrypts blocks independent blocks of in into out under key schedule s,
+ *  as tc_aes_encrypt on each, interleaved where the backend allows it
+ *  @note Assumes s was initialized by aes_set_encrypt_key;
+ *              out and in point to blocks * 16 byte buffers, which are either
+ *              the same or do not overlap
+ *  @return  returns TC_CRYPTO_SUCCESS (1)
+ *           returns TC_CRYPTO_FAIL (0) if: out == NULL or in == NULL or s == NULL
+ *  @param out IN/OUT -- buffer to receive the ciphertext blocks
+ *  @param in IN -- plaintext blocks to encrypt
+ *  @param blocks IN -- number of blocks
+ *  @param s IN -- initialized AES key schedule
+ */
+int tc_aes_encrypt_blocks(uint8_t *out, const uint8_t *in, size_t blocks,
+			  const TCAesKeySched_t s);
+
 /**
  *  @brief Set the AES-128 decryption key
  *  Uses key k to initialize s
  *  @return returns TC_CRYPTO_SUCCESS (1)
  *          returns TC_CRYPTO_FAIL (0) if: s == NULL or k == NULL
- *  @note       This is the implementation of the straightforward inverse cipher
- *              using the cipher documented in FIPS-197 figure 12, not the
- *              equivalent inverse cipher presented in Figure 15
+ *  @note       This is the key schedule of the equivalent inverse cipher
+ *              presented in FIPS-197 Figure 15, InvMixColumns being applied
+ *              to the round keys of rounds 1 to Nr - 1. It can only be used
+ *              with tc_aes_decrypt and tc_aes_decrypt_blocks
  *  @warning    This routine skips the additional steps required for keys larger
  *              than 128, and must not be used for AES-192 or AES-256 key
  *              schedule -- see FIPS 197 for details
@@ -110,11 +148,11 @@ int tc_aes_encrypt(uint8_t *out, const uint8_t *in,
 int tc_aes128_set_decrypt_key(TCAesKeySched_t s, const uint8_t *k);
 
 /**
- *  @brief AES-128 Encryption procedure
+ *  @brief AES-128 Decryption procedure
  *  Decrypts in buffer into out buffer under key schedule s
  *  @return returns TC_CRYPTO_SUCCESS (1)
  *          returns TC_CRYPTO_FAIL (0) if: out is NULL or in is NULL or s is NULL
- *  @note   Assumes s was initialized by aes_set_encrypt_key
+ *  @note   Assumes s was initialized by aes_set_decrypt_key
  *          out and in point to 16 byte buffers
  *  @param out IN/OUT -- buffer to receive ciphertext block
  *  @param in IN -- a plaintext block to encrypt
@@ -123,6 +161,23 @@ int tc_aes128_set_decrypt_key(TCAesKeySched_t s, const uint8_t *k);
 int tc_aes_decrypt(uint8_t *out, const uint8_t *in, 
 		   const TCAesKeySched_t s);
 
+/**
+ *  @brief AES-128 Decryption of several blocks
+ *  Decrypts blocks independent blocks of in into out under key schedule s,
+ *  as tc_aes_decrypt on each, interleaved where the backend allows it
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: out is NULL or in is NULL or s is NULL
+ *  @note   Assumes s was initialized by aes_set_decrypt_key
+ *          out and in point to blocks * 16 byte buffers, which are either
+ *          the same or do not overlap
+ *  @param out IN/OUT -- buffer to receive the plaintext blocks
+ *  @param in IN -- ciphertext blocks to decrypt
+ *  @param blocks IN -- number of blocks
+ *  @param s IN -- initialized AES key schedule
+ */
+int tc_aes_decrypt_blocks(uint8_t *out, const uint8_t *in, size_t blocks,
+			  const TCAesKeySched_t s);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,88 @@
+/* chacha20.h - TinyCrypt interface to a ChaCha20 implementation */
+
+/**
+ * @file
+ * @brief Interface to the ChaCha20 stream cipher.
+ *
+ *  Overview:  ChaCha20 is the stream cipher of RFC 8439, with a 256-bit key,
+ *             a 96-bit nonce and a 32-bit block counter. Each 64 byte block
+ *             of key stream is 20 rounds of additions, rotations and XORs
+ *             over a 4x4 matrix of 32-bit words, which needs no tables.
+ *
+ *  Security:  The same nonce must never be used twice with a key. A message
+ *             is limited to 2^32 blocks (256 GB) of key stream.
+ *
+ *  Usage:     1) call tc_chacha20_set_key once per key.
+ *
+ *             2) call tc_chacha20_start with the nonce and first counter of
+ *             the message.
+ *
+ *             3) call tc_chacha20_crypt as many times as needed, the same
+ *             call encrypts and decrypts.
+ *
+ *  Backends:  Blocks are computed one at a time with 32-bit words. With SSE2
+ *             or NEON, four blocks are computed at a time, one per lane.
+ */
+
+#ifndef __TC_CHACHA20_H__
+#define __TC_CHACHA20_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TC_CHACHA20_KEY_SIZE (32)
+#define TC_CHACHA20_NONCE_SIZE (12)
+#define TC_CHACHA20_BLOCK_SIZE (64)
+
+typedef struct tc_chacha20_state_struct {
+	uint32_t state[16];
+	uint8_t keystream[TC_CHACHA20_BLOCK_SIZE];
+	unsigned int keystream_used;	/* TC_CHACHA20_BLOCK_SIZE when spent */
+} *TCChaCha20State_t;
+
+/**
+ *  @brief Set the ChaCha20 key
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: s == NULL or key == NULL
+ *  @param s IN/OUT -- ChaCha20 state to initialize
+ *  @param key IN -- TC_CHACHA20_KEY_SIZE byte key
+ */
+int tc_chacha20_set_key(TCChaCha20State_t s, const uint8_t *key);
+
+/**
+ *  @brief Start a message
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: s == NULL or nonce == NULL
+ *  @note Assumes s was initialized by tc_chacha20_set_key
+ *  @param s IN/OUT -- ChaCha20 state
+ *  @param nonce IN -- TC_CHACHA20_NONCE_SIZE byte nonce
+ *  @param counter IN -- counter of the first block
+ */
+int tc_chacha20_start(TCChaCha20State_t s, const uint8_t *nonce,
+		      uint32_t counter);
+
+/**
+ *  @brief Encrypt or decrypt data
+ *  XORs the next len bytes of key stream into in, the rest of a partial
+ *  block being kept for the next call
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: s == NULL or
+ *                out == NULL or in == NULL and len != 0
+ *  @note out and in are either the same or do not overlap
+ *  @param s IN/OUT -- ChaCha20 state
+ *  @param out OUT -- len bytes of output
+ *  @param in IN -- len bytes of input
+ *  @param len IN -- data length in bytes
+ */
+int tc_chacha20_crypt(TCChaCha20State_t s, uint8_t *out, const uint8_t *in,
+		      size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TC_CHACHA20_H__ */
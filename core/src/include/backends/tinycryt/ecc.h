@@ -81,8 +81,46 @@ extern "C" {
 #define uECC_CURVE_TYPE_SECP256R1		1
 #define uECC_CURVE_TYPE_SECP256K1		2
 
-/* Word size (4 bytes considering 32-bits architectures) */
+/*
+ * Word size: 8 bytes on LP64 hosts with a native 64x64->128 multiply (the
+ * Linux gateways), 4 bytes on 32-bits architectures. Both give the same
+ * results, define uECC_WORD_SIZE to 4 to force the 32-bits code.
+ */
+#ifndef uECC_WORD_SIZE
+#if defined(__SIZEOF_INT128__) && (defined(__LP64__) || defined(_LP64))
+#define uECC_WORD_SIZE 8
+#else
 #define uECC_WORD_SIZE 4
+#endif
+#endif
+
+/*
+ * Teeth of the fixed-base comb used to multiply the generator, per curve.
+ * A comb of w teeth keeps 2^(w-1) points of G (64 bytes each) in flash and
+ * needs ceil(256 / w) doublings and additions, 0 falls back to the
+ * Montgomery ladder. Supported values are 0, 4, 5 and 6.
+ */
+#ifndef uECC_SECP256R1_COMB_TEETH
+#define uECC_SECP256R1_COMB_TEETH 5
+#endif
+
+#ifndef uECC_SECP256K1_COMB_TEETH
+#define uECC_SECP256K1_COMB_TEETH 5
+#endif
+
+/*
+ * Variable-time secp256k1 verification with the GLV endomorphism, see
+ * uECC_verify_glv(). It keeps 64 multiples of G (4 KB) in flash and a 576
+ * bytes table per cached key, so it is only on by default on the 64-bits
+ * hosts that verify device uploads. Devices keep the Shamir's trick verify.
+ */
+#ifndef uECC_SECP256K1_GLV
+#if (uECC_WORD_SIZE == 8)
+#define uECC_SECP256K1_GLV 1
+#else
+#define uECC_SECP256K1_GLV 0
+#endif
+#endif
 
 /* setting max number of calls to prng: */
 #ifndef uECC_RNG_MAX_TRIES
@@ -94,6 +132,21 @@ typedef int8_t wordcount_t;
 typedef int16_t bitcount_t;
 /* defining data type for comparison result: */
 typedef int8_t cmpresult_t;
+#if (uECC_WORD_SIZE == 8)
+/* defining data type to store ECC coordinate/point in 64bits words: */
+typedef uint64_t uECC_word_t;
+/* defining data type to store the product of two words: */
+typedef unsigned __int128 uECC_dword_t;
+
+/* defining masks useful for ecc computations: */
+#define HIGH_BIT_SET 0x8000000000000000ull
+#define uECC_WORD_BITS 64
+#define uECC_WORD_BITS_SHIFT 6
+#define uECC_WORD_BITS_MASK 0x03F
+
+/* Number of words of 64 bits to represent an element of the the curve p-256: */
+#define NUM_ECC_WORDS 4
+#elif (uECC_WORD_SIZE == 4)
 /* defining data type to store ECC coordinate/point in 32bits words: */
 typedef unsigned int uECC_word_t;
 /* defining data type to store an ECC coordinate/point in 64bits words: */
@@ -107,6 +160,9 @@ typedef uint64_t uECC_dword_t;
 
 /* Number of words of 32 bits to represent an element of the the curve p-256: */
 #define NUM_ECC_WORDS 8
+#else
+#error "uECC_WORD_SIZE must be 4 or 8"
+#endif
 /* Number of bytes to represent an element of the the curve p-256: */
 #define NUM_ECC_BYTES (uECC_WORD_SIZE*NUM_ECC_WORDS)
 
@@ -125,6 +181,9 @@ struct uECC_Curve_t {
 	uECC_Curve curve);
   void (*x_side)(uECC_word_t *result, const uECC_word_t *x, uECC_Curve curve);
   void (*mmod_fast)(uECC_word_t *result, uECC_word_t *product);
+  const uECC_word_t *comb;	/* precomputed multiples of G, see ecc_comb_table.c */
+  uint8_t comb_teeth;
+  uECC_word_t mu[NUM_ECC_WORDS + 1];	/* floor(2^512 / n), see uECC_vli_modMult_n() */
 };
 
 /*
@@ -152,16 +211,53 @@ void x_side_default(uECC_word_t *result, const uECC_word_t *x,
  * @param result OUT -- product % curve_p
  * @param product IN -- value to be reduced mod curve_p
  */
-void vli_mmod_fast_secp256r1(unsigned int *result, unsigned int *product);
-void vli_mmod_fast_secp256k1(unsigned int *result, unsigned int *product);
+void vli_mmod_fast_secp256r1(uECC_word_t *result, uECC_word_t *product);
+void vli_mmod_fast_secp256k1(uECC_word_t *result, uECC_word_t *product);
 
 /* Bytes to words ordering: */
+#if (uECC_WORD_SIZE == 8)
+#define BYTES_TO_WORDS_8(a, b, c, d, e, f, g, h) 0x##h##g##f##e##d##c##b##a##ull
+#else
 #define BYTES_TO_WORDS_8(a, b, c, d, e, f, g, h) 0x##d##c##b##a, 0x##h##g##f##e
+#endif
 #define BYTES_TO_WORDS_4(a, b, c, d) 0x##d##c##b##a
 #define BITS_TO_WORDS(num_bits) \
 	((num_bits + ((uECC_WORD_SIZE * 8) - 1)) / (uECC_WORD_SIZE * 8))
 #define BITS_TO_BYTES(num_bits) ((num_bits + 7) / 8)
 
+#if uECC_SECP256R1_COMB_TEETH
+extern const uECC_word_t uECC_secp256r1_comb_table[];
+#define uECC_SECP256R1_COMB_TABLE uECC_secp256r1_comb_table
+#else
+#define uECC_SECP256R1_COMB_TABLE 0
+#endif
+
+#if uECC_SECP256K1_COMB_TEETH
+extern const uECC_word_t uECC_secp256k1_comb_table[];
+#define uECC_SECP256K1_COMB_TABLE uECC_secp256k1_comb_table
+#else
+#define uECC_SECP256K1_COMB_TABLE 0
+#endif
+
+#if uECC_SECP256K1_GLV
+/* Odd multiples G, 3G, .. 127G, see ecc_glv_table.c */
+extern const uECC_word_t uECC_secp256k1_glv_table[];
+
+/* Width of the wNAF digits of the public key half scalars */
+#define uECC_GLV_KEY_WINDOW 5
+
+/*
+ * Odd multiples Q, 3Q, .. 15Q of a secp256k1 public key Q in affine
+ * coordinates. Building it costs about as much as a tenth of a verification,
+ * callers that check many signatures of one key keep it between calls.
+ */
+typedef struct uECC_glv_table {
+	uECC_word_t key[NUM_ECC_WORDS * 2];
+	uECC_word_t odd[1 << (uECC_GLV_KEY_WINDOW - 2)][NUM_ECC_WORDS * 2];
+	uint8_t valid;
+} uECC_glv_table;
+#endif
+
 /* definition of curve NIST p-256: */
 static const struct uECC_Curve_t curve_secp256r1 = {
 	NUM_ECC_WORDS,
@@ -194,7 +290,15 @@ static const struct uECC_Curve_t curve_secp256r1 = {
 	},
         &double_jacobian_default,
         &x_side_default,
-        &vli_mmod_fast_secp256r1
+        &vli_mmod_fast_secp256r1,
+        uECC_SECP256R1_COMB_TABLE,
+        uECC_SECP256R1_COMB_TEETH, {
+		BYTES_TO_WORDS_8(FE, 9B, DF, EE, 85, FD, 2F, 01),
+		BYTES_TO_WORDS_8(21, 6C, 1A, DF, 52, 05, 19, 43),
+		BYTES_TO_WORDS_8(FF, FF, FF, FF, FE, FF, FF, FF),
+		BYTES_TO_WORDS_8(FF, FF, FF, FF, 00, 00, 00, 00),
+		1
+	}
 };
 
 uECC_Curve uECC_secp256r1(void);
@@ -231,11 +335,27 @@ static const struct uECC_Curve_t curve_secp256k1 = {
 	},
         &double_jacobian_default,
         &x_side_default,
-        &vli_mmod_fast_secp256k1
+        &vli_mmod_fast_secp256k1,
+        uECC_SECP256K1_COMB_TABLE,
+        uECC_SECP256K1_COMB_TEETH, {
+		BYTES_TO_WORDS_8(C0, BE, C9, 2F, 73, A1, 2D, 40),
+		BYTES_TO_WORDS_8(C4, 5F, B7, 50, 19, 23, 51, 45),
+		BYTES_TO_WORDS_8(01, 00, 00, 00, 00, 00, 00, 00),
+		BYTES_TO_WORDS_8(00, 00, 00, 00, 00, 00, 00, 00),
+		1
+	}
 };
 
 uECC_Curve uECC_secp256k1(void);
 
+/*
+ * @brief Identifies a curve returned by uECC_secp256r1() or uECC_secp256k1().
+ * @return uECC_CURVE_TYPE_SECP256R1, uECC_CURVE_TYPE_SECP256K1 or
+ * uECC_CURVE_TYPE_NONE
+ * @param curve IN -- elliptic curve
+ */
+int uECC_get_curve_type(uECC_Curve curve);
+
 /*
  * @brief Generates a random integer in the range 0 < random < top.
  * Both random and top have num_words words.
@@ -345,6 +465,63 @@ void EccPoint_mult(uECC_word_t * result, const uECC_word_t * point,
 		   const uECC_word_t * scalar, const uECC_word_t * initial_Z,
 		   bitcount_t num_bits, uECC_Curve curve);
 
+/*
+ * @brief Multiplication of the curve generator, using the fixed-base comb when
+ * the curve has one and the Montgomery ladder otherwise. Runs in constant time.
+ * @param result OUT -- returns scalar*G
+ * @param scalar IN -- scalar, 0 < scalar < curve->n
+ * @param curve IN -- elliptic curve
+ */
+void EccPoint_mult_base(uECC_word_t * result, const uECC_word_t * scalar,
+			uECC_Curve curve);
+
+/*
+ * @brief Computes (X1, Y1, Z1) += (x2, y2), in place, not in constant time.
+ * @note Z1 == 0 stands for the point at infinity.
+ * @param X1 IN/OUT -- x coordinate of the jacobian point
+ * @param Y1 IN/OUT -- y coordinate of the jacobian point
+ * @param Z1 IN/OUT -- z coordinate of the jacobian point
+ * @param x2 IN -- x coordinate of the affine point
+ * @param y2 IN -- y coordinate of the affine point
+ * @param curve IN -- elliptic curve
+ */
+void EccPoint_add_mixed(uECC_word_t * X1, uECC_word_t * Y1,
+			uECC_word_t * Z1, const uECC_word_t * x2,
+			const uECC_word_t * y2, uECC_Curve curve);
+
+/*
+ * @brief Checks that the affine x of a jacobian point is r modulo n, comparing
+ * X with r * Z^2 instead of inverting Z. Not in constant time.
+ * @return 1 if X / Z^2 is r modulo n, 0 otherwise or for the point at infinity
+ * @param X IN -- x coordinate of the jacobian point
+ * @param Z IN -- z coordinate of the jacobian point, 0 for infinity
+ * @param r IN -- 0 < r < n
+ * @param curve IN -- elliptic curve
+ */
+int EccPoint_check_x(const uECC_word_t * X, const uECC_word_t * Z,
+		     const uECC_word_t * r, uECC_Curve curve);
+
+#if uECC_SECP256K1_GLV
+/*
+ * @brief Fills table with the odd multiples of a secp256k1 public key.
+ * @param table OUT -- table of point, marked valid
+ * @param point IN -- public key, x followed by y, on secp256k1
+ */
+void uECC_glv_table_init(uECC_glv_table *table, const uECC_word_t *point);
+
+/*
+ * @brief Checks the ECDSA equation on secp256k1 with the GLV endomorphism and
+ * interleaved wNAF. Runs in variable time, for public inputs only.
+ * @return 1 if the x coordinate of u1 * G + u2 * Q is r modulo n, 0 otherwise
+ * @param u1 IN -- scalar of G, below n
+ * @param u2 IN -- scalar of Q, below n
+ * @param r IN -- r of the signature, 0 < r < n
+ * @param table IN -- odd multiples of Q, from uECC_glv_table_init()
+ */
+int EccPoint_verify_glv(const uECC_word_t *u1, const uECC_word_t *u2,
+			const uECC_word_t *r, const uECC_glv_table *table);
+#endif
+
 /*
  * @brief Constant-time comparison to zero - secure way to compare long integers
  * @param vli IN -- very long integer
@@ -484,6 +661,27 @@ void uECC_vli_modMult(uECC_word_t *result, const uECC_word_t *left,
 		      const uECC_word_t *right, const uECC_word_t *mod,
 	              wordcount_t num_words);
 
+/*
+ * @brief Computes (left * right) % curve->n with Barrett's reduction, much
+ * faster than uECC_vli_modMult(). Runs in constant time.
+ * @param result OUT -- (left * right) % n
+ * @param left IN -- left term in product, below n
+ * @param right IN -- right term in product, below n
+ * @param curve IN -- elliptic curve
+ */
+void uECC_vli_modMult_n(uECC_word_t *result, const uECC_word_t *left,
+			const uECC_word_t *right, uECC_Curve curve);
+
+/*
+ * @brief Computes result = left * right.
+ * @param result OUT -- left * right, 2 * num_words long
+ * @param left IN -- left term in product
+ * @param right IN -- right term in product
+ * @param num_words IN -- number of words
+ */
+void uECC_vli_mult(uECC_word_t *result, const uECC_word_t *left,
+		   const uECC_word_t *right, wordcount_t num_words);
+
 /*
  * @brief Computes (1 / input) % mod
  * @note All VLIs are the same size.
@@ -569,7 +767,7 @@ int uECC_valid_public_key(const uint8_t *public_key, uECC_Curve curve);
   * @param native IN -- uECC native representation
   */
 void uECC_vli_nativeToBytes(uint8_t *bytes, int num_bytes,
-    			    const unsigned int *native);
+    			    const uECC_word_t *native);
 
 /*
  * @brief Converts big-endian bytes to an integer in uECC native format.
@@ -577,7 +775,7 @@ void uECC_vli_nativeToBytes(uint8_t *bytes, int num_bytes,
  * @param bytes IN -- bytes representation
  * @param num_bytes IN -- number of bytes
  */
-void uECC_vli_bytesToNative(unsigned int *native, const uint8_t *bytes,
+void uECC_vli_bytesToNative(uECC_word_t *native, const uint8_t *bytes,
 			    int num_bytes);
 
 int uECC_compute_public_key_with_ed25519(const uint8_t *private_key, uint8_t *public_key);				
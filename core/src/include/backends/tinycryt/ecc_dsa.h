@@ -105,6 +105,54 @@ extern "C" {
 int uECC_sign(const uint8_t *p_private_key, const uint8_t *p_message_hash,
 	      unsigned p_hash_size, uint8_t *p_signature, uECC_Curve curve);
 
+/**
+ * @brief Generate an ECDSA signature in canonical low-S form.
+ * @return returns TC_CRYPTO_SUCCESS (1) if the signature generated successfully
+ *         returns TC_CRYPTO_FAIL (0) if an error occurred.
+ *
+ * Same as uECC_sign(), except that s is replaced by n - s when it is larger
+ * than n / 2 (n being the curve order), as Ethereum-style verifiers require.
+ * The replacement is done in constant time on the native words of s.
+ */
+int uECC_sign_low_s(const uint8_t *p_private_key, const uint8_t *p_message_hash,
+		    unsigned p_hash_size, uint8_t *p_signature, uECC_Curve curve);
+
+/* The part of a signature that does not depend on the key or the message */
+typedef struct uECC_sign_nonce {
+	uECC_word_t r[NUM_ECC_WORDS];		/* x(kG) */
+	uECC_word_t kinv[NUM_ECC_WORDS];	/* 1 / k mod n */
+	uECC_Curve curve;
+} uECC_sign_nonce;
+
+/**
+ * @brief Draw a random nonce k and compute its share of a signature.
+ * @return returns TC_CRYPTO_SUCCESS (1) if the nonce was computed
+ *         returns TC_CRYPTO_FAIL (0) if the RNG failed
+ *
+ * @param p_nonce OUT -- Receives r and 1/k, it must be kept secret.
+ *
+ * @note This is the costly half of uECC_sign(), the scalar multiplication
+ * and the inversion, so it can run ahead of time while the device is idle.
+ */
+int uECC_sign_precompute(uECC_sign_nonce *p_nonce, uECC_Curve curve);
+
+/**
+ * @brief Sign with a nonce from uECC_sign_precompute(), a few modular
+ * multiplications.
+ * @return returns TC_CRYPTO_SUCCESS (1) if the signature generated successfully
+ *         returns TC_CRYPTO_FAIL (0) if the nonce is for another curve
+ *
+ * @param p_nonce IN/OUT -- The nonce, wiped on return so it is never reused.
+ * @param low_s IN -- Whether to produce a low-S signature, as
+ * uECC_sign_low_s().
+ *
+ * Other parameters are as for uECC_sign().
+ */
+int uECC_sign_with_nonce(const uint8_t *p_private_key,
+			 const uint8_t *p_message_hash, unsigned p_hash_size,
+			 uECC_sign_nonce *p_nonce, uint8_t *p_signature,
+			 int low_s, uECC_Curve curve);
+
 #ifdef ENABLE_TESTS
 /*
  * THIS FUNCTION SHOULD BE CALLED FOR TEST PURPOSES ONLY.
@@ -132,6 +180,68 @@ int uECC_sign_with_k(const uint8_t *private_key, const uint8_t *message_hash,
 int uECC_verify(const uint8_t *p_public_key, const uint8_t *p_message_hash,
 		unsigned int p_hash_size, const uint8_t *p_signature, uECC_Curve curve);
 
+/**
+ * @brief Same as uECC_verify(), with the public key already decoded into
+ * native words, x followed by y (2 * NUM_ECC_WORDS words).
+ */
+int uECC_verify_native(const uECC_word_t *p_public, const uint8_t *p_message_hash,
+		       unsigned int p_hash_size, const uint8_t *p_signature,
+		       uECC_Curve curve);
+
+#if uECC_SECP256K1_GLV
+/**
+ * @brief Verify a secp256k1 ECDSA signature with the GLV endomorphism.
+ * @return returns TC_SUCCESS (1) if the signature is valid
+ * 	   returns TC_FAIL (0) if the signature is invalid.
+ *
+ * @param p_public IN -- The signer's public key in native words, x then y.
+ * @param p_message_hash IN -- The hash of the signed data.
+ * @param p_hash_size IN -- The size of p_message_hash in bytes.
+ * @param p_signature IN -- The signature values.
+ * @param p_table IN/OUT -- Odd multiples of p_public, rebuilt when it is not
+ * valid or belongs to another key. May be NULL to build a temporary one.
+ *
+ * @note Runs in variable time, which is fine since every input of a
+ * verification is public. uECC_verify_native() uses it for secp256k1 with a
+ * temporary table, keeping the table saves about a tenth of each call.
+ */
+int uECC_verify_glv(const uECC_word_t *p_public, const uint8_t *p_message_hash,
+		    unsigned int p_hash_size, const uint8_t *p_signature,
+		    uECC_glv_table *p_table);
+#endif
+
+/* Signatures sharing each modular inversion in uECC_verify_batch() */
+#ifndef uECC_VERIFY_BATCH_CHUNK
+#define uECC_VERIFY_BATCH_CHUNK 16
+#endif
+
+/* One signature of uECC_verify_batch() */
+typedef struct uECC_verify_item {
+	const uECC_word_t *public_key;	/* native words, x then y */
+	const uint8_t *message_hash;
+	unsigned int hash_size;
+	const uint8_t *signature;
+#if uECC_SECP256K1_GLV
+	uECC_glv_table *table;		/* secp256k1 only, may be NULL */
+#endif
+	int result;			/* OUT: 1 if valid, 0 otherwise */
+} uECC_verify_item;
+
+/**
+ * @brief Verify a batch of ECDSA signatures on one curve.
+ *
+ * @param p_items IN/OUT -- The signatures, result receives the outcome of
+ * each one as uECC_verify_native() would return it.
+ * @param p_count IN -- Number of items.
+ *
+ * @note Every uECC_VERIFY_BATCH_CHUNK signatures share one inversion of s
+ * modulo n and, with Shamir's trick, one inversion modulo p for G + Q, using
+ * Montgomery's simultaneous inversion. The final 1/Z of every signature is
+ * avoided by checking x in jacobian coordinates.
+ */
+void uECC_verify_batch(uECC_verify_item *p_items, unsigned int p_count,
+		       uECC_Curve curve);
+
 #ifdef __cplusplus
 }
 #endif
@@ -80,6 +80,20 @@ extern "C" {
 */
 #define default_RNG_defined 1
 
+/*
+ * On POSIX, default_CSPRNG() is a process-wide CTR-PRNG seeded from
+ * /dev/urandom. Its output is produced uECC_RNG_BUFFER_SIZE bytes at a time,
+ * and it takes fresh entropy from the OS every uECC_RNG_RESEED_INTERVAL bytes
+ * and in the child after a fork().
+ */
+#ifndef uECC_RNG_BUFFER_SIZE
+#define uECC_RNG_BUFFER_SIZE 512
+#endif
+
+#ifndef uECC_RNG_RESEED_INTERVAL
+#define uECC_RNG_RESEED_INTERVAL (1UL << 20)
+#endif
+
 int default_CSPRNG(uint8_t *dest, unsigned int size);
 void default_SetSeed(uint8_t seed);
 
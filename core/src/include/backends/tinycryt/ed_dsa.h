@@ -4,13 +4,79 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "include/backends/tinycryt/ge.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Signatures checked by one multi-scalar multiplication in
+ * uECC_ed25519_verify_batch(), each takes about 400 bytes of stack.
+ * Set from CONFIG_PSA_ED25519_BATCH_CHUNK when built with Kconfig */
+#ifndef ED25519_BATCH_CHUNK
+#define ED25519_BATCH_CHUNK 64
+#endif
+
+/* Smaller chunks are verified one signature at a time */
+#ifndef ED25519_BATCH_MIN
+#define ED25519_BATCH_MIN 8
+#endif
+
+/* One signature of uECC_ed25519_verify_batch() */
+typedef struct uECC_ed25519_batch_item {
+    const uint8_t *public_key;
+    const uint8_t *message;
+    unsigned message_len;
+    const uint8_t *signature;
+    int result;                 /* OUT: 1 if valid, 0 otherwise */
+} uECC_ed25519_batch_item;
+
+/*
+ * An Ed25519 key with everything derived from it that signing and verification
+ * need, so they skip the hashing of the seed and the decoding of the public key.
+ */
+typedef struct uECC_ed25519_key {
+    uint8_t expanded[64];       /* clamped scalar a || prefix, from SHA-512 of the seed */
+    uint8_t public_key[32];     /* encoding of A = aB */
+    uint8_t has_secret;         /* 0 for a key made from a public key only */
+    ge_cached neg_A[GE_DSM_TABLE_SIZE]; /* -A, -3A, ..., -15A */
+} uECC_ed25519_key;
+
 int uECC_ed25519_sign(const uint8_t *private_key, const uint8_t *public_key, const uint8_t *message, unsigned message_len, uint8_t *signature);
 int uECC_ed25519_verify(const uint8_t *public_key, const uint8_t *message, unsigned message_len, const uint8_t *signature); 
 
+/*
+ * Verifies count signatures, setting the result of every item. Returns 1 if
+ * they are all valid.
+ *
+ * Every ED25519_BATCH_CHUNK signatures are checked at once with a random
+ * linear combination of their equations, one multi-scalar multiplication of
+ * about twice as many points. A chunk that fails is verified again one
+ * signature at a time to find the invalid ones. The random coefficients come
+ * from the uECC RNG, without one every signature is verified on its own.
+ *
+ * The combination is the equation of uECC_ed25519_verify() for points of
+ * prime order. A signature whose only defect is a small order component in
+ * its public key or R may pass a batch that uECC_ed25519_verify() rejects.
+ */
+int uECC_ed25519_verify_batch(uECC_ed25519_batch_item *items, unsigned count);
+
+/* expanded = SHA-512(seed) with the scalar half clamped, seed is 32 bytes */
+void uECC_ed25519_expand(const uint8_t *seed, uint8_t *expanded);
+
+/* public_key = encoding of aB for the scalar a of the 32 byte seed, returns 1 */
+int uECC_ed25519_public_key(const uint8_t *seed, uint8_t *public_key);
+
+/*
+ * Fills key from the 32 byte seed of a key pair, or from the encoded public_key
+ * when seed is NULL. Returns 0 if the public key does not decode to a point.
+ */
+int uECC_ed25519_key_init(uECC_ed25519_key *key, const uint8_t *seed, const uint8_t *public_key);
+
+/* Same as uECC_ed25519_sign()/verify(), returns 0 when signing with a public key */
+int uECC_ed25519_sign_with_key(const uECC_ed25519_key *key, const uint8_t *message, unsigned message_len, uint8_t *signature);
+int uECC_ed25519_verify_with_key(const uECC_ed25519_key *key, const uint8_t *message, unsigned message_len, const uint8_t *signature);
+
 #ifdef __cplusplus
 }
 #endif
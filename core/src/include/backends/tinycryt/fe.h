@@ -4,6 +4,44 @@
 #include "include/backends/tinycryt/fixedint.h"
 
 
+/*
+    On 64-bit targets with a 128-bit product the field elements are five
+    51 bit limbs instead, define FE_RADIX51 to 0 to keep the 32-bit code.
+*/
+#ifndef FE_RADIX51
+#if defined(__SIZEOF_INT128__) && (defined(__LP64__) || defined(_LP64))
+#define FE_RADIX51 1
+#else
+#define FE_RADIX51 0
+#endif
+#endif
+
+
+#if FE_RADIX51
+
+/*
+    fe means field element.
+    Here the field is \Z/(2^255-19).
+    An element t, entries t[0]...t[4], represents the integer
+    t[0]+2^51 t[1]+2^102 t[2]+2^153 t[3]+2^204 t[4].
+    The limbs are unsigned, below 2^52 once carried.
+*/
+
+
+typedef uint64_t fe[5];
+
+/*
+    Constants are written in the 10 limb form below, limb i is
+    t[2i]+2^26 t[2i+1] plus 2p so that it stays positive.
+*/
+#define FE_LIMB(a, b, p2) ((uint64_t) ((int64_t) (a) + (int64_t) (b) * 67108864 + (int64_t) (p2)))
+#define FE_CONST(t0, t1, t2, t3, t4, t5, t6, t7, t8, t9) { \
+    FE_LIMB(t0, t1, 0xfffffffffffdaLL), FE_LIMB(t2, t3, 0xffffffffffffeLL), \
+    FE_LIMB(t4, t5, 0xffffffffffffeLL), FE_LIMB(t6, t7, 0xffffffffffffeLL), \
+    FE_LIMB(t8, t9, 0xffffffffffffeLL) }
+
+#else
+
 /*
     fe means field element.
     Here the field is \Z/(2^255-19).
@@ -15,6 +53,10 @@
 
 typedef int32_t fe[10];
 
+#define FE_CONST(t0, t1, t2, t3, t4, t5, t6, t7, t8, t9) { t0, t1, t2, t3, t4, t5, t6, t7, t8, t9 }
+
+#endif
+
 
 void fe_0(fe h);
 void fe_1(fe h);
@@ -0,0 +1,138 @@
+/* gcm_mode.h - TinyCrypt interface to a GCM mode implementation */
+
+/**
+ * @file
+ * @brief Interface to GCM mode.
+ *
+ *  Overview:  GCM (Galois/Counter Mode) is a NIST approved authenticated
+ *             encryption mode specified in SP 800-38D. The data is encrypted
+ *             in CTR mode and authenticated, with the associated data, by
+ *             GHASH, a polynomial hash over GF(2^128) keyed with
+ *             H = E(K, 0^128). Both passes run over the data once, so unlike
+ *             CCM it can be used in a single streaming pass. TinyCrypt hard
+ *             codes AES128 as the block cipher.
+ *
+ *  Security:  The same nonce must never be used twice with a key. Nonces of
+ *             12 bytes are the recommended size, others are hashed.
+ *
+ *  Requires: AES-128
+ *
+ *  Usage:     1) call tc_gcm_set_key once per key.
+ *
+ *             2) call tc_gcm_start with the nonce of the message.
+ *
+ *             3) call tc_gcm_update_aad as many times as needed, then
+ *             tc_gcm_encrypt_update or tc_gcm_decrypt_update as many times
+ *             as needed.
+ *
+ *             4) call tc_gcm_final to get the tag. A decrypting caller
+ *             compares it to the received tag in constant time.
+ *
+ *  Backends:  GHASH uses 4-bit tables (256 bytes per key). On x86-64 with
+ *             PCLMULQDQ and on ARMv8 with PMULL, carry-less multiplication
+ *             over four blocks at a time is used instead, chosen at run time.
+ */
+
+#ifndef __TC_GCM_MODE_H__
+#define __TC_GCM_MODE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "include/backends/tinycryt/aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TC_GCM_TAG_SIZE (16)
+#define TC_GCM_NONCE_SIZE (12)
+
+/* at most 2^32 - 2 blocks of data per nonce */
+#define TC_GCM_MAX_DATA_SIZE ((((uint64_t) 1) << 36) - 32)
+
+typedef struct tc_gcm_state_struct {
+	struct tc_aes_key_sched_struct sched;
+	uint64_t htable[32];	/* multiplication by H, laid out by the backend */
+	uint8_t ek0[16];	/* E(K, J0), masks the tag */
+	uint8_t ctr[16];	/* counter block of the next key stream block */
+	uint8_t x[16];		/* GHASH accumulator */
+	uint8_t buf[16];	/* partial block of associated data or ciphertext */
+	uint8_t ks[16];		/* key stream of the partial data block */
+	uint64_t aad_len;
+	uint64_t len;
+} *TCGcmState_t;
+
+/**
+ *  @brief Set the GCM key
+ *  Expands the AES-128 key and the GHASH key H
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: s == NULL or key == NULL
+ *  @param s IN/OUT -- GCM state to initialize
+ *  @param key IN -- 16 byte AES key
+ */
+int tc_gcm_set_key(TCGcmState_t s, const uint8_t *key);
+
+/**
+ *  @brief Start a message
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: s == NULL or nonce == NULL or
+ *                nonce_len == 0
+ *  @note Assumes s was initialized by tc_gcm_set_key
+ *  @param s IN/OUT -- GCM state
+ *  @param nonce IN -- nonce of the message
+ *  @param nonce_len IN -- nonce length in bytes
+ */
+int tc_gcm_start(TCGcmState_t s, const uint8_t *nonce, size_t nonce_len);
+
+/**
+ *  @brief Authenticate associated data
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: s == NULL or
+ *                aad == NULL and aad_len != 0 or
+ *                data was already processed
+ *  @param s IN/OUT -- GCM state
+ *  @param aad IN -- associated data
+ *  @param aad_len IN -- associated data length in bytes
+ */
+int tc_gcm_update_aad(TCGcmState_t s, const uint8_t *aad, size_t aad_len);
+
+/**
+ *  @brief Encrypt and authenticate data
+ *  The whole input is encrypted, partial blocks are carried over to the
+ *  next call
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: s == NULL or
+ *                in == NULL or out == NULL and len != 0 or
+ *                the message would exceed TC_GCM_MAX_DATA_SIZE
+ *  @note out and in are either the same or do not overlap
+ *  @param s IN/OUT -- GCM state
+ *  @param out OUT -- len bytes of ciphertext
+ *  @param in IN -- len bytes of plaintext
+ *  @param len IN -- data length in bytes
+ */
+int tc_gcm_encrypt_update(TCGcmState_t s, uint8_t *out, const uint8_t *in,
+			  size_t len);
+
+/**
+ *  @brief Authenticate and decrypt data
+ *  As tc_gcm_encrypt_update, in being the ciphertext
+ */
+int tc_gcm_decrypt_update(TCGcmState_t s, uint8_t *out, const uint8_t *in,
+			  size_t len);
+
+/**
+ *  @brief Finish the message
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: s == NULL or tag == NULL
+ *  @param s IN/OUT -- GCM state, to be started again before reuse
+ *  @param tag OUT -- TC_GCM_TAG_SIZE byte tag, which may be truncated by the
+ *                caller
+ */
+int tc_gcm_final(TCGcmState_t s, uint8_t *tag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TC_GCM_MODE_H__ */
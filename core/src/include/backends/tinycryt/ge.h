@@ -18,6 +18,14 @@ Representations:
   ge_precomp (Duif): (y+x,y-x,2dxy)
 */
 
+/* Odd multiples A, 3A, ..., 15A used by ge_double_scalarmult_vartime() */
+#define GE_DSM_TABLE_SIZE 8
+
+/* Largest window of ge_multi_scalarmult_vartime(), 2^(w-1) buckets on the stack */
+#ifndef GE_MSM_MAX_WINDOW
+#define GE_MSM_MAX_WINDOW 6
+#endif
+
 typedef struct {
   fe X;
   fe Y;
@@ -58,6 +66,9 @@ int ge_frombytes_negate_vartime(ge_p3 *h, const unsigned char *s);
 void ge_add(ge_p1p1 *r, const ge_p3 *p, const ge_cached *q);
 void ge_sub(ge_p1p1 *r, const ge_p3 *p, const ge_cached *q);
 void ge_double_scalarmult_vartime(ge_p2 *r, const unsigned char *a, const ge_p3 *A, const unsigned char *b);
+void ge_double_scalarmult_precompute(ge_cached *Ai, const ge_p3 *A);
+void ge_double_scalarmult_vartime_cached(ge_p2 *r, const unsigned char *a, const ge_cached *Ai, const unsigned char *b);
+void ge_multi_scalarmult_vartime(ge_p3 *r, const unsigned char *a, const ge_cached *P, unsigned count);
 void ge_madd(ge_p1p1 *r, const ge_p3 *p, const ge_precomp *q);
 void ge_msub(ge_p1p1 *r, const ge_p3 *p, const ge_precomp *q);
 void ge_scalarmult_base(ge_p3 *h, const unsigned char *a);
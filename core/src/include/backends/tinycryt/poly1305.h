@@ -0,0 +1,98 @@
+/* poly1305.h - TinyCrypt interface to a Poly1305 implementation */
+
+/**
+ * @file
+ * @brief Interface to the Poly1305 one-time authenticator.
+ *
+ *  Overview:  Poly1305 (RFC 8439) evaluates the message, in 16 byte chunks,
+ *             as a polynomial at r modulo 2^130 - 5 and adds s to the result,
+ *             r and s making up its 32 byte key.
+ *
+ *  Security:  A key must only ever authenticate one message, as the
+ *             ChaCha20-Poly1305 construction does by deriving it from the
+ *             nonce.
+ *
+ *  Usage:     1) call tc_poly1305_init with the one-time key.
+ *
+ *             2) call tc_poly1305_update as many times as needed.
+ *
+ *             3) call tc_poly1305_final to get the tag.
+ */
+
+#ifndef __TC_POLY1305_H__
+#define __TC_POLY1305_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TC_POLY1305_KEY_SIZE (32)
+#define TC_POLY1305_TAG_SIZE (16)
+#define TC_POLY1305_BLOCK_SIZE (16)
+
+/*
+ * On 64-bit targets with a 128-bit product the accumulator is three 44 bit
+ * limbs instead of five 26 bit ones, define TC_POLY1305_RADIX44 to 0 to keep
+ * the 32-bit code.
+ */
+#ifndef TC_POLY1305_RADIX44
+#if defined(__SIZEOF_INT128__) && (defined(__LP64__) || defined(_LP64))
+#define TC_POLY1305_RADIX44 1
+#else
+#define TC_POLY1305_RADIX44 0
+#endif
+#endif
+
+#if TC_POLY1305_RADIX44
+typedef uint64_t tc_poly1305_limb_t;
+#define TC_POLY1305_LIMBS (3)
+#else
+typedef uint32_t tc_poly1305_limb_t;
+#define TC_POLY1305_LIMBS (5)
+#endif
+
+typedef struct tc_poly1305_state_struct {
+	tc_poly1305_limb_t r[TC_POLY1305_LIMBS];
+	tc_poly1305_limb_t h[TC_POLY1305_LIMBS];
+	uint32_t pad[4];
+	uint8_t buf[TC_POLY1305_BLOCK_SIZE];
+	unsigned int leftover;
+} *TCPoly1305State_t;
+
+/**
+ *  @brief Start a tag
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: s == NULL or key == NULL
+ *  @param s IN/OUT -- Poly1305 state to initialize
+ *  @param key IN -- TC_POLY1305_KEY_SIZE byte one-time key
+ */
+int tc_poly1305_init(TCPoly1305State_t s, const uint8_t *key);
+
+/**
+ *  @brief Authenticate data
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: s == NULL or
+ *                data == NULL and len != 0
+ *  @param s IN/OUT -- Poly1305 state
+ *  @param data IN -- message data
+ *  @param len IN -- data length in bytes
+ */
+int tc_poly1305_update(TCPoly1305State_t s, const uint8_t *data, size_t len);
+
+/**
+ *  @brief Finish the tag
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if: s == NULL or tag == NULL
+ *  @param s IN/OUT -- Poly1305 state, wiped on return
+ *  @param tag OUT -- TC_POLY1305_TAG_SIZE byte tag
+ */
+int tc_poly1305_final(TCPoly1305State_t s, uint8_t *tag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TC_POLY1305_H__ */
@@ -6,6 +6,18 @@ The set of scalars is \Z/l
 where l = 2^252 + 27742317777372353535851937790883648493.
 */
 
+/*
+On 64-bit targets with a 128-bit product the scalars are reduced in
+64 bit words, define SC_RADIX64 to 0 to keep the 21 bit limbs.
+*/
+#ifndef SC_RADIX64
+#if defined(__SIZEOF_INT128__) && (defined(__LP64__) || defined(_LP64))
+#define SC_RADIX64 1
+#else
+#define SC_RADIX64 0
+#endif
+#endif
+
 void sc_reduce(unsigned char *s);
 void sc_muladd(unsigned char *s, const unsigned char *a, const unsigned char *b, const unsigned char *c);
 
@@ -122,6 +122,32 @@ int tc_sha256_update (TCSha256State_t s, const uint8_t *data, size_t datalen);
  */
 int tc_sha256_final(uint8_t *digest, TCSha256State_t s);
 
+/*
+ * Below this many messages tc_sha256_multi hashes them one at a time, since
+ * the eight lanes of the multi-buffer path would mostly idle.
+ */
+#ifndef TC_SHA256_MULTI_MIN
+#define TC_SHA256_MULTI_MIN (4)
+#endif
+
+/**
+ *  @brief SHA256 of several independent messages
+ *  Computes digest[i] = SHA256(data[i][0 .. datalen[i] - 1]) for each i.
+ *  On x86-64 CPUs with AVX2 eight messages are hashed at once, one per
+ *  vector lane; elsewhere the messages are hashed one after another.
+ *  @return returns TC_CRYPTO_SUCCESS (1)
+ *          returns TC_CRYPTO_FAIL (0) if:
+ *                digest, data or datalen == NULL,
+ *                digest[i] == NULL or data[i] == NULL for some i
+ *  @note digest[i] points to at least TC_SHA256_DIGEST_SIZE bytes
+ *  @param digest digests, one per message
+ *  @param data messages to hash
+ *  @param datalen lengths of the messages
+ *  @param count number of messages
+ */
+int tc_sha256_multi(uint8_t * const *digest, const uint8_t * const *data,
+		    const size_t *datalen, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,6 +5,8 @@
 #define CONFIG_PSA_CRYPTO_C 1
 #define CONFIG_PSA_CRYPTO_BACKENDS_TINYCRYPT 1
 #define CONFIG_PSA_CRYPTO_EXTERNAL_RNG 1
+#define CONFIG_PSA_ECDSA_NONCE_POOL_DEPTH 4
+#define CONFIG_PSA_ED25519_BATCH_CHUNK 64
 #define CONFIG_PSA_CIPHER_ENABLE 1
 #define CONFIG_PSA_CIPHER_SUPPORT_AES 1
 #define CONFIG_PSA_CIPHER_MODE_CBC_SUPPORT 1
@@ -25,6 +27,9 @@
 #define CONFIG_APP_DEVNET_ACCESS_MQTT 1
 #define CONFIG_APP_DEVNET_ACCESS_STUDIO_TOPIC "eth_0x31c3785bebe03cc5ba691c486d6d1cdf8bb438c4_arduino_test"
 #define CONFIG_APP_DEVNET_ACCESS_STUDIO_URL "devnet-staging-mqtt.w3bstream.com"
+#define CONFIG_APP_DEVNET_ACCESS_UPLOAD_QUEUE 1
+#define CONFIG_APP_DEVNET_ACCESS_UPLOAD_QUEUE_LEN 8
+#define CONFIG_APP_DEVNET_ACCESS_COMPRESSION 1
 #define CONFIG_SUPPORT_JSON_FORMAT 1
 #define CONFIG_SUPPORT_PB_FORMAT 1
 #define CONFIG_SUPPORT_RAW_FORMAT 1
@@ -339,6 +339,18 @@
 #define IOTEX_CIPHER_PADDING_ZEROS
 #endif
 
+#ifdef CONFIG_PSA_AEAD_GCM
+#define IOTEX_GCM_C
+#endif
+
+#if defined(CONFIG_PSA_AEAD_CHACHA20_POLY1305) || defined(CONFIG_PSA_CIPHER_SUPPORT_CHACHA20)
+#define IOTEX_CHACHA20_C
+#endif
+
+#ifdef CONFIG_PSA_AEAD_CHACHA20_POLY1305
+#define IOTEX_CHACHAPOLY_C
+#endif
+
 /** \def IOTEX_CTR_DRBG_USE_128_BIT_KEY
  *
  * Uncomment this macro to use a 128-bit key in the CTR_DRBG module.
@@ -875,6 +887,26 @@
 #define IOTEX_PSA_CRYPTO_EXTERNAL_RNG
 #endif
 
+/**
+ * \def IOTEX_PSA_ECDSA_POOL_DEPTH
+ *
+ * Number of ECDSA nonces precomputed by iotex_psa_ecdsa_pool_refill(),
+ * 0 disables the pool.
+ */
+#ifdef CONFIG_PSA_ECDSA_NONCE_POOL_DEPTH
+#define IOTEX_PSA_ECDSA_POOL_DEPTH CONFIG_PSA_ECDSA_NONCE_POOL_DEPTH
+#endif
+
+/**
+ * \def ED25519_BATCH_CHUNK
+ *
+ * Signatures checked by one multi-scalar multiplication in
+ * uECC_ed25519_verify_batch(), about 400 bytes of stack each.
+ */
+#ifdef CONFIG_PSA_ED25519_BATCH_CHUNK
+#define ED25519_BATCH_CHUNK CONFIG_PSA_ED25519_BATCH_CHUNK
+#endif
+
 /**
  * \def IOTEX_PSA_CRYPTO_SPM
  *
@@ -1776,7 +1808,10 @@
  *
  * Enable the ChaCha20 stream cipher.
  *
- * Module:  library/chacha20.c
+ * Module:  crypto/chacha20.c
+ *
+ * Set from CONFIG_PSA_AEAD_CHACHA20_POLY1305 or
+ * CONFIG_PSA_CIPHER_SUPPORT_CHACHA20 above.
  */
 //#define IOTEX_CHACHA20_C
 
@@ -1785,7 +1820,9 @@
  *
  * Enable the ChaCha20-Poly1305 AEAD algorithm.
  *
- * Module:  library/chachapoly.c
+ * Module:  psa/psa_crypto_porting.c
+ *
+ * Set from CONFIG_PSA_AEAD_CHACHA20_POLY1305 above.
  *
  * This module requires: IOTEX_CHACHA20_C, IOTEX_POLY1305_C
  */
@@ -1993,13 +2030,11 @@
  *
  * Enable the Galois/Counter Mode (GCM).
  *
- * Module:  library/gcm.c
+ * Module:  crypto/gcm_mode.c
  *
- * Requires: IOTEX_CIPHER_C, IOTEX_AES_C or IOTEX_CAMELLIA_C or
- *                             IOTEX_ARIA_C
+ * Requires: IOTEX_CIPHER_C, IOTEX_AES_C
  *
- * This module enables the AES-GCM and CAMELLIA-GCM ciphersuites, if other
- * requisites are enabled as well.
+ * This module enables AES-128-GCM. Set from CONFIG_PSA_AEAD_GCM above.
  */
 //#define IOTEX_GCM_C
 
@@ -2285,8 +2320,8 @@
  *
  * Enable the Poly1305 MAC algorithm.
  *
- * Module:  library/poly1305.c
- * Caller:  library/chachapoly.c
+ * Module:  crypto/poly1305.c
+ * Caller:  psa/psa_crypto_porting.c
  */
 #define IOTEX_POLY1305_C
 
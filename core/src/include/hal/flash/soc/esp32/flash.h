@@ -7,4 +7,13 @@
 
 extern flash_drv esp32_flash;
 
+/* Data partition backing the upload spool, its size is taken from the partition table */
+#ifndef ESP32_SPOOL_PARTITION_LABEL
+#define ESP32_SPOOL_PARTITION_LABEL   "spool"
+#endif
+
+#define ESP32_SPOOL_BLOCK_SIZE        4096
+
+extern flash_drv esp32_spool_flash;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef __IOTEX_HAL_FLASH_LINUX__
+#define __IOTEX_HAL_FLASH_LINUX__
+
+#ifndef LINUX_FLASH_FILE
+#define LINUX_FLASH_FILE                "iotex_flash.bin"
+#endif
+
+#define LINUX_FLASH_START_ADDRESS       0
+
+#ifndef LINUX_FLASH_SIZE
+#define LINUX_FLASH_SIZE                (64 * 1024)
+#endif
+
+#ifndef LINUX_FLASH_BLOCK_SIZE
+#define LINUX_FLASH_BLOCK_SIZE          (4 * 1024)
+#endif
+
+extern flash_drv linux_flash;
+
+#endif
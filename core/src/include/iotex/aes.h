@@ -220,6 +220,34 @@ int iotex_aes_crypt_ecb( iotex_aes_context *ctx,
                     const unsigned char input[16],
                     unsigned char output[16] );
 
+/**
+ * \brief          This function performs AES-ECB encryption or decryption on
+ *                 several consecutive blocks, as iotex_aes_crypt_ecb() on
+ *                 each of them, so the backend can process them interleaved.
+ *
+ * \param ctx      The AES context to use for encryption or decryption.
+ *                 It must be initialized and bound to a key.
+ * \param mode     The AES operation: #IOTEX_AES_ENCRYPT or
+ *                 #IOTEX_AES_DECRYPT.
+ * \param length   The length of the input data in Bytes. This must be a
+ *                 multiple of the block size (\c 16 Bytes).
+ * \param input    The buffer holding the input data.
+ *                 It must be readable and of size \p length Bytes.
+ * \param output   The buffer where the output data will be written.
+ *                 It must be writeable and of size \p length Bytes, and
+ *                 either be \p input or not overlap it.
+ *
+ * \return         \c 0 on success.
+ * \return         #IOTEX_ERR_AES_INVALID_INPUT_LENGTH
+ *                 on failure.
+ */
+IOTEX_CHECK_RETURN_TYPICAL
+int iotex_aes_crypt_ecb_blocks( iotex_aes_context *ctx,
+                    int mode,
+                    size_t length,
+                    const unsigned char *input,
+                    unsigned char *output );
+
 #if defined(IOTEX_CIPHER_MODE_CBC)
 /**
  * \brief  This function performs an AES-CBC encryption or decryption operation
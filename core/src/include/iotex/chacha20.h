@@ -3,6 +3,8 @@
 
 #include "include/iotex/build_info.h"
 
+#include "include/backends/tinycryt/chacha20.h"
+
 #include <stdint.h>
 #include <stddef.h>
 
@@ -17,9 +19,8 @@ extern "C" {
 
 typedef struct iotex_chacha20_context
 {
-    uint32_t state[16];          /*! The state (before round operations). */
-    uint8_t  keystream8[64];     /*! Leftover keystream bytes. */
-    size_t keystream_bytes_used; /*! Number of keystream bytes already used. */
+    struct tc_chacha20_state_struct chacha20; /*! The state and leftover
+                                                  keystream bytes. */
 }
 iotex_chacha20_context;
 
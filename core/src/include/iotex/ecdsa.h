@@ -143,7 +143,7 @@ int iotex_ecdsa_sign( iotex_ecp_group *grp, iotex_mpi *r, iotex_mpi *s,
                 int (*f_rng)(void *, unsigned char *, size_t), void *p_rng );
 #else
 int iotex_ecdsa_sign( psa_key_type_t type, 
-            const uint8_t *key_buffer, size_t key_buffer_size, 
+            const uint8_t *key_buffer, size_t key_buffer_size, psa_algorithm_t alg,
             const uint8_t *hash, size_t hash_length, uint8_t *signature, size_t *signature_length );    
 #endif                
 
@@ -238,6 +238,30 @@ int iotex_ecdsa_verify( iotex_ecp_group *grp,
 int iotex_ecdsa_verify( psa_key_type_t type,
                           const uint8_t *key_buffer, size_t key_buffer_size,
                           const uint8_t *hash, size_t hash_length, uint8_t *signature, size_t signature_length );                          
+
+/* Verifies against a public point from iotex_ecp_load_public_point(). *table
+ * caches per-key data of the backend between calls, it starts out NULL and is
+ * released with iotex_ecdsa_free_point_table(). table may be NULL. */
+int iotex_ecdsa_verify_point( psa_key_type_t type, const uint8_t *point, void **table,
+                          const uint8_t *hash, size_t hash_length, const uint8_t *signature, size_t signature_length );
+void iotex_ecdsa_free_point_table( void *table );
+
+/* One signature of iotex_ecdsa_verify_point_batch(), point and table as for
+ * iotex_ecdsa_verify_point() */
+typedef struct iotex_ecdsa_batch_item
+{
+    const uint8_t *point;
+    void **table;
+    const uint8_t *hash;
+    size_t hash_length;
+    const uint8_t *signature;
+    size_t signature_length;
+    psa_status_t status;            /* OUT */
+} iotex_ecdsa_batch_item;
+
+/* Verifies count signatures on the curve family type, sharing the modular
+ * inversions between them. Every item receives its own status. */
+void iotex_ecdsa_verify_point_batch( psa_key_type_t type, iotex_ecdsa_batch_item *items, size_t count );
 #endif
 /**
  * \brief           This function computes the ECDSA signature and writes it
@@ -1272,7 +1272,16 @@ int iotex_ecp_check_pub_priv(
 int iotex_ecp_export(const iotex_ecp_keypair *key, iotex_ecp_group *grp,
                        iotex_mpi *d, iotex_ecp_point *Q);
 
-int iotex_psa_ecp_export_key_from_raw_data(psa_key_type_t type, const uint8_t *key_buffer, uint8_t *data, size_t *data_length );                       
+int iotex_psa_ecp_export_key_from_raw_data(psa_key_type_t type, const uint8_t *key_buffer, uint8_t *data, size_t *data_length );
+
+#ifndef PSA_CRYPTO_BACKENDS_MBEDTLS
+/* Derives the public point of a SECP key pair in the backend's native form, 0 on success */
+int iotex_ecp_load_public_point( psa_key_type_t type, const uint8_t *key_buffer, uint8_t *point );
+/* Loads a SECP public key, 0x04 || x || y or x || y, checking it is on the curve, 0 on success */
+int iotex_ecp_read_public_point( psa_key_type_t type, const uint8_t *data, size_t data_length, uint8_t *point );
+/* Writes a point from iotex_ecp_load_public_point() as x || y, 0 on success */
+int iotex_ecp_write_public_point( psa_key_type_t type, const uint8_t *point, uint8_t *data, size_t data_size, size_t *data_length );
+#endif                       
 
 #if defined(IOTEX_SELF_TEST)
 
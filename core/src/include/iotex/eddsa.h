@@ -16,6 +16,23 @@ int iotex_eddsa_sign( uint16_t type,
                             const uint8_t *key_buffer, size_t key_buffer_size, 
                             const uint8_t *hash, size_t hash_length, uint8_t *signature, size_t *signature_length );
 
+/* type is the whole key type, key_buffer the seed of a key pair or the encoded public key */
+int iotex_eddsa_verify( uint16_t type,
+                          const uint8_t *key_buffer, size_t key_buffer_size,
+                          const uint8_t *hash, size_t hash_length, uint8_t *signature, size_t signature_length );
+
+/* Key context kept in the key slot: the expanded seed, the public key and the
+ * multiples of the decoded public point. NULL if the key is not Ed25519, is
+ * malformed or there is no memory; release it with iotex_eddsa_key_free(). */
+void *iotex_eddsa_key_load( uint16_t type, const uint8_t *key_buffer, size_t key_buffer_size );
+void iotex_eddsa_key_free( void *key );
+
+/* Pure EdDSA with a context from iotex_eddsa_key_load(), PSA status codes */
+int iotex_eddsa_sign_key( const void *key, const uint8_t *input, size_t input_length,
+                          uint8_t *signature, size_t signature_size, size_t *signature_length );
+int iotex_eddsa_verify_key( const void *key, const uint8_t *input, size_t input_length,
+                            const uint8_t *signature, size_t signature_length );
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,6 +5,8 @@
 
 #include "include/iotex/cipher.h"
 
+#include "include/backends/tinycryt/gcm_mode.h"
+
 #include <stdint.h>
 
 #define IOTEX_GCM_ENCRYPT     1
@@ -28,14 +30,8 @@ extern "C" {
  */
 typedef struct iotex_gcm_context
 {
-    iotex_cipher_context_t cipher_ctx;  /*!< The cipher context used. */
-    uint64_t HL[16];                      /*!< Precalculated HTable low. */
-    uint64_t HH[16];                      /*!< Precalculated HTable high. */
-    uint64_t len;                         /*!< The total length of the encrypted data. */
-    uint64_t add_len;                     /*!< The total length of the additional data. */
-    unsigned char base_ectr[16];          /*!< The first ECTR for tag. */
-    unsigned char y[16];                  /*!< The Y working value. */
-    unsigned char buf[16];                /*!< The buf working value. */
+    struct tc_gcm_state_struct gcm;       /*!< The key schedule, GHASH table
+                                               and message state. */
     int mode;                             /*!< The operation to perform:
                                                #IOTEX_GCM_ENCRYPT or
                                                #IOTEX_GCM_DECRYPT. */
@@ -67,13 +63,11 @@ void iotex_gcm_init( iotex_gcm_context *ctx );
  * \param cipher    The 128-bit block cipher to use.
  * \param key       The encryption key. This must be a readable buffer of at
  *                  least \p keybits bits.
- * \param keybits   The key size in bits. Valid options are:
- *                  <ul><li>128 bits</li>
- *                  <li>192 bits</li>
- *                  <li>256 bits</li></ul>
+ * \param keybits   The key size in bits. Only AES with 128 bits is
+ *                  implemented.
  *
  * \return          \c 0 on success.
- * \return          A cipher-specific error code on failure.
+ * \return          #IOTEX_ERR_GCM_BAD_INPUT for other ciphers or key sizes.
  */
 int iotex_gcm_setkey( iotex_gcm_context *ctx,
                         iotex_cipher_id_t cipher,
@@ -3,6 +3,8 @@
 
 #include "include/iotex/build_info.h"
 
+#include "include/backends/tinycryt/poly1305.h"
+
 #include <stdint.h>
 #include <stddef.h>
 
@@ -17,11 +19,8 @@ extern "C" {
 
 typedef struct iotex_poly1305_context
 {
-    uint32_t r[4];      /** The value for 'r' (low 128 bits of the key). */
-    uint32_t s[4];      /** The value for 's' (high 128 bits of the key). */
-    uint32_t acc[5];    /** The accumulator number. */
-    uint8_t queue[16];  /** The current partial block of data. */
-    size_t queue_len;   /** The number of bytes stored in 'queue'. */
+    struct tc_poly1305_state_struct poly1305; /** r, s, the accumulator and
+                                                  the current partial block. */
 }
 iotex_poly1305_context;
 
@@ -155,6 +155,28 @@ int iotex_sha256( const unsigned char *input,
                     unsigned char *output,
                     int is224 );
 
+/**
+ * \brief          This function calculates the SHA-256 checksums of
+ *                 \p count independent buffers.
+ *
+ *                 Where the backend supports it, several buffers are
+ *                 hashed at once in the lanes of a vector unit.
+ *
+ * \param input    The buffers holding the data, \p input[i] must be a
+ *                 readable buffer of length \p ilen[i] Bytes.
+ * \param ilen     The lengths of the input buffers in Bytes.
+ * \param output   The SHA-256 checksum results, each a writable buffer
+ *                 of length \c 32 bytes.
+ * \param count    The number of buffers.
+ *
+ * \return         \c 0 on success.
+ * \return         A negative error code on failure.
+ */
+int iotex_sha256_multi( const unsigned char * const *input,
+                          const size_t *ilen,
+                          unsigned char * const *output,
+                          size_t count );
+
 #ifdef __cplusplus
 }
 #endif
@@ -1498,9 +1498,21 @@
 #define PSA_ALG_DETERMINISTIC_ECDSA(hash_alg)                           \
     (PSA_ALG_DETERMINISTIC_ECDSA_BASE | ((hash_alg) & PSA_ALG_HASH_MASK))
 #define PSA_ALG_ECDSA_DETERMINISTIC_FLAG        ((psa_algorithm_t)0x00000100)
+/** Implementation-specific flag that makes an ECDSA algorithm output the
+ * canonical low-S signature, with \c s no larger than half the curve order,
+ * as Ethereum-style verifiers require.
+ *
+ * Only the signer is affected: both forms remain valid signatures, and a key
+ * whose policy permits an ECDSA algorithm permits its low-S variant too.
+ */
+#define PSA_ALG_ECDSA_LOW_S_FLAG                ((psa_algorithm_t)0x00010000)
+#define PSA_ALG_ECDSA_LOW_S(ecdsa_alg)                                  \
+    ((ecdsa_alg) | PSA_ALG_ECDSA_LOW_S_FLAG)
+#define PSA_ALG_ECDSA_IS_LOW_S(alg)                                     \
+    (((alg) & PSA_ALG_ECDSA_LOW_S_FLAG) != 0)
 #define PSA_ALG_IS_ECDSA(alg)                                           \
-    (((alg) & ~PSA_ALG_HASH_MASK & ~PSA_ALG_ECDSA_DETERMINISTIC_FLAG) ==  \
-     PSA_ALG_ECDSA_BASE)
+    (((alg) & ~PSA_ALG_HASH_MASK & ~PSA_ALG_ECDSA_DETERMINISTIC_FLAG &  \
+      ~PSA_ALG_ECDSA_LOW_S_FLAG) == PSA_ALG_ECDSA_BASE)
 #define PSA_ALG_ECDSA_IS_DETERMINISTIC(alg)             \
     (((alg) & PSA_ALG_ECDSA_DETERMINISTIC_FLAG) != 0)
 #define PSA_ALG_IS_DETERMINISTIC_ECDSA(alg)                             \
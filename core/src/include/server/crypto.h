@@ -2904,6 +2904,40 @@ psa_status_t psa_verify_message( psa_key_id_t key,
                                  const uint8_t * signature,
                                  size_t signature_length );
 
+/**
+ * \brief Verify a batch of signatures with public keys, starting from the
+ *        messages.
+ *
+ * Every signature is checked as psa_verify_message() would check it, ECDSA
+ * signatures share their modular inversions as in psa_verify_hash_batch().
+ *
+ * \param[in] key               Identifiers of the keys to use, \p count of
+ *                              them, as for psa_verify_message().
+ * \param alg                   A signature algorithm that is compatible with
+ *                              the type of every key.
+ * \param[in] input             The \p count messages whose signature is to
+ *                              be verified.
+ * \param[in] input_length      Size of every \p input buffer in bytes.
+ * \param[in] signature         The \p count signatures to verify.
+ * \param[in] signature_length  Size of every \p signature buffer in bytes.
+ * \param count                 Number of signatures.
+ * \param[out] status           On return, \p count statuses, the result
+ *                              psa_verify_message() would give for each
+ *                              signature.
+ *
+ * \retval #PSA_SUCCESS
+ *         Every signature is valid.
+ * \return The first status in \p status that is not #PSA_SUCCESS.
+ */
+psa_status_t psa_verify_message_batch(const psa_key_id_t *key,
+                                      psa_algorithm_t alg,
+                                      const uint8_t * const *input,
+                                      const size_t *input_length,
+                                      const uint8_t * const *signature,
+                                      const size_t *signature_length,
+                                      size_t count,
+                                      psa_status_t *status);
+
 /**
  * \brief Sign a hash or short message with a private key.
  *
@@ -3008,6 +3042,42 @@ psa_status_t psa_verify_hash(psa_key_id_t key,
                              const uint8_t *signature,
                              size_t signature_length);
 
+/**
+ * \brief Verify a batch of signatures with public keys, starting from the
+ *        hashes.
+ *
+ * Every signature is checked as psa_verify_hash() would check it. ECDSA
+ * signatures are verified together, sharing the modular inversions of the
+ * curve arithmetic, which makes a batch cheaper than the same number of
+ * psa_verify_hash() calls. The keys may differ and be on different curves.
+ *
+ * \param[in] key               Identifiers of the keys to use, \p count of
+ *                              them, as for psa_verify_hash().
+ * \param alg                   A signature algorithm that is compatible with
+ *                              the type of every key.
+ * \param[in] hash              The \p count hashes whose signature is to be
+ *                              verified.
+ * \param[in] hash_length       Size of every \p hash buffer in bytes.
+ * \param[in] signature         The \p count signatures to verify.
+ * \param[in] signature_length  Size of every \p signature buffer in bytes.
+ * \param count                 Number of signatures.
+ * \param[out] status           On return, \p count statuses, the result
+ *                              psa_verify_hash() would give for each
+ *                              signature.
+ *
+ * \retval #PSA_SUCCESS
+ *         Every signature is valid.
+ * \return The first status in \p status that is not #PSA_SUCCESS.
+ */
+psa_status_t psa_verify_hash_batch(const psa_key_id_t *key,
+                                   psa_algorithm_t alg,
+                                   const uint8_t * const *hash,
+                                   const size_t *hash_length,
+                                   const uint8_t * const *signature,
+                                   const size_t *signature_length,
+                                   size_t count,
+                                   psa_status_t *status);
+
 /**
  * \brief Encrypt a short message with a public key.
  *
@@ -4013,6 +4083,34 @@ void iotex_psa_set_timestamp(iotex_psa_get_ts_func func);
 void iotex_psa_set_personalstring(uint8_t *string, size_t string_len);
 void iotex_psa_set_entroy_inject_func(iotex_psa_entroy_inject entroy_inject);
 
+/** Counters of the ECDSA nonce pool */
+typedef struct iotex_psa_ecdsa_pool_stats
+{
+    uint32_t hits;          /* signatures that used a precomputed nonce */
+    uint32_t misses;        /* signatures that computed their nonce */
+    uint32_t precomputed;   /* nonces computed by iotex_psa_ecdsa_pool_refill() */
+    uint32_t ready;         /* nonces waiting in the pool */
+} iotex_psa_ecdsa_pool_stats_t;
+
+/* ECDSA signing is split in an offline part, the nonce k with r = x(kG) and
+ * 1/k, and an online part of a few modular multiplications. The pool keeps up
+ * to IOTEX_PSA_ECDSA_POOL_DEPTH nonces for one curve, and psa_sign_hash() and
+ * psa_sign_message() take one when it matches the key.
+ *
+ * family is the curve to fill the pool for, 0 to follow the last ECDSA key
+ * used. target is the number of nonces to keep ready, per_refill the most a
+ * single iotex_psa_ecdsa_pool_refill() computes, to bound its latency. */
+void iotex_psa_ecdsa_pool_config( psa_ecc_family_t family, size_t target, size_t per_refill );
+
+/* Tops the pool up, to be called while idle: from iotex_dev_access_loop() or
+ * a low-priority task. Returns the number of nonces computed. */
+size_t iotex_psa_ecdsa_pool_refill( void );
+
+void iotex_psa_ecdsa_pool_get_stats( iotex_psa_ecdsa_pool_stats_t *stats );
+
+/* Wipes every precomputed nonce */
+void iotex_psa_ecdsa_pool_clear( void );
+
 
 #ifdef __cplusplus
 }
@@ -25,6 +25,11 @@ static inline int iotex_psa_safer_memcmp(
     return( diff );
 }
 
+#ifndef PSA_CRYPTO_BACKENDS_MBEDTLS
+/* Room for x and y of a 256-bit curve */
+#define PSA_KEY_SLOT_PUBLIC_POINT_SIZE  64
+#endif
+
 /** The data structure representing a key slot, containing key material
  * and metadata for one key.
  */
@@ -64,6 +69,26 @@ typedef struct
         uint8_t *data;
         size_t bytes;
     } key;
+
+#if defined(PSA_KEY_SLOT_PUBLIC_POINT_SIZE)
+    /* Public point of a SECP key, derived or parsed once when the key is
+     * created or loaded so that verify and export skip the scalar
+     * multiplication. Opaque here, it holds the ECC backend's native words
+     * as written by iotex_ecp_load_public_point() for a key pair or
+     * iotex_ecp_read_public_point() for a public key. table is the backend's
+     * verification cache for the key, allocated on the first verification.
+     * For an Ed25519 key ed25519 is the context of iotex_eddsa_key_load()
+     * instead, built with the slot so that sign and verify neither expand
+     * the seed nor decode the public point again.
+     * All are released with the slot. */
+    struct key_public
+    {
+        uint8_t point[PSA_KEY_SLOT_PUBLIC_POINT_SIZE];
+        uint8_t valid;
+        void *table;
+        void *ed25519;
+    } pub;
+#endif
 } psa_key_slot_t;
 
 /* A mask of key attribute flags used only internally.
@@ -214,6 +239,17 @@ psa_status_t psa_copy_key_material_into_slot( psa_key_slot_t *slot,
                                               const uint8_t *data,
                                               size_t data_length );
 
+/** Derive and cache the public point of the SECP key pair or public key in
+ * a slot.
+ *
+ * Does nothing for other key types or if the backend has no cache. A failure,
+ * such as a public key that is not on the curve, only leaves the cache empty,
+ * users then work from the key material.
+ *
+ * \param[in,out] slot          Key slot holding the key material.
+ */
+void psa_key_slot_cache_public_point( psa_key_slot_t *slot );
+
 /** Convert an mbed TLS error code to a PSA error code
  *
  * \note This function is provided solely for the convenience of
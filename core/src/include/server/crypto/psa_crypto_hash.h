@@ -48,6 +48,45 @@ psa_status_t iotex_psa_hash_compute(
     size_t hash_size,
     size_t *hash_length);
 
+/** Calculate the hashes of several independent messages with Mbed TLS
+ *  routines.
+ *
+ * SHA-256 messages are handed to the backend together, which hashes several
+ * of them at once where the CPU has the vector units for it. Other
+ * algorithms are computed one message after another.
+ *
+ * \param alg               The hash algorithm to compute
+ *                          (\c PSA_ALG_XXX value such that
+ *                          #PSA_ALG_IS_HASH(\p alg) is true).
+ * \param[in] input         The messages to hash.
+ * \param input_length      The sizes of the messages in bytes.
+ * \param[out] hash         The buffers where the hashes are written,
+ *                          one per message.
+ * \param hash_size         Size of each \p hash buffer in bytes.
+ * \param[out] hash_length  On success, the number of bytes that make up
+ *                          each hash value.
+ * \param count             The number of messages.
+ *
+ * \retval #PSA_SUCCESS
+ *         Success.
+ * \retval #PSA_ERROR_NOT_SUPPORTED
+ *         \p alg is not supported
+ * \retval #PSA_ERROR_BUFFER_TOO_SMALL
+ *         \p hash_size is too small
+ * \retval #PSA_ERROR_INVALID_ARGUMENT
+ *         One of the buffers is \c NULL
+ * \retval #PSA_ERROR_INSUFFICIENT_MEMORY
+ * \retval #PSA_ERROR_CORRUPTION_DETECTED
+ */
+psa_status_t iotex_psa_hash_compute_multi(
+    psa_algorithm_t alg,
+    const uint8_t * const *input,
+    const size_t *input_length,
+    uint8_t * const *hash,
+    size_t hash_size,
+    size_t *hash_length,
+    size_t count );
+
 /** Set up a multipart hash operation using Mbed TLS routines.
  *
  * \note The signature of this function is that of a PSA driver hash_setup
@@ -0,0 +1,70 @@
+#ifndef __IOTEX_JSON_WRITER_H__
+#define __IOTEX_JSON_WRITER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "include/backends/tinycryt/sha256.h"
+
+#define IOTEX_JSON_WRITER_ERR_SUCCESS           0
+#define IOTEX_JSON_WRITER_ERR_BAD_INPUT         -0x01
+#define IOTEX_JSON_WRITER_ERR_BUFFER_FULL       -0x02
+#define IOTEX_JSON_WRITER_ERR_BAD_STATE         -0x03
+
+#define IOTEX_JSON_WRITER_MAX_DEPTH             32
+
+/*
+ * Tree-free JSON writer for fixed-shape telemetry. Values are printed
+ * straight into the caller's buffer in the same compact format as
+ * cJSON_PrintUnformatted(), except that negative zero prints as 0 where
+ * cJSON prints -0, and optionally fed into a running SHA-256 so the result
+ * can be signed without a second pass.
+ *
+ * Errors are sticky: after the first failure every call returns it again
+ * and iotex_json_writer_finish() reports it.
+ */
+typedef struct iotex_json_writer {
+
+    char    *buf;
+    size_t   size;
+    size_t   len;
+
+    uint32_t nonempty;          /* bit n set: level n already holds a member */
+    uint32_t is_object;         /* bit n set: level n is an object */
+    uint8_t  depth;
+    uint8_t  after_key;
+
+    int      error;
+
+    struct tc_sha256_state_struct *sha;
+
+}iotex_json_writer_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void iotex_json_writer_init(iotex_json_writer_t *writer, char *buf, size_t size, struct tc_sha256_state_struct *sha);
+
+int iotex_json_begin_object(iotex_json_writer_t *writer);
+int iotex_json_end_object(iotex_json_writer_t *writer);
+int iotex_json_begin_array(iotex_json_writer_t *writer);
+int iotex_json_end_array(iotex_json_writer_t *writer);
+
+int iotex_json_key(iotex_json_writer_t *writer, const char *key);
+
+int iotex_json_string(iotex_json_writer_t *writer, const char *str);
+int iotex_json_number(iotex_json_writer_t *writer, double number);
+int iotex_json_int(iotex_json_writer_t *writer, int64_t number);
+int iotex_json_bool(iotex_json_writer_t *writer, bool value);
+int iotex_json_null(iotex_json_writer_t *writer);
+
+/* Returns the document length, or a negative error if it is incomplete or did not fit */
+int iotex_json_writer_finish(iotex_json_writer_t *writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IOTEX_JSON_WRITER_H__ */
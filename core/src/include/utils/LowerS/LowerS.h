@@ -1,15 +0,0 @@
-#ifndef __IOTEX_LOWERS_H__
-#define __IOTEX_LOWERS_H__
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-void InitLowsCalc(void);
-void LowsCalc(char *s, char *out);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* __IOTEX_LOWERS_H__ */
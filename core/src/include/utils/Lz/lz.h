@@ -0,0 +1,50 @@
+#ifndef __IOTEX_LZ_H__
+#define __IOTEX_LZ_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define IOTEX_LZ_ERR_SUCCESS            0
+#define IOTEX_LZ_ERR_BAD_INPUT          -0x01
+#define IOTEX_LZ_ERR_OUTPUT_FULL        -0x02
+#define IOTEX_LZ_ERR_CORRUPT            -0x03
+
+/* Hash table of 2^IOTEX_LZ_HASH_LOG 16-bit positions, supplied by the caller */
+#ifndef IOTEX_LZ_HASH_LOG
+#define IOTEX_LZ_HASH_LOG               9
+#endif
+#define IOTEX_LZ_HASH_SIZE              (1 << IOTEX_LZ_HASH_LOG)
+
+/* Largest match distance the compressor emits, at most 65535 */
+#ifndef IOTEX_LZ_WINDOW
+#define IOTEX_LZ_WINDOW                 4096
+#endif
+
+/* Largest input accepted by iotex_lz_compress() */
+#define IOTEX_LZ_MAX_INPUT              0xFFFF
+
+/* Worst-case output size for an input of n bytes */
+#define IOTEX_LZ_BOUND(n)               ((n) + (n) / 255 + 16)
+
+/*
+ * Small-footprint LZ77 compressor producing the LZ4 block format, so the
+ * backend can decode it with any stock LZ4 library. It keeps no state besides
+ * the caller's hash table and never looks further back than IOTEX_LZ_WINDOW
+ * bytes. The block does not carry the uncompressed size, the caller frames it.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returns the compressed length, or IOTEX_LZ_ERR_OUTPUT_FULL if it does not fit in dst_size */
+int iotex_lz_compress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_size, uint16_t table[IOTEX_LZ_HASH_SIZE]);
+
+/* Returns the decompressed length, or a negative error for a malformed block */
+int iotex_lz_decompress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IOTEX_LZ_H__ */
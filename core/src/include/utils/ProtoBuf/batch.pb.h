@@ -0,0 +1,76 @@
+/* Automatically generated nanopb header */
+/* Generated by nanopb-0.4.7 */
+
+#ifndef PB_BATCH_PB_H_INCLUDED
+#define PB_BATCH_PB_H_INCLUDED
+#include "include/utils/ProtoBuf/pb.h"
+
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+/* Struct definitions */
+typedef struct _BatchRecord {
+    uint32_t index;
+    pb_callback_t data;
+    pb_callback_t proof;
+} BatchRecord;
+
+typedef PB_BYTES_ARRAY_T(32) Batch_root_t;
+typedef struct _Batch {
+    uint32_t count;
+    Batch_root_t root;
+    pb_callback_t records;
+} Batch;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Initializer values for message structs */
+#define BatchRecord_init_default                 {0, {{NULL}, NULL}, {{NULL}, NULL}}
+#define Batch_init_default                       {0, {0, {0}}, {{NULL}, NULL}}
+#define BatchRecord_init_zero                    {0, {{NULL}, NULL}, {{NULL}, NULL}}
+#define Batch_init_zero                          {0, {0, {0}}, {{NULL}, NULL}}
+
+/* Field tags (for use in manual encoding/decoding) */
+#define BatchRecord_index_tag                    1
+#define BatchRecord_data_tag                     2
+#define BatchRecord_proof_tag                    3
+#define Batch_count_tag                          1
+#define Batch_root_tag                           2
+#define Batch_records_tag                        3
+
+/* Struct field encoding specification for nanopb */
+#define BatchRecord_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   index,             1) \
+X(a, CALLBACK, SINGULAR, BYTES,    data,              2) \
+X(a, CALLBACK, SINGULAR, BYTES,    proof,             3)
+#define BatchRecord_CALLBACK pb_default_field_callback
+#define BatchRecord_DEFAULT NULL
+
+#define Batch_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   count,             1) \
+X(a, STATIC,   SINGULAR, BYTES,    root,              2) \
+X(a, CALLBACK, REPEATED, MESSAGE,  records,           3)
+#define Batch_CALLBACK pb_default_field_callback
+#define Batch_DEFAULT NULL
+#define Batch_records_MSGTYPE BatchRecord
+
+extern const pb_msgdesc_t BatchRecord_msg;
+extern const pb_msgdesc_t Batch_msg;
+
+/* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define BatchRecord_fields &BatchRecord_msg
+#define Batch_fields &Batch_msg
+
+/* Maximum encoded size of messages (where known) */
+/* BatchRecord_size depends on runtime parameters */
+/* Batch_size depends on runtime parameters */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,63 @@
+/* Automatically generated nanopb header */
+/* Generated by nanopb-0.4.7 */
+
+#ifndef PB_CHUNK_PB_H_INCLUDED
+#define PB_CHUNK_PB_H_INCLUDED
+#include "include/utils/ProtoBuf/pb.h"
+
+#if PB_PROTO_HEADER_VERSION != 40
+#error Regenerate this file with the current version of nanopb generator.
+#endif
+
+/* Struct definitions */
+typedef PB_BYTES_ARRAY_T(32) Chunk_digest_t;
+typedef struct _Chunk {
+    uint32_t session;
+    uint32_t seq;
+    uint32_t offset;
+    uint32_t total;
+    pb_callback_t data;
+    Chunk_digest_t digest;
+} Chunk;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Initializer values for message structs */
+#define Chunk_init_default                       {0, 0, 0, 0, {{NULL}, NULL}, {0, {0}}}
+#define Chunk_init_zero                          {0, 0, 0, 0, {{NULL}, NULL}, {0, {0}}}
+
+/* Field tags (for use in manual encoding/decoding) */
+#define Chunk_session_tag                        1
+#define Chunk_seq_tag                            2
+#define Chunk_offset_tag                         3
+#define Chunk_total_tag                          4
+#define Chunk_data_tag                           5
+#define Chunk_digest_tag                         6
+
+/* Struct field encoding specification for nanopb */
+#define Chunk_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   session,           1) \
+X(a, STATIC,   SINGULAR, UINT32,   seq,               2) \
+X(a, STATIC,   SINGULAR, UINT32,   offset,            3) \
+X(a, STATIC,   SINGULAR, UINT32,   total,             4) \
+X(a, CALLBACK, SINGULAR, BYTES,    data,              5) \
+X(a, STATIC,   SINGULAR, BYTES,    digest,            6)
+#define Chunk_CALLBACK pb_default_field_callback
+#define Chunk_DEFAULT NULL
+
+extern const pb_msgdesc_t Chunk_msg;
+
+/* Defines for backwards compatibility with code written before nanopb-0.4.0 */
+#define Chunk_fields &Chunk_msg
+
+/* Maximum encoded size of messages (where known) */
+/* Chunk_size depends on runtime parameters */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
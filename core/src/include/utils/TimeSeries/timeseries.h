@@ -0,0 +1,107 @@
+#ifndef __IOTEX_TIMESERIES_H__
+#define __IOTEX_TIMESERIES_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define IOTEX_TS_ERR_SUCCESS            0
+#define IOTEX_TS_ERR_BAD_INPUT          -0x01
+#define IOTEX_TS_ERR_BUFFER_FULL        -0x02
+#define IOTEX_TS_ERR_CORRUPT            -0x03
+#define IOTEX_TS_ERR_END                -0x04
+
+#define IOTEX_TS_VERSION                1
+
+#ifndef IOTEX_TS_MAX_CHANNELS
+#define IOTEX_TS_MAX_CHANNELS           8
+#endif
+
+/* Largest fixed-point scale, 10^IOTEX_TS_MAX_DECIMALS */
+#define IOTEX_TS_MAX_DECIMALS           9
+
+/* version, channels, count, t0, decimals and one length per column, all varints at their widest */
+#define IOTEX_TS_HEADER_MAX_SIZE        (2 + 5 + 10 + IOTEX_TS_MAX_CHANNELS + (IOTEX_TS_MAX_CHANNELS + 1) * 5)
+
+/*
+ * Columnar encoding of periodic samples, one timestamp and up to
+ * IOTEX_TS_MAX_CHANNELS values each:
+ *
+ *   header   version, channels, count, t0, decimals[channels],
+ *            byte length of every column
+ *   column 0 timestamps after t0 as zig-zag delta-of-delta, the first
+ *            delta is taken against 0
+ *   column n channel n-1 as zig-zag deltas of round(value * 10^decimals),
+ *            the first value is taken against 0
+ *
+ * Every field is a LEB128 varint except version, channels and decimals, which
+ * are single bytes. A fixed upload cadence costs one byte per timestamp and a
+ * slowly changing reading one or two bytes per value.
+ *
+ * The builder grows every column in its own region of the caller's buffer.
+ * When a region fills, the free space is shared out again between all
+ * columns, so appending a sample is amortized O(1). iotex_ts_builder_finish()
+ * then packs the columns and writes the header in front of them, in place.
+ */
+typedef struct iotex_ts_builder {
+
+    uint8_t *buf;
+    size_t   size;
+
+    uint8_t  channels;
+    uint8_t  decimals[IOTEX_TS_MAX_CHANNELS];
+    double   scale[IOTEX_TS_MAX_CHANNELS];
+
+    size_t   col_start[IOTEX_TS_MAX_CHANNELS + 1];
+    size_t   col_len[IOTEX_TS_MAX_CHANNELS + 1];
+
+    uint32_t count;
+    uint64_t t0;
+    uint64_t prev_ts;
+    int64_t  prev_delta;
+    int64_t  prev_value[IOTEX_TS_MAX_CHANNELS];
+
+    int      finished;
+
+}iotex_ts_builder_t;
+
+typedef struct iotex_ts_decoder {
+
+    uint8_t  channels;
+    uint8_t  decimals[IOTEX_TS_MAX_CHANNELS];
+    double   scale[IOTEX_TS_MAX_CHANNELS];
+
+    uint32_t count;
+    uint32_t index;
+
+    const uint8_t *col[IOTEX_TS_MAX_CHANNELS + 1];
+    const uint8_t *col_end[IOTEX_TS_MAX_CHANNELS + 1];
+
+    uint64_t prev_ts;
+    int64_t  prev_delta;
+    int64_t  prev_value[IOTEX_TS_MAX_CHANNELS];
+
+}iotex_ts_decoder_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* decimals may be NULL for integer channels */
+int iotex_ts_builder_init(iotex_ts_builder_t *builder, uint8_t *buf, size_t size, uint8_t channels, const uint8_t *decimals);
+
+/* Appends one sample of builder->channels values, a sample that does not fit leaves the builder unchanged */
+int iotex_ts_builder_append(iotex_ts_builder_t *builder, uint64_t timestamp, const double *values);
+
+/* Returns the encoded length at builder->buf, no more samples can be appended afterwards */
+int iotex_ts_builder_finish(iotex_ts_builder_t *builder);
+
+int iotex_ts_decoder_init(iotex_ts_decoder_t *decoder, const uint8_t *buf, size_t len);
+
+/* Returns IOTEX_TS_ERR_END once every sample has been read */
+int iotex_ts_decoder_next(iotex_ts_decoder_t *decoder, uint64_t *timestamp, double *values);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IOTEX_TIMESERIES_H__ */
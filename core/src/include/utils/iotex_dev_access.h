@@ -6,13 +6,25 @@
 #include <stddef.h>
 #include <time.h>
 
+#include "include/iotex/build_info.h"
 #include "include/utils/cJSON/cJSON.h"
+#include "include/utils/JsonWriter/json_writer.h"
+#include "include/utils/TimeSeries/timeseries.h"
 #include "include/utils/base64/base64.h"
 #include "include/utils/keccak256/keccak256.h"
 #include "include/utils/ProtoBuf/pb_common.h"
 #include "include/utils/ProtoBuf/pb_decode.h"
 #include "include/utils/ProtoBuf/pb_encode.h"
 #include "include/utils/ProtoBuf/devnet_upload.pb.h"
+#include "include/backends/tinycryt/sha256.h"
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_SPOOL
+#include "include/utils/iotex_spool.h"
+#endif
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_COMPRESSION
+#include "include/utils/Lz/lz.h"
+#endif
 
 
 #define IOTEX_KEEP_ALIVE                        60
@@ -36,6 +48,9 @@
 #define IOTEX_DEV_ACCESS_ERR_MQTT_SUB_FUNC_EMPTY   	-0x103
 
 #define IOTEX_DEV_ACCESS_ERR_JSON_FAIL				-0x200
+#define IOTEX_DEV_ACCESS_ERR_COMPRESS_FAIL			-0x201
+
+#define IOTEX_DEV_ACCESS_ERR_QUEUE_FULL				-0x300
 
 #define IOTEX_DEVICE_ID_LEN                     15
 
@@ -48,6 +63,72 @@
 #define IOTEX_DEV_REG_DEBUG_ENABLE              1
 #define IOTEX_DEV_REG_DEBUG_DISABLE             0
 
+/* Largest user field the arena buffer can encode, streaming transports are not limited */
+#ifndef IOTEX_DEV_ACCESS_USER_DATA_SIZE
+#define IOTEX_DEV_ACCESS_USER_DATA_SIZE         320
+#endif
+
+#ifndef IOTEX_DEV_ACCESS_BATCH_MAX_RECORDS
+#define IOTEX_DEV_ACCESS_BATCH_MAX_RECORDS      8
+#endif
+
+/* Sibling hashes in the inclusion proof of one record of a full batch, ceil(log2(records)) */
+#define IOTEX_DEV_ACCESS_BATCH_PROOF_HASHES(n)  ((n) <= 1 ? 0 : (n) <= 2 ? 1 : (n) <= 4 ? 2 : (n) <= 8 ? 3 : \
+                                                 (n) <= 16 ? 4 : (n) <= 32 ? 5 : (n) <= 64 ? 6 : (n) <= 128 ? 7 : \
+                                                 (n) <= 256 ? 8 : 16)
+
+/* BatchRecord framing, index and proof of one record, its data aside */
+#define IOTEX_DEV_ACCESS_BATCH_RECORD_OVERHEAD  (15 + 32 * IOTEX_DEV_ACCESS_BATCH_PROOF_HASHES(IOTEX_DEV_ACCESS_BATCH_MAX_RECORDS))
+
+/*
+ * Largest Upload produced with a IOTEX_DEV_ACCESS_USER_DATA_SIZE user field, see
+ * devnet_upload.proto, plus the framing of a full batch. A batch of
+ * IOTEX_DEV_ACCESS_BATCH_MAX_RECORDS records fits as long as their data adds up
+ * to no more than IOTEX_DEV_ACCESS_USER_DATA_SIZE bytes.
+ */
+#ifndef IOTEX_DEV_ACCESS_ENCODE_ARENA_SIZE
+#define IOTEX_DEV_ACCESS_ENCODE_ARENA_SIZE      (854 + IOTEX_DEV_ACCESS_BATCH_MAX_RECORDS * IOTEX_DEV_ACCESS_BATCH_RECORD_OVERHEAD)
+#endif
+
+#ifndef IOTEX_DEV_ACCESS_JSON_BUF_SIZE
+#define IOTEX_DEV_ACCESS_JSON_BUF_SIZE          320
+#endif
+
+/* Printed JSON accepted by the compressed upload types, before compression */
+#ifndef IOTEX_DEV_ACCESS_LZ_INPUT_SIZE
+#define IOTEX_DEV_ACCESS_LZ_INPUT_SIZE          1024
+#endif
+
+/* User data carried by one fragment of a chunked upload */
+#ifndef IOTEX_DEV_ACCESS_CHUNK_SIZE
+#define IOTEX_DEV_ACCESS_CHUNK_SIZE             512
+#endif
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_UPLOAD_QUEUE_LEN
+#define IOTEX_DEV_ACCESS_QUEUE_LEN              CONFIG_APP_DEVNET_ACCESS_UPLOAD_QUEUE_LEN
+#endif
+
+/* Must be a power of two */
+#ifndef IOTEX_DEV_ACCESS_QUEUE_LEN
+#define IOTEX_DEV_ACCESS_QUEUE_LEN              8
+#endif
+
+#ifndef IOTEX_DEV_ACCESS_QUEUE_RECORD_SIZE
+#define IOTEX_DEV_ACCESS_QUEUE_RECORD_SIZE      IOTEX_DEV_ACCESS_JSON_BUF_SIZE
+#endif
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_SPOOL_REPLAY_RATE
+#define IOTEX_DEV_ACCESS_SPOOL_REPLAY_RATE      CONFIG_APP_DEVNET_ACCESS_SPOOL_REPLAY_RATE
+#endif
+
+/* Spooled uploads replayed per second once the link is back, bursts up to one second's worth */
+#ifndef IOTEX_DEV_ACCESS_SPOOL_REPLAY_RATE
+#define IOTEX_DEV_ACCESS_SPOOL_REPLAY_RATE      10
+#endif
+
+/* Sum of ceil(n / 2^k) over all tree levels, bounded by 2n + log2(n) */
+#define IOTEX_DEV_ACCESS_BATCH_TREE_NODES       (2 * IOTEX_DEV_ACCESS_BATCH_MAX_RECORDS + 16)
+
 #define DEFAULT_CHANNEL  8183
 #define DEFAULT_UPLOAD_PERIOD   300
 
@@ -77,13 +158,43 @@ enum MQTT_PUB_TOPIC{
 enum UserData_Type {
     IOTEX_USER_DATA_TYPE_JSON = 0,
 	IOTEX_USER_DATA_TYPE_PB,
-	IOTEX_USER_DATA_TYPE_RAW
+	IOTEX_USER_DATA_TYPE_RAW,
+	IOTEX_USER_DATA_TYPE_JSON_LZ4,		/* as above, LZ4 compressed before signing */
+	IOTEX_USER_DATA_TYPE_PB_LZ4,
+	IOTEX_USER_DATA_TYPE_RAW_LZ4,
+	IOTEX_USER_DATA_TYPE_TIMESERIES		/* encoded by iotex_ts_builder_finish(), see timeseries.h */
+};
+
+#define IOTEX_USER_DATA_TYPE_IS_LZ4(t)		((t) >= IOTEX_USER_DATA_TYPE_JSON_LZ4 && (t) <= IOTEX_USER_DATA_TYPE_RAW_LZ4)
+#define IOTEX_USER_DATA_TYPE_PLAIN(t)		(IOTEX_USER_DATA_TYPE_IS_LZ4(t) ? (enum UserData_Type)((t) - IOTEX_USER_DATA_TYPE_JSON_LZ4) : (t))
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_COMPRESSION
+#define IOTEX_USER_DATA_TYPE_VALID(t)		((unsigned)(t) <= IOTEX_USER_DATA_TYPE_TIMESERIES)
+#else
+#define IOTEX_USER_DATA_TYPE_VALID(t)		((unsigned)(t) <= IOTEX_USER_DATA_TYPE_TIMESERIES && !IOTEX_USER_DATA_TYPE_IS_LZ4(t))
+#endif
+
+/* What an enqueue does when the upload queue is full */
+enum IOTEX_QUEUE_POLICY {
+	IOTEX_QUEUE_POLICY_DROP_OLDEST,		/* discard the oldest pending record */
+	IOTEX_QUEUE_POLICY_BLOCK,			/* wait until iotex_dev_access_loop() frees a slot, fails in the loop's task or without a scheduler */
+	IOTEX_QUEUE_POLICY_COALESCE,		/* overwrite the newest pending record */
 };
 
 typedef time_t (*iotex_gettime)(void);
 typedef int (*iotex_mqtt_pub)(unsigned char *topic, unsigned char *buf, unsigned int buflen, int qos);
 typedef int (*iotex_mqtt_sub)(unsigned char *topic);
 
+/*
+ * Optional streaming publish. begin() reserves the fixed header and topic in the
+ * transport's packet buffer, write() appends encoded bytes behind them and end()
+ * sends the packet. A packet that was begun but not ended is discarded by the
+ * next begin(). All three return non-zero on success.
+ */
+typedef int (*iotex_mqtt_pub_begin)(unsigned char *topic, unsigned int payload_len, int qos);
+typedef int (*iotex_mqtt_pub_write)(const unsigned char *buf, unsigned int buflen);
+typedef int (*iotex_mqtt_pub_end)(void);
+
 typedef int (*iotex_sign_message)(const uint8_t * input, size_t input_length, uint8_t * signature, size_t * signature_length );
 
 #ifdef IOTEX_DEBUG_ENABLE
@@ -105,6 +216,10 @@ typedef struct iotex_mqtt_ctx {
     iotex_mqtt_pub mqtt_pub_func;
     iotex_mqtt_sub mqtt_sub_func;
 
+    iotex_mqtt_pub_begin mqtt_pub_begin_func;
+    iotex_mqtt_pub_write mqtt_pub_write_func;
+    iotex_mqtt_pub_end   mqtt_pub_end_func;
+
 }iotex_mqtt_ctx_t;
 
 typedef struct iotex_crypto_ctx {
@@ -119,6 +234,159 @@ typedef struct iotex_crypto_ctx {
 
 }iotex_crypto_ctx_t;
 
+/* Bytes referenced by a pb_callback_t field, encoded without an intermediate copy */
+typedef struct iotex_pb_bytes {
+
+    const uint8_t *buf;
+    size_t len;
+
+}iotex_pb_bytes_t;
+
+/* One pre-serialized record of a batched upload */
+typedef struct iotex_upload_record {
+
+    const void *buf;
+    size_t len;
+
+}iotex_upload_record_t;
+
+/*
+ * Merkle tree over the records of one batch, stored level by level starting
+ * with the leaves. leaf = SHA256(0x00 || data), node = SHA256(0x01 || L || R),
+ * an unpaired last node is carried up to the next level unchanged.
+ */
+typedef struct iotex_batch_tree {
+
+    const iotex_upload_record_t *records;
+    size_t count;
+    size_t root;
+
+    uint8_t node[IOTEX_DEV_ACCESS_BATCH_TREE_NODES][32];
+
+}iotex_batch_tree_t;
+
+/*
+ * State of a chunked upload. The digest of the data sent so far is kept
+ * incrementally so no more than one fragment is ever held in memory.
+ */
+typedef struct iotex_chunk_ctx {
+
+    struct tc_sha256_state_struct sha;
+
+    int      active;
+    uint32_t session;
+    uint32_t seq;
+    uint32_t offset;
+    uint32_t total;
+
+    enum UserData_Type type;
+    int8_t   mac[6];
+
+}iotex_chunk_ctx_t;
+
+/*
+ * Header submessage serialized once whenever the token or topic changes.
+ * buf[0, prefix_len) holds event_type, pub_id and token, buf[prefix_len, len)
+ * holds event_id. pub_time is encoded between the two on every upload.
+ */
+typedef struct iotex_header_template {
+
+    uint8_t buf[Header_size];
+    size_t  prefix_len;
+    size_t  len;
+
+}iotex_header_template_t;
+
+/*
+ * Encode arena shared by all upload encoders. It is set up once by
+ * iotex_dev_access_init() so that building a message never touches the heap.
+ * The arena is not reentrant: uploads must be issued from one context.
+ * buf is only used when no streaming publish functions are registered.
+ */
+typedef struct iotex_encode_arena {
+
+    iotex_header_template_t header;
+    Payload  payload;
+
+    iotex_pb_bytes_t user;
+    iotex_pb_bytes_t sign;
+    iotex_pb_bytes_t pubkey;
+
+    iotex_batch_tree_t batch;
+    iotex_chunk_ctx_t  chunk;
+
+    uint8_t  sign_buf[64];
+    char     json_buf[IOTEX_DEV_ACCESS_JSON_BUF_SIZE];
+
+    iotex_json_writer_t json_writer;
+    struct tc_sha256_state_struct json_sha;
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_COMPRESSION
+    char     lz_src[IOTEX_DEV_ACCESS_LZ_INPUT_SIZE];
+    uint8_t  lz_buf[IOTEX_DEV_ACCESS_JSON_BUF_SIZE];
+    uint16_t lz_table[IOTEX_LZ_HASH_SIZE];
+#endif
+
+    uint8_t *buf;
+    size_t   buf_size;
+
+}iotex_encode_arena_t;
+
+typedef struct iotex_upload_queue_stats {
+
+    uint32_t depth;
+    uint32_t high_water;
+    uint32_t enqueued;
+    uint32_t sent;
+    uint32_t failed;        /* dropped after failing to encode, sign or publish */
+    uint32_t dropped;
+    uint32_t coalesced;
+
+}iotex_upload_queue_stats_t;
+
+/*
+ * Slot of the upload queue. seq == pos: free for the producer of pos (or
+ * being coalesced), seq == pos + 1: holds the record of pos, ready to be
+ * drained, seq == pos + 2: the record of pos is being sent.
+ */
+typedef struct iotex_upload_slot {
+
+    size_t seq;
+
+    enum UserData_Type type;
+    int8_t  mac[6];
+    uint8_t framed;         /* buf already holds the compressed frame of a *_LZ4 record */
+    size_t  len;
+    uint8_t buf[IOTEX_DEV_ACCESS_QUEUE_RECORD_SIZE];
+
+}iotex_upload_slot_t;
+
+/*
+ * Bounded lock-free ring of records waiting to be signed and published.
+ * Producers may run in any task or ISR-free context, the ring is drained
+ * by iotex_dev_access_loop().
+ */
+typedef struct iotex_upload_queue {
+
+    size_t head;
+    size_t tail;
+
+    enum IOTEX_QUEUE_POLICY policy;
+    iotex_upload_queue_stats_t stats;
+
+    uintptr_t consumer;     /* task that last ran iotex_dev_access_loop() */
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_COMPRESSION
+    /* JSON_LZ4 records are printed here and compressed into their slot, one producer at a time */
+    int      lz_busy;
+    char     lz_src[IOTEX_DEV_ACCESS_LZ_INPUT_SIZE];
+    uint16_t lz_table[IOTEX_LZ_HASH_SIZE];
+#endif
+
+    iotex_upload_slot_t slot[IOTEX_DEV_ACCESS_QUEUE_LEN];
+
+}iotex_upload_queue_t;
+
 typedef struct iotex_dev_ctx {
 
     int  inited;
@@ -130,6 +398,18 @@ typedef struct iotex_dev_ctx {
     iotex_mqtt_ctx_t mqtt_ctx;
     iotex_crypto_ctx_t crypto_ctx;
 
+    iotex_encode_arena_t arena;
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_UPLOAD_QUEUE
+    iotex_upload_queue_t queue;
+#endif
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_SPOOL
+    iotex_spool_t spool;
+    uint32_t spool_tokens;
+    time_t   spool_time;
+#endif
+
 }iotex_dev_ctx_t;
 
 #ifdef __cplusplus
@@ -145,6 +425,7 @@ int iotex_dev_access_set_token(const char *token, int token_len);
 int iotex_dev_access_set_mqtt_topic(const char *topic, int topic_len, int topic_location);
 int iotex_dev_access_set_time_func(iotex_gettime get_time_func);
 int iotex_dev_access_set_mqtt_func(iotex_mqtt_pub mqtt_pub, iotex_mqtt_sub mqtt_sub);
+int iotex_dev_access_set_mqtt_stream_func(iotex_mqtt_pub_begin pub_begin, iotex_mqtt_pub_write pub_write, iotex_mqtt_pub_end pub_end);
 int iotex_dev_access_set_sign_func(iotex_sign_message sign_func);
 #ifdef IOTEX_DEBUG_ENABLE
 int iotex_dev_access_set_verify_func(iotex_verify_message verify_func);
@@ -153,8 +434,24 @@ int iotex_dev_access_set_mqtt_status(enum IOTEX_MQTT_STATUS status);
 
 int iotex_dev_access_mqtt_input(uint8_t *topic, uint8_t *payload, uint32_t len);
 int iotex_dev_access_generate_dev_addr(const unsigned char* public_key, char *dev_address);
+int iotex_dev_access_generate_dev_addr_batch(const unsigned char * const *public_key, char * const *dev_address, size_t count);
 
 int iotex_dev_access_data_upload_with_userdata(void *buf, size_t buf_len, enum UserData_Type type, int8_t mac[6]);
+#ifdef CONFIG_APP_DEVNET_ACCESS_UPLOAD_QUEUE
+int iotex_dev_access_data_enqueue(void *buf, size_t buf_len, enum UserData_Type type, int8_t mac[6]);
+int iotex_dev_access_set_queue_policy(enum IOTEX_QUEUE_POLICY policy);
+int iotex_dev_access_get_queue_stats(iotex_upload_queue_stats_t *stats);
+#endif
+iotex_json_writer_t *iotex_dev_access_json_writer_begin(void);
+int iotex_dev_access_json_writer_upload(iotex_json_writer_t *writer, int8_t mac[6]);
+int iotex_dev_access_chunk_upload_begin(size_t total_len, enum UserData_Type type, int8_t mac[6]);
+int iotex_dev_access_chunk_upload_write(const void *buf, size_t buf_len);
+int iotex_dev_access_chunk_upload_end(void);
+#ifdef CONFIG_APP_DEVNET_ACCESS_SPOOL
+int iotex_dev_access_spool_attach(flash_drv *drv);
+int iotex_dev_access_get_spool_stats(iotex_spool_stats_t *stats);
+#endif
+int iotex_dev_access_data_upload_batch(const iotex_upload_record_t *records, size_t count, enum UserData_Type type, int8_t mac[6]);
 char *iotex_dev_access_get_mqtt_connect_addr_in_format(void);
 char *iotex_dev_access_get_mqtt_connect_addr_in_url(void);
 int iotex_dev_access_get_mqtt_connect_port(void);
@@ -0,0 +1,88 @@
+#ifndef __IOTEX_SPOOL_H__
+#define __IOTEX_SPOOL_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "include/hal/flash/flash_common.h"
+
+#define IOTEX_SPOOL_ERR_SUCCESS             0
+#define IOTEX_SPOOL_ERR_BAD_INPUT           -0x01
+#define IOTEX_SPOOL_ERR_NOT_MOUNTED         -0x02
+#define IOTEX_SPOOL_ERR_EMPTY               -0x03
+#define IOTEX_SPOOL_ERR_FLASH               -0x04
+
+#ifndef IOTEX_SPOOL_MAX_BLOCKS
+#define IOTEX_SPOOL_MAX_BLOCKS              64
+#endif
+
+/* Window for sequential reads, also bounds the largest record */
+#ifndef IOTEX_SPOOL_READ_BUF_SIZE
+#define IOTEX_SPOOL_READ_BUF_SIZE           2048
+#endif
+
+#define IOTEX_SPOOL_RECORD_HEADER_SIZE      16
+#define IOTEX_SPOOL_RECORD_MAX_SIZE         (IOTEX_SPOOL_READ_BUF_SIZE - IOTEX_SPOOL_RECORD_HEADER_SIZE)
+
+typedef struct iotex_spool_stats {
+
+    uint32_t pending;
+    uint32_t appended;
+    uint32_t replayed;
+    uint32_t dropped;
+    uint32_t corrupt;
+
+}iotex_spool_stats_t;
+
+/*
+ * Append-only record log on a flash_drv, used as a ring of erase blocks.
+ *
+ * Each record is framed as magic, length, sequence number, CRC-32 over
+ * length, sequence and data, and a state word. The state word is left erased
+ * while the record is pending and cleared once it has been replayed, so both
+ * steps only ever clear bits. A record torn by power loss fails its CRC and
+ * is skipped. When the ring is full the oldest block is erased and its
+ * pending records are dropped.
+ *
+ * Only the per-block pending counts and the head and tail positions are kept
+ * in RAM. They are rebuilt by iotex_spool_mount(). Records are read back
+ * through a window of IOTEX_SPOOL_READ_BUF_SIZE bytes, so replaying a
+ * backlog takes one large flash read per window rather than one per record.
+ */
+typedef struct iotex_spool {
+
+    flash_drv *drv;
+
+    uint32_t block_num;
+    uint32_t head_block;
+    uint32_t head_off;
+    uint32_t tail_block;
+    uint32_t tail_off;
+    uint32_t next_seq;
+
+    uint16_t live[IOTEX_SPOOL_MAX_BLOCKS];
+
+    iotex_spool_stats_t stats;
+
+    uint32_t win_addr;
+    uint32_t win_len;
+    uint8_t  win[IOTEX_SPOOL_READ_BUF_SIZE];
+
+}iotex_spool_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int iotex_spool_mount(iotex_spool_t *spool, flash_drv *drv);
+int iotex_spool_append(iotex_spool_t *spool, const uint8_t *buf, size_t len);
+
+/* Oldest pending record, valid until the next call on the spool */
+int iotex_spool_peek(iotex_spool_t *spool, const uint8_t **buf, size_t *len);
+int iotex_spool_pop(iotex_spool_t *spool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IOTEX_SPOOL_H__ */
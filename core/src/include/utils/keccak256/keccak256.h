@@ -13,19 +13,40 @@
 #include <stdint.h>
 
 #define IOTEX_HASH_LEN			32
-#define IOTEX_BLOCK_SIZE		200 - IOTEX_HASH_LEN * 2
+#define IOTEX_BLOCK_SIZE		(200 - IOTEX_HASH_LEN * 2)
 #define IOTEX_NUM_ROUNDS		24
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* 
+ * Incremental Keccak-256 state, the message is XORed into the state as it comes.
+ */
+typedef struct keccak256_ctx {
+	uint64_t state[25];
+	size_t offset;		// byte offset of the next input in the current block
+} keccak256_ctx;
+
 /* 
  * Computes the Keccak-256 hash of a sequence of bytes. The hash value is 32 bytes long.
- * Provides just one static method.
  */
 void keccak256_getHash(const uint8_t *msg, size_t len, uint8_t *hashResult);
 
+/* 
+ * Computes the hashes of four messages of the same length at once, interleaving
+ * the four states. Used to derive many addresses at a time.
+ */
+void keccak256_getHash_x4(const uint8_t * const msg[4], size_t len, uint8_t * const hashResult[4]);
+
+/* 
+ * Streaming interface: init, then any number of update calls, then final to get the
+ * 32 byte hash. The context must be initialized again before it is reused.
+ */
+void keccak256_init(keccak256_ctx *ctx);
+void keccak256_update(keccak256_ctx *ctx, const uint8_t *msg, size_t len);
+void keccak256_final(keccak256_ctx *ctx, uint8_t *hashResult);
+
 
 //class Keccak256 final {
 	
@@ -41,6 +41,7 @@
 #endif
 
 #include "include/iotex/iotex_crypto_all.h"
+#include "include/iotex/eddsa.h"
 
 #define ARRAY_LENGTH( array ) ( sizeof( array ) / sizeof( *( array ) ) )
 
@@ -126,6 +127,9 @@ psa_status_t iotex_to_psa_error( int ret )
         case IOTEX_ERR_CHACHAPOLY_AUTH_FAILED:
             return( PSA_ERROR_INVALID_SIGNATURE );
 
+        case IOTEX_ERR_POLY1305_BAD_INPUT_DATA:
+            return( PSA_ERROR_INVALID_ARGUMENT );
+
         case IOTEX_ERR_CIPHER_FEATURE_UNAVAILABLE:
             return( PSA_ERROR_NOT_SUPPORTED );
         case IOTEX_ERR_CIPHER_BAD_INPUT_DATA:
@@ -506,6 +510,45 @@ psa_status_t psa_copy_key_material_into_slot( psa_key_slot_t *slot,
     return( PSA_SUCCESS );
 }
 
+void psa_key_slot_cache_public_point( psa_key_slot_t *slot )
+{
+#if defined(PSA_KEY_SLOT_PUBLIC_POINT_SIZE)
+    psa_key_type_t type = slot->attr.type;
+    size_t bytes = PSA_BITS_TO_BYTES( slot->attr.bits );
+
+    slot->pub.valid = 0;
+
+    if( PSA_KEY_TYPE_IS_ECC( type ) &&
+        PSA_KEY_TYPE_ECC_GET_FAMILY( type ) == PSA_ECC_FAMILY_TWISTED_EDWARDS )
+    {
+        iotex_eddsa_key_free( slot->pub.ed25519 );
+        slot->pub.ed25519 = iotex_eddsa_key_load( type, slot->key.data,
+                                                  slot->key.bytes );
+        return;
+    }
+
+    if( ! PSA_KEY_TYPE_IS_ECC( type ) ||
+        PSA_KEY_TYPE_ECC_GET_FAMILY( type ) == PSA_ECC_FAMILY_MONTGOMERY ||
+        slot->key.data == NULL ||
+        bytes * 2 > sizeof( slot->pub.point ) )
+        return;
+
+    if( PSA_KEY_TYPE_IS_ECC_KEY_PAIR( type ) )
+    {
+        if( slot->key.bytes == bytes &&
+            iotex_ecp_load_public_point( PSA_KEY_TYPE_ECC_GET_FAMILY( type ),
+                                         slot->key.data, slot->pub.point ) == 0 )
+            slot->pub.valid = 1;
+    }
+    else if( iotex_ecp_read_public_point( PSA_KEY_TYPE_ECC_GET_FAMILY( type ),
+                                          slot->key.data, slot->key.bytes,
+                                          slot->pub.point ) == 0 )
+        slot->pub.valid = 1;
+#else
+    (void) slot;
+#endif
+}
+
 psa_status_t psa_import_key_into_slot(
     const psa_key_attributes_t *attributes,
     const uint8_t *data, size_t data_length,
@@ -687,6 +730,14 @@ static int psa_key_algorithm_permits( psa_key_type_t key_type,
     if( requested_alg == policy_alg )
         return( 1 );
 
+    /* Low-S only picks one of the two valid signatures of the same algorithm. */
+    if( PSA_ALG_IS_ECDSA( requested_alg ) &&
+        PSA_ALG_ECDSA_IS_LOW_S( requested_alg ) )
+    {
+        return( psa_key_algorithm_permits( key_type, policy_alg,
+                    requested_alg & ~PSA_ALG_ECDSA_LOW_S_FLAG ) );
+    }
+
     if( PSA_ALG_IS_SIGN_HASH( requested_alg ) &&
         PSA_ALG_SIGN_GET_HASH( policy_alg ) == PSA_ALG_ANY_HASH )
     {
@@ -922,6 +973,12 @@ psa_status_t psa_remove_key_data_from_memory( psa_key_slot_t *slot )
     slot->key.data = NULL;
     slot->key.bytes = 0;
 
+#if defined(PSA_KEY_SLOT_PUBLIC_POINT_SIZE)
+    iotex_ecdsa_free_point_table( slot->pub.table );
+    iotex_eddsa_key_free( slot->pub.ed25519 );
+    memset( &slot->pub, 0, sizeof( slot->pub ) );
+#endif
+
     return( PSA_SUCCESS );
 }
 
@@ -1322,6 +1379,20 @@ psa_status_t psa_export_public_key( psa_key_id_t key,
          goto exit;
     }
 
+#if defined(PSA_KEY_SLOT_PUBLIC_POINT_SIZE)
+    /* A public key is exported as it was imported, below */
+    if( slot->pub.valid && PSA_KEY_TYPE_IS_ECC_KEY_PAIR( slot->attr.type ) )
+    {
+        if( iotex_ecp_write_public_point(
+                PSA_KEY_TYPE_ECC_GET_FAMILY( slot->attr.type ), slot->pub.point,
+                data, data_size, data_length ) != 0 )
+            status = PSA_ERROR_BUFFER_TOO_SMALL;
+        else
+            status = PSA_SUCCESS;
+        goto exit;
+    }
+#endif
+
     psa_key_attributes_t attributes = {
         .core = slot->attr
     };
@@ -1608,6 +1679,8 @@ static psa_status_t psa_finish_key_creation(
 #endif /* IOTEX_PSA_CRYPTO_SE_C */
     if( status == PSA_SUCCESS )
     {
+        psa_key_slot_cache_public_point( slot );
+
         *key = slot->attr.id;
         status = psa_unlock_key_slot( slot );
         if( status != PSA_SUCCESS )
@@ -2558,6 +2631,32 @@ static psa_status_t psa_sign_internal( psa_key_id_t key,
         goto exit;
     }
 
+#if defined(PSA_KEY_SLOT_PUBLIC_POINT_SIZE)
+    if( slot->pub.ed25519 != NULL &&
+        ( alg == PSA_ALG_PURE_EDDSA || PSA_ALG_IS_HASH_EDDSA( alg ) ) )
+    {
+        uint8_t hash[PSA_HASH_MAX_SIZE];
+        size_t hash_length = input_length;
+        const uint8_t *digest = input;
+
+        if( input_is_message && PSA_ALG_IS_SIGN_HASH( alg ) )
+        {
+            status = psa_driver_wrapper_hash_compute(
+                        PSA_ALG_SIGN_GET_HASH( alg ),
+                        input, input_length,
+                        hash, sizeof( hash ), &hash_length );
+            if( status != PSA_SUCCESS )
+                goto exit;
+            digest = hash;
+        }
+
+        status = iotex_eddsa_sign_key( slot->pub.ed25519, digest, hash_length,
+                                       signature, signature_size,
+                                       signature_length );
+        goto exit;
+    }
+#endif
+
     psa_key_attributes_t attributes = {
       .core = slot->attr
     };
@@ -2622,6 +2721,55 @@ static psa_status_t psa_verify_internal( psa_key_id_t key,
     if( status != PSA_SUCCESS )
         return( status );
 
+#if defined(PSA_KEY_SLOT_PUBLIC_POINT_SIZE)
+    if( slot->pub.valid && PSA_ALG_IS_ECDSA( alg ) )
+    {
+        uint8_t hash[PSA_HASH_MAX_SIZE];
+        size_t hash_length = input_length;
+        const uint8_t *digest = input;
+
+        if( input_is_message )
+        {
+            status = psa_driver_wrapper_hash_compute(
+                        PSA_ALG_SIGN_GET_HASH( alg ),
+                        input, input_length,
+                        hash, sizeof( hash ), &hash_length );
+            if( status != PSA_SUCCESS )
+                goto exit;
+            digest = hash;
+        }
+
+        status = iotex_ecdsa_verify_point(
+                    PSA_KEY_TYPE_ECC_GET_FAMILY( slot->attr.type ),
+                    slot->pub.point, &slot->pub.table, digest, hash_length,
+                    signature, signature_length );
+        goto exit;
+    }
+
+    if( slot->pub.ed25519 != NULL &&
+        ( alg == PSA_ALG_PURE_EDDSA || PSA_ALG_IS_HASH_EDDSA( alg ) ) )
+    {
+        uint8_t hash[PSA_HASH_MAX_SIZE];
+        size_t hash_length = input_length;
+        const uint8_t *digest = input;
+
+        if( input_is_message && PSA_ALG_IS_SIGN_HASH( alg ) )
+        {
+            status = psa_driver_wrapper_hash_compute(
+                        PSA_ALG_SIGN_GET_HASH( alg ),
+                        input, input_length,
+                        hash, sizeof( hash ), &hash_length );
+            if( status != PSA_SUCCESS )
+                goto exit;
+            digest = hash;
+        }
+
+        status = iotex_eddsa_verify_key( slot->pub.ed25519, digest, hash_length,
+                                         signature, signature_length );
+        goto exit;
+    }
+#endif
+
     psa_key_attributes_t attributes = {
       .core = slot->attr
     };
@@ -2641,12 +2789,161 @@ static psa_status_t psa_verify_internal( psa_key_id_t key,
             signature, signature_length );
     }
 
+#if defined(PSA_KEY_SLOT_PUBLIC_POINT_SIZE)
+exit:
+#endif
     unlock_status = psa_unlock_key_slot( slot );
 
     return( ( status == PSA_SUCCESS ) ? unlock_status : status );
 
 }
 
+#if defined(PSA_KEY_SLOT_PUBLIC_POINT_SIZE)
+/* Signatures handed to the backend at once by psa_verify_batch_internal() */
+#ifndef PSA_VERIFY_BATCH_CHUNK
+#define PSA_VERIFY_BATCH_CHUNK 16
+#endif
+
+/* Verifies the ECDSA signatures whose key carries its public point in batches
+ * sharing the modular inversions, one per curve family. status[] receives the
+ * outcome of every signature, the others go through psa_verify_internal(). */
+static void psa_verify_batch_chunk( const psa_key_id_t *key,
+                                    int input_is_message,
+                                    psa_algorithm_t alg,
+                                    const uint8_t * const *input,
+                                    const size_t *input_length,
+                                    const uint8_t * const *signature,
+                                    const size_t *signature_length,
+                                    size_t count,
+                                    psa_status_t *status )
+{
+    psa_key_slot_t *slot[PSA_VERIFY_BATCH_CHUNK];
+    iotex_ecdsa_batch_item item[PSA_VERIFY_BATCH_CHUNK];
+    iotex_ecdsa_batch_item group[PSA_VERIFY_BATCH_CHUNK];
+    uint8_t hash[PSA_VERIFY_BATCH_CHUNK][PSA_HASH_MAX_SIZE];
+    size_t i, j, n;
+
+    for( i = 0; i < count; i++ )
+    {
+        slot[i] = NULL;
+        status[i] = psa_get_and_lock_key_slot_with_policy(
+                        key[i], &slot[i],
+                        input_is_message ? PSA_KEY_USAGE_VERIFY_MESSAGE :
+                                           PSA_KEY_USAGE_VERIFY_HASH,
+                        alg );
+        if( status[i] != PSA_SUCCESS )
+            continue;
+
+        if( ! slot[i]->pub.valid )
+        {
+            psa_unlock_key_slot( slot[i] );
+            slot[i] = NULL;
+            status[i] = psa_verify_internal( key[i], input_is_message, alg,
+                                             input[i], input_length[i],
+                                             signature[i], signature_length[i] );
+            continue;
+        }
+
+        item[i].point = slot[i]->pub.point;
+        item[i].table = &slot[i]->pub.table;
+        item[i].hash = input[i];
+        item[i].hash_length = input_length[i];
+        item[i].signature = signature[i];
+        item[i].signature_length = signature_length[i];
+
+        if( input_is_message )
+        {
+            status[i] = psa_driver_wrapper_hash_compute(
+                            PSA_ALG_SIGN_GET_HASH( alg ),
+                            input[i], input_length[i],
+                            hash[i], sizeof( hash[i] ), &item[i].hash_length );
+            if( status[i] != PSA_SUCCESS )
+            {
+                psa_unlock_key_slot( slot[i] );
+                slot[i] = NULL;
+                continue;
+            }
+            item[i].hash = hash[i];
+        }
+
+        /* Pending until its family has been verified */
+        status[i] = PSA_ERROR_CORRUPTION_DETECTED;
+    }
+
+    for( i = 0; i < count; i++ )
+    {
+        psa_ecc_family_t family;
+
+        if( NULL == slot[i] || status[i] != PSA_ERROR_CORRUPTION_DETECTED )
+            continue;
+
+        family = PSA_KEY_TYPE_ECC_GET_FAMILY( slot[i]->attr.type );
+
+        for( j = i, n = 0; j < count; j++ )
+            if( NULL != slot[j] &&
+                PSA_KEY_TYPE_ECC_GET_FAMILY( slot[j]->attr.type ) == family )
+                group[n++] = item[j];
+
+        iotex_ecdsa_verify_point_batch( family, group, n );
+
+        for( j = i, n = 0; j < count; j++ )
+            if( NULL != slot[j] &&
+                PSA_KEY_TYPE_ECC_GET_FAMILY( slot[j]->attr.type ) == family )
+                status[j] = group[n++].status;
+    }
+
+    for( i = 0; i < count; i++ )
+    {
+        psa_status_t unlock_status;
+
+        if( NULL == slot[i] )
+            continue;
+
+        unlock_status = psa_unlock_key_slot( slot[i] );
+        if( status[i] == PSA_SUCCESS )
+            status[i] = unlock_status;
+    }
+}
+#endif
+
+static psa_status_t psa_verify_batch_internal( const psa_key_id_t *key,
+                                               int input_is_message,
+                                               psa_algorithm_t alg,
+                                               const uint8_t * const *input,
+                                               const size_t *input_length,
+                                               const uint8_t * const *signature,
+                                               const size_t *signature_length,
+                                               size_t count,
+                                               psa_status_t *status )
+{
+    size_t i = 0;
+
+#if defined(PSA_KEY_SLOT_PUBLIC_POINT_SIZE)
+    if( PSA_ALG_IS_ECDSA( alg ) &&
+        psa_sign_verify_check_alg( input_is_message, alg ) == PSA_SUCCESS )
+    {
+        for( ; i < count; i += PSA_VERIFY_BATCH_CHUNK )
+            psa_verify_batch_chunk( key + i, input_is_message, alg,
+                                    input + i, input_length + i,
+                                    signature + i, signature_length + i,
+                                    count - i < PSA_VERIFY_BATCH_CHUNK ?
+                                        count - i : PSA_VERIFY_BATCH_CHUNK,
+                                    status + i );
+    }
+#endif
+
+    for( ; i < count; i++ )
+        status[i] = psa_verify_internal( key[i], input_is_message, alg,
+                                         input[i], input_length[i],
+                                         signature[i], signature_length[i] );
+
+    for( i = 0; i < count; i++ )
+        if( status[i] != PSA_SUCCESS )
+            return( status[i] );
+
+    return( PSA_SUCCESS );
+}
+
 psa_status_t psa_sign_message_builtin(
     const psa_key_attributes_t *attributes,
     const uint8_t *key_buffer,
@@ -2756,6 +3053,20 @@ psa_status_t psa_verify_message( psa_key_id_t key,
         signature, signature_length );
 }
 
+psa_status_t psa_verify_message_batch( const psa_key_id_t *key,
+                                       psa_algorithm_t alg,
+                                       const uint8_t * const *input,
+                                       const size_t *input_length,
+                                       const uint8_t * const *signature,
+                                       const size_t *signature_length,
+                                       size_t count,
+                                       psa_status_t *status )
+{
+    return psa_verify_batch_internal(
+        key, 1, alg, input, input_length,
+        signature, signature_length, count, status );
+}
+
 psa_status_t psa_sign_hash_builtin(
     const psa_key_attributes_t *attributes,
     const uint8_t *key_buffer, size_t key_buffer_size,
@@ -2908,6 +3219,20 @@ psa_status_t psa_verify_hash( psa_key_id_t key,
         signature, signature_length );
 }
 
+psa_status_t psa_verify_hash_batch( const psa_key_id_t *key,
+                                    psa_algorithm_t alg,
+                                    const uint8_t * const *hash,
+                                    const size_t *hash_length,
+                                    const uint8_t * const *signature,
+                                    const size_t *signature_length,
+                                    size_t count,
+                                    psa_status_t *status )
+{
+    return psa_verify_batch_internal(
+        key, 0, alg, hash, hash_length,
+        signature, signature_length, count, status );
+}
+
 psa_status_t psa_asymmetric_encrypt( psa_key_id_t key,
                                      psa_algorithm_t alg,
                                      const uint8_t *input,
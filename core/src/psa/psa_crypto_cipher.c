@@ -22,8 +22,10 @@
 #include "include/server/crypto/psa_crypto_core.h"
 #include "include/server/crypto/psa_crypto_random_impl.h"
 
+#include "include/iotex/aes.h"
 #include "include/iotex/cipher.h"
 #include "include/iotex/error.h"
+#include "include/server/cipher_wrap.h"
 
 #include <string.h>
 
@@ -340,6 +342,29 @@ static psa_status_t psa_cipher_update_ecb(
         }
     }
 
+#if defined(IOTEX_AES_C)
+    if( input_length >= block_size &&
+        ctx->cipher_info->base->cipher == IOTEX_CIPHER_ID_AES )
+    {
+        /* AES takes all full blocks at once, to interleave them */
+        internal_output_length = input_length - input_length % block_size;
+
+        status = iotex_to_psa_error(
+            iotex_aes_crypt_ecb_blocks( ctx->cipher_ctx, ctx->operation,
+                                        internal_output_length,
+                                        input, output ) );
+
+        if( status != PSA_SUCCESS )
+            goto exit;
+
+        input_length -= internal_output_length;
+        input += internal_output_length;
+
+        output += internal_output_length;
+        *output_length += internal_output_length;
+    }
+#endif /* IOTEX_AES_C */
+
     while( input_length >= block_size )
     {
         /* Run all full blocks we have, one by one */
@@ -375,7 +375,7 @@ psa_status_t iotex_psa_ecdsa_sign_hash(
     iotex_ecp_keypair *ecp = NULL;
     int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
     size_t curve_bytes;
-    iotex_mpi r, s;
+    iotex_mpi r, s, neg;
 
     status = iotex_psa_ecp_load_representation( attributes->core.type,
                                                   attributes->core.bits,
@@ -389,6 +389,7 @@ psa_status_t iotex_psa_ecdsa_sign_hash(
 
     iotex_mpi_init( &r );
     iotex_mpi_init( &s );
+    iotex_mpi_init( &neg );
 
     if( signature_size < 2 * curve_bytes )
     {
@@ -422,6 +423,14 @@ psa_status_t iotex_psa_ecdsa_sign_hash(
                                              IOTEX_PSA_RANDOM_STATE ) );
     }
 
+    if( PSA_ALG_ECDSA_IS_LOW_S( alg ) )
+    {
+        /* s > n / 2 exactly when n - s < s */
+        IOTEX_MPI_CHK( iotex_mpi_sub_mpi( &neg, &ecp->grp.N, &s ) );
+        if( iotex_mpi_cmp_mpi( &neg, &s ) < 0 )
+            IOTEX_MPI_CHK( iotex_mpi_copy( &s, &neg ) );
+    }
+
     IOTEX_MPI_CHK( iotex_mpi_write_binary( &r,
                                                signature,
                                                curve_bytes ) );
@@ -431,6 +440,7 @@ psa_status_t iotex_psa_ecdsa_sign_hash(
 cleanup:
     iotex_mpi_free( &r );
     iotex_mpi_free( &s );
+    iotex_mpi_free( &neg );
     if( ret == 0 )
         *signature_length = 2 * curve_bytes;
 
@@ -441,7 +451,7 @@ cleanup:
 #else
     
     return iotex_ecdsa_sign( PSA_KEY_TYPE_ECC_GET_FAMILY(attributes->core.type), 
-                    key_buffer, key_buffer_size, 
+                    key_buffer, key_buffer_size, alg,
                     hash, hash_length, 
                     signature, signature_length);
 
@@ -538,7 +548,7 @@ psa_status_t iotex_psa_eddsa_verify_hash(
     psa_algorithm_t alg, const uint8_t *hash, size_t hash_length,
     const uint8_t *signature, size_t signature_length )
 {
-    return iotex_eddsa_verify( PSA_KEY_TYPE_ECC_GET_FAMILY(attributes->core.type), 
+    return iotex_eddsa_verify( attributes->core.type, 
                             key_buffer, key_buffer_size,
                             hash, hash_length, (uint8_t *)signature, signature_length);    
 }
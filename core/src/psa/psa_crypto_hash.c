@@ -402,6 +402,41 @@ exit:
         return( status );
 
 }
+
+psa_status_t iotex_psa_hash_compute_multi(
+    psa_algorithm_t alg,
+    const uint8_t * const *input,
+    const size_t *input_length,
+    uint8_t * const *hash,
+    size_t hash_size,
+    size_t *hash_length,
+    size_t count )
+{
+    psa_status_t status = PSA_SUCCESS;
+    size_t i;
+
+#if defined(IOTEX_PSA_BUILTIN_ALG_SHA_256)
+    if( alg == PSA_ALG_SHA_256 )
+    {
+        if( hash_size < PSA_HASH_LENGTH( alg ) )
+            return( PSA_ERROR_BUFFER_TOO_SMALL );
+
+        if( iotex_sha256_multi( input, input_length, hash, count ) != 0 )
+            return( PSA_ERROR_INVALID_ARGUMENT );
+
+        for( i = 0; i < count; i++ )
+            hash_length[i] = PSA_HASH_LENGTH( alg );
+
+        return( PSA_SUCCESS );
+    }
+#endif
+
+    for( i = 0; i < count && status == PSA_SUCCESS; i++ )
+        status = iotex_psa_hash_compute( alg, input[i], input_length[i],
+                                         hash[i], hash_size, &hash_length[i] );
+
+    return( status );
+}
 #endif /* IOTEX_PSA_BUILTIN_HASH */
 
 #endif /* IOTEX_PSA_CRYPTO_C */
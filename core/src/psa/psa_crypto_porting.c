@@ -69,9 +69,13 @@
 #include "include/backends/tinycryt/ecc_dsa.h"
 #include "include/backends/tinycryt/ed_dsa.h"
 #include "include/backends/tinycryt/ecc_platform_specific.h"
+#include "include/backends/tinycryt/utils.h"
 #include "include/backends/tinycryt/aes.h"
 #include "include/backends/tinycryt/hmac_prng.h"
 #include "include/backends/tinycryt/ctr_mode.h"
+#include "include/backends/tinycryt/gcm_mode.h"
+#include "include/backends/tinycryt/chacha20.h"
+#include "include/backends/tinycryt/poly1305.h"
 
 #endif
 
@@ -86,7 +90,8 @@
 #define ECP_CURVE25519_KEY_SIZE 32
 #define ECP_CURVE448_KEY_SIZE   56
 
-struct tc_aes_key_sched_struct s;
+/* The tinycrypt key schedule lives in the context, so operations never share one */
+#define AES_SCHED( ctx )    ( (TCAesKeySched_t) ( ctx )->buf )
 
 /****************************************************************/
 /* Static */
@@ -271,6 +276,106 @@ static int get_no_padding( unsigned char *input, size_t input_len,
 }
 #endif /* IOTEX_CIPHER_MODE_WITH_PADDING */
 
+#if defined(IOTEX_CIPHER_MODE_AEAD)
+/*
+ * Packet-oriented encryption for AEAD modes: the tag is written separately
+ */
+static int cipher_aead_encrypt( iotex_cipher_context_t *ctx,
+                                const unsigned char *iv, size_t iv_len,
+                                const unsigned char *ad, size_t ad_len,
+                                const unsigned char *input, size_t ilen,
+                                unsigned char *output, size_t *olen,
+                                unsigned char *tag, size_t tag_len )
+{
+#if defined(IOTEX_GCM_C)
+    if( IOTEX_MODE_GCM == ctx->cipher_info->mode )
+    {
+        *olen = ilen;
+        return( iotex_gcm_crypt_and_tag( ctx->cipher_ctx, IOTEX_GCM_ENCRYPT,
+                                           ilen, iv, iv_len, ad, ad_len,
+                                           input, output, tag_len, tag ) );
+    }
+#endif /* IOTEX_GCM_C */
+#if defined(IOTEX_CHACHAPOLY_C)
+    if( IOTEX_CIPHER_CHACHA20_POLY1305 == ctx->cipher_info->type )
+    {
+        /* ChachaPoly has a fixed length nonce and MAC (tag) */
+        if( ( iv_len != ctx->cipher_info->iv_size ) ||
+            ( tag_len != 16U ) )
+        {
+            return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+        }
+
+        *olen = ilen;
+        return( iotex_chachapoly_encrypt_and_tag( ctx->cipher_ctx,
+                                ilen, iv, ad, ad_len, input, output, tag ) );
+    }
+#endif /* IOTEX_CHACHAPOLY_C */
+
+    (void) iv; (void) iv_len; (void) ad; (void) ad_len;
+    (void) input; (void) ilen; (void) output; (void) olen;
+    (void) tag; (void) tag_len;
+
+    return( IOTEX_ERR_CIPHER_FEATURE_UNAVAILABLE );
+}
+
+/*
+ * Packet-oriented decryption for AEAD modes: the tag is passed separately
+ */
+static int cipher_aead_decrypt( iotex_cipher_context_t *ctx,
+                                const unsigned char *iv, size_t iv_len,
+                                const unsigned char *ad, size_t ad_len,
+                                const unsigned char *input, size_t ilen,
+                                unsigned char *output, size_t *olen,
+                                const unsigned char *tag, size_t tag_len )
+{
+#if defined(IOTEX_GCM_C)
+    if( IOTEX_MODE_GCM == ctx->cipher_info->mode )
+    {
+        int ret;
+
+        *olen = ilen;
+        ret = iotex_gcm_auth_decrypt( ctx->cipher_ctx, ilen,
+                                        iv, iv_len, ad, ad_len,
+                                        tag, tag_len, input, output );
+
+        if( ret == IOTEX_ERR_GCM_AUTH_FAILED )
+            ret = IOTEX_ERR_CIPHER_AUTH_FAILED;
+
+        return( ret );
+    }
+#endif /* IOTEX_GCM_C */
+#if defined(IOTEX_CHACHAPOLY_C)
+    if( IOTEX_CIPHER_CHACHA20_POLY1305 == ctx->cipher_info->type )
+    {
+        int ret;
+
+        /* ChachaPoly has a fixed length nonce and MAC (tag) */
+        if( ( iv_len != ctx->cipher_info->iv_size ) ||
+            ( tag_len != 16U ) )
+        {
+            return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+        }
+
+        *olen = ilen;
+        ret = iotex_chachapoly_auth_decrypt( ctx->cipher_ctx, ilen,
+                                iv, ad, ad_len, tag, input, output );
+
+        if( ret == IOTEX_ERR_CHACHAPOLY_AUTH_FAILED )
+            ret = IOTEX_ERR_CIPHER_AUTH_FAILED;
+
+        return( ret );
+    }
+#endif /* IOTEX_CHACHAPOLY_C */
+
+    (void) iv; (void) iv_len; (void) ad; (void) ad_len;
+    (void) input; (void) ilen; (void) output; (void) olen;
+    (void) tag; (void) tag_len;
+
+    return( IOTEX_ERR_CIPHER_FEATURE_UNAVAILABLE );
+}
+#endif /* IOTEX_CIPHER_MODE_AEAD */
+
 int32_t iotex_int_to_string(uint32_t N, char *str)
 {
     int i = 0, j = 0;
@@ -522,6 +627,30 @@ inline int iotex_sha256( const unsigned char *input, size_t ilen, unsigned char
 #endif
 }
 
+inline int iotex_sha256_multi( const unsigned char * const *input, const size_t *ilen, unsigned char * const *output, size_t count )
+{
+#ifdef CONFIG_PSA_CRYPTO_BACKENDS_TINYCRYPT
+    if ( tc_sha256_multi( output, input, ilen, count ) != TC_CRYPTO_SUCCESS )
+        return IOTEX_ERR_SHA256_BAD_INPUT_DATA;
+
+    return 0;
+#endif
+
+#ifdef PSA_CRYPTO_BACKENDS_MBEDTLS
+    size_t i;
+    int ret;
+
+    for ( i = 0; i < count; i++ )
+    {
+        ret = mbedtls_sha256( input[i], ilen[i], output[i], 0 );
+        if ( ret != 0 )
+            return ret;
+    }
+
+    return 0;
+#endif
+}
+
 /****************************************************************/
 /* SHA512 */
 /****************************************************************/
@@ -832,7 +961,14 @@ void iotex_cipher_init( iotex_cipher_context_t *ctx )
 
 inline void iotex_cipher_free( iotex_cipher_context_t *ctx )
 {
-    (void)ctx;
+    if( ctx == NULL )
+        return;
+
+    /* The cipher context holds the key schedule */
+    if( ctx->cipher_ctx != NULL && ctx->cipher_info != NULL )
+        ctx->cipher_info->base->ctx_free_func( ctx->cipher_ctx );
+
+    iotex_platform_zeroize( ctx, sizeof( iotex_cipher_context_t ) );
 }
 
 inline int iotex_cipher_setup( iotex_cipher_context_t *ctx, const iotex_cipher_info_t *cipher_info )
@@ -1071,7 +1207,41 @@ inline int iotex_cipher_reset( iotex_cipher_context_t *ctx )
 #if defined(IOTEX_GCM_C) || defined(IOTEX_CHACHAPOLY_C)
 inline int iotex_cipher_update_ad( iotex_cipher_context_t *ctx, const unsigned char *ad, size_t ad_len )
 {
-    // TODO iotex_cipher_update_ad( (iotex_cipher_context_t *)ctx, ad, ad_len );
+    if( ctx == NULL || ctx->cipher_info == NULL )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+    if( ad_len != 0 && ad == NULL )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+
+#if defined(IOTEX_GCM_C)
+    if( IOTEX_MODE_GCM == ctx->cipher_info->mode )
+    {
+        return( iotex_gcm_update_ad( (iotex_gcm_context *) ctx->cipher_ctx,
+                                       ad, ad_len ) );
+    }
+#endif
+
+#if defined(IOTEX_CHACHAPOLY_C)
+    if( IOTEX_CIPHER_CHACHA20_POLY1305 == ctx->cipher_info->type )
+    {
+        int result;
+        iotex_chachapoly_mode_t mode;
+
+        mode = ( ctx->operation == IOTEX_ENCRYPT )
+                ? IOTEX_CHACHAPOLY_ENCRYPT
+                : IOTEX_CHACHAPOLY_DECRYPT;
+
+        result = iotex_chachapoly_starts( (iotex_chachapoly_context*) ctx->cipher_ctx,
+                                            ctx->iv,
+                                            mode );
+        if ( result != 0 )
+            return( result );
+
+        return( iotex_chachapoly_update_aad( (iotex_chachapoly_context*) ctx->cipher_ctx,
+                                               ad, ad_len ) );
+    }
+#endif
+
+    return( IOTEX_ERR_CIPHER_FEATURE_UNAVAILABLE );
 }
 #endif /* IOTEX_GCM_C || IOTEX_CHACHAPOLY_C */
 
@@ -1419,12 +1589,98 @@ int iotex_cipher_finish( iotex_cipher_context_t *ctx, unsigned char *output, siz
 #if defined(IOTEX_GCM_C) || defined(IOTEX_CHACHAPOLY_C)
 inline int iotex_cipher_write_tag( iotex_cipher_context_t *ctx, unsigned char *tag, size_t tag_len )
 {
-    // TODO iotex_cipher_write_tag( (iotex_cipher_context_t *)ctx, tag, tag_len );
+    if( ctx == NULL || ctx->cipher_info == NULL )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+    if( tag_len != 0 && tag == NULL )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+
+    if( IOTEX_ENCRYPT != ctx->operation )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+
+#if defined(IOTEX_GCM_C)
+    if( IOTEX_MODE_GCM == ctx->cipher_info->mode )
+    {
+        size_t output_length;
+        /* The tinycrypt engine has no buffered output to flush */
+        return( iotex_gcm_finish( (iotex_gcm_context *) ctx->cipher_ctx,
+                                    NULL, 0, &output_length,
+                                    tag, tag_len ) );
+    }
+#endif
+
+#if defined(IOTEX_CHACHAPOLY_C)
+    if ( IOTEX_CIPHER_CHACHA20_POLY1305 == ctx->cipher_info->type )
+    {
+        /* Don't allow truncated MAC for Poly1305 */
+        if ( tag_len != 16U )
+            return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+
+        return( iotex_chachapoly_finish( (iotex_chachapoly_context*) ctx->cipher_ctx,
+                                           tag ) );
+    }
+#endif
+
+    return( 0 );
 }
 
 inline int iotex_cipher_check_tag( iotex_cipher_context_t *ctx, const unsigned char *tag, size_t tag_len )
 {
-    // TODO iotex_cipher_check_tag( (iotex_cipher_context_t *)ctx, tag, tag_len );
+    unsigned char check_tag[16];
+    int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+
+    if( ctx == NULL || ctx->cipher_info == NULL )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+    if( tag_len != 0 && tag == NULL )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+
+    if( IOTEX_DECRYPT != ctx->operation )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+
+    /* Nothing to check on a non-authenticated algorithm */
+    ret = 0;
+
+#if defined(IOTEX_GCM_C)
+    if( IOTEX_MODE_GCM == ctx->cipher_info->mode )
+    {
+        size_t output_length;
+
+        if( tag_len > sizeof( check_tag ) )
+            return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+
+        if( 0 != ( ret = iotex_gcm_finish( (iotex_gcm_context *) ctx->cipher_ctx,
+                                             NULL, 0, &output_length,
+                                             check_tag, tag_len ) ) )
+        {
+            return( ret );
+        }
+
+        /* Check the tag in "constant-time" */
+        if( iotex_psa_safer_memcmp( tag, check_tag, tag_len ) != 0 )
+            ret = IOTEX_ERR_CIPHER_AUTH_FAILED;
+    }
+#endif
+
+#if defined(IOTEX_CHACHAPOLY_C)
+    if ( IOTEX_CIPHER_CHACHA20_POLY1305 == ctx->cipher_info->type )
+    {
+        /* Don't allow truncated MAC for Poly1305 */
+        if ( tag_len != sizeof( check_tag ) )
+            return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+
+        ret = iotex_chachapoly_finish( (iotex_chachapoly_context*) ctx->cipher_ctx,
+                                         check_tag );
+        if ( ret != 0 )
+            return( ret );
+
+        /* Check the tag in "constant-time" */
+        if( iotex_psa_safer_memcmp( tag, check_tag, tag_len ) != 0 )
+            ret = IOTEX_ERR_CIPHER_AUTH_FAILED;
+    }
+#endif
+
+    iotex_platform_zeroize( check_tag, sizeof( check_tag ) );
+
+    return( ret );
 }
 #endif /* IOTEX_GCM_C || IOTEX_CHACHAPOLY_C */
 
@@ -1437,14 +1693,58 @@ inline int iotex_cipher_crypt( iotex_cipher_context_t *ctx, const unsigned char
 #if defined(IOTEX_CIPHER_MODE_AEAD) || defined(IOTEX_NIST_KW_C)
 inline int iotex_cipher_auth_encrypt_ext( iotex_cipher_context_t *ctx, const unsigned char *iv, size_t iv_len, const unsigned char *ad, size_t ad_len, const unsigned char *input, size_t ilen, unsigned char *output, size_t output_len, size_t *olen, size_t tag_len )
 {
-    // TODO iotex_cipher_auth_encrypt_ext( (iotex_cipher_context_t *)ctx, iv, iv_len, ad, ad_len, input, ilen, output, output_len, olen, tag_len);
-	return 0;
+    int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+
+    if( ctx == NULL || ctx->cipher_info == NULL )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+    if( ( iv_len != 0 && iv == NULL ) || ( ad_len != 0 && ad == NULL ) )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+    if( ( ilen != 0 && input == NULL ) || output == NULL || olen == NULL )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+
+#if defined(IOTEX_CIPHER_MODE_AEAD)
+    /* AEAD case: check length before passing on to shared function */
+    if( output_len < ilen || output_len - ilen < tag_len )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+
+    ret = cipher_aead_encrypt( ctx, iv, iv_len, ad, ad_len,
+                               input, ilen, output, olen,
+                               output + ilen, tag_len );
+    *olen += tag_len;
+#else
+    (void) output_len;
+    ret = IOTEX_ERR_CIPHER_FEATURE_UNAVAILABLE;
+#endif /* IOTEX_CIPHER_MODE_AEAD */
+
+    return( ret );
 }
 
 inline int iotex_cipher_auth_decrypt_ext( iotex_cipher_context_t *ctx, const unsigned char *iv, size_t iv_len, const unsigned char *ad, size_t ad_len, const unsigned char *input, size_t ilen, unsigned char *output, size_t output_len, size_t *olen, size_t tag_len )
 {
-    // TODO iotex_cipher_auth_decrypt_ext( (iotex_cipher_context_t *)ctx, iv, iv_len, ad, ad_len, input, ilen, output, output_len, olen, tag_len );
-	return 0;
+    int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+
+    if( ctx == NULL || ctx->cipher_info == NULL )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+    if( ( iv_len != 0 && iv == NULL ) || ( ad_len != 0 && ad == NULL ) )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+    if( ( ilen != 0 && input == NULL ) || ( output_len != 0 && output == NULL ) ||
+        olen == NULL )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+
+#if defined(IOTEX_CIPHER_MODE_AEAD)
+    /* AEAD case: check length before passing on to shared function */
+    if( ilen < tag_len || output_len < ilen - tag_len )
+        return( IOTEX_ERR_CIPHER_BAD_INPUT_DATA );
+
+    ret = cipher_aead_decrypt( ctx, iv, iv_len, ad, ad_len,
+                               input, ilen - tag_len, output, olen,
+                               input + ilen - tag_len, tag_len );
+#else
+    (void) output_len;
+    ret = IOTEX_ERR_CIPHER_FEATURE_UNAVAILABLE;
+#endif /* IOTEX_CIPHER_MODE_AEAD */
+
+    return( ret );
 }
 #endif
 
@@ -1471,13 +1771,18 @@ inline int iotex_aes_setkey_enc( iotex_aes_context *ctx, const unsigned char *ke
 {
     int ret = 0;
 
+    if ( ctx == NULL )
+        return (IOTEX_ERR_AES_BAD_INPUT_DATA);
     if ( keybits != 128 )
         return PSA_ERROR_NOT_SUPPORTED;
 
-    ret = tc_aes128_set_encrypt_key(&s, key);
+    ret = tc_aes128_set_encrypt_key(AES_SCHED( ctx ), key);
     if ( ret == 0 )
         return IOTEX_ERR_AES_INVALID_KEY_LENGTH;
 
+    ctx->nr = Nr;
+    ctx->rk = ctx->buf;
+
     return 0;
 }
 
@@ -1485,13 +1790,18 @@ inline int iotex_aes_setkey_dec( iotex_aes_context *ctx, const unsigned char *ke
 {
     int ret = 0;
 
+    if ( ctx == NULL )
+        return (IOTEX_ERR_AES_BAD_INPUT_DATA);
     if ( keybits != 128 )
         return PSA_ERROR_NOT_SUPPORTED;
 
-    ret = tc_aes128_set_decrypt_key(&s, key);
+    ret = tc_aes128_set_decrypt_key(AES_SCHED( ctx ), key);
     if ( ret == 0 )
         return IOTEX_ERR_AES_INVALID_KEY_LENGTH;
 
+    ctx->nr = Nr;
+    ctx->rk = ctx->buf;
+
     return 0;    
 }
 
@@ -1508,13 +1818,13 @@ inline int iotex_aes_crypt_ecb( iotex_aes_context *ctx, int mode, const unsigned
 
     if( mode == IOTEX_AES_DECRYPT )
     {
-        ret = tc_aes_decrypt(output, input, &s);
+        ret = tc_aes_decrypt(output, input, AES_SCHED( ctx ));
         if (ret != 1)
             return IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
     }
     else
     {
-        ret = tc_aes_encrypt(output, output, &s);
+        ret = tc_aes_encrypt(output, input, AES_SCHED( ctx ));
         if (ret != 1)
             return IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
     }
@@ -1522,12 +1832,38 @@ inline int iotex_aes_crypt_ecb( iotex_aes_context *ctx, int mode, const unsigned
     return 0;
 }
 
+int iotex_aes_crypt_ecb_blocks( iotex_aes_context *ctx, int mode, size_t length, const unsigned char *input, unsigned char *output )
+{
+    int ret = 0;
+
+    if ( ctx == NULL )
+        return (IOTEX_ERR_AES_BAD_INPUT_DATA);
+    if ( mode != IOTEX_AES_ENCRYPT && mode != IOTEX_AES_DECRYPT )
+        return (IOTEX_ERR_AES_BAD_INPUT_DATA);
+    if ( input == NULL  || output == NULL)
+        return (IOTEX_ERR_AES_BAD_INPUT_DATA);
+    if ( length % 16 )
+        return( IOTEX_ERR_AES_INVALID_INPUT_LENGTH );
+
+    if( mode == IOTEX_AES_DECRYPT )
+        ret = tc_aes_decrypt_blocks(output, input, length / 16, AES_SCHED( ctx ));
+    else
+        ret = tc_aes_encrypt_blocks(output, input, length / 16, AES_SCHED( ctx ));
+
+    if (ret != 1)
+        return IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+
+    return 0;
+}
+
 #if defined(IOTEX_CIPHER_MODE_CBC)
 int iotex_aes_crypt_cbc( iotex_aes_context *ctx, int mode, size_t length, unsigned char iv[16], const unsigned char *input, unsigned char *output )
 {
     int i;
     int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
-    unsigned char temp[16];
+    unsigned char temp[16 * TC_AES_PARALLEL];
+    size_t n;
+    size_t j;
 
     if ( ctx == NULL )
         return (IOTEX_ERR_AES_BAD_INPUT_DATA);
@@ -1542,21 +1878,30 @@ int iotex_aes_crypt_cbc( iotex_aes_context *ctx, int mode, size_t length, unsign
 
     if( mode == IOTEX_AES_DECRYPT )
     {
+        /* Blocks decrypt independently, so a batch goes through the cipher
+         * at once and is chained afterwards from the saved ciphertext */
         while( length > 0 )
         {
-            memcpy( temp, input, 16 );
-            ret = tc_aes_decrypt(output, input, &s);
+            n = length < sizeof( temp ) ? length : sizeof( temp );
+
+            memcpy( temp, input, n );
+            ret = tc_aes_decrypt_blocks(output, temp, n / 16, AES_SCHED( ctx ));
             if( ret != 1 )
+            {
+                ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
                 goto exit;
+            }
 
             for( i = 0; i < 16; i++ )
                 output[i] = (unsigned char)( output[i] ^ iv[i] );
+            for( j = 16; j < n; j++ )
+                output[j] = (unsigned char)( output[j] ^ temp[j - 16] );
 
-            memcpy( iv, temp, 16 );
+            memcpy( iv, temp + n - 16, 16 );
 
-            input  += 16;
-            output += 16;
-            length -= 16;
+            input  += n;
+            output += n;
+            length -= n;
         }
     }
     else
@@ -1566,9 +1911,12 @@ int iotex_aes_crypt_cbc( iotex_aes_context *ctx, int mode, size_t length, unsign
             for( i = 0; i < 16; i++ )
                 output[i] = (unsigned char)( input[i] ^ iv[i] );
 
-            ret = tc_aes_encrypt(output, output, &s);
+            ret = tc_aes_encrypt(output, output, AES_SCHED( ctx ));
             if( ret != 1 )
+            {
+                ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
                 goto exit;
+            }
             memcpy( iv, output, 16 );
 
             input  += 16;
@@ -1610,6 +1958,16 @@ int iotex_aes_crypt_ofb( iotex_aes_context *ctx, size_t length, size_t *iv_off,
 #endif /* IOTEX_CIPHER_MODE_OFB */
 
 #if defined(IOTEX_CIPHER_MODE_CTR)
+/* The whole 128-bit block is the big-endian counter */
+static void aes_ctr_increment( unsigned char counter[16] )
+{
+    int i;
+
+    for( i = 16; i > 0; i-- )
+        if( ++counter[i - 1] != 0 )
+            break;
+}
+
 inline int iotex_aes_crypt_ctr( iotex_aes_context *ctx,
                        size_t length,
                        size_t *nc_off,
@@ -1618,49 +1976,679 @@ inline int iotex_aes_crypt_ctr( iotex_aes_context *ctx,
                        const unsigned char *input,
                        unsigned char *output )
 {
-	int ret = TC_CRYPTO_SUCCESS;
-	ret = tc_ctr_mode(output, length, input, length, nonce_counter, &s);
-	if( TC_CRYPTO_SUCCESS == ret )
-		return 0;
-	else
-		return IOTEX_ERR_CIPHER_INVALID_CONTEXT;
+    unsigned char stream[16 * TC_AES_PARALLEL];
+    size_t blocks, used, i;
+    size_t n;
+
+    if ( ctx == NULL || nc_off == NULL || nonce_counter == NULL || stream_block == NULL )
+        return (IOTEX_ERR_AES_BAD_INPUT_DATA);
+    if ( length > 0 && ( input == NULL || output == NULL ) )
+        return (IOTEX_ERR_AES_BAD_INPUT_DATA);
+
+    n = *nc_off;
+    if ( n > 15 )
+        return (IOTEX_ERR_AES_BAD_INPUT_DATA);
+
+    /* Use up the key stream left over by the previous call first */
+    while( n != 0 && length > 0 )
+    {
+        *output++ = (unsigned char)( *input++ ^ stream_block[n] );
+        n = ( n + 1 ) & 0x0F;
+        length--;
+    }
+
+    while( length > 0 )
+    {
+        blocks = ( length + 15 ) / 16;
+        if( blocks > TC_AES_PARALLEL )
+            blocks = TC_AES_PARALLEL;
+
+        for( i = 0; i < blocks; i++ )
+        {
+            memcpy( stream + 16 * i, nonce_counter, 16 );
+            aes_ctr_increment( nonce_counter );
+        }
+
+        if( tc_aes_encrypt_blocks(stream, stream, blocks, AES_SCHED( ctx )) != TC_CRYPTO_SUCCESS )
+        {
+            iotex_platform_zeroize( stream, sizeof( stream ) );
+            return IOTEX_ERR_CIPHER_INVALID_CONTEXT;
+        }
+
+        used = length < 16 * blocks ? length : 16 * blocks;
+        for( i = 0; i < used; i++ )
+            output[i] = (unsigned char)( input[i] ^ stream[i] );
+
+        /* A partial last block keeps the rest of its key stream */
+        n = used & 0x0F;
+        if( n != 0 )
+            memcpy( stream_block, stream + used - n, 16 );
+
+        input  += used;
+        output += used;
+        length -= used;
+    }
+
+    *nc_off = n;
+    iotex_platform_zeroize( stream, sizeof( stream ) );
+
+    return 0;
 }
 #endif /* IOTEX_CIPHER_MODE_CTR */
 
 /****************************************************************/
-/* RSA */
+/* GCM */
 /****************************************************************/
-inline void iotex_rsa_init( iotex_rsa_context *ctx )
+#if defined(IOTEX_GCM_C)
+inline void iotex_gcm_init( iotex_gcm_context *ctx )
 {
-    // TODO iotex_rsa_init( (iotex_rsa_context *)ctx );
-}
+    if ( ctx == NULL )
+        return;
 
-inline int iotex_rsa_set_padding( iotex_rsa_context *ctx, int padding,
-                             iotex_md_type_t hash_id )
-{     
-    // TODO iotex_rsa_set_padding((iotex_rsa_context *)ctx, padding, hash_id );
-	return 0;
+    memset( ctx, 0, sizeof( iotex_gcm_context ) );
 }
 
-inline int iotex_rsa_import( iotex_rsa_context *ctx,
-                        const iotex_mpi *N,
-                        const iotex_mpi *P, const iotex_mpi *Q,
-                        const iotex_mpi *D, const iotex_mpi *E )
+inline int iotex_gcm_setkey( iotex_gcm_context *ctx, iotex_cipher_id_t cipher, const unsigned char *key, unsigned int keybits )
 {
-    // TODO iotex_rsa_import( (iotex_rsa_context *)ctx, (iotex_mpi *)N, (iotex_mpi *)P, (iotex_mpi *)Q, (iotex_mpi *)D, (iotex_mpi *)E );
-	return 0;
+    if ( ctx == NULL || key == NULL )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    /* The tinycrypt engine is AES-128 only */
+    if ( cipher != IOTEX_CIPHER_ID_AES || keybits != 128 )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    if ( tc_gcm_set_key( &ctx->gcm, key ) != TC_CRYPTO_SUCCESS )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    return( 0 );
 }
 
-inline int iotex_rsa_import_raw( iotex_rsa_context *ctx,
-                            unsigned char const *N, size_t N_len,
-                            unsigned char const *P, size_t P_len,
-                            unsigned char const *Q, size_t Q_len,
-                            unsigned char const *D, size_t D_len,
-                            unsigned char const *E, size_t E_len )
+inline int iotex_gcm_starts( iotex_gcm_context *ctx, int mode, const unsigned char *iv, size_t iv_len )
 {
-    // TODO iotex_rsa_import_raw( (iotex_rsa_context *)ctx, N, N_len, P, P_len, Q, Q_len, D, D_len, E, E_len );
-	return 0;
-}
+    if ( ctx == NULL || iv == NULL )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    /* IV is limited to 2^64 bits, so 2^61 bytes */
+    if ( iv_len == 0 || ( (uint64_t) iv_len ) >> 61 != 0 )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    if ( tc_gcm_start( &ctx->gcm, iv, iv_len ) != TC_CRYPTO_SUCCESS )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    ctx->mode = mode;
+
+    return( 0 );
+}
+
+inline int iotex_gcm_update_ad( iotex_gcm_context *ctx, const unsigned char *add, size_t add_len )
+{
+    if ( ctx == NULL )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    /* Fails once data has been passed to iotex_gcm_update() */
+    if ( tc_gcm_update_aad( &ctx->gcm, add, add_len ) != TC_CRYPTO_SUCCESS )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    return( 0 );
+}
+
+inline int iotex_gcm_update( iotex_gcm_context *ctx, const unsigned char *input, size_t input_length, unsigned char *output, size_t output_size, size_t *output_length )
+{
+    int ret = 0;
+
+    if ( ctx == NULL || output_length == NULL )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    if ( output_size < input_length )
+        return( IOTEX_ERR_GCM_BUFFER_TOO_SMALL );
+
+    /* Output is produced immediately, so in-place is the only overlap allowed */
+    if ( output > input && (size_t) ( output - input ) < input_length )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    if ( ctx->mode == IOTEX_GCM_DECRYPT )
+        ret = tc_gcm_decrypt_update( &ctx->gcm, output, input, input_length );
+    else
+        ret = tc_gcm_encrypt_update( &ctx->gcm, output, input, input_length );
+
+    if ( ret != TC_CRYPTO_SUCCESS )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    *output_length = input_length;
+
+    return( 0 );
+}
+
+inline int iotex_gcm_finish( iotex_gcm_context *ctx, unsigned char *output, size_t output_size, size_t *output_length, unsigned char *tag, size_t tag_len )
+{
+    unsigned char full_tag[TC_GCM_TAG_SIZE];
+
+    (void) output;
+    (void) output_size;
+
+    if ( ctx == NULL || output_length == NULL || tag == NULL )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    if ( tag_len > TC_GCM_TAG_SIZE || tag_len < 4 )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    /* iotex_gcm_update() left nothing buffered */
+    *output_length = 0;
+
+    if ( tc_gcm_final( &ctx->gcm, full_tag ) != TC_CRYPTO_SUCCESS )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    memcpy( tag, full_tag, tag_len );
+    iotex_platform_zeroize( full_tag, sizeof( full_tag ) );
+
+    return( 0 );
+}
+
+inline int iotex_gcm_crypt_and_tag( iotex_gcm_context *ctx, int mode, size_t length, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len, const unsigned char *input, unsigned char *output, size_t tag_len, unsigned char *tag )
+{
+    int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+    size_t olen;
+
+    if( ( ret = iotex_gcm_starts( ctx, mode, iv, iv_len ) ) != 0 )
+        return( ret );
+
+    if( ( ret = iotex_gcm_update_ad( ctx, add, add_len ) ) != 0 )
+        return( ret );
+
+    if( ( ret = iotex_gcm_update( ctx, input, length,
+                                    output, length, &olen ) ) != 0 )
+        return( ret );
+
+    if( ( ret = iotex_gcm_finish( ctx, NULL, 0, &olen, tag, tag_len ) ) != 0 )
+        return( ret );
+
+    return( 0 );
+}
+
+inline int iotex_gcm_auth_decrypt( iotex_gcm_context *ctx, size_t length, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len, const unsigned char *tag, size_t tag_len, const unsigned char *input, unsigned char *output )
+{
+    int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+    unsigned char check_tag[TC_GCM_TAG_SIZE];
+
+    if ( tag == NULL )
+        return( IOTEX_ERR_GCM_BAD_INPUT );
+
+    if( ( ret = iotex_gcm_crypt_and_tag( ctx, IOTEX_GCM_DECRYPT, length,
+                                   iv, iv_len, add, add_len,
+                                   input, output, tag_len, check_tag ) ) != 0 )
+    {
+        return( ret );
+    }
+
+    /* Check tag in "constant-time" */
+    if( iotex_psa_safer_memcmp( tag, check_tag, tag_len ) != 0 )
+    {
+        iotex_platform_zeroize( output, length );
+        ret = IOTEX_ERR_GCM_AUTH_FAILED;
+    }
+
+    iotex_platform_zeroize( check_tag, sizeof( check_tag ) );
+
+    return( ret );
+}
+
+inline void iotex_gcm_free( iotex_gcm_context *ctx )
+{
+    if( ctx == NULL )
+        return;
+
+    iotex_platform_zeroize( ctx, sizeof( iotex_gcm_context ) );
+}
+#endif /* IOTEX_GCM_C */
+
+/****************************************************************/
+/* CHACHA20 */
+/****************************************************************/
+#if defined(IOTEX_CHACHA20_C)
+inline void iotex_chacha20_init( iotex_chacha20_context *ctx )
+{
+    if ( ctx == NULL )
+        return;
+
+    memset( ctx, 0, sizeof( iotex_chacha20_context ) );
+}
+
+inline void iotex_chacha20_free( iotex_chacha20_context *ctx )
+{
+    if( ctx == NULL )
+        return;
+
+    iotex_platform_zeroize( ctx, sizeof( iotex_chacha20_context ) );
+}
+
+inline int iotex_chacha20_setkey( iotex_chacha20_context *ctx, const unsigned char key[32] )
+{
+    if ( ctx == NULL )
+        return( IOTEX_ERR_CHACHA20_BAD_INPUT_DATA );
+
+    if ( tc_chacha20_set_key( &ctx->chacha20, key ) != TC_CRYPTO_SUCCESS )
+        return( IOTEX_ERR_CHACHA20_BAD_INPUT_DATA );
+
+    return( 0 );
+}
+
+inline int iotex_chacha20_starts( iotex_chacha20_context* ctx, const unsigned char nonce[12], uint32_t counter )
+{
+    if ( ctx == NULL )
+        return( IOTEX_ERR_CHACHA20_BAD_INPUT_DATA );
+
+    if ( tc_chacha20_start( &ctx->chacha20, nonce, counter ) != TC_CRYPTO_SUCCESS )
+        return( IOTEX_ERR_CHACHA20_BAD_INPUT_DATA );
+
+    return( 0 );
+}
+
+inline int iotex_chacha20_update( iotex_chacha20_context *ctx, size_t size, const unsigned char *input, unsigned char *output )
+{
+    if ( ctx == NULL )
+        return( IOTEX_ERR_CHACHA20_BAD_INPUT_DATA );
+
+    if ( tc_chacha20_crypt( &ctx->chacha20, output, input, size ) != TC_CRYPTO_SUCCESS )
+        return( IOTEX_ERR_CHACHA20_BAD_INPUT_DATA );
+
+    return( 0 );
+}
+
+inline int iotex_chacha20_crypt( const unsigned char key[32], const unsigned char nonce[12], uint32_t counter, size_t data_len, const unsigned char* input, unsigned char* output )
+{
+    iotex_chacha20_context ctx;
+    int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+
+    iotex_chacha20_init( &ctx );
+
+    ret = iotex_chacha20_setkey( &ctx, key );
+    if( ret != 0 )
+        goto cleanup;
+
+    ret = iotex_chacha20_starts( &ctx, nonce, counter );
+    if( ret != 0 )
+        goto cleanup;
+
+    ret = iotex_chacha20_update( &ctx, data_len, input, output );
+
+cleanup:
+    iotex_chacha20_free( &ctx );
+    return( ret );
+}
+#endif /* IOTEX_CHACHA20_C */
+
+/****************************************************************/
+/* POLY1305 */
+/****************************************************************/
+#if defined(IOTEX_POLY1305_C)
+inline void iotex_poly1305_init( iotex_poly1305_context *ctx )
+{
+    if ( ctx == NULL )
+        return;
+
+    memset( ctx, 0, sizeof( iotex_poly1305_context ) );
+}
+
+inline void iotex_poly1305_free( iotex_poly1305_context *ctx )
+{
+    if( ctx == NULL )
+        return;
+
+    iotex_platform_zeroize( ctx, sizeof( iotex_poly1305_context ) );
+}
+
+inline int iotex_poly1305_starts( iotex_poly1305_context *ctx, const unsigned char key[32] )
+{
+    if ( ctx == NULL )
+        return( IOTEX_ERR_POLY1305_BAD_INPUT_DATA );
+
+    if ( tc_poly1305_init( &ctx->poly1305, key ) != TC_CRYPTO_SUCCESS )
+        return( IOTEX_ERR_POLY1305_BAD_INPUT_DATA );
+
+    return( 0 );
+}
+
+inline int iotex_poly1305_update( iotex_poly1305_context *ctx, const unsigned char *input, size_t ilen )
+{
+    if ( ctx == NULL )
+        return( IOTEX_ERR_POLY1305_BAD_INPUT_DATA );
+
+    if ( tc_poly1305_update( &ctx->poly1305, input, ilen ) != TC_CRYPTO_SUCCESS )
+        return( IOTEX_ERR_POLY1305_BAD_INPUT_DATA );
+
+    return( 0 );
+}
+
+inline int iotex_poly1305_finish( iotex_poly1305_context *ctx, unsigned char mac[16] )
+{
+    if ( ctx == NULL )
+        return( IOTEX_ERR_POLY1305_BAD_INPUT_DATA );
+
+    /* Wipes the state, a new tag starts with iotex_poly1305_starts() */
+    if ( tc_poly1305_final( &ctx->poly1305, mac ) != TC_CRYPTO_SUCCESS )
+        return( IOTEX_ERR_POLY1305_BAD_INPUT_DATA );
+
+    return( 0 );
+}
+
+inline int iotex_poly1305_mac( const unsigned char key[32], const unsigned char *input, size_t ilen, unsigned char mac[16] )
+{
+    iotex_poly1305_context ctx;
+    int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+
+    iotex_poly1305_init( &ctx );
+
+    ret = iotex_poly1305_starts( &ctx, key );
+    if( ret != 0 )
+        goto cleanup;
+
+    ret = iotex_poly1305_update( &ctx, input, ilen );
+    if( ret != 0 )
+        goto cleanup;
+
+    ret = iotex_poly1305_finish( &ctx, mac );
+
+cleanup:
+    iotex_poly1305_free( &ctx );
+    return( ret );
+}
+#endif /* IOTEX_POLY1305_C */
+
+/****************************************************************/
+/* CHACHAPOLY */
+/****************************************************************/
+#if defined(IOTEX_CHACHAPOLY_C)
+#define CHACHAPOLY_STATE_INIT       ( 0 )
+#define CHACHAPOLY_STATE_AAD        ( 1 )
+#define CHACHAPOLY_STATE_CIPHERTEXT ( 2 ) /* Encrypting or decrypting */
+#define CHACHAPOLY_STATE_FINISHED   ( 3 )
+
+/*
+ * Adds nul bytes to pad the AAD or the ciphertext for Poly1305
+ */
+static int chachapoly_pad( iotex_chachapoly_context *ctx, uint64_t len )
+{
+    uint32_t partial_block_len = (uint32_t) ( len % 16U );
+    unsigned char zeroes[15];
+
+    if( partial_block_len == 0U )
+        return( 0 );
+
+    memset( zeroes, 0, sizeof( zeroes ) );
+
+    return( iotex_poly1305_update( &ctx->poly1305_ctx,
+                                     zeroes,
+                                     16U - partial_block_len ) );
+}
+
+inline void iotex_chachapoly_init( iotex_chachapoly_context *ctx )
+{
+    if ( ctx == NULL )
+        return;
+
+    iotex_chacha20_init( &ctx->chacha20_ctx );
+    iotex_poly1305_init( &ctx->poly1305_ctx );
+    ctx->aad_len        = 0U;
+    ctx->ciphertext_len = 0U;
+    ctx->state          = CHACHAPOLY_STATE_INIT;
+    ctx->mode           = IOTEX_CHACHAPOLY_ENCRYPT;
+}
+
+inline void iotex_chachapoly_free( iotex_chachapoly_context *ctx )
+{
+    if( ctx == NULL )
+        return;
+
+    iotex_chacha20_free( &ctx->chacha20_ctx );
+    iotex_poly1305_free( &ctx->poly1305_ctx );
+    ctx->aad_len        = 0U;
+    ctx->ciphertext_len = 0U;
+    ctx->state          = CHACHAPOLY_STATE_INIT;
+    ctx->mode           = IOTEX_CHACHAPOLY_ENCRYPT;
+}
+
+inline int iotex_chachapoly_setkey( iotex_chachapoly_context *ctx, const unsigned char key[32] )
+{
+    if ( ctx == NULL || key == NULL )
+        return( IOTEX_ERR_CHACHA20_BAD_INPUT_DATA );
+
+    return( iotex_chacha20_setkey( &ctx->chacha20_ctx, key ) );
+}
+
+inline int iotex_chachapoly_starts( iotex_chachapoly_context *ctx, const unsigned char nonce[12], iotex_chachapoly_mode_t mode )
+{
+    int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+    unsigned char poly1305_key[64];
+
+    if ( ctx == NULL || nonce == NULL )
+        return( IOTEX_ERR_CHACHA20_BAD_INPUT_DATA );
+
+    /* Set counter = 0, will be update to 1 when generating Poly1305 key */
+    ret = iotex_chacha20_starts( &ctx->chacha20_ctx, nonce, 0U );
+    if( ret != 0 )
+        goto cleanup;
+
+    /* Generate the Poly1305 key by getting the ChaCha20 keystream output with
+     * counter = 0.  This is the same as encrypting a buffer of zeroes.
+     * Only the first 256-bits (32 bytes) of the key is used for Poly1305.
+     * The other 256 bits are discarded.
+     */
+    memset( poly1305_key, 0, sizeof( poly1305_key ) );
+    ret = iotex_chacha20_update( &ctx->chacha20_ctx, sizeof( poly1305_key ),
+                                   poly1305_key, poly1305_key );
+    if( ret != 0 )
+        goto cleanup;
+
+    ret = iotex_poly1305_starts( &ctx->poly1305_ctx, poly1305_key );
+
+    if( ret == 0 )
+    {
+        ctx->aad_len        = 0U;
+        ctx->ciphertext_len = 0U;
+        ctx->state          = CHACHAPOLY_STATE_AAD;
+        ctx->mode           = mode;
+    }
+
+cleanup:
+    iotex_platform_zeroize( poly1305_key, 64U );
+    return( ret );
+}
+
+inline int iotex_chachapoly_update_aad( iotex_chachapoly_context *ctx, const unsigned char *aad, size_t aad_len )
+{
+    if ( ctx == NULL )
+        return( IOTEX_ERR_CHACHA20_BAD_INPUT_DATA );
+
+    if( ctx->state != CHACHAPOLY_STATE_AAD )
+        return( IOTEX_ERR_CHACHAPOLY_BAD_STATE );
+
+    ctx->aad_len += aad_len;
+
+    return( iotex_poly1305_update( &ctx->poly1305_ctx, aad, aad_len ) );
+}
+
+inline int iotex_chachapoly_update( iotex_chachapoly_context *ctx, size_t len, const unsigned char *input, unsigned char *output )
+{
+    int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+
+    if ( ctx == NULL )
+        return( IOTEX_ERR_CHACHA20_BAD_INPUT_DATA );
+
+    if( ( ctx->state != CHACHAPOLY_STATE_AAD ) &&
+        ( ctx->state != CHACHAPOLY_STATE_CIPHERTEXT ) )
+    {
+        return( IOTEX_ERR_CHACHAPOLY_BAD_STATE );
+    }
+
+    if( ctx->state == CHACHAPOLY_STATE_AAD )
+    {
+        ctx->state = CHACHAPOLY_STATE_CIPHERTEXT;
+
+        ret = chachapoly_pad( ctx, ctx->aad_len );
+        if( ret != 0 )
+            return( ret );
+    }
+
+    ctx->ciphertext_len += len;
+
+    if( ctx->mode == IOTEX_CHACHAPOLY_ENCRYPT )
+    {
+        ret = iotex_chacha20_update( &ctx->chacha20_ctx, len, input, output );
+        if( ret != 0 )
+            return( ret );
+
+        ret = iotex_poly1305_update( &ctx->poly1305_ctx, output, len );
+        if( ret != 0 )
+            return( ret );
+    }
+    else /* DECRYPT */
+    {
+        /* The MAC covers the ciphertext, which may be overwritten in place */
+        ret = iotex_poly1305_update( &ctx->poly1305_ctx, input, len );
+        if( ret != 0 )
+            return( ret );
+
+        ret = iotex_chacha20_update( &ctx->chacha20_ctx, len, input, output );
+        if( ret != 0 )
+            return( ret );
+    }
+
+    return( 0 );
+}
+
+inline int iotex_chachapoly_finish( iotex_chachapoly_context *ctx, unsigned char mac[16] )
+{
+    int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+    unsigned char len_block[16];
+    unsigned int i;
+
+    if ( ctx == NULL || mac == NULL )
+        return( IOTEX_ERR_CHACHA20_BAD_INPUT_DATA );
+
+    if( ctx->state == CHACHAPOLY_STATE_INIT )
+        return( IOTEX_ERR_CHACHAPOLY_BAD_STATE );
+
+    if( ctx->state == CHACHAPOLY_STATE_AAD )
+        ret = chachapoly_pad( ctx, ctx->aad_len );
+    else
+        ret = chachapoly_pad( ctx, ctx->ciphertext_len );
+    if( ret != 0 )
+        return( ret );
+
+    ctx->state = CHACHAPOLY_STATE_FINISHED;
+
+    /* The lengths of the AAD and ciphertext are processed by
+     * Poly1305 as the final 128-bit block, encoded as little-endian integers.
+     */
+    for( i = 0; i < 8; i++ )
+    {
+        len_block[i]     = (unsigned char) ( ctx->aad_len >> ( 8 * i ) );
+        len_block[8 + i] = (unsigned char) ( ctx->ciphertext_len >> ( 8 * i ) );
+    }
+
+    ret = iotex_poly1305_update( &ctx->poly1305_ctx, len_block, 16U );
+    if( ret != 0 )
+        return( ret );
+
+    return( iotex_poly1305_finish( &ctx->poly1305_ctx, mac ) );
+}
+
+static int chachapoly_crypt_and_tag( iotex_chachapoly_context *ctx,
+                                     iotex_chachapoly_mode_t mode,
+                                     size_t length,
+                                     const unsigned char nonce[12],
+                                     const unsigned char *aad,
+                                     size_t aad_len,
+                                     const unsigned char *input,
+                                     unsigned char *output,
+                                     unsigned char tag[16] )
+{
+    int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+
+    ret = iotex_chachapoly_starts( ctx, nonce, mode );
+    if( ret != 0 )
+        return( ret );
+
+    ret = iotex_chachapoly_update_aad( ctx, aad, aad_len );
+    if( ret != 0 )
+        return( ret );
+
+    ret = iotex_chachapoly_update( ctx, length, input, output );
+    if( ret != 0 )
+        return( ret );
+
+    return( iotex_chachapoly_finish( ctx, tag ) );
+}
+
+inline int iotex_chachapoly_encrypt_and_tag( iotex_chachapoly_context *ctx, size_t length, const unsigned char nonce[12], const unsigned char *aad, size_t aad_len, const unsigned char *input, unsigned char *output, unsigned char tag[16] )
+{
+    return( chachapoly_crypt_and_tag( ctx, IOTEX_CHACHAPOLY_ENCRYPT,
+                                      length, nonce, aad, aad_len,
+                                      input, output, tag ) );
+}
+
+inline int iotex_chachapoly_auth_decrypt( iotex_chachapoly_context *ctx, size_t length, const unsigned char nonce[12], const unsigned char *aad, size_t aad_len, const unsigned char tag[16], const unsigned char *input, unsigned char *output )
+{
+    int ret = IOTEX_ERR_ERROR_CORRUPTION_DETECTED;
+    unsigned char check_tag[16];
+
+    if ( tag == NULL )
+        return( IOTEX_ERR_CHACHA20_BAD_INPUT_DATA );
+
+    if( ( ret = chachapoly_crypt_and_tag( ctx,
+                        IOTEX_CHACHAPOLY_DECRYPT, length, nonce,
+                        aad, aad_len, input, output, check_tag ) ) != 0 )
+    {
+        return( ret );
+    }
+
+    /* Check tag in "constant-time" */
+    if( iotex_psa_safer_memcmp( tag, check_tag, sizeof( check_tag ) ) != 0 )
+    {
+        iotex_platform_zeroize( output, length );
+        ret = IOTEX_ERR_CHACHAPOLY_AUTH_FAILED;
+    }
+
+    iotex_platform_zeroize( check_tag, sizeof( check_tag ) );
+
+    return( ret );
+}
+#endif /* IOTEX_CHACHAPOLY_C */
+
+/****************************************************************/
+/* RSA */
+/****************************************************************/
+inline void iotex_rsa_init( iotex_rsa_context *ctx )
+{
+    // TODO iotex_rsa_init( (iotex_rsa_context *)ctx );
+}
+
+inline int iotex_rsa_set_padding( iotex_rsa_context *ctx, int padding,
+                             iotex_md_type_t hash_id )
+{     
+    // TODO iotex_rsa_set_padding((iotex_rsa_context *)ctx, padding, hash_id );
+	return 0;
+}
+
+inline int iotex_rsa_import( iotex_rsa_context *ctx,
+                        const iotex_mpi *N,
+                        const iotex_mpi *P, const iotex_mpi *Q,
+                        const iotex_mpi *D, const iotex_mpi *E )
+{
+    // TODO iotex_rsa_import( (iotex_rsa_context *)ctx, (iotex_mpi *)N, (iotex_mpi *)P, (iotex_mpi *)Q, (iotex_mpi *)D, (iotex_mpi *)E );
+	return 0;
+}
+
+inline int iotex_rsa_import_raw( iotex_rsa_context *ctx,
+                            unsigned char const *N, size_t N_len,
+                            unsigned char const *P, size_t P_len,
+                            unsigned char const *Q, size_t Q_len,
+                            unsigned char const *D, size_t D_len,
+                            unsigned char const *E, size_t E_len )
+{
+    // TODO iotex_rsa_import_raw( (iotex_rsa_context *)ctx, N, N_len, P, P_len, Q, Q_len, D, D_len, E, E_len );
+	return 0;
+}
 
 inline int iotex_rsa_complete( iotex_rsa_context *ctx )
 {
@@ -1950,7 +2938,6 @@ inline void iotex_mpi_free( iotex_mpi *X )
 /* ECP */
 /****************************************************************/
 static uint8_t public[2 * NUM_ECC_BYTES];
-static uint8_t EdPublic[NUM_ECC_BYTES];
 
 inline void iotex_ecp_keypair_init( iotex_ecp_keypair *key )
 {
@@ -2072,7 +3059,10 @@ inline int iotex_ecp_gen_key( psa_key_type_t type, uint8_t *key_buffer, size_t k
     switch (type)
     {
     case PSA_ECC_FAMILY_TWISTED_EDWARDS:
-        return uECC_make_key_with_ed25519(EdPublic, key_buffer);
+        /* The key is the 32 byte seed, expanded when the key is used */
+        if (key_buffer_size < 32 || !default_CSPRNG(key_buffer, 32))
+            return 1;
+        return 0;
     case PSA_ECC_FAMILY_SECP_R1:
         curve = uECC_secp256r1();
         break;
@@ -2099,7 +3089,8 @@ inline int iotex_ecp_calc_pub_key( psa_key_type_t type, uint8_t *key_buffer, siz
     switch (type)
     {
     case PSA_ECC_FAMILY_TWISTED_EDWARDS:
-        return uECC_compute_public_key_with_ed25519(key_buffer, EdPublic);
+        /* Derived in the key context of the slot, see iotex_eddsa_key_load() */
+        return 0;
     case PSA_ECC_FAMILY_SECP_R1:
         curve = uECC_secp256r1();
         break;
@@ -2125,7 +3116,7 @@ inline int iotex_psa_ecp_export_key_from_raw_data(psa_key_type_t type, const uin
     switch (type)
     {
     case PSA_ECC_FAMILY_TWISTED_EDWARDS:
-        uECC_compute_public_key_with_ed25519(key_buffer, data);
+        uECC_ed25519_public_key(key_buffer, data);
         *data_length = 32;
 
         return 0;
@@ -2145,6 +3136,90 @@ inline int iotex_psa_ecp_export_key_from_raw_data(psa_key_type_t type, const uin
     return 0;
 }
 
+static uECC_Curve iotex_ecp_secp_curve( psa_key_type_t type )
+{
+    switch (type)
+    {
+    case PSA_ECC_FAMILY_SECP_R1:
+        return uECC_secp256r1();
+    case PSA_ECC_FAMILY_SECP_K1:
+        return uECC_secp256k1();
+    default:
+        return NULL;
+    }
+}
+
+/* The cached point is x then y in native words, copied in and out with memcpy */
+#if (2 * NUM_ECC_BYTES) > PSA_KEY_SLOT_PUBLIC_POINT_SIZE
+#error "PSA_KEY_SLOT_PUBLIC_POINT_SIZE is too small for the ECC backend"
+#endif
+
+inline int iotex_ecp_load_public_point( psa_key_type_t type, const uint8_t *key_buffer, uint8_t *point )
+{
+    uECC_Curve curve = iotex_ecp_secp_curve( type );
+    uECC_word_t _private[NUM_ECC_WORDS];
+    uECC_word_t _public[NUM_ECC_WORDS * 2];
+
+    if (NULL == key_buffer || NULL == point || NULL == curve)
+        return 1;
+
+    uECC_vli_bytesToNative(_private, key_buffer, BITS_TO_BYTES(curve->num_n_bits));
+    if (!EccPoint_compute_public_key(_public, _private, curve)) {
+        _set_secure(_private, 0, sizeof(_private));
+        return 1;
+    }
+    _set_secure(_private, 0, sizeof(_private));
+
+    memcpy(point, _public, sizeof(_public));
+
+    return 0;
+}
+
+inline int iotex_ecp_read_public_point( psa_key_type_t type, const uint8_t *data, size_t data_length, uint8_t *point )
+{
+    uECC_Curve curve = iotex_ecp_secp_curve( type );
+    uECC_word_t _public[NUM_ECC_WORDS * 2];
+
+    if (NULL == data || NULL == point || NULL == curve)
+        return 1;
+
+    /* 0x04 || x || y as PSA formats it, or the bare x || y of this backend */
+    if (data_length == 2 * (size_t)curve->num_bytes + 1 && 0x04 == data[0])
+        data++;
+    else if (data_length != 2 * (size_t)curve->num_bytes)
+        return 1;
+
+    uECC_vli_bytesToNative(_public, data, curve->num_bytes);
+    uECC_vli_bytesToNative(_public + curve->num_words, data + curve->num_bytes, curve->num_bytes);
+
+    if (uECC_valid_point(_public, curve) != 0)
+        return 1;
+
+    memcpy(point, _public, sizeof(_public));
+
+    return 0;
+}
+
+inline int iotex_ecp_write_public_point( psa_key_type_t type, const uint8_t *point, uint8_t *data, size_t data_size, size_t *data_length )
+{
+    uECC_Curve curve = iotex_ecp_secp_curve( type );
+    uECC_word_t _public[NUM_ECC_WORDS * 2];
+
+    if (NULL == point || NULL == data || NULL == curve)
+        return 1;
+
+    if (data_size < 2 * (size_t)curve->num_bytes)
+        return 1;
+
+    memcpy(_public, point, sizeof(_public));
+
+    uECC_vli_nativeToBytes(data, curve->num_bytes, _public);
+    uECC_vli_nativeToBytes(data + curve->num_bytes, curve->num_bytes, _public + curve->num_words);
+    *data_length = 2 * curve->num_bytes;
+
+    return 0;
+}
+
 /****************************************************************/
 /* ECDSA */
 /****************************************************************/
@@ -2179,8 +3254,214 @@ inline int iotex_ecdsa_verify( iotex_ecp_group *grp,
 }
 
 #else
+
+#ifndef IOTEX_PSA_ECDSA_POOL_DEPTH
+#define IOTEX_PSA_ECDSA_POOL_DEPTH 0
+#endif
+
+#if IOTEX_PSA_ECDSA_POOL_DEPTH > 0
+
+#define ECDSA_POOL_FREE     0
+#define ECDSA_POOL_BUSY     1       /* being filled or taken */
+#define ECDSA_POOL_READY    2
+
+/* A forked child inherits the parent's precomputed nonces; signing with them in
+ * both processes would reuse k and give away the key, so each nonce records
+ * the process that made it */
+#if defined(unix) || defined(__unix__) || defined(__unix) || \
+    ( defined(__APPLE__) && defined(__MACH__) )
+#include <unistd.h>
+#define ECDSA_POOL_PID()    ( (long) getpid() )
+#else
+#define ECDSA_POOL_PID()    ( 0L )
+#endif
+
+/* Slots change hands through their state, so the pool may be refilled by one
+ * task while another signs */
+static struct iotex_psa_ecdsa_pool
+{
+    struct
+    {
+        uint8_t state;
+        long pid;                   /* process that precomputed the nonce */
+        uECC_sign_nonce nonce;
+    } slot[IOTEX_PSA_ECDSA_POOL_DEPTH];
+
+    psa_ecc_family_t family;        /* configured curve, 0 to follow the keys */
+    psa_ecc_family_t last;          /* curve of the last ECDSA key used */
+    size_t target;
+    size_t per_refill;
+
+    iotex_psa_ecdsa_pool_stats_t stats;
+
+} ecdsa_pool = { .target = IOTEX_PSA_ECDSA_POOL_DEPTH, .per_refill = 1 };
+
+static int ecdsa_pool_acquire( size_t i, uint8_t state )
+{
+    return __atomic_compare_exchange_n( &ecdsa_pool.slot[i].state, &state, ECDSA_POOL_BUSY,
+                                        false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED );
+}
+
+static void ecdsa_pool_release( size_t i, uint8_t state )
+{
+    if ( ECDSA_POOL_FREE == state )
+        _set_secure( &ecdsa_pool.slot[i].nonce, 0, sizeof( ecdsa_pool.slot[i].nonce ) );
+
+    __atomic_store_n( &ecdsa_pool.slot[i].state, state, __ATOMIC_RELEASE );
+}
+
+/* Whether the nonce in slot i, held or READY, may be used for curve here */
+static int ecdsa_pool_usable( size_t i, uECC_Curve curve )
+{
+    return ecdsa_pool.slot[i].nonce.curve == curve &&
+           ecdsa_pool.slot[i].pid == ECDSA_POOL_PID();
+}
+
+/* Moves a nonce for curve out of the pool into nonce */
+static int ecdsa_pool_take( uECC_Curve curve, uECC_sign_nonce *nonce )
+{
+    size_t i;
+
+    for ( i = 0; i < IOTEX_PSA_ECDSA_POOL_DEPTH; i++ )
+    {
+        if ( !ecdsa_pool_acquire( i, ECDSA_POOL_READY ) )
+            continue;
+
+        if ( ecdsa_pool_usable( i, curve ) )
+        {
+            memcpy( nonce, &ecdsa_pool.slot[i].nonce, sizeof( *nonce ) );
+            ecdsa_pool_release( i, ECDSA_POOL_FREE );
+            return 1;
+        }
+
+        /* Inherited across fork(), never to be used */
+        if ( ecdsa_pool.slot[i].pid != ECDSA_POOL_PID() )
+        {
+            ecdsa_pool_release( i, ECDSA_POOL_FREE );
+            continue;
+        }
+
+        ecdsa_pool_release( i, ECDSA_POOL_READY );
+    }
+
+    return 0;
+}
+
+void iotex_psa_ecdsa_pool_config( psa_ecc_family_t family, size_t target, size_t per_refill )
+{
+    ecdsa_pool.family = family;
+    ecdsa_pool.target = target < IOTEX_PSA_ECDSA_POOL_DEPTH ? target : IOTEX_PSA_ECDSA_POOL_DEPTH;
+    ecdsa_pool.per_refill = per_refill;
+}
+
+size_t iotex_psa_ecdsa_pool_refill( void )
+{
+    psa_ecc_family_t family = ecdsa_pool.family ? ecdsa_pool.family :
+                              __atomic_load_n( &ecdsa_pool.last, __ATOMIC_RELAXED );
+    uECC_Curve curve = iotex_ecp_secp_curve( family );
+    size_t ready = 0, done = 0, i;
+
+    if ( NULL == curve )
+        return 0;
+
+    for ( i = 0; i < IOTEX_PSA_ECDSA_POOL_DEPTH; i++ )
+        if ( __atomic_load_n( &ecdsa_pool.slot[i].state, __ATOMIC_ACQUIRE ) == ECDSA_POOL_READY &&
+             ecdsa_pool_usable( i, curve ) )
+            ready++;
+
+    /* Free slots first, then the ones holding nonces for another curve or
+     * from another process */
+    for ( i = 0; i < 2 * IOTEX_PSA_ECDSA_POOL_DEPTH; i++ )
+    {
+        size_t j = i % IOTEX_PSA_ECDSA_POOL_DEPTH;
+
+        if ( ready >= ecdsa_pool.target || done >= ecdsa_pool.per_refill )
+            break;
+
+        if ( i < IOTEX_PSA_ECDSA_POOL_DEPTH ) {
+            if ( !ecdsa_pool_acquire( j, ECDSA_POOL_FREE ) )
+                continue;
+        } else {
+            if ( !ecdsa_pool_acquire( j, ECDSA_POOL_READY ) )
+                continue;
+
+            if ( ecdsa_pool_usable( j, curve ) ) {
+                ecdsa_pool_release( j, ECDSA_POOL_READY );
+                continue;
+            }
+        }
+
+        if ( !uECC_sign_precompute( &ecdsa_pool.slot[j].nonce, curve ) )
+        {
+            ecdsa_pool_release( j, ECDSA_POOL_FREE );
+            break;
+        }
+
+        ecdsa_pool.slot[j].pid = ECDSA_POOL_PID();
+        ecdsa_pool_release( j, ECDSA_POOL_READY );
+        ready++;
+        done++;
+    }
+
+    __atomic_fetch_add( &ecdsa_pool.stats.precomputed, (uint32_t)done, __ATOMIC_RELAXED );
+
+    return done;
+}
+
+void iotex_psa_ecdsa_pool_get_stats( iotex_psa_ecdsa_pool_stats_t *stats )
+{
+    size_t i;
+
+    if ( NULL == stats )
+        return;
+
+    stats->hits = __atomic_load_n( &ecdsa_pool.stats.hits, __ATOMIC_RELAXED );
+    stats->misses = __atomic_load_n( &ecdsa_pool.stats.misses, __ATOMIC_RELAXED );
+    stats->precomputed = __atomic_load_n( &ecdsa_pool.stats.precomputed, __ATOMIC_RELAXED );
+    stats->ready = 0;
+
+    for ( i = 0; i < IOTEX_PSA_ECDSA_POOL_DEPTH; i++ )
+        if ( __atomic_load_n( &ecdsa_pool.slot[i].state, __ATOMIC_RELAXED ) == ECDSA_POOL_READY )
+            stats->ready++;
+}
+
+void iotex_psa_ecdsa_pool_clear( void )
+{
+    size_t i;
+
+    for ( i = 0; i < IOTEX_PSA_ECDSA_POOL_DEPTH; i++ )
+        if ( ecdsa_pool_acquire( i, ECDSA_POOL_READY ) )
+            ecdsa_pool_release( i, ECDSA_POOL_FREE );
+}
+
+#else
+
+void iotex_psa_ecdsa_pool_config( psa_ecc_family_t family, size_t target, size_t per_refill )
+{
+    (void) family;
+    (void) target;
+    (void) per_refill;
+}
+
+size_t iotex_psa_ecdsa_pool_refill( void )
+{
+    return 0;
+}
+
+void iotex_psa_ecdsa_pool_get_stats( iotex_psa_ecdsa_pool_stats_t *stats )
+{
+    if ( NULL != stats )
+        memset( stats, 0, sizeof( *stats ) );
+}
+
+void iotex_psa_ecdsa_pool_clear( void )
+{
+}
+
+#endif /* IOTEX_PSA_ECDSA_POOL_DEPTH > 0 */
+
 inline int iotex_ecdsa_sign( psa_key_type_t type, 
-                            const uint8_t *key_buffer, size_t key_buffer_size, 
+                            const uint8_t *key_buffer, size_t key_buffer_size, psa_algorithm_t alg,
                             const uint8_t *hash, size_t hash_length, uint8_t *signature, size_t *signature_length )
 {
     const struct uECC_Curve_t * curve;
@@ -2204,7 +3485,28 @@ inline int iotex_ecdsa_sign( psa_key_type_t type,
             return 1;
     }
 
-    ret = uECC_sign(key_buffer, hash, hash_length, signature, curve);
+#if IOTEX_PSA_ECDSA_POOL_DEPTH > 0
+    uECC_sign_nonce nonce;
+
+    __atomic_store_n( &ecdsa_pool.last, (psa_ecc_family_t)type, __ATOMIC_RELAXED );
+
+    if ( ecdsa_pool_take( curve, &nonce ) )
+    {
+        __atomic_fetch_add( &ecdsa_pool.stats.hits, 1, __ATOMIC_RELAXED );
+        ret = uECC_sign_with_nonce(key_buffer, hash, hash_length, &nonce, signature, PSA_ALG_ECDSA_IS_LOW_S(alg), curve);
+        _set_secure( &nonce, 0, sizeof( nonce ) );
+    }
+    else
+    {
+        __atomic_fetch_add( &ecdsa_pool.stats.misses, 1, __ATOMIC_RELAXED );
+#endif
+    if ( PSA_ALG_ECDSA_IS_LOW_S(alg) )
+        ret = uECC_sign_low_s(key_buffer, hash, hash_length, signature, curve);
+    else
+        ret = uECC_sign(key_buffer, hash, hash_length, signature, curve);
+#if IOTEX_PSA_ECDSA_POOL_DEPTH > 0
+    }
+#endif
     if ( ret )
         *signature_length = 64;
     else
@@ -2217,14 +3519,21 @@ int iotex_eddsa_sign( psa_key_type_t type,
                             const uint8_t *key_buffer, size_t key_buffer_size, 
                             const uint8_t *hash, size_t hash_length, uint8_t *signature, size_t *signature_length )
 {
+    uint8_t expanded[64];
+    uint8_t public_key[32];
     int ret = 0;
 
     uECC_set_rng(&default_CSPRNG);
 
-    if (EdPublic[0])
-        ret = uECC_ed25519_sign(key_buffer, EdPublic, hash, hash_length, signature);
-    else
-        ret = 0;
+    if ( key_buffer_size != 32 )
+        return PSA_ERROR_INVALID_ARGUMENT;
+
+    uECC_ed25519_expand(key_buffer, expanded);
+    uECC_ed25519_public_key(key_buffer, public_key);
+
+    ret = uECC_ed25519_sign(expanded, public_key, hash, hash_length, signature);
+
+    _set_secure(expanded, 0, sizeof(expanded));
 
     if ( ret )
         *signature_length = 64;
@@ -2234,6 +3543,64 @@ int iotex_eddsa_sign( psa_key_type_t type,
     return PSA_SUCCESS;
 }
 
+void *iotex_eddsa_key_load( psa_key_type_t type, const uint8_t *key_buffer, size_t key_buffer_size )
+{
+    uECC_ed25519_key *key;
+
+    if ( PSA_KEY_TYPE_ECC_GET_FAMILY( type ) != PSA_ECC_FAMILY_TWISTED_EDWARDS ||
+         NULL == key_buffer || key_buffer_size != 32 )
+        return NULL;
+
+    key = iotex_calloc( 1, sizeof( uECC_ed25519_key ) );
+    if ( NULL == key )
+        return NULL;
+
+    if ( !uECC_ed25519_key_init( key, PSA_KEY_TYPE_IS_ECC_KEY_PAIR( type ) ? key_buffer : NULL, key_buffer ) )
+    {
+        iotex_free( key );
+        return NULL;
+    }
+
+    return key;
+}
+
+void iotex_eddsa_key_free( void *key )
+{
+    if ( NULL == key )
+        return;
+
+    _set_secure( key, 0, sizeof( uECC_ed25519_key ) );
+    iotex_free( key );
+}
+
+int iotex_eddsa_sign_key( const void *key, const uint8_t *input, size_t input_length,
+                                 uint8_t *signature, size_t signature_size, size_t *signature_length )
+{
+    uECC_set_rng(&default_CSPRNG);
+
+    if ( signature_size < 64 )
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+
+    if ( !uECC_ed25519_sign_with_key( (const uECC_ed25519_key *)key, input, input_length, signature ) )
+        return PSA_ERROR_INVALID_ARGUMENT;
+
+    *signature_length = 64;
+
+    return PSA_SUCCESS;
+}
+
+int iotex_eddsa_verify_key( const void *key, const uint8_t *input, size_t input_length,
+                                   const uint8_t *signature, size_t signature_length )
+{
+    if ( signature_length != 64 )
+        return PSA_ERROR_INVALID_SIGNATURE;
+
+    if ( !uECC_ed25519_verify_with_key( (const uECC_ed25519_key *)key, input, input_length, signature ) )
+        return PSA_ERROR_GENERIC_ERROR;
+
+    return PSA_SUCCESS;
+}
+
 
 inline int iotex_ecdsa_verify( psa_key_type_t type,
                           const uint8_t *key_buffer, size_t key_buffer_size,
@@ -2276,16 +3643,110 @@ inline int iotex_ecdsa_verify( psa_key_type_t type,
     return PSA_SUCCESS;
 }
 
+inline int iotex_ecdsa_verify_point( psa_key_type_t type, const uint8_t *point, void **table,
+                          const uint8_t *hash, size_t hash_length, const uint8_t *signature, size_t signature_length )
+{
+    uECC_Curve curve = iotex_ecp_secp_curve( type );
+    uECC_word_t _public[NUM_ECC_WORDS * 2];
+    int ret;
+
+    if ( NULL == curve )
+        return PSA_ERROR_GENERIC_ERROR;
+
+    if ( signature_length != 2 * (size_t)curve->num_bytes )
+        return PSA_ERROR_GENERIC_ERROR;
+
+    memcpy(_public, point, sizeof(_public));
+
+#if uECC_SECP256K1_GLV
+    /* Keep the odd multiples of the key for the next verification, without
+     * them (no table or no memory) uECC_verify_native() rebuilds them */
+    if ( PSA_ECC_FAMILY_SECP_K1 == type && NULL != table && NULL == *table )
+        *table = iotex_calloc( 1, sizeof( uECC_glv_table ) );
+
+    if ( PSA_ECC_FAMILY_SECP_K1 == type && NULL != table && NULL != *table )
+        ret = uECC_verify_glv(_public, hash, hash_length, signature, (uECC_glv_table *)*table);
+    else
+#else
+    (void) table;
+#endif
+        ret = uECC_verify_native(_public, hash, hash_length, signature, curve);
+
+    if ( 0 == ret )
+        return PSA_ERROR_GENERIC_ERROR;
+
+    return PSA_SUCCESS;
+}
+
+inline void iotex_ecdsa_free_point_table( void *table )
+{
+    iotex_free( table );
+}
+
+inline void iotex_ecdsa_verify_point_batch( psa_key_type_t type, iotex_ecdsa_batch_item *items, size_t count )
+{
+    uECC_Curve curve = iotex_ecp_secp_curve( type );
+    uECC_word_t _public[uECC_VERIFY_BATCH_CHUNK][NUM_ECC_WORDS * 2];
+    uECC_verify_item batch[uECC_VERIFY_BATCH_CHUNK];
+    iotex_ecdsa_batch_item *item[uECC_VERIFY_BATCH_CHUNK];
+    size_t i, n;
+
+    while ( count )
+    {
+        /* Fill a chunk with the well-formed signatures */
+        for ( n = 0; count && n < uECC_VERIFY_BATCH_CHUNK; items++, count-- )
+        {
+            if ( NULL == curve || items->signature_length != 2 * (size_t)curve->num_bytes )
+            {
+                items->status = PSA_ERROR_GENERIC_ERROR;
+                continue;
+            }
+
+            memcpy(_public[n], items->point, sizeof(_public[n]));
+
+            batch[n].public_key = _public[n];
+            batch[n].message_hash = items->hash;
+            batch[n].hash_size = (unsigned int)items->hash_length;
+            batch[n].signature = items->signature;
+#if uECC_SECP256K1_GLV
+            batch[n].table = NULL;
+            if ( PSA_ECC_FAMILY_SECP_K1 == type && NULL != items->table )
+            {
+                if ( NULL == *items->table )
+                    *items->table = iotex_calloc( 1, sizeof( uECC_glv_table ) );
+                batch[n].table = (uECC_glv_table *)*items->table;
+            }
+#endif
+            item[n++] = items;
+        }
+
+        if ( 0 == n )
+            continue;
+
+        uECC_verify_batch(batch, (unsigned int)n, curve);
+
+        for ( i = 0; i < n; i++ )
+            item[i]->status = batch[i].result ? PSA_SUCCESS : PSA_ERROR_GENERIC_ERROR;
+    }
+}
+
 int iotex_eddsa_verify( psa_key_type_t type,
                           const uint8_t *key_buffer, size_t key_buffer_size,
                           const uint8_t *hash, size_t hash_length, uint8_t *signature, size_t signature_length )
 {
+    uint8_t public_key[32];
     int ret;
 
-    if (EdPublic[0])
-        ret = uECC_ed25519_verify(EdPublic, hash, hash_length, signature);
+    if ( key_buffer_size != 32 || signature_length != 64 )
+        return PSA_ERROR_GENERIC_ERROR;
+
+    /* type is the whole key type, a key pair holds the seed */
+    if ( PSA_KEY_TYPE_IS_ECC_KEY_PAIR( type ) )
+        uECC_ed25519_public_key(key_buffer, public_key);
     else
-        ret = 0;
+        memcpy(public_key, key_buffer, sizeof(public_key));
+
+    ret = uECC_ed25519_verify(public_key, hash, hash_length, signature);
 
     if ( 0 == ret )
         return PSA_ERROR_GENERIC_ERROR;
@@ -2344,7 +3805,8 @@ struct iotex_hmac_prng_ctx {
 psa_status_t iotex_psa_external_get_random(iotex_psa_external_random_context_t *context,
               uint8_t *output, size_t output_size, size_t *output_length)
 { 
-    default_CSPRNG(output, output_size);
+    if ( output_size > 0 && !default_CSPRNG(output, output_size) )
+        return( PSA_ERROR_INSUFFICIENT_ENTROPY );
 
     *output_length = output_size;
 
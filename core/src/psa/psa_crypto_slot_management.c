@@ -265,6 +265,8 @@ static psa_status_t psa_load_persistent_key_into_slot( psa_key_slot_t *slot )
 #endif /* IOTEX_PSA_CRYPTO_SE_C */
 
    status = psa_copy_key_material_into_slot( slot, key_data, key_data_length );
+   if( status == PSA_SUCCESS )
+       psa_key_slot_cache_public_point( slot );
 
 exit:
    psa_free_persistent_key_data( key_data, key_data_length );
@@ -22,13 +22,14 @@
 #include "include/iotex/platform.h"
 #else
 #define iotex_snprintf   snprintf
+#define iotex_setbuf     setbuf
 #endif
 
 #if defined(_WIN32)
 #include <windows.h>
 #endif
 
-#include "include/crypto/psa_crypto_its.h"
+#include "include/server/crypto/psa_crypto_its.h"
 
 #include <limits.h>
 #include <stdint.h>
@@ -0,0 +1,335 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "include/utils/JsonWriter/json_writer.h"
+
+#define IOTEX_JSON_BIT(depth)	((uint32_t)1 << (depth))
+
+static int iotex_json_fail(iotex_json_writer_t *writer, int error) {
+
+	if (IOTEX_JSON_WRITER_ERR_SUCCESS == writer->error)
+		writer->error = error;
+
+	return writer->error;
+}
+
+/* One byte is always kept free for the terminating NUL */
+static int iotex_json_put(iotex_json_writer_t *writer, const char *str, size_t len) {
+
+	if (writer->error)
+		return writer->error;
+
+	if (len >= writer->size - writer->len)
+		return iotex_json_fail(writer, IOTEX_JSON_WRITER_ERR_BUFFER_FULL);
+
+	memcpy(writer->buf + writer->len, str, len);
+
+	if (writer->sha)
+		tc_sha256_update(writer->sha, (const uint8_t *)str, len);
+
+	writer->len += len;
+
+	return IOTEX_JSON_WRITER_ERR_SUCCESS;
+}
+
+/* Separator and state checks shared by every value, including nested containers */
+static int iotex_json_value_begin(iotex_json_writer_t *writer) {
+
+	uint32_t bit = IOTEX_JSON_BIT(writer->depth);
+
+	if (writer->error)
+		return writer->error;
+
+	if (writer->depth && (writer->is_object & bit)) {
+
+		if (!writer->after_key)
+			return iotex_json_fail(writer, IOTEX_JSON_WRITER_ERR_BAD_STATE);
+
+		writer->after_key = 0;
+
+		return IOTEX_JSON_WRITER_ERR_SUCCESS;
+	}
+
+	if (0 == writer->depth && writer->len)
+		return iotex_json_fail(writer, IOTEX_JSON_WRITER_ERR_BAD_STATE);
+
+	if (writer->nonempty & bit)
+		return iotex_json_put(writer, ",", 1);
+
+	writer->nonempty |= bit;
+
+	return IOTEX_JSON_WRITER_ERR_SUCCESS;
+}
+
+void iotex_json_writer_init(iotex_json_writer_t *writer, char *buf, size_t size, struct tc_sha256_state_struct *sha) {
+
+	if (NULL == writer)
+		return;
+
+	memset(writer, 0, sizeof(iotex_json_writer_t));
+
+	writer->buf  = buf;
+	writer->size = size;
+	writer->sha  = sha;
+
+	if (NULL == buf || 0 == size)
+		writer->error = IOTEX_JSON_WRITER_ERR_BAD_INPUT;
+}
+
+static int iotex_json_begin(iotex_json_writer_t *writer, const char *open, bool object) {
+
+	if (NULL == writer)
+		return IOTEX_JSON_WRITER_ERR_BAD_INPUT;
+
+	if (iotex_json_value_begin(writer))
+		return writer->error;
+
+	if (writer->depth + 1 >= IOTEX_JSON_WRITER_MAX_DEPTH)
+		return iotex_json_fail(writer, IOTEX_JSON_WRITER_ERR_BAD_STATE);
+
+	if (iotex_json_put(writer, open, 1))
+		return writer->error;
+
+	writer->depth++;
+	writer->nonempty &= ~IOTEX_JSON_BIT(writer->depth);
+
+	if (object)
+		writer->is_object |= IOTEX_JSON_BIT(writer->depth);
+	else
+		writer->is_object &= ~IOTEX_JSON_BIT(writer->depth);
+
+	return IOTEX_JSON_WRITER_ERR_SUCCESS;
+}
+
+static int iotex_json_end(iotex_json_writer_t *writer, const char *close, bool object) {
+
+	if (NULL == writer)
+		return IOTEX_JSON_WRITER_ERR_BAD_INPUT;
+
+	if (writer->error)
+		return writer->error;
+
+	if (0 == writer->depth || writer->after_key || object != !!(writer->is_object & IOTEX_JSON_BIT(writer->depth)))
+		return iotex_json_fail(writer, IOTEX_JSON_WRITER_ERR_BAD_STATE);
+
+	if (iotex_json_put(writer, close, 1))
+		return writer->error;
+
+	writer->depth--;
+
+	return IOTEX_JSON_WRITER_ERR_SUCCESS;
+}
+
+int iotex_json_begin_object(iotex_json_writer_t *writer) {
+
+	return iotex_json_begin(writer, "{", true);
+}
+
+int iotex_json_end_object(iotex_json_writer_t *writer) {
+
+	return iotex_json_end(writer, "}", true);
+}
+
+int iotex_json_begin_array(iotex_json_writer_t *writer) {
+
+	return iotex_json_begin(writer, "[", false);
+}
+
+int iotex_json_end_array(iotex_json_writer_t *writer) {
+
+	return iotex_json_end(writer, "]", false);
+}
+
+/* Quoted and escaped the same way as cJSON */
+static int iotex_json_put_string(iotex_json_writer_t *writer, const char *str) {
+
+	const char *run = str;
+	char escape[7];
+
+	if (iotex_json_put(writer, "\"", 1))
+		return writer->error;
+
+	for (; *str; str++) {
+
+		unsigned char c = (unsigned char)*str;
+		size_t len = 2;
+
+		if (c >= 0x20 && c != '\"' && c != '\\')
+			continue;
+
+		if (iotex_json_put(writer, run, str - run))
+			return writer->error;
+
+		escape[0] = '\\';
+
+		switch (c) {
+			case '\"': escape[1] = '\"'; break;
+			case '\\': escape[1] = '\\'; break;
+			case '\b': escape[1] = 'b'; break;
+			case '\f': escape[1] = 'f'; break;
+			case '\n': escape[1] = 'n'; break;
+			case '\r': escape[1] = 'r'; break;
+			case '\t': escape[1] = 't'; break;
+			default:
+				len = snprintf(escape, sizeof(escape), "\\u%04x", c);
+				break;
+		}
+
+		if (iotex_json_put(writer, escape, len))
+			return writer->error;
+
+		run = str + 1;
+	}
+
+	if (iotex_json_put(writer, run, str - run))
+		return writer->error;
+
+	return iotex_json_put(writer, "\"", 1);
+}
+
+int iotex_json_key(iotex_json_writer_t *writer, const char *key) {
+
+	if (NULL == writer)
+		return IOTEX_JSON_WRITER_ERR_BAD_INPUT;
+
+	if (NULL == key)
+		return iotex_json_fail(writer, IOTEX_JSON_WRITER_ERR_BAD_INPUT);
+
+	if (writer->error)
+		return writer->error;
+
+	if (0 == writer->depth || !(writer->is_object & IOTEX_JSON_BIT(writer->depth)) || writer->after_key)
+		return iotex_json_fail(writer, IOTEX_JSON_WRITER_ERR_BAD_STATE);
+
+	if (writer->nonempty & IOTEX_JSON_BIT(writer->depth)) {
+		if (iotex_json_put(writer, ",", 1))
+			return writer->error;
+	}
+
+	writer->nonempty |= IOTEX_JSON_BIT(writer->depth);
+
+	if (iotex_json_put_string(writer, key) || iotex_json_put(writer, ":", 1))
+		return writer->error;
+
+	writer->after_key = 1;
+
+	return IOTEX_JSON_WRITER_ERR_SUCCESS;
+}
+
+int iotex_json_string(iotex_json_writer_t *writer, const char *str) {
+
+	if (NULL == writer)
+		return IOTEX_JSON_WRITER_ERR_BAD_INPUT;
+
+	if (NULL == str)
+		return iotex_json_fail(writer, IOTEX_JSON_WRITER_ERR_BAD_INPUT);
+
+	if (iotex_json_value_begin(writer))
+		return writer->error;
+
+	return iotex_json_put_string(writer, str);
+}
+
+int iotex_json_int(iotex_json_writer_t *writer, int64_t number) {
+
+	char digits[21];
+	uint64_t value = (number < 0 ? (uint64_t)0 - (uint64_t)number : (uint64_t)number);
+	size_t pos = sizeof(digits);
+
+	if (NULL == writer)
+		return IOTEX_JSON_WRITER_ERR_BAD_INPUT;
+
+	if (iotex_json_value_begin(writer))
+		return writer->error;
+
+	do {
+		digits[--pos] = '0' + (char)(value % 10);
+		value /= 10;
+	} while (value);
+
+	if (number < 0)
+		digits[--pos] = '-';
+
+	return iotex_json_put(writer, digits + pos, sizeof(digits) - pos);
+}
+
+/*
+ * Same text as cJSON's print_number(), integral values skip printf entirely.
+ * Negative zero is normalised and prints as 0, not -0.
+ */
+int iotex_json_number(iotex_json_writer_t *writer, double number) {
+
+	char digits[26];
+	double test = 0.0;
+	int len = 0;
+
+	if (NULL == writer)
+		return IOTEX_JSON_WRITER_ERR_BAD_INPUT;
+
+	if (isnan(number) || isinf(number)) {
+		if (iotex_json_value_begin(writer))
+			return writer->error;
+		return iotex_json_put(writer, "null", 4);
+	}
+
+	if (number > -1e15 && number < 1e15 && number == (double)(int64_t)number)
+		return iotex_json_int(writer, (int64_t)number);
+
+	if (iotex_json_value_begin(writer))
+		return writer->error;
+
+	len = snprintf(digits, sizeof(digits), "%1.15g", number);
+
+	if ((sscanf(digits, "%lg", &test) != 1) || fabs(test - number) > fmax(fabs(test), fabs(number)) * DBL_EPSILON)
+		len = snprintf(digits, sizeof(digits), "%1.17g", number);
+
+	if (len < 0 || len >= (int)sizeof(digits))
+		return iotex_json_fail(writer, IOTEX_JSON_WRITER_ERR_BAD_INPUT);
+
+	for (int i = 0; i < len; i++) {
+		if (',' == digits[i])
+			digits[i] = '.';
+	}
+
+	return iotex_json_put(writer, digits, len);
+}
+
+int iotex_json_bool(iotex_json_writer_t *writer, bool value) {
+
+	if (NULL == writer)
+		return IOTEX_JSON_WRITER_ERR_BAD_INPUT;
+
+	if (iotex_json_value_begin(writer))
+		return writer->error;
+
+	return (value ? iotex_json_put(writer, "true", 4) : iotex_json_put(writer, "false", 5));
+}
+
+int iotex_json_null(iotex_json_writer_t *writer) {
+
+	if (NULL == writer)
+		return IOTEX_JSON_WRITER_ERR_BAD_INPUT;
+
+	if (iotex_json_value_begin(writer))
+		return writer->error;
+
+	return iotex_json_put(writer, "null", 4);
+}
+
+int iotex_json_writer_finish(iotex_json_writer_t *writer) {
+
+	if (NULL == writer)
+		return IOTEX_JSON_WRITER_ERR_BAD_INPUT;
+
+	if (writer->error)
+		return writer->error;
+
+	if (writer->depth || writer->after_key || 0 == writer->len)
+		return iotex_json_fail(writer, IOTEX_JSON_WRITER_ERR_BAD_STATE);
+
+	writer->buf[writer->len] = '\0';
+
+	return (int)writer->len;
+}
@@ -0,0 +1,196 @@
+#include <string.h>
+
+#include "include/utils/Lz/lz.h"
+
+#define IOTEX_LZ_MIN_MATCH		4
+#define IOTEX_LZ_LAST_LITERALS	5		/* the block always ends with this many literals */
+#define IOTEX_LZ_MF_LIMIT		12		/* no match may start closer than this to the end */
+
+static uint32_t iotex_lz_read32(const uint8_t *p) {
+
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+
+	return v;
+}
+
+static uint32_t iotex_lz_hash(uint32_t v) {
+
+	return (v * 2654435761U) >> (32 - IOTEX_LZ_HASH_LOG);
+}
+
+/* Length field continuation: runs of 255 followed by the remainder */
+static uint8_t *iotex_lz_put_length(uint8_t *op, const uint8_t *oend, size_t len) {
+
+	for (; len >= 255; len -= 255) {
+		if (op >= oend)
+			return NULL;
+		*op++ = 255;
+	}
+
+	if (op >= oend)
+		return NULL;
+
+	*op++ = (uint8_t)len;
+
+	return op;
+}
+
+static uint8_t *iotex_lz_put_sequence(uint8_t *op, const uint8_t *oend, const uint8_t *literal, size_t literal_len, size_t offset, size_t match_len) {
+
+	uint8_t *token = op;
+
+	if (op >= oend)
+		return NULL;
+
+	*op++ = (uint8_t)((literal_len < 15 ? literal_len : 15) << 4);
+
+	if (literal_len >= 15 && NULL == (op = iotex_lz_put_length(op, oend, literal_len - 15)))
+		return NULL;
+
+	if ((size_t)(oend - op) < literal_len)
+		return NULL;
+
+	memcpy(op, literal, literal_len);
+	op += literal_len;
+
+	/* The last sequence carries literals only */
+	if (0 == match_len)
+		return op;
+
+	if (oend - op < 2)
+		return NULL;
+
+	*op++ = (uint8_t)offset;
+	*op++ = (uint8_t)(offset >> 8);
+
+	match_len -= IOTEX_LZ_MIN_MATCH;
+	*token |= (uint8_t)(match_len < 15 ? match_len : 15);
+
+	if (match_len >= 15 && NULL == (op = iotex_lz_put_length(op, oend, match_len - 15)))
+		return NULL;
+
+	return op;
+}
+
+int iotex_lz_compress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_size, uint16_t table[IOTEX_LZ_HASH_SIZE]) {
+
+	const uint8_t *oend = dst + dst_size;
+	uint8_t *op = dst;
+	size_t ip = 0, anchor = 0;
+
+	if (NULL == src || NULL == dst || NULL == table || src_len > IOTEX_LZ_MAX_INPUT)
+		return IOTEX_LZ_ERR_BAD_INPUT;
+
+	memset(table, 0, IOTEX_LZ_HASH_SIZE * sizeof(uint16_t));
+
+	while (src_len > IOTEX_LZ_MF_LIMIT && ip + IOTEX_LZ_MF_LIMIT <= src_len) {
+
+		uint32_t h = iotex_lz_hash(iotex_lz_read32(src + ip));
+		size_t ref = table[h];
+		size_t len = IOTEX_LZ_MIN_MATCH;
+
+		table[h] = (uint16_t)ip;
+
+		if (ref >= ip || ip - ref > IOTEX_LZ_WINDOW || iotex_lz_read32(src + ref) != iotex_lz_read32(src + ip)) {
+			ip++;
+			continue;
+		}
+
+		while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+			ip--;
+			ref--;
+			len++;
+		}
+
+		while (ip + len < src_len - IOTEX_LZ_LAST_LITERALS && src[ref + len] == src[ip + len])
+			len++;
+
+		if (NULL == (op = iotex_lz_put_sequence(op, oend, src + anchor, ip - anchor, ip - ref, len)))
+			return IOTEX_LZ_ERR_OUTPUT_FULL;
+
+		ip += len;
+		anchor = ip;
+
+		/* Seed the table inside the match so the next repeat is found right away */
+		if (ip + IOTEX_LZ_MF_LIMIT <= src_len)
+			table[iotex_lz_hash(iotex_lz_read32(src + ip - 2))] = (uint16_t)(ip - 2);
+	}
+
+	if (NULL == (op = iotex_lz_put_sequence(op, oend, src + anchor, src_len - anchor, 0, 0)))
+		return IOTEX_LZ_ERR_OUTPUT_FULL;
+
+	return (int)(op - dst);
+}
+
+static int iotex_lz_get_length(const uint8_t **ip, const uint8_t *iend, size_t *len) {
+
+	uint8_t b;
+
+	do {
+		if (*ip >= iend)
+			return IOTEX_LZ_ERR_CORRUPT;
+		b = *(*ip)++;
+		*len += b;
+	} while (255 == b);
+
+	return IOTEX_LZ_ERR_SUCCESS;
+}
+
+int iotex_lz_decompress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_size) {
+
+	const uint8_t *ip = src, *iend = src + src_len;
+	size_t op = 0;
+
+	if (NULL == src || NULL == dst || 0 == src_len)
+		return IOTEX_LZ_ERR_BAD_INPUT;
+
+	for (;;) {
+
+		uint8_t token = *ip++;
+		size_t literal_len = token >> 4, match_len = token & 0x0F, offset;
+
+		if (15 == literal_len && iotex_lz_get_length(&ip, iend, &literal_len))
+			return IOTEX_LZ_ERR_CORRUPT;
+
+		if ((size_t)(iend - ip) < literal_len)
+			return IOTEX_LZ_ERR_CORRUPT;
+
+		if (dst_size - op < literal_len)
+			return IOTEX_LZ_ERR_OUTPUT_FULL;
+
+		memcpy(dst + op, ip, literal_len);
+		ip += literal_len;
+		op += literal_len;
+
+		if (ip == iend)
+			break;
+
+		if (iend - ip < 2)
+			return IOTEX_LZ_ERR_CORRUPT;
+
+		offset = ip[0] | ((size_t)ip[1] << 8);
+		ip += 2;
+
+		if (0 == offset || offset > op)
+			return IOTEX_LZ_ERR_CORRUPT;
+
+		if (15 == match_len && iotex_lz_get_length(&ip, iend, &match_len))
+			return IOTEX_LZ_ERR_CORRUPT;
+
+		match_len += IOTEX_LZ_MIN_MATCH;
+
+		if (dst_size - op < match_len)
+			return IOTEX_LZ_ERR_OUTPUT_FULL;
+
+		/* Byte by byte, the match may overlap the bytes it produces */
+		for (size_t i = 0; i < match_len; i++, op++)
+			dst[op] = dst[op - offset];
+
+		if (ip >= iend)
+			return IOTEX_LZ_ERR_CORRUPT;
+	}
+
+	return (int)op;
+}
@@ -0,0 +1,347 @@
+#include <string.h>
+#include <math.h>
+
+#include "include/utils/TimeSeries/timeseries.h"
+
+#define IOTEX_TS_VARINT_MAX		10
+
+static const double iotex_ts_pow10[IOTEX_TS_MAX_DECIMALS + 1] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+};
+
+static size_t iotex_ts_put_varint(uint8_t *dst, uint64_t v) {
+
+	size_t len = 0;
+
+	while (v >= 0x80) {
+		dst[len++] = (uint8_t)(v | 0x80);
+		v >>= 7;
+	}
+
+	dst[len++] = (uint8_t)v;
+
+	return len;
+}
+
+static size_t iotex_ts_varint_len(uint64_t v) {
+
+	size_t len = 1;
+
+	while (v >= 0x80) {
+		v >>= 7;
+		len++;
+	}
+
+	return len;
+}
+
+static int iotex_ts_get_varint(const uint8_t **p, const uint8_t *end, uint64_t *v) {
+
+	uint64_t result = 0;
+
+	for (unsigned shift = 0; shift < 64; shift += 7) {
+
+		if (*p >= end)
+			return IOTEX_TS_ERR_CORRUPT;
+
+		result |= (uint64_t)(**p & 0x7F) << shift;
+
+		if (0 == (*(*p)++ & 0x80)) {
+			*v = result;
+			return IOTEX_TS_ERR_SUCCESS;
+		}
+	}
+
+	return IOTEX_TS_ERR_CORRUPT;
+}
+
+static uint64_t iotex_ts_zigzag(int64_t v) {
+
+	return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t iotex_ts_unzigzag(uint64_t v) {
+
+	return (int64_t)((v >> 1) ^ (0 - (v & 1)));
+}
+
+/* Differences wrap instead of overflowing, the decoder wraps back the same way */
+static int64_t iotex_ts_sub(uint64_t a, uint64_t b) {
+
+	return (int64_t)(a - b);
+}
+
+static size_t iotex_ts_header_len(const iotex_ts_builder_t *builder, uint32_t count, uint64_t t0, const size_t *col_len) {
+
+	size_t len = 2 + iotex_ts_varint_len(count) + iotex_ts_varint_len(t0) + builder->channels;
+
+	for (int c = 0; c <= builder->channels; c++)
+		len += iotex_ts_varint_len(col_len[c]);
+
+	return len;
+}
+
+/*
+ * Give every column at least extra[c] bytes of room past its data and share
+ * whatever is left evenly. The new layout keeps the column order, so columns
+ * moving down are moved first, in ascending order, then those moving up in
+ * descending order, and no move overwrites data that has not moved yet.
+ */
+static void iotex_ts_rebalance(iotex_ts_builder_t *builder, const size_t *extra) {
+
+	size_t start[IOTEX_TS_MAX_CHANNELS + 1];
+	size_t used = 0, share = 0;
+	int columns = builder->channels + 1;
+
+	for (int c = 0; c < columns; c++)
+		used += builder->col_len[c] + extra[c];
+
+	share = (builder->size - used) / columns;
+
+	start[0] = 0;
+	for (int c = 1; c < columns; c++)
+		start[c] = start[c - 1] + builder->col_len[c - 1] + extra[c - 1] + share;
+
+	for (int c = 0; c < columns; c++) {
+		if (start[c] < builder->col_start[c]) {
+			memmove(builder->buf + start[c], builder->buf + builder->col_start[c], builder->col_len[c]);
+			builder->col_start[c] = start[c];
+		}
+	}
+
+	for (int c = columns - 1; c >= 0; c--) {
+		if (start[c] > builder->col_start[c]) {
+			memmove(builder->buf + start[c], builder->buf + builder->col_start[c], builder->col_len[c]);
+			builder->col_start[c] = start[c];
+		}
+	}
+}
+
+int iotex_ts_builder_init(iotex_ts_builder_t *builder, uint8_t *buf, size_t size, uint8_t channels, const uint8_t *decimals) {
+
+	size_t region = 0;
+
+	if (NULL == builder)
+		return IOTEX_TS_ERR_BAD_INPUT;
+
+	memset(builder, 0, sizeof(iotex_ts_builder_t));
+
+	if (NULL == buf || 0 == channels || channels > IOTEX_TS_MAX_CHANNELS || size > UINT32_MAX)
+		return IOTEX_TS_ERR_BAD_INPUT;
+
+	builder->buf      = buf;
+	builder->size     = size;
+	builder->channels = channels;
+
+	for (int c = 0; c < channels; c++) {
+
+		builder->decimals[c] = (decimals ? decimals[c] : 0);
+
+		if (builder->decimals[c] > IOTEX_TS_MAX_DECIMALS)
+			return IOTEX_TS_ERR_BAD_INPUT;
+
+		builder->scale[c] = iotex_ts_pow10[builder->decimals[c]];
+	}
+
+	region = size / (channels + 1);
+	for (int c = 0; c <= channels; c++)
+		builder->col_start[c] = c * region;
+
+	if (size < iotex_ts_header_len(builder, 0, 0, builder->col_len))
+		return IOTEX_TS_ERR_BUFFER_FULL;
+
+	return IOTEX_TS_ERR_SUCCESS;
+}
+
+int iotex_ts_builder_append(iotex_ts_builder_t *builder, uint64_t timestamp, const double *values) {
+
+	uint8_t enc[IOTEX_TS_MAX_CHANNELS + 1][IOTEX_TS_VARINT_MAX];
+	size_t enc_len[IOTEX_TS_MAX_CHANNELS + 1] = {0};
+	size_t col_len[IOTEX_TS_MAX_CHANNELS + 1];
+	int64_t fixed[IOTEX_TS_MAX_CHANNELS];
+	int64_t delta = 0;
+	size_t used = 0;
+	int columns = 0, rebalance = 0;
+
+	if (NULL == builder || NULL == builder->buf || builder->finished || NULL == values)
+		return IOTEX_TS_ERR_BAD_INPUT;
+
+	if (UINT32_MAX == builder->count)
+		return IOTEX_TS_ERR_BUFFER_FULL;
+
+	columns = builder->channels + 1;
+
+	if (builder->count) {
+		delta = iotex_ts_sub(timestamp, builder->prev_ts);
+		enc_len[0] = iotex_ts_put_varint(enc[0], iotex_ts_zigzag(iotex_ts_sub(delta, builder->prev_delta)));
+	}
+
+	for (int c = 0; c < builder->channels; c++) {
+
+		double scaled = values[c] * builder->scale[c];
+
+		if (!(fabs(scaled) < 9.2e18))
+			return IOTEX_TS_ERR_BAD_INPUT;
+
+		fixed[c] = llround(scaled);
+		enc_len[c + 1] = iotex_ts_put_varint(enc[c + 1], iotex_ts_zigzag(iotex_ts_sub(fixed[c], builder->prev_value[c])));
+	}
+
+	for (int c = 0; c < columns; c++) {
+		col_len[c] = builder->col_len[c] + enc_len[c];
+		used += col_len[c];
+	}
+
+	/* The header goes in front of the columns at finish, keep room for it */
+	if (used + iotex_ts_header_len(builder, builder->count + 1, (builder->count ? builder->t0 : timestamp), col_len) > builder->size)
+		return IOTEX_TS_ERR_BUFFER_FULL;
+
+	for (int c = 0; c < columns; c++) {
+		size_t end = (c + 1 < columns ? builder->col_start[c + 1] : builder->size);
+		if (builder->col_start[c] + col_len[c] > end)
+			rebalance = 1;
+	}
+
+	if (rebalance)
+		iotex_ts_rebalance(builder, enc_len);
+
+	for (int c = 0; c < columns; c++) {
+		memcpy(builder->buf + builder->col_start[c] + builder->col_len[c], enc[c], enc_len[c]);
+		builder->col_len[c] = col_len[c];
+	}
+
+	if (0 == builder->count)
+		builder->t0 = timestamp;
+
+	builder->prev_delta = delta;
+	builder->prev_ts    = timestamp;
+	memcpy(builder->prev_value, fixed, builder->channels * sizeof(int64_t));
+
+	builder->count++;
+
+	return IOTEX_TS_ERR_SUCCESS;
+}
+
+int iotex_ts_builder_finish(iotex_ts_builder_t *builder) {
+
+	uint8_t header[IOTEX_TS_HEADER_MAX_SIZE];
+	size_t header_len = 0, len = 0;
+
+	if (NULL == builder || NULL == builder->buf || builder->finished)
+		return IOTEX_TS_ERR_BAD_INPUT;
+
+	/* Pack the columns from offset 0, every one of them only moves down */
+	for (int c = 0; c <= builder->channels; c++) {
+		memmove(builder->buf + len, builder->buf + builder->col_start[c], builder->col_len[c]);
+		builder->col_start[c] = len;
+		len += builder->col_len[c];
+	}
+
+	header[header_len++] = IOTEX_TS_VERSION;
+	header[header_len++] = builder->channels;
+	header_len += iotex_ts_put_varint(header + header_len, builder->count);
+	header_len += iotex_ts_put_varint(header + header_len, builder->t0);
+
+	memcpy(header + header_len, builder->decimals, builder->channels);
+	header_len += builder->channels;
+
+	for (int c = 0; c <= builder->channels; c++)
+		header_len += iotex_ts_put_varint(header + header_len, builder->col_len[c]);
+
+	memmove(builder->buf + header_len, builder->buf, len);
+	memcpy(builder->buf, header, header_len);
+
+	builder->finished = 1;
+
+	return (int)(header_len + len);
+}
+
+int iotex_ts_decoder_init(iotex_ts_decoder_t *decoder, const uint8_t *buf, size_t len) {
+
+	const uint8_t *p = buf, *end = buf + len;
+	uint64_t col_len[IOTEX_TS_MAX_CHANNELS + 1];
+	uint64_t v = 0;
+
+	if (NULL == decoder || NULL == buf)
+		return IOTEX_TS_ERR_BAD_INPUT;
+
+	memset(decoder, 0, sizeof(iotex_ts_decoder_t));
+
+	if (len < 2 || IOTEX_TS_VERSION != p[0] || 0 == p[1] || p[1] > IOTEX_TS_MAX_CHANNELS)
+		return IOTEX_TS_ERR_CORRUPT;
+
+	decoder->channels = p[1];
+	p += 2;
+
+	if (iotex_ts_get_varint(&p, end, &v) || v > UINT32_MAX)
+		return IOTEX_TS_ERR_CORRUPT;
+	decoder->count = (uint32_t)v;
+
+	if (iotex_ts_get_varint(&p, end, &decoder->prev_ts))
+		return IOTEX_TS_ERR_CORRUPT;
+
+	if ((size_t)(end - p) < decoder->channels)
+		return IOTEX_TS_ERR_CORRUPT;
+
+	for (int c = 0; c < decoder->channels; c++) {
+
+		decoder->decimals[c] = *p++;
+
+		if (decoder->decimals[c] > IOTEX_TS_MAX_DECIMALS)
+			return IOTEX_TS_ERR_CORRUPT;
+
+		decoder->scale[c] = iotex_ts_pow10[decoder->decimals[c]];
+	}
+
+	for (int c = 0; c <= decoder->channels; c++) {
+		if (iotex_ts_get_varint(&p, end, &col_len[c]))
+			return IOTEX_TS_ERR_CORRUPT;
+	}
+
+	/* The columns follow the header back to back */
+	for (int c = 0; c <= decoder->channels; c++) {
+
+		if ((uint64_t)(end - p) < col_len[c])
+			return IOTEX_TS_ERR_CORRUPT;
+
+		decoder->col[c]     = p;
+		decoder->col_end[c] = p + col_len[c];
+		p += col_len[c];
+	}
+
+	return IOTEX_TS_ERR_SUCCESS;
+}
+
+int iotex_ts_decoder_next(iotex_ts_decoder_t *decoder, uint64_t *timestamp, double *values) {
+
+	uint64_t v = 0;
+
+	if (NULL == decoder || NULL == timestamp || NULL == values)
+		return IOTEX_TS_ERR_BAD_INPUT;
+
+	if (decoder->index >= decoder->count)
+		return IOTEX_TS_ERR_END;
+
+	if (decoder->index) {
+
+		if (iotex_ts_get_varint(&decoder->col[0], decoder->col_end[0], &v))
+			return IOTEX_TS_ERR_CORRUPT;
+
+		decoder->prev_delta = (int64_t)((uint64_t)decoder->prev_delta + (uint64_t)iotex_ts_unzigzag(v));
+		decoder->prev_ts   += (uint64_t)decoder->prev_delta;
+	}
+
+	for (int c = 0; c < decoder->channels; c++) {
+
+		if (iotex_ts_get_varint(&decoder->col[c + 1], decoder->col_end[c + 1], &v))
+			return IOTEX_TS_ERR_CORRUPT;
+
+		decoder->prev_value[c] = (int64_t)((uint64_t)decoder->prev_value[c] + (uint64_t)iotex_ts_unzigzag(v));
+		values[c] = (double)decoder->prev_value[c] / decoder->scale[c];
+	}
+
+	*timestamp = decoder->prev_ts;
+	decoder->index++;
+
+	return IOTEX_TS_ERR_SUCCESS;
+}
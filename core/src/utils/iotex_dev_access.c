@@ -1,16 +1,28 @@
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
 #include "include/common.h"
 #include "include/utils/iotex_dev_access.h"
 #include "include/psa/crypto.h"
+#include "include/backends/tinycryt/sha256.h"
 
 #ifdef CONFIG_PSA_ITS_FLASH_C
 #include "include/hal/flash/flash_common.h"
 #endif
 
+#ifdef CONFIG_APP_DEVNET_ACCESS_UPLOAD_QUEUE
+#if defined(ESP_PLATFORM)
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#endif
+
 #ifdef CONFIG_PSA_ITS_NVS_C
 #include "include/hal/nvs/nvs_common.h"
 #endif
@@ -19,11 +31,28 @@
 #define DEFAULT_TIME_STAMP_UNIX_VALUE      	1701284562
 
 extern psa_key_id_t g_sdkcore_key;
+extern uint8_t * iotex_deviceconnect_sdk_core_get_public_key(void);
 
 iotex_dev_ctx_t *dev_ctx = NULL;
 
+#ifdef CONFIG_APP_DEVNET_ACCESS_ENCODE_ARENA_STATIC
+static iotex_dev_ctx_t dev_ctx_static;
+static uint8_t encode_arena_buf[IOTEX_DEV_ACCESS_ENCODE_ARENA_SIZE];
+#endif
+
 static char wallet_addr[USER_WALLET_ADDR_LEN_MAX] = {0};
 
+static int iotex_dev_access_header_update(void);
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_UPLOAD_QUEUE
+static void iotex_upload_queue_init(iotex_upload_queue_t *queue);
+static void iotex_upload_queue_drain(void);
+#endif
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_SPOOL
+static void iotex_dev_access_spool_replay(void);
+#endif
+
 static char str2Hex(char c) {
 
     if (c >= '0' && c <= '9') {
@@ -70,8 +99,17 @@ int iotex_user_wallet_addr_set(char *buf, int32_t buf_len) {
 
 int iotex_dev_access_init(void)
 {
-	if (NULL == dev_ctx)
+	uint8_t *arena_buf = NULL;
+
+	if (NULL == dev_ctx) {
+#ifdef CONFIG_APP_DEVNET_ACCESS_ENCODE_ARENA_STATIC
+		dev_ctx = &dev_ctx_static;
+#else
 		dev_ctx = (iotex_dev_ctx_t *)malloc(sizeof(iotex_dev_ctx_t));
+#endif
+	} else {
+		arena_buf = dev_ctx->arena.buf;
+	}
 
 	if (NULL == dev_ctx)
 		return IOTEX_DEV_ACCESS_ERR_ALLOCATE_FAIL;
@@ -80,6 +118,26 @@ int iotex_dev_access_init(void)
 	memcpy(dev_ctx->mqtt_ctx.topic[0], CONFIG_APP_DEVNET_ACCESS_STUDIO_TOPIC, strlen(CONFIG_APP_DEVNET_ACCESS_STUDIO_TOPIC));
 	memcpy(dev_ctx->mqtt_ctx.token, CONFIG_APP_DEVNET_ACCESS_STUDIO_TOKEN, strlen(CONFIG_APP_DEVNET_ACCESS_STUDIO_TOKEN));   
 
+#ifdef CONFIG_APP_DEVNET_ACCESS_ENCODE_ARENA_STATIC
+	arena_buf = encode_arena_buf;
+#else
+	if (NULL == arena_buf)
+		arena_buf = (uint8_t *)malloc(IOTEX_DEV_ACCESS_ENCODE_ARENA_SIZE);
+
+	if (NULL == arena_buf)
+		return IOTEX_DEV_ACCESS_ERR_ALLOCATE_FAIL;
+#endif
+
+	dev_ctx->arena.buf      = arena_buf;
+	dev_ctx->arena.buf_size = IOTEX_DEV_ACCESS_ENCODE_ARENA_SIZE;
+
+	if (iotex_dev_access_header_update())
+		return IOTEX_DEV_ACCESS_ERR_GENERAL;
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_UPLOAD_QUEUE
+	iotex_upload_queue_init(&dev_ctx->queue);
+#endif
+
 #ifdef CONFIG_PSA_ITS_FLASH_C
 	iotex_hal_flash_drv_init();
 #endif
@@ -106,6 +164,9 @@ int iotex_dev_access_set_mqtt_topic(const char *topic, int topic_len, int topic_
     memset(dev_ctx->mqtt_ctx.topic[topic_location], 0, IOTEX_MAX_TOPIC_SIZE);
     memcpy(dev_ctx->mqtt_ctx.topic[topic_location], topic, strlen(topic));
 
+    if( iotex_dev_access_header_update() )
+        return IOTEX_DEV_ACCESS_ERR_GENERAL;
+
 #ifdef IOTEX_DEBUG_ENABLE
     if( dev_ctx->debug_enable ) {
         printf("Success to set mqtt topic: \n");
@@ -125,6 +186,9 @@ int iotex_dev_access_set_token(const char *token, int token_len) {
     memset(dev_ctx->mqtt_ctx.token, 0, IOTEX_MAX_TOKEN_SIZE);
     memcpy(dev_ctx->mqtt_ctx.token, token, strlen(token));
 
+    if( iotex_dev_access_header_update() )
+        return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
 #ifdef IOTEX_DEBUG_ENABLE
     if( dev_ctx->debug_enable ) {
         printf("Success to set token: \n");
@@ -157,6 +221,22 @@ int iotex_dev_access_set_mqtt_func(iotex_mqtt_pub mqtt_pub, iotex_mqtt_sub mqtt_
     return IOTEX_DEV_ACCESS_ERR_SUCCESS;
 }
 
+int iotex_dev_access_set_mqtt_stream_func(iotex_mqtt_pub_begin pub_begin, iotex_mqtt_pub_write pub_write, iotex_mqtt_pub_end pub_end) {
+
+    if( (NULL == dev_ctx) || (0 == dev_ctx->inited) ) {
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+    }
+
+    if( (NULL == pub_begin) != (NULL == pub_write) || (NULL == pub_begin) != (NULL == pub_end) )
+        return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+    dev_ctx->mqtt_ctx.mqtt_pub_begin_func = pub_begin;
+    dev_ctx->mqtt_ctx.mqtt_pub_write_func = pub_write;
+    dev_ctx->mqtt_ctx.mqtt_pub_end_func   = pub_end;
+
+    return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+}
+
 int iotex_dev_access_set_sign_func(iotex_sign_message sign_func) {
 
     if( (NULL == dev_ctx) || (0 == dev_ctx->inited) ) {
@@ -225,309 +305,1333 @@ int iotex_dev_access_mqtt_input(uint8_t *topic, uint8_t *payload, uint32_t len)
 
 void iotex_dev_access_loop(void) {
 
-	// TODO: Loop code here
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+		return;
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_UPLOAD_QUEUE
+	iotex_upload_queue_drain();
+#endif
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_SPOOL
+	iotex_dev_access_spool_replay();
+#endif
+
+#if defined(CONFIG_PSA_ECDSA_NONCE_POOL_DEPTH) && CONFIG_PSA_ECDSA_NONCE_POOL_DEPTH > 0
+	/* Spend idle time on the ECDSA nonces of the next uploads */
+	iotex_psa_ecdsa_pool_refill();
+#endif
 }
 
-int iotex_dev_access_data_upload_with_userdata(void *buf, size_t buf_len, enum UserData_Type type, int8_t mac[6]) {
+static bool iotex_pb_encode_bytes(pb_ostream_t *stream, const pb_field_t *field, void * const *arg) {
 
-	char sign_buf[64]  = {0};
-	unsigned int  sign_len = 0;
-	char *message = NULL;
-	size_t message_len = 0;
+	const iotex_pb_bytes_t *bytes = (const iotex_pb_bytes_t *)*arg;
 
-	if (NULL == dev_ctx || 0 == dev_ctx->inited)
-        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+	if (NULL == bytes || 0 == bytes->len)
+		return true;
 
-	if (dev_ctx->mqtt_ctx.status != IOTEX_MQTT_BIND_STATUS_OK)
-		return IOTEX_DEV_ACCESS_ERR_BAD_STATUS;
+	if (!pb_encode_tag_for_field(stream, field))
+		return false;
 
-	unsigned char *buffer = malloc(Upload_size);
-	if (NULL == buffer)
-		return IOTEX_DEV_ACCESS_ERR_ALLOCATE_FAIL;
+	return pb_encode_string(stream, bytes->buf, bytes->len);
+}
 
-	if (NULL == buf || 0 == buf_len)
-		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+static void iotex_pb_bytes_bind(pb_callback_t *cb, iotex_pb_bytes_t *bytes, const void *buf, size_t len) {
 
-	pb_ostream_t ostream_upload = {0};
-	Upload upload = Upload_init_default;
+	bytes->buf = (const uint8_t *)buf;
+	bytes->len = len;
 
-	upload.has_header = true;
-	strcpy(upload.header.event_id, IOTEX_EVENT_ID_DEFAULT);
-	strcpy(upload.header.pub_id,   IOTEX_PUB_ID_DEFAULT);
-	strcpy(upload.header.event_type, IOTEX_EVENT_TYPE_DEFAULT);
-	strcpy(upload.header.token, dev_ctx->mqtt_ctx.token);
-	upload.header.pub_time = IOTEX_PUB_TIME_TEST_DEFAULT;
+	cb->funcs.encode = iotex_pb_encode_bytes;
+	cb->arg          = bytes;
+}
 
-	upload.payload.ptype = Payload_PackageType_USERDATA;
- 	upload.payload.dtype = type;
+/* As nanopb encodes a char[max_len + 1] field, longer strings are rejected rather than cut */
+static bool iotex_pb_encode_str(pb_ostream_t *stream, uint32_t tag, const char *str, size_t max_len) {
 
- 	switch (type) {
+	size_t len = strnlen(str, max_len + 1);
 
- 		case IOTEX_USER_DATA_TYPE_JSON:
+	if (len > max_len)
+		PB_RETURN_ERROR(stream, "unterminated string");
 
- 			message = cJSON_PrintUnformatted((const cJSON *)buf);
- 			message_len = strlen(message);
+	if (0 == len)
+		return true;
 
- 			upload.payload.user.size = message_len;
- 			memcpy(upload.payload.user.bytes, message, message_len);
+	if (!pb_encode_tag(stream, PB_WT_STRING, tag))
+		return false;
 
- 			break;
- 		case IOTEX_USER_DATA_TYPE_PB:
+	return pb_encode_string(stream, (const pb_byte_t *)str, len);
+}
 
- 			upload.payload.user.size = buf_len;
- 			memcpy(upload.payload.user.bytes, buf, buf_len);
+/*
+ * Serialize the constant part of the Header submessage. pub_time (tag 4) is the
+ * only field that changes per upload, it is spliced in between the prefix and
+ * event_id when the Upload is encoded.
+ */
+static int iotex_dev_access_header_update(void) {
 
- 			message = (char *)buf;
- 			message_len = buf_len;
+	iotex_header_template_t *header = &dev_ctx->arena.header;
+	pb_ostream_t ostream_header = pb_ostream_from_buffer(header->buf, sizeof(header->buf));
 
- 			break;
- 		case IOTEX_USER_DATA_TYPE_RAW:
+	if (!iotex_pb_encode_str(&ostream_header, Header_event_type_tag, IOTEX_EVENT_TYPE_DEFAULT, sizeof(((Header *)0)->event_type) - 1) ||
+		!iotex_pb_encode_str(&ostream_header, Header_pub_id_tag, IOTEX_PUB_ID_DEFAULT, sizeof(((Header *)0)->pub_id) - 1) ||
+		!iotex_pb_encode_str(&ostream_header, Header_token_tag, dev_ctx->mqtt_ctx.token, sizeof(((Header *)0)->token) - 1))
+		goto err;
 
- 			upload.payload.user.size = buf_len;
-			memcpy(upload.payload.user.bytes, buf, buf_len);
+	header->prefix_len = ostream_header.bytes_written;
 
- 			message = (char *)buf;
- 			message_len = buf_len;
+	if (!iotex_pb_encode_str(&ostream_header, Header_event_id_tag, IOTEX_EVENT_ID_DEFAULT, sizeof(((Header *)0)->event_id) - 1))
+		goto err;
 
- 			break;
- 		default:
- 			return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
- 	}
+	header->len = ostream_header.bytes_written;
 
- 	psa_sign_message( g_sdkcore_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256), (const uint8_t *)message, message_len, (uint8_t *)sign_buf, 64, &sign_len);
+	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
 
- 	upload.has_payload = true;
- 	upload.payload.sign.size = sign_len;
- 	memcpy(upload.payload.sign.bytes, sign_buf, sign_len);
+err:
+	printf("pb encode [header] error in [%s]\n", PB_GET_ERROR(&ostream_header));
+	header->prefix_len = header->len = 0;
 
-	upload.payload.pubkey.size = 65;
-    memcpy(upload.payload.pubkey.bytes, iotex_deviceconnect_sdk_core_get_public_key(), 65);
+	return IOTEX_DEV_ACCESS_ERR_GENERAL;
+}
 
-	upload.payload.mac.size = 6;
-	memcpy(upload.payload.mac.bytes, mac, 6);
+static Payload *iotex_dev_access_upload_prepare(void) {
 
-	upload.payload.has_pConfirm = false;
+	Payload *payload = &dev_ctx->arena.payload;
 
-	memset(buffer, 0, Upload_size);
-	ostream_upload  = pb_ostream_from_buffer(buffer, Upload_size);
-	if (!pb_encode(&ostream_upload, Upload_fields, &upload)) {
-		printf("pb encode [event] error in [%s]\n", PB_GET_ERROR(&ostream_upload));
-		goto exit;
-	}
+	memset(payload, 0, sizeof(Payload));
 
-#ifdef IOTEX_DEBUG_ENABLE
-	printf("Event Upload len %d\n", ostream_upload.bytes_written);
+	return payload;
+}
 
-	for (int i = 0; i < ostream_upload.bytes_written; i++) {
-		printf("%02x ", buffer[i]);
-	}
-	printf("\n");
-#endif
+static size_t iotex_pb_varint_size(uint64_t value) {
 
-	iotex_dev_access_send_data(buffer, ostream_upload.bytes_written);
+	size_t size = 1;
 
-exit:
-	if(buffer) {
-		free(buffer);
-		buffer = NULL;
-	}
+	while (value >>= 7)
+		size++;
 
-	if (IOTEX_USER_DATA_TYPE_JSON == type &&  message) {
-		free(message);
-		message = NULL;
-	}
+	return size;
+}
 
-	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+/*
+ * Equivalent to pb_encode(stream, Upload_fields, ...) but with the Header
+ * submessage taken from the pre-serialized template.
+ */
+static bool iotex_dev_access_upload_encode(pb_ostream_t *stream) {
+
+	iotex_encode_arena_t *arena = &dev_ctx->arena;
+	uint64_t pub_time = (uint64_t)IOTEX_PUB_TIME_TEST_DEFAULT;
+	size_t pub_time_len = 1 + iotex_pb_varint_size(pub_time);
+
+	/* The template is cleared when the token or topic could not be encoded */
+	if (0 == arena->header.len)
+		PB_RETURN_ERROR(stream, "no header");
+
+	if (!pb_encode_tag(stream, PB_WT_STRING, Upload_header_tag) ||
+		!pb_encode_varint(stream, arena->header.len + pub_time_len) ||
+		!pb_write(stream, arena->header.buf, arena->header.prefix_len) ||
+		!pb_encode_tag(stream, PB_WT_VARINT, Header_pub_time_tag) ||
+		!pb_encode_varint(stream, pub_time) ||
+		!pb_write(stream, arena->header.buf + arena->header.prefix_len, arena->header.len - arena->header.prefix_len))
+		return false;
+
+	if (!pb_encode_tag(stream, PB_WT_STRING, Upload_payload_tag))
+		return false;
+
+	return pb_encode_submessage(stream, Payload_fields, &arena->payload);
 }
 
-int iotex_dev_access_query_dev_register_status(int8_t mac[6]) {
+static bool iotex_dev_access_ostream_write(pb_ostream_t *stream, const pb_byte_t *buf, size_t count) {
 
-	if (NULL == dev_ctx || 0 == dev_ctx->inited)
-        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+	(void)stream;
 
-	if (dev_ctx->mqtt_ctx.status != IOTEX_MQTT_CONNECTED)
-		return IOTEX_DEV_ACCESS_ERR_BAD_STATUS;
+	return dev_ctx->mqtt_ctx.mqtt_pub_write_func((const unsigned char *)buf, count) != 0;
+}
 
-	unsigned char *buffer = malloc(Upload_size);
-	if (NULL == buffer)
-		return IOTEX_DEV_ACCESS_ERR_ALLOCATE_FAIL;
+static int iotex_dev_access_upload_stream(void) {
 
-	pb_ostream_t ostream_upload = {0};
-	Upload upload = Upload_init_default;
+	iotex_mqtt_ctx_t *mqtt_ctx = &dev_ctx->mqtt_ctx;
+	pb_ostream_t ostream_upload = PB_OSTREAM_SIZING;
 
-	upload.has_header = true;
-	strcpy(upload.header.event_id, IOTEX_EVENT_ID_DEFAULT);
-	strcpy(upload.header.pub_id,   IOTEX_PUB_ID_DEFAULT);
-	strcpy(upload.header.event_type, IOTEX_EVENT_TYPE_DEFAULT);
-	strcpy(upload.header.token, dev_ctx->mqtt_ctx.token);
-	upload.header.pub_time = IOTEX_PUB_TIME_TEST_DEFAULT;
+	if (!iotex_dev_access_upload_encode(&ostream_upload))
+		return IOTEX_DEV_ACCESS_ERR_GENERAL;
 
- 	upload.has_payload = true;
- 	upload.payload.ptype = Payload_PackageType_QUERY;
+	if (!mqtt_ctx->mqtt_pub_begin_func((unsigned char *)mqtt_ctx->topic[0], ostream_upload.bytes_written, 0))
+		return IOTEX_DEV_ACCESS_ERR_SEND_DATA_FAIL;
 
-	upload.payload.mac.size = 6;
-	memcpy(upload.payload.mac.bytes, mac, 6);
+	ostream_upload.callback      = iotex_dev_access_ostream_write;
+	ostream_upload.max_size      = ostream_upload.bytes_written;
+	ostream_upload.bytes_written = 0;
 
-	memset(buffer, 0, Upload_size);
-	ostream_upload  = pb_ostream_from_buffer(buffer, Upload_size);
-	if (!pb_encode(&ostream_upload, Upload_fields, &upload)) {
+	/* The sizing pass succeeded, so a failure here comes from the transport */
+	if (!iotex_dev_access_upload_encode(&ostream_upload)) {
 		printf("pb encode [event] error in [%s]\n", PB_GET_ERROR(&ostream_upload));
-		goto exit;
+		return IOTEX_DEV_ACCESS_ERR_SEND_DATA_FAIL;
+	}
+
+#ifdef IOTEX_DEBUG_ENABLE
+	printf("Event Upload len %d\n", ostream_upload.bytes_written);
+#endif
+
+	return (mqtt_ctx->mqtt_pub_end_func() ? IOTEX_DEV_ACCESS_ERR_SUCCESS : IOTEX_DEV_ACCESS_ERR_SEND_DATA_FAIL);
+}
+
+static int iotex_dev_access_upload_encode_and_send(void) {
+
+	iotex_encode_arena_t *arena = &dev_ctx->arena;
+	pb_ostream_t ostream_upload = {0};
+
+	if (dev_ctx->mqtt_ctx.mqtt_pub_begin_func)
+		return iotex_dev_access_upload_stream();
+
+	ostream_upload = pb_ostream_from_buffer(arena->buf, arena->buf_size);
+	if (!iotex_dev_access_upload_encode(&ostream_upload)) {
+		printf("pb encode [event] error in [%s]\n", PB_GET_ERROR(&ostream_upload));
+		return IOTEX_DEV_ACCESS_ERR_GENERAL;
 	}
 
 #ifdef IOTEX_DEBUG_ENABLE
 	printf("Event Upload len %d\n", ostream_upload.bytes_written);
 
 	for (int i = 0; i < ostream_upload.bytes_written; i++) {
-		printf("%02x ", buffer[i]);
+		printf("%02x ", arena->buf[i]);
 	}
 	printf("\n");
 #endif
 
-	iotex_dev_access_send_data(buffer, ostream_upload.bytes_written);
+	return iotex_dev_access_send_data(arena->buf, ostream_upload.bytes_written);
+}
 
-exit:
-	if(buffer) {
-		free(buffer);
-		buffer = NULL;
+#ifdef CONFIG_APP_DEVNET_ACCESS_SPOOL
+static int iotex_dev_access_spool_ready(void) {
+
+	return (NULL != dev_ctx->spool.drv);
+}
+
+/* Encode the signed Upload into the arena buffer and append it to the spool */
+static int iotex_dev_access_upload_spool(void) {
+
+	iotex_encode_arena_t *arena = &dev_ctx->arena;
+	pb_ostream_t ostream_upload = pb_ostream_from_buffer(arena->buf, arena->buf_size);
+
+	if (!iotex_dev_access_upload_encode(&ostream_upload)) {
+		printf("pb encode [event] error in [%s]\n", PB_GET_ERROR(&ostream_upload));
+		return IOTEX_DEV_ACCESS_ERR_GENERAL;
 	}
 
-	return IOTEX_DEV_ACCESS_ERR_SUCCESS;	
+	if (iotex_spool_append(&dev_ctx->spool, arena->buf, ostream_upload.bytes_written))
+		return IOTEX_DEV_ACCESS_ERR_GENERAL;
+
+	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
 }
 
-int iotex_dev_access_dev_register_confirm(int8_t mac[6]) {
+/* Replay spooled uploads with a token bucket so a reconnect does not flood the link */
+static void iotex_dev_access_spool_replay(void) {
 
-	char raw_data[24]  = {0};
-	char sign_buf[64]  = {0};
-	unsigned int  sign_len = 0;
+	iotex_spool_t *spool = &dev_ctx->spool;
+	const uint8_t *buf = NULL;
+	size_t len = 0;
+	time_t now = 0;
+
+	if (!iotex_dev_access_spool_ready() || dev_ctx->mqtt_ctx.status != IOTEX_MQTT_BIND_STATUS_OK)
+		return;
+
+	now = (dev_ctx->get_time_func ? dev_ctx->get_time_func() : time(NULL));
+
+	if (now > dev_ctx->spool_time) {
+		uint64_t tokens = dev_ctx->spool_tokens + (uint64_t)(now - dev_ctx->spool_time) * IOTEX_DEV_ACCESS_SPOOL_REPLAY_RATE;
+		dev_ctx->spool_tokens = (tokens > IOTEX_DEV_ACCESS_SPOOL_REPLAY_RATE ? IOTEX_DEV_ACCESS_SPOOL_REPLAY_RATE : (uint32_t)tokens);
+	}
+	dev_ctx->spool_time = now;
+
+	while (dev_ctx->spool_tokens && IOTEX_SPOOL_ERR_SUCCESS == iotex_spool_peek(spool, &buf, &len)) {
+
+		if (IOTEX_DEV_ACCESS_ERR_SUCCESS != iotex_dev_access_send_data((unsigned char *)buf, len))
+			break;
+
+		iotex_spool_pop(spool);
+		dev_ctx->spool_tokens--;
+	}
+}
+
+int iotex_dev_access_spool_attach(flash_drv *drv) {
 
 	if (NULL == dev_ctx || 0 == dev_ctx->inited)
         return IOTEX_DEV_ACCESS_ERR_NO_INIT;
 
-	if (dev_ctx->mqtt_ctx.status != IOTEX_MQTT_CONNECTED)
-		return IOTEX_DEV_ACCESS_ERR_BAD_STATUS;
+	if (NULL == drv)
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
 
-	unsigned char *buffer = malloc(Upload_size);
-	if (NULL == buffer)
-		return IOTEX_DEV_ACCESS_ERR_ALLOCATE_FAIL;
+	if (iotex_spool_mount(&dev_ctx->spool, drv))
+		return IOTEX_DEV_ACCESS_ERR_GENERAL;
 
-	uint32_t timestamp = time(0);
-	if (timestamp < DEFAULT_TIME_STAMP_UNIX_VALUE)
-		timestamp = DEFAULT_TIME_STAMP_UNIX_VALUE;
-	
-	pb_ostream_t ostream_upload = {0};
-	Upload upload = Upload_init_default;
+	dev_ctx->spool_tokens = IOTEX_DEV_ACCESS_SPOOL_REPLAY_RATE;
+	dev_ctx->spool_time   = 0;
 
-	upload.has_header = true;
-	strcpy(upload.header.event_id, IOTEX_EVENT_ID_DEFAULT);
-	strcpy(upload.header.pub_id,   IOTEX_PUB_ID_DEFAULT);
-	strcpy(upload.header.event_type, IOTEX_EVENT_TYPE_DEFAULT);
-	strcpy(upload.header.token, dev_ctx->mqtt_ctx.token);
-	upload.header.pub_time = IOTEX_PUB_TIME_TEST_DEFAULT;
+	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+}
 
- 	upload.has_payload = true;
- 	upload.payload.ptype = Payload_PackageType_COMFIRM;
+int iotex_dev_access_get_spool_stats(iotex_spool_stats_t *stats) {
 
-	upload.payload.mac.size = 6;
-	memcpy(upload.payload.mac.bytes, mac, 6);
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
 
-	upload.payload.pubkey.size = 65;
-    memcpy(upload.payload.pubkey.bytes, iotex_deviceconnect_sdk_core_get_public_key(), 65);	
+	if (NULL == stats)
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
 
-	upload.payload.has_pConfirm = true;
+	*stats = dev_ctx->spool.stats;
 
-	upload.payload.pConfirm.owner.size = hexStr2Bin(wallet_addr + 2, (char *)upload.payload.pConfirm.owner.bytes);
-	
-	memcpy(raw_data, upload.payload.pConfirm.owner.bytes, upload.payload.pConfirm.owner.size);
-	raw_data[upload.payload.pConfirm.owner.size]     = (char)((timestamp & 0xFF000000) >> 24);
-    raw_data[upload.payload.pConfirm.owner.size + 1] = (char)((timestamp & 0x00FF0000) >> 16);
-    raw_data[upload.payload.pConfirm.owner.size + 2] = (char)((timestamp & 0x0000FF00) >> 8);
-    raw_data[upload.payload.pConfirm.owner.size + 3] = (char)(timestamp & 0x000000FF);	
-
-	psa_sign_message( g_sdkcore_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256), (const uint8_t *)(raw_data), upload.payload.pConfirm.owner.size + 4, (uint8_t *)sign_buf, 64, &sign_len);
-	LowsCalc(sign_buf + 32, sign_buf + 32);
-	
-	upload.payload.pConfirm.timestamp = timestamp;
+	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+}
+#endif
 
-	upload.payload.pConfirm.signature.size = sign_len;
-	memcpy(upload.payload.pConfirm.signature.bytes, sign_buf, sign_len);
+/* Whether user data can be accepted: the link is up or it can be spooled */
+static int iotex_dev_access_upload_ready(void) {
 
-	upload.payload.pConfirm.channel = 8183;
-	
-	memset(buffer, 0, Upload_size);
-	ostream_upload  = pb_ostream_from_buffer(buffer, Upload_size);
-	if (!pb_encode(&ostream_upload, Upload_fields, &upload)) {
-		printf("pb encode [event] error in [%s]\n", PB_GET_ERROR(&ostream_upload));
-		goto exit;
-	}
+	if (dev_ctx->mqtt_ctx.status == IOTEX_MQTT_BIND_STATUS_OK)
+		return 1;
 
-#ifdef IOTEX_DEBUG_ENABLE
-	printf("Event Upload len %d\n", ostream_upload.bytes_written);
-	for (int i = 0; i < ostream_upload.bytes_written; i++) {
-		printf("%02x ", buffer[i]);
-	}
-	printf("\n");
+#ifdef CONFIG_APP_DEVNET_ACCESS_SPOOL
+	return iotex_dev_access_spool_ready();
+#else
+	return 0;
 #endif
+}
 
-	iotex_dev_access_send_data(buffer, ostream_upload.bytes_written);
+/*
+ * Publish signed user data. Fresh data is always sent directly while the link
+ * is up, spooled data is replayed separately by iotex_dev_access_loop().
+ */
+static int iotex_dev_access_upload_userdata_send(void) {
 
-exit:
-	if(buffer) {
-		free(buffer);
-		buffer = NULL;
-	}
+#ifdef CONFIG_APP_DEVNET_ACCESS_SPOOL
+	int ret = IOTEX_DEV_ACCESS_ERR_SEND_DATA_FAIL;
 
-	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+	if (dev_ctx->mqtt_ctx.status == IOTEX_MQTT_BIND_STATUS_OK)
+		ret = iotex_dev_access_upload_encode_and_send();
+
+	if (IOTEX_DEV_ACCESS_ERR_SEND_DATA_FAIL == ret && iotex_dev_access_spool_ready())
+		ret = iotex_dev_access_upload_spool();
+
+	return ret;
+#else
+	return iotex_dev_access_upload_encode_and_send();
+#endif
 }
 
-int iotex_dev_access_set_mqtt_status(enum IOTEX_MQTT_STATUS status) {
+#ifdef CONFIG_APP_DEVNET_ACCESS_COMPRESSION
+/*
+ * Compress message into out as a 4-byte little-endian uncompressed length
+ * followed by one LZ4 block. Returns the framed length, or 0 if the result
+ * would not be smaller than the message or not fit in out_size bytes.
+ */
+static size_t iotex_dev_access_compress(const void *message, size_t message_len, uint8_t *out, size_t out_size, uint16_t *table) {
 
-	if( NULL == dev_ctx || 0 == dev_ctx->inited ) {
-		return IOTEX_DEV_ACCESS_ERR_NO_INIT;
-	}
+	int len = 0;
 
-	dev_ctx->mqtt_ctx.status = status;
-#ifdef IOTEX_DEBUG_ENABLE
-#ifndef IOTEX_DEBUG_ENABLE_FORCE
-	if( dev_ctx->debug_enable ) {
+	if (message_len > IOTEX_LZ_MAX_INPUT || message_len <= 4 || out_size <= 4)
+		return 0;
+
+	len = iotex_lz_compress((const uint8_t *)message, message_len, out + 4, out_size - 4, table);
+	if (len < 0 || (size_t)len + 4 >= message_len)
+		return 0;
+
+	out[0] = (uint8_t)message_len;
+	out[1] = (uint8_t)(message_len >> 8);
+	out[2] = (uint8_t)(message_len >> 16);
+	out[3] = (uint8_t)(message_len >> 24);
+
+	return (size_t)len + 4;
+}
 #endif
-		printf("mqtt status set %d\n", dev_ctx->mqtt_ctx.status);
-#ifndef IOTEX_DEBUG_ENABLE_FORCE
+
+/*
+ * Sign and publish one serialized record as it is, *_LZ4 records must already be compressed.
+ * digest is the SHA-256 of message when the caller already computed it.
+ */
+static int iotex_dev_access_upload_signed(const void *message, size_t message_len, const uint8_t *digest, enum UserData_Type type, int8_t mac[6]) {
+
+	psa_status_t status = PSA_ERROR_GENERIC_ERROR;
+	size_t sign_len = 0;
+	iotex_encode_arena_t *arena = &dev_ctx->arena;
+	Payload *payload = iotex_dev_access_upload_prepare();
+
+	/* Only a streaming transport can publish more than the arena buffer was sized for */
+	if (message_len > IOTEX_DEV_ACCESS_USER_DATA_SIZE && NULL == dev_ctx->mqtt_ctx.mqtt_pub_begin_func)
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	payload->ptype = Payload_PackageType_USERDATA;
+ 	payload->dtype = type;
+
+ 	if (digest)
+ 		status = psa_sign_hash( g_sdkcore_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256), digest, 32, arena->sign_buf, sizeof(arena->sign_buf), &sign_len);
+ 	else
+ 		status = psa_sign_message( g_sdkcore_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256), (const uint8_t *)message, message_len, arena->sign_buf, sizeof(arena->sign_buf), &sign_len);
+
+ 	if (PSA_SUCCESS != status)
+ 		return IOTEX_DEV_ACCESS_ERR_GENERAL;
+
+	iotex_pb_bytes_bind(&payload->user, &arena->user, message, message_len);
+	iotex_pb_bytes_bind(&payload->sign, &arena->sign, arena->sign_buf, sign_len);
+	iotex_pb_bytes_bind(&payload->pubkey, &arena->pubkey, iotex_deviceconnect_sdk_core_get_public_key(), 65);
+
+	payload->mac.size = 6;
+	memcpy(payload->mac.bytes, mac, 6);
+
+	payload->has_pConfirm = false;
+
+	return iotex_dev_access_upload_userdata_send();
+}
+
+/*
+ * Sign and publish one serialized record, shared by the direct and queued uploads.
+ * The *_LZ4 types are compressed here so the signature covers the bytes sent,
+ * data that does not shrink goes out uncompressed under its plain type.
+ */
+static int iotex_dev_access_upload_message(const void *message, size_t message_len, const uint8_t *digest, enum UserData_Type type, int8_t mac[6]) {
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_COMPRESSION
+	if (IOTEX_USER_DATA_TYPE_IS_LZ4(type)) {
+
+		iotex_encode_arena_t *arena = &dev_ctx->arena;
+		size_t lz_len = iotex_dev_access_compress(message, message_len, arena->lz_buf, sizeof(arena->lz_buf), arena->lz_table);
+
+		if (lz_len)
+			return iotex_dev_access_upload_signed(arena->lz_buf, lz_len, NULL, type, mac);
+
+		type = IOTEX_USER_DATA_TYPE_PLAIN(type);
 	}
-#endif
 #endif
 
-	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+	return iotex_dev_access_upload_signed(message, message_len, digest, type, mac);
 }
 
-int iotex_dev_access_debug_enable(int enable) {
+int iotex_dev_access_data_upload_with_userdata(void *buf, size_t buf_len, enum UserData_Type type, int8_t mac[6]) {
 
-    if( NULL == dev_ctx || 0 == dev_ctx->inited )
+	char *message = NULL;
+	size_t message_len = 0;
+	iotex_encode_arena_t *arena = NULL;
+
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
         return IOTEX_DEV_ACCESS_ERR_NO_INIT;
 
-    dev_ctx->debug_enable = enable;
+	if (!iotex_dev_access_upload_ready())
+		return IOTEX_DEV_ACCESS_ERR_BAD_STATUS;
 
-    return IOTEX_DEV_ACCESS_ERR_SUCCESS;
-}
+	if (NULL == buf || 0 == buf_len || !IOTEX_USER_DATA_TYPE_VALID(type))
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
 
-int iotex_dev_access_generate_dev_addr(const unsigned char* public_key, char *dev_address)
-{
-	// The device address is the hex string representation of the last 20 bytes of the keccak256 hash of the public key.
+	arena  = &dev_ctx->arena;
 
-	uint8_t hash[32] = {0};
-	keccak256_getHash(public_key + 1, 64, hash);
+ 	switch (type) {
 
-    dev_address[0] = '0';
-    dev_address[1] = 'x';
+ 		case IOTEX_USER_DATA_TYPE_JSON:
 
-	for (int i=0; i<20; i++)
-	{
-		char buf[3] = {0};
-		sprintf(buf, "%02x", hash[32 - 20 + i]);
+ 			if (!cJSON_PrintPreallocated((cJSON *)buf, arena->json_buf, sizeof(arena->json_buf), 0))
+ 				return IOTEX_DEV_ACCESS_ERR_JSON_FAIL;
 
-        memcpy(dev_address + 2 + i * 2, buf, 2);
+ 			message = arena->json_buf;
+ 			message_len = strlen(message);
 
-	}
+ 			break;
+#ifdef CONFIG_APP_DEVNET_ACCESS_COMPRESSION
+ 		case IOTEX_USER_DATA_TYPE_JSON_LZ4:
+
+ 			/* Printed into the larger lz_src, only the compressed result has to fit the user field */
+ 			if (!cJSON_PrintPreallocated((cJSON *)buf, arena->lz_src, sizeof(arena->lz_src), 0))
+ 				return IOTEX_DEV_ACCESS_ERR_JSON_FAIL;
+
+ 			message = arena->lz_src;
+ 			message_len = strlen(message);
+
+ 			break;
+ 		case IOTEX_USER_DATA_TYPE_PB_LZ4:
+ 		case IOTEX_USER_DATA_TYPE_RAW_LZ4:
+#endif
+ 		case IOTEX_USER_DATA_TYPE_PB:
+ 		case IOTEX_USER_DATA_TYPE_RAW:
+ 		case IOTEX_USER_DATA_TYPE_TIMESERIES:
+
+ 			message = (char *)buf;
+ 			message_len = buf_len;
+
+ 			break;
+ 		default:
+ 			return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+ 	}
+
+	return iotex_dev_access_upload_message(message, message_len, NULL, type, mac);
+}
+
+/*
+ * JSON upload without a cJSON tree: the returned writer prints straight into
+ * the encode arena and hashes as it goes, so the upload only has to sign the
+ * digest. Not reentrant, the writer is owned by the arena.
+ */
+iotex_json_writer_t *iotex_dev_access_json_writer_begin(void) {
+
+	iotex_encode_arena_t *arena = NULL;
+
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+        return NULL;
+
+	arena = &dev_ctx->arena;
+
+	tc_sha256_init(&arena->json_sha);
+	iotex_json_writer_init(&arena->json_writer, arena->json_buf, sizeof(arena->json_buf), &arena->json_sha);
+
+	return &arena->json_writer;
+}
+
+int iotex_dev_access_json_writer_upload(iotex_json_writer_t *writer, int8_t mac[6]) {
+
+	iotex_encode_arena_t *arena = NULL;
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+	int len = 0;
+
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+
+	arena = &dev_ctx->arena;
+
+	if (writer != &arena->json_writer || NULL == mac)
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	if (!iotex_dev_access_upload_ready())
+		return IOTEX_DEV_ACCESS_ERR_BAD_STATUS;
+
+	if ((len = iotex_json_writer_finish(writer)) < 0)
+		return IOTEX_DEV_ACCESS_ERR_JSON_FAIL;
+
+	tc_sha256_final(digest, &arena->json_sha);
+
+	return iotex_dev_access_upload_message(arena->json_buf, len, digest, IOTEX_USER_DATA_TYPE_JSON, mac);
+}
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_UPLOAD_QUEUE
+
+#define IOTEX_QUEUE_MASK	(IOTEX_DEV_ACCESS_QUEUE_LEN - 1)
+
+#if (IOTEX_DEV_ACCESS_QUEUE_LEN & IOTEX_QUEUE_MASK) != 0
+#error "IOTEX_DEV_ACCESS_QUEUE_LEN must be a power of two"
+#endif
+
+/* seq of a slot whose record is being sent, distinct from pos + LEN while LEN >= 4 */
+#if IOTEX_DEV_ACCESS_QUEUE_LEN < 4
+#error "IOTEX_DEV_ACCESS_QUEUE_LEN must be at least 4"
+#endif
+#define IOTEX_QUEUE_SENDING(pos)	((pos) + 2)
+
+/* Identifies the task running iotex_dev_access_loop(), 0 where unknown */
+#if defined(ESP_PLATFORM)
+#define IOTEX_QUEUE_SELF()			((uintptr_t)xTaskGetCurrentTaskHandle())
+#elif defined(__linux__)
+#define IOTEX_QUEUE_SELF()			((uintptr_t)pthread_self())
+#else
+#define IOTEX_QUEUE_SELF()			((uintptr_t)0)
+#endif
+
+/* Whether iotex_upload_queue_wait() lets another task run the loop */
+#if defined(ESP_PLATFORM) || defined(__linux__)
+#define IOTEX_QUEUE_CAN_WAIT		1
+#else
+#define IOTEX_QUEUE_CAN_WAIT		0
+#endif
+
+static void iotex_upload_queue_init(iotex_upload_queue_t *queue) {
+
+	for (size_t i = 0; i < IOTEX_DEV_ACCESS_QUEUE_LEN; i++)
+		queue->slot[i].seq = i;
+
+	queue->head     = 0;
+	queue->tail     = 0;
+	queue->policy   = IOTEX_QUEUE_POLICY_DROP_OLDEST;
+	queue->consumer = 0;
+}
+
+/*
+ * Claim the slot at tail (producer) or head (consumer). ready is the offset of
+ * seq from the position that makes the slot usable: 0 to fill, 1 to drain.
+ * Returns NULL when the ring is full or empty respectively.
+ */
+static iotex_upload_slot_t *iotex_upload_queue_claim(size_t *index, size_t ready, size_t *pos) {
+
+	iotex_upload_queue_t *queue = &dev_ctx->queue;
+	size_t cur = __atomic_load_n(index, __ATOMIC_RELAXED);
+
+	for (;;) {
+
+		iotex_upload_slot_t *slot = &queue->slot[cur & IOTEX_QUEUE_MASK];
+		size_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+		intptr_t diff = (intptr_t)seq - (intptr_t)(cur + ready);
+
+		if (0 == diff) {
+			if (__atomic_compare_exchange_n(index, &cur, cur + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				*pos = cur;
+				return slot;
+			}
+		} else if (diff < 0) {
+			return NULL;
+		} else {
+			cur = __atomic_load_n(index, __ATOMIC_RELAXED);
+		}
+	}
+}
+
+static void iotex_upload_queue_wait(void) {
+
+#if defined(ESP_PLATFORM)
+	vTaskDelay(1);
+#elif defined(__linux__)
+	sched_yield();
+#endif
+}
+
+/*
+ * Take the record of pos, whose head the caller has claimed, by moving its seq
+ * from pos + 1 to to. A coalescing producer may still hold the slot at seq ==
+ * pos, it republishes it shortly.
+ */
+static void iotex_upload_queue_take(iotex_upload_slot_t *slot, size_t pos, size_t to) {
+
+	size_t seq = pos + 1;
+
+	while (!__atomic_compare_exchange_n(&slot->seq, &seq, to, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+		seq = pos + 1;
+		iotex_upload_queue_wait();
+	}
+}
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_COMPRESSION
+/*
+ * JSON_LZ4 is printed into the queue's scratch, which is sized like the direct
+ * upload's and not like a slot, and only the compressed frame is stored. Text
+ * that does not shrink is stored as plain JSON if it fits.
+ */
+static int iotex_upload_queue_fill_lz(iotex_upload_slot_t *slot, cJSON *json) {
+
+	iotex_upload_queue_t *queue = &dev_ctx->queue;
+	size_t len = 0;
+	int idle = 0, ret = IOTEX_DEV_ACCESS_ERR_SUCCESS;
+
+	while (!__atomic_compare_exchange_n(&queue->lz_busy, &idle, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+		idle = 0;
+		iotex_upload_queue_wait();
+	}
+
+	slot->len = 0;
+
+	if (!cJSON_PrintPreallocated(json, queue->lz_src, sizeof(queue->lz_src), 0)) {
+		ret = IOTEX_DEV_ACCESS_ERR_JSON_FAIL;
+		goto exit;
+	}
+
+	len = strlen(queue->lz_src);
+
+	if (0 != (slot->len = iotex_dev_access_compress(queue->lz_src, len, slot->buf, sizeof(slot->buf), queue->lz_table))) {
+		slot->framed = 1;
+	} else if (len <= sizeof(slot->buf)) {
+		memcpy(slot->buf, queue->lz_src, len);
+		slot->len  = len;
+		slot->type = IOTEX_USER_DATA_TYPE_JSON;
+	} else {
+		ret = IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+	}
+
+exit:
+	__atomic_store_n(&queue->lz_busy, 0, __ATOMIC_RELEASE);
+
+	return ret;
+}
+#endif
+
+static int iotex_upload_queue_fill(iotex_upload_slot_t *slot, void *buf, size_t buf_len, enum UserData_Type type, int8_t mac[6]) {
+
+	slot->type   = type;
+	slot->framed = 0;
+	memcpy(slot->mac, mac, 6);
+
+#ifdef CONFIG_APP_DEVNET_ACCESS_COMPRESSION
+	if (IOTEX_USER_DATA_TYPE_JSON_LZ4 == type)
+		return iotex_upload_queue_fill_lz(slot, (cJSON *)buf);
+#endif
+
+	if (IOTEX_USER_DATA_TYPE_JSON == type) {
+
+		/* A failed print still has to be published, an empty record is skipped by the loop */
+		if (!cJSON_PrintPreallocated((cJSON *)buf, (char *)slot->buf, sizeof(slot->buf), 0)) {
+			slot->len = 0;
+			return IOTEX_DEV_ACCESS_ERR_JSON_FAIL;
+		}
+
+		slot->len = strlen((char *)slot->buf);
+	} else {
+		memcpy(slot->buf, buf, buf_len);
+		slot->len = buf_len;
+	}
+
+	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+}
+
+/*
+ * Replace the newest pending record, fails if it is being sent, dropped or
+ * filled. Consumers move seq away from pos + 1 before they touch a record, so
+ * the CAS only wins while the record is still pending.
+ */
+static int iotex_upload_queue_coalesce(void *buf, size_t buf_len, enum UserData_Type type, int8_t mac[6]) {
+
+	iotex_upload_queue_t *queue = &dev_ctx->queue;
+	size_t pos = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED) - 1;
+	iotex_upload_slot_t *slot = &queue->slot[pos & IOTEX_QUEUE_MASK];
+	size_t seq = pos + 1;
+	int ret;
+
+	/* seq == pos hides the slot from consumers while it is rewritten */
+	if (!__atomic_compare_exchange_n(&slot->seq, &seq, pos, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+		return IOTEX_DEV_ACCESS_ERR_QUEUE_FULL;
+
+	ret = iotex_upload_queue_fill(slot, buf, buf_len, type, mac);
+
+	/* Nothing else moves seq off pos, a consumer waits for pos + 1 */
+	seq = pos;
+	if (!__atomic_compare_exchange_n(&slot->seq, &seq, pos + 1, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+		return IOTEX_DEV_ACCESS_ERR_QUEUE_FULL;
+
+	__atomic_fetch_add(&queue->stats.coalesced, 1, __ATOMIC_RELAXED);
+
+	return ret;
+}
+
+int iotex_dev_access_data_enqueue(void *buf, size_t buf_len, enum UserData_Type type, int8_t mac[6]) {
+
+	iotex_upload_queue_t *queue = NULL;
+	iotex_upload_slot_t *slot = NULL;
+	size_t pos = 0, depth = 0;
+	int ret = 0;
+
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+
+	if (NULL == buf || 0 == buf_len || NULL == mac)
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	if (!IOTEX_USER_DATA_TYPE_VALID(type))
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	if (IOTEX_USER_DATA_TYPE_JSON != IOTEX_USER_DATA_TYPE_PLAIN(type) && buf_len > IOTEX_DEV_ACCESS_QUEUE_RECORD_SIZE)
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	queue = &dev_ctx->queue;
+
+	while (NULL == (slot = iotex_upload_queue_claim(&queue->tail, 0, &pos))) {
+
+		switch (queue->policy) {
+
+			case IOTEX_QUEUE_POLICY_DROP_OLDEST:
+
+				slot = iotex_upload_queue_claim(&queue->head, 1, &pos);
+				if (slot) {
+					iotex_upload_queue_take(slot, pos, pos + IOTEX_DEV_ACCESS_QUEUE_LEN);
+					__atomic_fetch_add(&queue->stats.dropped, 1, __ATOMIC_RELAXED);
+				}
+
+				break;
+			case IOTEX_QUEUE_POLICY_BLOCK:
+
+				/* Only iotex_dev_access_loop() frees slots, it must not wait on itself */
+#if IOTEX_QUEUE_CAN_WAIT
+				if (IOTEX_QUEUE_SELF() == __atomic_load_n(&queue->consumer, __ATOMIC_RELAXED))
+					return IOTEX_DEV_ACCESS_ERR_QUEUE_FULL;
+
+				iotex_upload_queue_wait();
+#else
+				/* Without a scheduler the loop cannot run while this call spins */
+				return IOTEX_DEV_ACCESS_ERR_QUEUE_FULL;
+#endif
+
+				break;
+			case IOTEX_QUEUE_POLICY_COALESCE:
+
+				if (IOTEX_DEV_ACCESS_ERR_QUEUE_FULL != (ret = iotex_upload_queue_coalesce(buf, buf_len, type, mac)))
+					return ret;
+
+				break;
+			default:
+				return IOTEX_DEV_ACCESS_ERR_QUEUE_FULL;
+		}
+	}
+
+	ret = iotex_upload_queue_fill(slot, buf, buf_len, type, mac);
+	__atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+
+	__atomic_fetch_add(&queue->stats.enqueued, 1, __ATOMIC_RELAXED);
+
+	depth = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED) - __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+	if (depth > __atomic_load_n(&queue->stats.high_water, __ATOMIC_RELAXED))
+		__atomic_store_n(&queue->stats.high_water, depth, __ATOMIC_RELAXED);
+
+	return ret;
+}
+
+int iotex_dev_access_set_queue_policy(enum IOTEX_QUEUE_POLICY policy) {
+
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+
+	if (policy > IOTEX_QUEUE_POLICY_COALESCE)
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	dev_ctx->queue.policy = policy;
+
+	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+}
+
+int iotex_dev_access_get_queue_stats(iotex_upload_queue_stats_t *stats) {
+
+	iotex_upload_queue_t *queue = NULL;
+
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+
+	if (NULL == stats)
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	queue = &dev_ctx->queue;
+
+	stats->depth      = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED) - __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+	stats->high_water = __atomic_load_n(&queue->stats.high_water, __ATOMIC_RELAXED);
+	stats->enqueued   = __atomic_load_n(&queue->stats.enqueued, __ATOMIC_RELAXED);
+	stats->sent       = __atomic_load_n(&queue->stats.sent, __ATOMIC_RELAXED);
+	stats->failed     = __atomic_load_n(&queue->stats.failed, __ATOMIC_RELAXED);
+	stats->dropped    = __atomic_load_n(&queue->stats.dropped, __ATOMIC_RELAXED);
+	stats->coalesced  = __atomic_load_n(&queue->stats.coalesced, __ATOMIC_RELAXED);
+
+	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+}
+
+/*
+ * Sign and publish at most one ring's worth of records, the only consumer besides drop-oldest.
+ * Nothing is popped while the upload is not ready; a record that fails to encode, sign or
+ * publish is dropped and counted as failed rather than retried, so it cannot wedge the ring.
+ */
+static void iotex_upload_queue_drain(void) {
+
+	iotex_upload_queue_t *queue = &dev_ctx->queue;
+	iotex_upload_slot_t *slot = NULL;
+	size_t pos = 0, seq = 0;
+	int ret = 0;
+
+	__atomic_store_n(&queue->consumer, IOTEX_QUEUE_SELF(), __ATOMIC_RELAXED);
+
+	for (int i = 0; i < IOTEX_DEV_ACCESS_QUEUE_LEN; i++) {
+
+		if (!iotex_dev_access_upload_ready())
+			return;
+
+		if (NULL == (slot = iotex_upload_queue_claim(&queue->head, 1, &pos)))
+			return;
+
+		iotex_upload_queue_take(slot, pos, IOTEX_QUEUE_SENDING(pos));
+
+		if (slot->framed)
+			ret = iotex_dev_access_upload_signed(slot->buf, slot->len, NULL, slot->type, slot->mac);
+		else if (slot->len)
+			ret = iotex_dev_access_upload_message(slot->buf, slot->len, NULL, slot->type, slot->mac);
+		else
+			ret = IOTEX_DEV_ACCESS_ERR_JSON_FAIL;
+
+		if (IOTEX_DEV_ACCESS_ERR_SUCCESS == ret)
+			__atomic_fetch_add(&queue->stats.sent, 1, __ATOMIC_RELAXED);
+		else
+			__atomic_fetch_add(&queue->stats.failed, 1, __ATOMIC_RELAXED);
+
+		/* The slot is ours while it is SENDING, the CAS cannot fail */
+		seq = IOTEX_QUEUE_SENDING(pos);
+		__atomic_compare_exchange_n(&slot->seq, &seq, pos + IOTEX_DEV_ACCESS_QUEUE_LEN, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+	}
+}
+
+#endif
+
+#define IOTEX_MERKLE_LEAF_PREFIX	0x00
+#define IOTEX_MERKLE_NODE_PREFIX	0x01
+
+static void iotex_merkle_hash(uint8_t *out, uint8_t prefix, const void *a, size_t a_len, const void *b, size_t b_len) {
+
+	struct tc_sha256_state_struct s;
+
+	tc_sha256_init(&s);
+	tc_sha256_update(&s, &prefix, 1);
+
+	if (a_len)
+		tc_sha256_update(&s, (const uint8_t *)a, a_len);
+	if (b_len)
+		tc_sha256_update(&s, (const uint8_t *)b, b_len);
+
+	tc_sha256_final(out, &s);
+}
+
+static int iotex_dev_access_batch_build(iotex_batch_tree_t *tree, const iotex_upload_record_t *records, size_t count) {
+
+	size_t start = 0, n = count, i;
+
+	for (i = 0; i < count; i++)
+		iotex_merkle_hash(tree->node[i], IOTEX_MERKLE_LEAF_PREFIX, records[i].buf, records[i].len, NULL, 0);
+
+	while (n > 1) {
+
+		size_t next = start + n;
+
+		if (next + (n + 1) / 2 > IOTEX_DEV_ACCESS_BATCH_TREE_NODES)
+			return IOTEX_DEV_ACCESS_ERR_GENERAL;
+
+		for (i = 0; i < n; i += 2) {
+			if (i + 1 < n)
+				iotex_merkle_hash(tree->node[next + i / 2], IOTEX_MERKLE_NODE_PREFIX, tree->node[start + i], 32, tree->node[start + i + 1], 32);
+			else
+				memcpy(tree->node[next + i / 2], tree->node[start + i], 32);
+		}
+
+		start = next;
+		n = (n + 1) / 2;
+	}
+
+	tree->records = records;
+	tree->count   = count;
+	tree->root    = start;
+
+	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+}
+
+/* Argument of the proof callback, the record the proof is for */
+typedef struct iotex_batch_proof_arg {
+
+	const iotex_batch_tree_t *tree;
+	size_t index;
+
+}iotex_batch_proof_arg_t;
+
+/*
+ * Inclusion proof of one record: the sibling hashes from the leaf up to the
+ * root, 32 bytes each. Levels where the node has no sibling contribute
+ * nothing, a verifier derives them from the record index and count.
+ */
+static bool iotex_pb_encode_batch_proof(pb_ostream_t *stream, const pb_field_t *field, void * const *arg) {
+
+	const iotex_batch_proof_arg_t *proof = (const iotex_batch_proof_arg_t *)*arg;
+	const iotex_batch_tree_t *tree = proof->tree;
+	size_t index = proof->index;
+	size_t pos, start, n, len = 0;
+
+	for (pos = index, start = 0, n = tree->count; n > 1; start += n, pos >>= 1, n = (n + 1) / 2) {
+		if ((pos ^ 1) < n)
+			len += 32;
+	}
+
+	if (0 == len)
+		return true;
+
+	if (!pb_encode_tag_for_field(stream, field) || !pb_encode_varint(stream, len))
+		return false;
+
+	for (pos = index, start = 0, n = tree->count; n > 1; start += n, pos >>= 1, n = (n + 1) / 2) {
+		if ((pos ^ 1) < n && !pb_write(stream, tree->node[start + (pos ^ 1)], 32))
+			return false;
+	}
+
+	return true;
+}
+
+static bool iotex_pb_encode_batch_records(pb_ostream_t *stream, const pb_field_t *field, void * const *arg) {
+
+	const iotex_batch_tree_t *tree = (const iotex_batch_tree_t *)*arg;
+	BatchRecord record = BatchRecord_init_zero;
+	iotex_batch_proof_arg_t proof = { tree, 0 };
+	iotex_pb_bytes_t data;
+	size_t i;
+
+	for (i = 0; i < tree->count; i++) {
+
+		record.index = i;
+		iotex_pb_bytes_bind(&record.data, &data, tree->records[i].buf, tree->records[i].len);
+
+		proof.index               = i;
+		record.proof.funcs.encode = iotex_pb_encode_batch_proof;
+		record.proof.arg          = &proof;
+
+		if (!pb_encode_tag_for_field(stream, field) || !pb_encode_submessage(stream, BatchRecord_fields, &record))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Whether the Upload bound in the arena fits the arena buffer, in case it
+ * has to go through it: without streaming publish functions, or to the
+ * spool while the link is down.
+ */
+static int iotex_dev_access_upload_fits(void) {
+
+	pb_ostream_t ostream_sizing = PB_OSTREAM_SIZING;
+
+	if (dev_ctx->mqtt_ctx.mqtt_pub_begin_func && dev_ctx->mqtt_ctx.status == IOTEX_MQTT_BIND_STATUS_OK)
+		return 1;
+
+	return iotex_dev_access_upload_encode(&ostream_sizing) && ostream_sizing.bytes_written <= dev_ctx->arena.buf_size;
+}
+
+/*
+ * Upload count records with a single signature over the Merkle root of the
+ * batch. Each record carries its inclusion proof so it can be verified on its
+ * own. Records are sent as-is, JSON records must already be serialized.
+ * Without streaming publish functions the whole batch has to fit the encode
+ * buffer of IOTEX_DEV_ACCESS_ENCODE_ARENA_SIZE bytes, a batch that does not is
+ * rejected with IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER before it is signed.
+ */
+int iotex_dev_access_data_upload_batch(const iotex_upload_record_t *records, size_t count, enum UserData_Type type, int8_t mac[6]) {
+
+	size_t sign_len = 0;
+	Payload *payload = NULL;
+	iotex_encode_arena_t *arena = NULL;
+
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+
+	if (!iotex_dev_access_upload_ready())
+		return IOTEX_DEV_ACCESS_ERR_BAD_STATUS;
+
+	if (NULL == records || 0 == count || count > IOTEX_DEV_ACCESS_BATCH_MAX_RECORDS)
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	if (!IOTEX_USER_DATA_TYPE_VALID(type) || IOTEX_USER_DATA_TYPE_IS_LZ4(type))
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	for (size_t i = 0; i < count; i++) {
+		if (NULL == records[i].buf && records[i].len)
+			return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+	}
+
+	arena  = &dev_ctx->arena;
+	payload = iotex_dev_access_upload_prepare();
+
+	if (iotex_dev_access_batch_build(&arena->batch, records, count))
+		return IOTEX_DEV_ACCESS_ERR_GENERAL;
+
+	payload->ptype = Payload_PackageType_USERDATA_BATCH;
+	payload->dtype = type;
+
+	/* Sized with a full-length signature first, so an oversized batch costs no signing */
+	iotex_pb_bytes_bind(&payload->sign, &arena->sign, arena->sign_buf, sizeof(arena->sign_buf));
+	iotex_pb_bytes_bind(&payload->pubkey, &arena->pubkey, iotex_deviceconnect_sdk_core_get_public_key(), 65);
+
+	payload->mac.size = 6;
+	memcpy(payload->mac.bytes, mac, 6);
+
+	payload->has_batch = true;
+	payload->batch.count = count;
+	payload->batch.root.size = 32;
+	memcpy(payload->batch.root.bytes, arena->batch.node[arena->batch.root], 32);
+	payload->batch.records.funcs.encode = iotex_pb_encode_batch_records;
+	payload->batch.records.arg          = &arena->batch;
+
+	if (!iotex_dev_access_upload_fits())
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	if (PSA_SUCCESS != psa_sign_message( g_sdkcore_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256), arena->batch.node[arena->batch.root], 32, arena->sign_buf, sizeof(arena->sign_buf), &sign_len))
+		return IOTEX_DEV_ACCESS_ERR_GENERAL;
+
+	iotex_pb_bytes_bind(&payload->sign, &arena->sign, arena->sign_buf, sign_len);
+
+	return iotex_dev_access_upload_userdata_send();
+}
+
+/*
+ * Chunked upload of user data too large to be held in RAM at once. Every
+ * write is sent as one or more USERDATA_CHUNK fragments of at most
+ * IOTEX_DEV_ACCESS_CHUNK_SIZE bytes. The closing fragment carries no data,
+ * but the SHA-256 digest of all fragments and its signature, which is the
+ * same signature psa_sign_message() would produce over the whole data.
+ */
+static Payload *iotex_dev_access_chunk_prepare(void) {
+
+	iotex_chunk_ctx_t *chunk = &dev_ctx->arena.chunk;
+	Payload *payload = iotex_dev_access_upload_prepare();
+
+	payload->ptype = Payload_PackageType_USERDATA_CHUNK;
+	payload->dtype = chunk->type;
+
+	payload->mac.size = 6;
+	memcpy(payload->mac.bytes, chunk->mac, 6);
+
+	payload->has_chunk     = true;
+	payload->chunk.session = chunk->session;
+	payload->chunk.seq     = chunk->seq;
+	payload->chunk.offset  = chunk->offset;
+	payload->chunk.total   = chunk->total;
+
+	return payload;
+}
+
+int iotex_dev_access_chunk_upload_begin(size_t total_len, enum UserData_Type type, int8_t mac[6]) {
+
+	iotex_chunk_ctx_t *chunk = NULL;
+
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+
+	if (dev_ctx->mqtt_ctx.status != IOTEX_MQTT_BIND_STATUS_OK)
+		return IOTEX_DEV_ACCESS_ERR_BAD_STATUS;
+
+	if (0 == total_len || total_len > UINT32_MAX || NULL == mac)
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	if (!IOTEX_USER_DATA_TYPE_VALID(type) || IOTEX_USER_DATA_TYPE_IS_LZ4(type))
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	chunk = &dev_ctx->arena.chunk;
+
+	/* A new session id lets the receiver drop fragments of an abandoned upload */
+	if (PSA_SUCCESS != psa_generate_random((uint8_t *)&chunk->session, sizeof(chunk->session)))
+		chunk->session++;
+
+	chunk->seq    = 0;
+	chunk->offset = 0;
+	chunk->total  = (uint32_t)total_len;
+	chunk->type   = type;
+	memcpy(chunk->mac, mac, 6);
+
+	tc_sha256_init(&chunk->sha);
+
+	chunk->active = 1;
+
+	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+}
+
+int iotex_dev_access_chunk_upload_write(const void *buf, size_t buf_len) {
+
+	iotex_chunk_ctx_t *chunk = NULL;
+	const uint8_t *data = (const uint8_t *)buf;
+	Payload *payload = NULL;
+	size_t len = 0;
+	int ret = 0;
+
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+
+	chunk = &dev_ctx->arena.chunk;
+
+	if (0 == chunk->active)
+		return IOTEX_DEV_ACCESS_ERR_BAD_STATUS;
+
+	if (NULL == buf || 0 == buf_len || buf_len > chunk->total - chunk->offset)
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	while (buf_len) {
+
+		len = (buf_len > IOTEX_DEV_ACCESS_CHUNK_SIZE ? IOTEX_DEV_ACCESS_CHUNK_SIZE : buf_len);
+
+		payload = iotex_dev_access_chunk_prepare();
+		iotex_pb_bytes_bind(&payload->chunk.data, &dev_ctx->arena.user, data, len);
+
+		if (IOTEX_DEV_ACCESS_ERR_SUCCESS != (ret = iotex_dev_access_upload_encode_and_send())) {
+			chunk->active = 0;
+			return ret;
+		}
+
+		tc_sha256_update(&chunk->sha, data, len);
+
+		chunk->seq++;
+		chunk->offset += len;
+
+		data    += len;
+		buf_len -= len;
+	}
+
+	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+}
+
+int iotex_dev_access_chunk_upload_end(void) {
+
+	iotex_encode_arena_t *arena = NULL;
+	iotex_chunk_ctx_t *chunk = NULL;
+	Payload *payload = NULL;
+	size_t sign_len = 0;
+
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+
+	arena = &dev_ctx->arena;
+	chunk = &arena->chunk;
+
+	if (0 == chunk->active)
+		return IOTEX_DEV_ACCESS_ERR_BAD_STATUS;
+
+	chunk->active = 0;
+
+	if (chunk->offset != chunk->total)
+		return IOTEX_DEV_ACCESS_ERR_BAD_STATUS;
+
+	payload = iotex_dev_access_chunk_prepare();
+
+	payload->chunk.digest.size = 32;
+	tc_sha256_final(payload->chunk.digest.bytes, &chunk->sha);
+
+	if (PSA_SUCCESS != psa_sign_hash( g_sdkcore_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256), payload->chunk.digest.bytes, 32, arena->sign_buf, sizeof(arena->sign_buf), &sign_len))
+		return IOTEX_DEV_ACCESS_ERR_GENERAL;
+
+	iotex_pb_bytes_bind(&payload->sign, &arena->sign, arena->sign_buf, sign_len);
+	iotex_pb_bytes_bind(&payload->pubkey, &arena->pubkey, iotex_deviceconnect_sdk_core_get_public_key(), 65);
+
+	return iotex_dev_access_upload_encode_and_send();
+}
+
+int iotex_dev_access_query_dev_register_status(int8_t mac[6]) {
+
+	Payload *payload = NULL;
+
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+
+	if (dev_ctx->mqtt_ctx.status != IOTEX_MQTT_CONNECTED)
+		return IOTEX_DEV_ACCESS_ERR_BAD_STATUS;
+
+	payload = iotex_dev_access_upload_prepare();
+
+ 	payload->ptype = Payload_PackageType_QUERY;
+
+	payload->mac.size = 6;
+	memcpy(payload->mac.bytes, mac, 6);
+
+	return iotex_dev_access_upload_encode_and_send();
+}
+
+int iotex_dev_access_dev_register_confirm(int8_t mac[6]) {
+
+	char raw_data[24]  = {0};
+	char sign_buf[64]  = {0};
+	size_t sign_len = 0;
+	Payload *payload = NULL;
+
+	if (NULL == dev_ctx || 0 == dev_ctx->inited)
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+
+	if (dev_ctx->mqtt_ctx.status != IOTEX_MQTT_CONNECTED)
+		return IOTEX_DEV_ACCESS_ERR_BAD_STATUS;
+
+	uint32_t timestamp = time(0);
+	if (timestamp < DEFAULT_TIME_STAMP_UNIX_VALUE)
+		timestamp = DEFAULT_TIME_STAMP_UNIX_VALUE;
+	
+	payload = iotex_dev_access_upload_prepare();
+
+ 	payload->ptype = Payload_PackageType_COMFIRM;
+
+	payload->mac.size = 6;
+	memcpy(payload->mac.bytes, mac, 6);
+
+	iotex_pb_bytes_bind(&payload->pubkey, &dev_ctx->arena.pubkey, iotex_deviceconnect_sdk_core_get_public_key(), 65);
+
+	payload->has_pConfirm = true;
+
+	payload->pConfirm.owner.size = hexStr2Bin(wallet_addr + 2, (char *)payload->pConfirm.owner.bytes);
+	
+	memcpy(raw_data, payload->pConfirm.owner.bytes, payload->pConfirm.owner.size);
+	raw_data[payload->pConfirm.owner.size]     = (char)((timestamp & 0xFF000000) >> 24);
+    raw_data[payload->pConfirm.owner.size + 1] = (char)((timestamp & 0x00FF0000) >> 16);
+    raw_data[payload->pConfirm.owner.size + 2] = (char)((timestamp & 0x0000FF00) >> 8);
+    raw_data[payload->pConfirm.owner.size + 3] = (char)(timestamp & 0x000000FF);	
+
+	if (PSA_SUCCESS != psa_sign_message( g_sdkcore_key, PSA_ALG_ECDSA_LOW_S(PSA_ALG_ECDSA(PSA_ALG_SHA_256)), (const uint8_t *)(raw_data), payload->pConfirm.owner.size + 4, (uint8_t *)sign_buf, 64, &sign_len))
+		return IOTEX_DEV_ACCESS_ERR_GENERAL;
+	
+	payload->pConfirm.timestamp = timestamp;
+
+	payload->pConfirm.signature.size = sign_len;
+	memcpy(payload->pConfirm.signature.bytes, sign_buf, sign_len);
+
+	payload->pConfirm.channel = 8183;
+	
+	return iotex_dev_access_upload_encode_and_send();
+}
+
+int iotex_dev_access_set_mqtt_status(enum IOTEX_MQTT_STATUS status) {
+
+	if( NULL == dev_ctx || 0 == dev_ctx->inited ) {
+		return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+	}
+
+	dev_ctx->mqtt_ctx.status = status;
+#ifdef IOTEX_DEBUG_ENABLE
+#ifndef IOTEX_DEBUG_ENABLE_FORCE
+	if( dev_ctx->debug_enable ) {
+#endif
+		printf("mqtt status set %d\n", dev_ctx->mqtt_ctx.status);
+#ifndef IOTEX_DEBUG_ENABLE_FORCE
+	}
+#endif
+#endif
+
+	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+}
+
+int iotex_dev_access_debug_enable(int enable) {
+
+    if( NULL == dev_ctx || 0 == dev_ctx->inited )
+        return IOTEX_DEV_ACCESS_ERR_NO_INIT;
+
+    dev_ctx->debug_enable = enable;
+
+    return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+}
+
+static void iotex_dev_access_format_dev_addr(const uint8_t *hash, char *dev_address)
+{
+    dev_address[0] = '0';
+    dev_address[1] = 'x';
+
+	for (int i=0; i<20; i++)
+	{
+		char buf[3] = {0};
+		sprintf(buf, "%02x", hash[32 - 20 + i]);
+
+        memcpy(dev_address + 2 + i * 2, buf, 2);
+
+	}
+}
+
+int iotex_dev_access_generate_dev_addr(const unsigned char* public_key, char *dev_address)
+{
+	// The device address is the hex string representation of the last 20 bytes of the keccak256 hash of the public key.
+
+	uint8_t hash[32] = {0};
+	keccak256_getHash(public_key + 1, 64, hash);
+
+	iotex_dev_access_format_dev_addr(hash, dev_address);
+
+	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
+}
+
+int iotex_dev_access_generate_dev_addr_batch(const unsigned char * const *public_key, char * const *dev_address, size_t count)
+{
+	// Four keys at a time share one interleaved keccak256 pass, the rest are hashed one by one.
+
+	uint8_t hash[4][32];
+	size_t i = 0;
+
+	if (NULL == public_key || NULL == dev_address)
+		return IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER;
+
+	for (; i + 4 <= count; i += 4) {
+		const uint8_t *msg[4] = { public_key[i] + 1, public_key[i + 1] + 1, public_key[i + 2] + 1, public_key[i + 3] + 1 };
+		uint8_t * const out[4] = { hash[0], hash[1], hash[2], hash[3] };
+
+		keccak256_getHash_x4(msg, 64, out);
+
+		for (int j = 0; j < 4; j++)
+			iotex_dev_access_format_dev_addr(hash[j], dev_address[i + j]);
+	}
+
+	for (; i < count; i++)
+		iotex_dev_access_generate_dev_addr(public_key[i], dev_address[i]);
 
 	return IOTEX_DEV_ACCESS_ERR_SUCCESS;
 }
@@ -0,0 +1,379 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "include/utils/iotex_spool.h"
+
+#define IOTEX_SPOOL_MAGIC			0x5053
+#define IOTEX_SPOOL_STATE_PENDING	0xFFFFFFFF
+#define IOTEX_SPOOL_STATE_DONE		0x00000000
+
+#define IOTEX_SPOOL_ALIGN(x)		(((x) + 3) & ~3U)
+#define IOTEX_SPOOL_SIZE(len)		(IOTEX_SPOOL_RECORD_HEADER_SIZE + IOTEX_SPOOL_ALIGN(len))
+
+/* Record layout, all fields little endian */
+#define IOTEX_SPOOL_OFF_MAGIC		0
+#define IOTEX_SPOOL_OFF_LEN			2
+#define IOTEX_SPOOL_OFF_SEQ			4
+#define IOTEX_SPOOL_OFF_CRC			8
+#define IOTEX_SPOOL_OFF_STATE		12
+
+enum iotex_spool_record {
+	IOTEX_SPOOL_RECORD_PENDING,
+	IOTEX_SPOOL_RECORD_DONE,
+	IOTEX_SPOOL_RECORD_CORRUPT,		/* torn or damaged, its length can still be trusted */
+	IOTEX_SPOOL_RECORD_END,			/* erased space or unusable rest of the block */
+};
+
+static const uint32_t iotex_spool_crc_table[16] = {
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+static uint32_t iotex_spool_crc32(uint32_t crc, const uint8_t *buf, size_t len) {
+
+	crc = ~crc;
+
+	while (len--) {
+		crc = iotex_spool_crc_table[(crc ^ *buf) & 0x0F] ^ (crc >> 4);
+		crc = iotex_spool_crc_table[(crc ^ (*buf++ >> 4)) & 0x0F] ^ (crc >> 4);
+	}
+
+	return ~crc;
+}
+
+static uint32_t iotex_spool_get32(const uint8_t *p) {
+
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void iotex_spool_put32(uint8_t *p, uint32_t v) {
+
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t iotex_spool_addr(iotex_spool_t *spool, uint32_t block, uint32_t off) {
+
+	return block * spool->drv->block_size + off;
+}
+
+/*
+ * Return len bytes at addr from the read window. A miss refills the window
+ * with one read that runs up to the end of the block.
+ */
+static const uint8_t *iotex_spool_window(iotex_spool_t *spool, uint32_t addr, uint32_t len) {
+
+	uint32_t block_end = (addr / spool->drv->block_size + 1) * spool->drv->block_size;
+	uint32_t n = 0;
+
+	if (addr >= spool->win_addr && addr + len <= spool->win_addr + spool->win_len)
+		return spool->win + (addr - spool->win_addr);
+
+	n = block_end - addr;
+	if (n > sizeof(spool->win))
+		n = sizeof(spool->win);
+
+	if (len > n)
+		return NULL;
+
+	spool->win_len = 0;
+
+	if (spool->drv->read(spool->drv->start_address, addr, spool->win, n) != (int)n)
+		return NULL;
+
+	spool->win_addr = addr;
+	spool->win_len  = n;
+
+	return spool->win;
+}
+
+static void iotex_spool_window_drop(iotex_spool_t *spool, uint32_t block) {
+
+	if (spool->win_len && spool->win_addr / spool->drv->block_size == block)
+		spool->win_len = 0;
+}
+
+static enum iotex_spool_record iotex_spool_parse(iotex_spool_t *spool, uint32_t block, uint32_t off, uint32_t *len, uint32_t *seq, const uint8_t **data) {
+
+	uint32_t addr = iotex_spool_addr(spool, block, off);
+	const uint8_t *p = NULL;
+	uint32_t crc = 0;
+	size_t i;
+
+	if (off + IOTEX_SPOOL_RECORD_HEADER_SIZE > spool->drv->block_size)
+		return IOTEX_SPOOL_RECORD_END;
+
+	if (NULL == (p = iotex_spool_window(spool, addr, IOTEX_SPOOL_RECORD_HEADER_SIZE)))
+		return IOTEX_SPOOL_RECORD_END;
+
+	for (i = 0; i < IOTEX_SPOOL_RECORD_HEADER_SIZE && 0xFF == p[i]; i++);
+	if (IOTEX_SPOOL_RECORD_HEADER_SIZE == i)
+		return IOTEX_SPOOL_RECORD_END;
+
+	*len = p[IOTEX_SPOOL_OFF_LEN] | (p[IOTEX_SPOOL_OFF_LEN + 1] << 8);
+	*seq = iotex_spool_get32(p + IOTEX_SPOOL_OFF_SEQ);
+
+	if ((p[IOTEX_SPOOL_OFF_MAGIC] | (p[IOTEX_SPOOL_OFF_MAGIC + 1] << 8)) != IOTEX_SPOOL_MAGIC ||
+		0 == *len || *len > IOTEX_SPOOL_RECORD_MAX_SIZE || off + IOTEX_SPOOL_SIZE(*len) > spool->drv->block_size)
+		return IOTEX_SPOOL_RECORD_END;
+
+	if (NULL == (p = iotex_spool_window(spool, addr, IOTEX_SPOOL_RECORD_HEADER_SIZE + *len)))
+		return IOTEX_SPOOL_RECORD_END;
+
+	crc = iotex_spool_crc32(0, p + IOTEX_SPOOL_OFF_LEN, 6);
+	crc = iotex_spool_crc32(crc, p + IOTEX_SPOOL_RECORD_HEADER_SIZE, *len);
+
+	if (crc != iotex_spool_get32(p + IOTEX_SPOOL_OFF_CRC))
+		return IOTEX_SPOOL_RECORD_CORRUPT;
+
+	*data = p + IOTEX_SPOOL_RECORD_HEADER_SIZE;
+
+	return (IOTEX_SPOOL_STATE_PENDING == iotex_spool_get32(p + IOTEX_SPOOL_OFF_STATE) ? IOTEX_SPOOL_RECORD_PENDING : IOTEX_SPOOL_RECORD_DONE);
+}
+
+int iotex_spool_mount(iotex_spool_t *spool, flash_drv *drv) {
+
+	uint32_t first_seq[IOTEX_SPOOL_MAX_BLOCKS];
+	uint32_t used[IOTEX_SPOOL_MAX_BLOCKS];
+	uint32_t block, off, len, seq;
+	const uint8_t *data = NULL;
+	enum iotex_spool_record state;
+	int tail = -1, head = -1;
+
+	if (NULL == spool || NULL == drv || NULL == drv->read || NULL == drv->write || NULL == drv->earse)
+		return IOTEX_SPOOL_ERR_BAD_INPUT;
+
+	if (drv->block_size < IOTEX_SPOOL_SIZE(1))
+		return IOTEX_SPOOL_ERR_BAD_INPUT;
+
+	if (drv->init && drv->init())
+		return IOTEX_SPOOL_ERR_FLASH;
+
+	memset(spool, 0, sizeof(iotex_spool_t));
+
+	spool->drv       = drv;
+	spool->block_num = drv->flash_size / drv->block_size;
+
+	if (spool->block_num > IOTEX_SPOOL_MAX_BLOCKS)
+		spool->block_num = IOTEX_SPOOL_MAX_BLOCKS;
+
+	if (spool->block_num < 2) {
+		spool->drv = NULL;
+		return IOTEX_SPOOL_ERR_BAD_INPUT;
+	}
+
+	/* Rebuild the RAM index from the record headers, one sequential pass */
+	for (block = 0; block < spool->block_num; block++) {
+
+		first_seq[block] = 0;
+
+		for (off = 0; ; off += IOTEX_SPOOL_SIZE(len)) {
+
+			state = iotex_spool_parse(spool, block, off, &len, &seq, &data);
+
+			if (IOTEX_SPOOL_RECORD_END == state)
+				break;
+
+			if (0 == off)
+				first_seq[block] = seq;
+
+			if (seq >= spool->next_seq)
+				spool->next_seq = seq + 1;
+
+			if (IOTEX_SPOOL_RECORD_PENDING == state)
+				spool->live[block]++;
+			else if (IOTEX_SPOOL_RECORD_CORRUPT == state)
+				spool->stats.corrupt++;
+		}
+
+		/* Anything but erased space past the last record makes the rest of the block unusable */
+		used[block] = off;
+		if (off + IOTEX_SPOOL_RECORD_HEADER_SIZE <= drv->block_size && IOTEX_SPOOL_RECORD_END == state && off) {
+			const uint8_t *p = iotex_spool_window(spool, iotex_spool_addr(spool, block, off), IOTEX_SPOOL_RECORD_HEADER_SIZE);
+			for (len = 0; p && len < IOTEX_SPOOL_RECORD_HEADER_SIZE && 0xFF == p[len]; len++);
+			if (len != IOTEX_SPOOL_RECORD_HEADER_SIZE)
+				used[block] = drv->block_size;
+		}
+
+		if (used[block] && (tail < 0 || first_seq[block] > first_seq[tail]))
+			tail = block;
+
+		spool->stats.pending += spool->live[block];
+	}
+
+	if (tail < 0) {
+		spool->tail_block = 0;
+		spool->tail_off   = 0;
+		spool->head_block = 0;
+		return IOTEX_SPOOL_ERR_SUCCESS;
+	}
+
+	spool->tail_block = tail;
+	spool->tail_off   = used[tail];
+
+	/* The oldest block with pending records, following the ring from the tail */
+	for (block = 1; block <= spool->block_num; block++) {
+		uint32_t b = (tail + block) % spool->block_num;
+		if (spool->live[b]) {
+			head = b;
+			break;
+		}
+	}
+
+	spool->head_block = (head < 0 ? (uint32_t)tail : (uint32_t)head);
+	spool->head_off   = (head < 0 ? used[tail] : 0);
+
+	return IOTEX_SPOOL_ERR_SUCCESS;
+}
+
+/* Move the tail to the next block, dropping its records if the ring is full */
+static int iotex_spool_advance(iotex_spool_t *spool) {
+
+	uint32_t next = (spool->tail_block + 1) % spool->block_num;
+
+	if (spool->live[next]) {
+
+		spool->stats.dropped += spool->live[next];
+		spool->stats.pending -= spool->live[next];
+		spool->live[next] = 0;
+	}
+
+	if (spool->head_block == next) {
+		spool->head_block = (next + 1) % spool->block_num;
+		spool->head_off   = 0;
+		if (0 == spool->stats.pending) {
+			spool->head_block = next;
+		}
+	}
+
+	spool->tail_block = next;
+	spool->tail_off   = 0;
+
+	return IOTEX_SPOOL_ERR_SUCCESS;
+}
+
+int iotex_spool_append(iotex_spool_t *spool, const uint8_t *buf, size_t len) {
+
+	flash_drv *drv = NULL;
+	uint8_t header[IOTEX_SPOOL_RECORD_HEADER_SIZE];
+	uint32_t addr = 0, crc = 0;
+
+	if (NULL == spool || NULL == spool->drv)
+		return IOTEX_SPOOL_ERR_NOT_MOUNTED;
+
+	if (NULL == buf || 0 == len || len > IOTEX_SPOOL_RECORD_MAX_SIZE || IOTEX_SPOOL_SIZE(len) > spool->drv->block_size)
+		return IOTEX_SPOOL_ERR_BAD_INPUT;
+
+	drv = spool->drv;
+
+	if (spool->tail_off + IOTEX_SPOOL_SIZE(len) > drv->block_size)
+		iotex_spool_advance(spool);
+
+	if (0 == spool->tail_off) {
+
+		iotex_spool_window_drop(spool, spool->tail_block);
+
+		if (drv->earse(drv->start_address + iotex_spool_addr(spool, spool->tail_block, 0)))
+			return IOTEX_SPOOL_ERR_FLASH;
+
+		if (0 == spool->stats.pending) {
+			spool->head_block = spool->tail_block;
+			spool->head_off   = 0;
+		}
+	}
+
+	header[IOTEX_SPOOL_OFF_MAGIC]     = (uint8_t)IOTEX_SPOOL_MAGIC;
+	header[IOTEX_SPOOL_OFF_MAGIC + 1] = (uint8_t)(IOTEX_SPOOL_MAGIC >> 8);
+	header[IOTEX_SPOOL_OFF_LEN]       = (uint8_t)len;
+	header[IOTEX_SPOOL_OFF_LEN + 1]   = (uint8_t)(len >> 8);
+	iotex_spool_put32(header + IOTEX_SPOOL_OFF_SEQ, spool->next_seq);
+
+	crc = iotex_spool_crc32(0, header + IOTEX_SPOOL_OFF_LEN, 6);
+	crc = iotex_spool_crc32(crc, buf, len);
+
+	iotex_spool_put32(header + IOTEX_SPOOL_OFF_CRC, crc);
+	iotex_spool_put32(header + IOTEX_SPOOL_OFF_STATE, IOTEX_SPOOL_STATE_PENDING);
+
+	addr = iotex_spool_addr(spool, spool->tail_block, spool->tail_off);
+
+	/* Claim the space first so a failed write is never written over */
+	spool->tail_off += IOTEX_SPOOL_SIZE(len);
+	iotex_spool_window_drop(spool, spool->tail_block);
+
+	if (drv->write(drv->start_address, addr, header, sizeof(header)) != sizeof(header) ||
+		drv->write(drv->start_address, addr + sizeof(header), (unsigned char *)buf, len) != (int)len)
+		return IOTEX_SPOOL_ERR_FLASH;
+
+	spool->next_seq++;
+	spool->live[spool->tail_block]++;
+	spool->stats.pending++;
+	spool->stats.appended++;
+
+	return IOTEX_SPOOL_ERR_SUCCESS;
+}
+
+int iotex_spool_peek(iotex_spool_t *spool, const uint8_t **buf, size_t *len) {
+
+	enum iotex_spool_record state;
+	uint32_t rlen = 0, seq = 0;
+
+	if (NULL == spool || NULL == spool->drv)
+		return IOTEX_SPOOL_ERR_NOT_MOUNTED;
+
+	if (NULL == buf || NULL == len)
+		return IOTEX_SPOOL_ERR_BAD_INPUT;
+
+	while (spool->stats.pending) {
+
+		state = iotex_spool_parse(spool, spool->head_block, spool->head_off, &rlen, &seq, buf);
+
+		if (IOTEX_SPOOL_RECORD_PENDING == state) {
+			*len = rlen;
+			return IOTEX_SPOOL_ERR_SUCCESS;
+		}
+
+		if (IOTEX_SPOOL_RECORD_END != state) {
+			spool->head_off += IOTEX_SPOOL_SIZE(rlen);
+			continue;
+		}
+
+		/* Index and flash disagree, trust the flash */
+		if (spool->head_block == spool->tail_block) {
+			memset(spool->live, 0, sizeof(spool->live));
+			spool->stats.pending = 0;
+			break;
+		}
+
+		spool->stats.pending -= spool->live[spool->head_block];
+		spool->live[spool->head_block] = 0;
+
+		spool->head_block = (spool->head_block + 1) % spool->block_num;
+		spool->head_off   = 0;
+	}
+
+	return IOTEX_SPOOL_ERR_EMPTY;
+}
+
+int iotex_spool_pop(iotex_spool_t *spool) {
+
+	uint8_t state[4] = {0};
+	const uint8_t *buf = NULL;
+	size_t len = 0;
+	int ret = 0;
+
+	if (IOTEX_SPOOL_ERR_SUCCESS != (ret = iotex_spool_peek(spool, &buf, &len)))
+		return ret;
+
+	if (spool->drv->write(spool->drv->start_address, iotex_spool_addr(spool, spool->head_block, spool->head_off) + IOTEX_SPOOL_OFF_STATE, state, sizeof(state)) != sizeof(state))
+		return IOTEX_SPOOL_ERR_FLASH;
+
+	spool->head_off += IOTEX_SPOOL_SIZE(len);
+
+	spool->live[spool->head_block]--;
+	spool->stats.pending--;
+	spool->stats.replayed++;
+
+	return IOTEX_SPOOL_ERR_SUCCESS;
+}
@@ -1,106 +1,299 @@
-/* 
+/*
  * Bitcoin cryptography library
  * Copyright (c) Project Nayuki
- * 
+ *
  * https://www.nayuki.io/page/bitcoin-cryptography-library
  * https://github.com/nayuki/Bitcoin-Cryptography-Library
  */
 
 //#include <cassert>
+#include <string.h>
+
 #include "include/utils/keccak256/keccak256.h"
 
+#define IOTEX_BLOCK_LANES		(IOTEX_BLOCK_SIZE / 8)
+
+// The 4-way permutation works on GCC vectors where they map to SIMD registers,
+// elsewhere the four hashes are computed one after another
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__aarch64__) || defined(__ARM_NEON))
+#define KECCAK256_X4_VECTOR
+typedef uint64_t keccak256_v4 __attribute__((vector_size(32)));
+#endif
+
 // Static initializers
-const unsigned char keccak256_ROTATION[5][5] = {
-	{ 0, 36,  3, 41, 18},
-	{ 1, 44, 10, 45,  2},
-	{62,  6, 43, 15, 61},
-	{28, 55, 25, 21, 56},
-	{27, 20, 39,  8, 14},
+static const uint64_t keccak256_ROUND_CONSTANTS[IOTEX_NUM_ROUNDS] = {
+	UINT64_C(0x0000000000000001), UINT64_C(0x0000000000008082),
+	UINT64_C(0x800000000000808A), UINT64_C(0x8000000080008000),
+	UINT64_C(0x000000000000808B), UINT64_C(0x0000000080000001),
+	UINT64_C(0x8000000080008081), UINT64_C(0x8000000000008009),
+	UINT64_C(0x000000000000008A), UINT64_C(0x0000000000000088),
+	UINT64_C(0x0000000080008009), UINT64_C(0x000000008000000A),
+	UINT64_C(0x000000008000808B), UINT64_C(0x800000000000008B),
+	UINT64_C(0x8000000000008089), UINT64_C(0x8000000000008003),
+	UINT64_C(0x8000000000008002), UINT64_C(0x8000000000000080),
+	UINT64_C(0x000000000000800A), UINT64_C(0x800000008000000A),
+	UINT64_C(0x8000000080008081), UINT64_C(0x8000000000008080),
+	UINT64_C(0x0000000080000001), UINT64_C(0x8000000080008008),
 };
 
-static uint64_t keccak256_rotl64(uint64_t x, int i) {
+// Requires 0 < n <= 63, works on scalars and GCC vectors alike
+#define KECCAK_ROL(x, n)	(((x) << (n)) | ((x) >> (64 - (n))))
+
+// Lanes are named after their column (a, e, i, o, u for x = 0..4) and
+// row (b, g, k, m, s for y = 0..4), lane (x, y) is state[x + 5 * y]
+#define KECCAK_LANES(A) \
+	A##ba, A##be, A##bi, A##bo, A##bu, \
+	A##ga, A##ge, A##gi, A##go, A##gu, \
+	A##ka, A##ke, A##ki, A##ko, A##ku, \
+	A##ma, A##me, A##mi, A##mo, A##mu, \
+	A##sa, A##se, A##si, A##so, A##su
+
+#define KECCAK_LOAD(A, s) \
+	A##ba = s[ 0]; A##be = s[ 1]; A##bi = s[ 2]; A##bo = s[ 3]; A##bu = s[ 4]; \
+	A##ga = s[ 5]; A##ge = s[ 6]; A##gi = s[ 7]; A##go = s[ 8]; A##gu = s[ 9]; \
+	A##ka = s[10]; A##ke = s[11]; A##ki = s[12]; A##ko = s[13]; A##ku = s[14]; \
+	A##ma = s[15]; A##me = s[16]; A##mi = s[17]; A##mo = s[18]; A##mu = s[19]; \
+	A##sa = s[20]; A##se = s[21]; A##si = s[22]; A##so = s[23]; A##su = s[24]
+
+#define KECCAK_STORE(s, A) \
+	s[ 0] = A##ba; s[ 1] = A##be; s[ 2] = A##bi; s[ 3] = A##bo; s[ 4] = A##bu; \
+	s[ 5] = A##ga; s[ 6] = A##ge; s[ 7] = A##gi; s[ 8] = A##go; s[ 9] = A##gu; \
+	s[10] = A##ka; s[11] = A##ke; s[12] = A##ki; s[13] = A##ko; s[14] = A##ku; \
+	s[15] = A##ma; s[16] = A##me; s[17] = A##mi; s[18] = A##mo; s[19] = A##mu; \
+	s[20] = A##sa; s[21] = A##se; s[22] = A##si; s[23] = A##so; s[24] = A##su
+
+// Inside the permutation these six lanes are kept complemented, which turns
+// most of the chi step's ANDNOTs into a single AND or OR
+#define KECCAK_COMPLEMENT(A) \
+	A##be = ~A##be; A##bi = ~A##bi; A##go = ~A##go; \
+	A##ki = ~A##ki; A##mi = ~A##mi; A##sa = ~A##sa
+
+// One round from the lanes A to the lanes E, rho and pi are folded into the
+// choice of the B inputs of each row so no intermediate state is kept
+#define KECCAK_ROUND(A, E, rc) \
+	Ca = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa; \
+	Ce = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se; \
+	Ci = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si; \
+	Co = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so; \
+	Cu = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su; \
+	Da = Cu ^ KECCAK_ROL(Ce, 1); \
+	De = Ca ^ KECCAK_ROL(Ci, 1); \
+	Di = Ce ^ KECCAK_ROL(Co, 1); \
+	Do = Ci ^ KECCAK_ROL(Cu, 1); \
+	Du = Co ^ KECCAK_ROL(Ca, 1); \
+	\
+	B0 = A##ba ^ Da; \
+	B1 = KECCAK_ROL(A##ge ^ De, 44); \
+	B2 = KECCAK_ROL(A##ki ^ Di, 43); \
+	B3 = KECCAK_ROL(A##mo ^ Do, 21); \
+	B4 = KECCAK_ROL(A##su ^ Du, 14); \
+	E##ba = B0 ^ (B1 | B2) ^ (rc); \
+	E##be = B1 ^ (~B2 | B3); \
+	E##bi = B2 ^ (B3 & B4); \
+	E##bo = B3 ^ (B4 | B0); \
+	E##bu = B4 ^ (B0 & B1); \
+	\
+	B0 = KECCAK_ROL(A##bo ^ Do, 28); \
+	B1 = KECCAK_ROL(A##gu ^ Du, 20); \
+	B2 = KECCAK_ROL(A##ka ^ Da, 3); \
+	B3 = KECCAK_ROL(A##me ^ De, 45); \
+	B4 = KECCAK_ROL(A##si ^ Di, 61); \
+	E##ga = B0 ^ (B1 | B2); \
+	E##ge = B1 ^ (B2 & B3); \
+	E##gi = B2 ^ (B3 | ~B4); \
+	E##go = B3 ^ (B4 | B0); \
+	E##gu = B4 ^ (B0 & B1); \
+	\
+	B0 = KECCAK_ROL(A##be ^ De, 1); \
+	B1 = KECCAK_ROL(A##gi ^ Di, 6); \
+	B2 = KECCAK_ROL(A##ko ^ Do, 25); \
+	B3 = KECCAK_ROL(A##mu ^ Du, 8); \
+	B4 = KECCAK_ROL(A##sa ^ Da, 18); \
+	E##ka = B0 ^ (B1 | B2); \
+	E##ke = B1 ^ (B2 & B3); \
+	E##ki = B2 ^ (~B3 & B4); \
+	E##ko = ~B3 ^ (B4 | B0); \
+	E##ku = B4 ^ (B0 & B1); \
+	\
+	B0 = KECCAK_ROL(A##bu ^ Du, 27); \
+	B1 = KECCAK_ROL(A##ga ^ Da, 36); \
+	B2 = KECCAK_ROL(A##ke ^ De, 10); \
+	B3 = KECCAK_ROL(A##mi ^ Di, 15); \
+	B4 = KECCAK_ROL(A##so ^ Do, 56); \
+	E##ma = B0 ^ (B1 & B2); \
+	E##me = B1 ^ (B2 | B3); \
+	E##mi = B2 ^ (~B3 | B4); \
+	E##mo = ~B3 ^ (B4 & B0); \
+	E##mu = B4 ^ (B0 | B1); \
+	\
+	B0 = KECCAK_ROL(A##bi ^ Di, 62); \
+	B1 = KECCAK_ROL(A##go ^ Do, 55); \
+	B2 = KECCAK_ROL(A##ku ^ Du, 39); \
+	B3 = KECCAK_ROL(A##ma ^ Da, 41); \
+	B4 = KECCAK_ROL(A##se ^ De, 2); \
+	E##sa = B0 ^ (~B1 & B2); \
+	E##se = ~B1 ^ (B2 | B3); \
+	E##si = B2 ^ (B3 & B4); \
+	E##so = B3 ^ (B4 | B0); \
+	E##su = B4 ^ (B0 & B1)
 
-	return ((0U + x) << i) | (x >> ((64 - i) & 63));
+static void keccak256_absorb(uint64_t state[25]) {
 
+	uint64_t KECCAK_LANES(A), KECCAK_LANES(E);
+	uint64_t Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du, B0, B1, B2, B3, B4;
+
+	KECCAK_LOAD(A, state);
+	KECCAK_COMPLEMENT(A);
+
+	for (int i = 0; i < IOTEX_NUM_ROUNDS; i += 2) {
+		KECCAK_ROUND(A, E, keccak256_ROUND_CONSTANTS[i]);
+		KECCAK_ROUND(E, A, keccak256_ROUND_CONSTANTS[i + 1]);
+	}
+
+	KECCAK_COMPLEMENT(A);
+	KECCAK_STORE(state, A);
 }
 
-static void keccak256_absorb(uint64_t state[5][5]) {
+#ifdef KECCAK256_X4_VECTOR
+static void keccak256_absorb_x4(keccak256_v4 state[25]) {
 
-	uint64_t (*a)[5] = state;
-	uint8_t r = 1;  // LFSR
-	for (int i = 0; i < IOTEX_NUM_ROUNDS; i++) {
-		// Theta step
-		uint64_t c[5] = {};
-		for (int x = 0; x < 5; x++) {
-			for (int y = 0; y < 5; y++)
-				c[x] ^= a[x][y];
-		}
-		for (int x = 0; x < 5; x++) {
-			uint64_t d = c[(x + 4) % 5] ^ keccak256_rotl64(c[(x + 1) % 5], 1);
-			for (int y = 0; y < 5; y++)
-				a[x][y] ^= d;
-		}
-		
-		// Rho and pi steps
-		uint64_t b[5][5];
-		for (int x = 0; x < 5; x++) {
-			for (int y = 0; y < 5; y++)
-				b[y][(x * 2 + y * 3) % 5] = keccak256_rotl64(a[x][y], keccak256_ROTATION[x][y]);
-		}
-		
-		// Chi step
-		for (int x = 0; x < 5; x++) {
-			for (int y = 0; y < 5; y++)
-				a[x][y] = b[x][y] ^ (~b[(x + 1) % 5][y] & b[(x + 2) % 5][y]);
+	keccak256_v4 KECCAK_LANES(A), KECCAK_LANES(E);
+	keccak256_v4 Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du, B0, B1, B2, B3, B4;
+
+	KECCAK_LOAD(A, state);
+	KECCAK_COMPLEMENT(A);
+
+	for (int i = 0; i < IOTEX_NUM_ROUNDS; i += 2) {
+		KECCAK_ROUND(A, E, keccak256_ROUND_CONSTANTS[i]);
+		KECCAK_ROUND(E, A, keccak256_ROUND_CONSTANTS[i + 1]);
+	}
+
+	KECCAK_COMPLEMENT(A);
+	KECCAK_STORE(state, A);
+}
+#endif
+
+static uint64_t keccak256_load64(const uint8_t *p) {
+
+	uint64_t x = 0;
+	for (int i = 7; i >= 0; i--)
+		x = (x << 8) | p[i];
+	return x;
+}
+
+static void keccak256_store(const uint64_t state[25], uint8_t *hashResult) {
+
+	// Uint64 array to bytes in little endian
+	for (int i = 0; i < IOTEX_HASH_LEN; i++)
+		hashResult[i] = (uint8_t)(state[i >> 3] >> ((i & 7) << 3));
+}
+
+void keccak256_init(keccak256_ctx *ctx) {
+
+	memset(ctx->state, 0, sizeof(ctx->state));
+	ctx->offset = 0;
+}
+
+void keccak256_update(keccak256_ctx *ctx, const uint8_t *msg, size_t len) {
+
+	size_t off = ctx->offset;
+
+	// XOR whole lanes into the state once the offset is lane aligned, and
+	// absorb full blocks
+	while (len > 0) {
+		if ((off & 7) == 0 && len >= 8) {
+			ctx->state[off >> 3] ^= keccak256_load64(msg);
+			msg += 8;
+			len -= 8;
+			off += 8;
+		} else {
+			ctx->state[off >> 3] ^= (uint64_t)(*msg++) << ((off & 7) << 3);
+			len--;
+			off++;
 		}
-		
-		// Iota step
-		for (int j = 0; j < 7; j++) {
-			a[0][0] ^= (uint64_t)(r & 1) << ((1 << j) - 1);
-			r = (uint8_t)((r << 1) ^ ((r >> 7) * 0x171));
+
+		if (off == IOTEX_BLOCK_SIZE) {
+			keccak256_absorb(ctx->state);
+			off = 0;
 		}
 	}
+
+	ctx->offset = off;
+}
+
+void keccak256_final(keccak256_ctx *ctx, uint8_t *hashResult) {
+
+	// Final block and padding
+	ctx->state[ctx->offset >> 3] ^= UINT64_C(0x01) << ((ctx->offset & 7) << 3);
+	ctx->state[IOTEX_BLOCK_LANES - 1] ^= UINT64_C(0x80) << 56;
+	keccak256_absorb(ctx->state);
+
+	keccak256_store(ctx->state, hashResult);
 }
 
 void keccak256_getHash(const uint8_t *msg, size_t len, uint8_t *hashResult) {
 
 	if( NULL == msg || 0 == len || NULL == hashResult )
 		return;
-	
-	uint64_t state[5][5] = {};
-	
-	// XOR each message byte into the state, and absorb full blocks
-	int blockOff = 0;
-	for (size_t i = 0; i < len; i++) {
-		int j = blockOff >> 3;
-		state[j % 5][j / 5] ^= (uint64_t)(msg[i]) << ((blockOff & 7) << 3);
-		blockOff++;
-		if (blockOff == IOTEX_BLOCK_SIZE) {
-			keccak256_absorb(state);
-			blockOff = 0;
-		}
-	}
-	
-	// Final block and padding
-	{
-		int i = blockOff >> 3;
-		state[i % 5][i / 5] ^= UINT64_C(0x01) << ((blockOff & 7) << 3);
-		blockOff = IOTEX_BLOCK_SIZE - 1;
-		int j = blockOff >> 3;
-		state[j % 5][j / 5] ^= UINT64_C(0x80) << ((blockOff & 7) << 3);
-		keccak256_absorb(state);
-	}
-	
-	// Uint64 array to bytes in little endian
-	for (int i = 0; i < IOTEX_HASH_LEN; i++) {
-		int j = i >> 3;
-		hashResult[i] = (uint8_t)(state[j % 5][j / 5] >> ((i & 7) << 3));
-	}
+
+	keccak256_ctx ctx;
+
+	keccak256_init(&ctx);
+	keccak256_update(&ctx, msg, len);
+	keccak256_final(&ctx, hashResult);
 }
 
+void keccak256_getHash_x4(const uint8_t * const msg[4], size_t len, uint8_t * const hashResult[4]) {
+
+	if( NULL == msg || 0 == len || NULL == hashResult )
+		return;
+
+	for (int w = 0; w < 4; w++) {
+		if( NULL == msg[w] || NULL == hashResult[w] )
+			return;
+	}
 
+#ifdef KECCAK256_X4_VECTOR
+	keccak256_v4 state[25];
+	uint8_t last[4][IOTEX_BLOCK_SIZE];
+	uint64_t lane[25];
+	size_t off = 0, tail;
 
+	memset(state, 0, sizeof(state));
 
+	// Lane i of way w lives in element w of state[i]
+	for (; len - off >= IOTEX_BLOCK_SIZE; off += IOTEX_BLOCK_SIZE) {
+		for (int i = 0; i < IOTEX_BLOCK_LANES; i++) {
+			keccak256_v4 v = { keccak256_load64(msg[0] + off + 8 * i), keccak256_load64(msg[1] + off + 8 * i),
+							   keccak256_load64(msg[2] + off + 8 * i), keccak256_load64(msg[3] + off + 8 * i) };
+			state[i] ^= v;
+		}
+		keccak256_absorb_x4(state);
+	}
 
+	// Final block and padding, the same for the four messages
+	tail = len - off;
+	for (int w = 0; w < 4; w++) {
+		memset(last[w], 0, sizeof(last[w]));
+		memcpy(last[w], msg[w] + off, tail);
+		last[w][tail] ^= 0x01;
+		last[w][IOTEX_BLOCK_SIZE - 1] ^= 0x80;
+	}
 
+	for (int i = 0; i < IOTEX_BLOCK_LANES; i++) {
+		keccak256_v4 v = { keccak256_load64(last[0] + 8 * i), keccak256_load64(last[1] + 8 * i),
+						   keccak256_load64(last[2] + 8 * i), keccak256_load64(last[3] + 8 * i) };
+		state[i] ^= v;
+	}
+	keccak256_absorb_x4(state);
 
+	for (int w = 0; w < 4; w++) {
+		for (int i = 0; i < IOTEX_HASH_LEN / 8; i++)
+			lane[i] = state[i][w];
+		keccak256_store(lane, hashResult[w]);
+	}
+#else
+	for (int w = 0; w < 4; w++)
+		keccak256_getHash(msg[w], len, hashResult[w]);
+#endif
+}
@@ -0,0 +1,332 @@
+/*
+ * Batched uploads through the arena buffer path: a batch of
+ * IOTEX_DEV_ACCESS_BATCH_MAX_RECORDS records has to fit, one that does not
+ * is rejected before it is signed, and every record carries the inclusion
+ * proof of the Merkle tree documented in iotex_dev_access.h.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "DeviceConnect_Core.h"
+#include "include/utils/ProtoBuf/pb_decode.h"
+#include "include/backends/tinycryt/sha256.h"
+#include "include/backends/tinycryt/tests/test_utils.h"
+
+extern psa_key_id_t g_sdkcore_key;
+
+#define TEST_MAX_RECORDS	IOTEX_DEV_ACCESS_BATCH_MAX_RECORDS
+
+typedef struct test_bytes {
+
+	size_t len;
+	uint8_t buf[IOTEX_DEV_ACCESS_ENCODE_ARENA_SIZE];
+
+}test_bytes_t;
+
+typedef struct test_record {
+
+	uint32_t index;
+	test_bytes_t data;
+	test_bytes_t proof;
+
+}test_record_t;
+
+static uint8_t published[IOTEX_DEV_ACCESS_ENCODE_ARENA_SIZE];
+static unsigned int published_len;
+static int published_count;
+
+static test_record_t decoded[TEST_MAX_RECORDS];
+static size_t decoded_count;
+
+static int test_mqtt_pub(unsigned char *topic, unsigned char *buf, unsigned int buflen, int qos) {
+
+	(void)topic;
+	(void)qos;
+
+	if (buflen > sizeof(published))
+		return 0;
+
+	memcpy(published, buf, buflen);
+	published_len = buflen;
+	published_count++;
+
+	return 1;
+}
+
+static int test_mqtt_sub(unsigned char *topic) {
+
+	(void)topic;
+
+	return 1;
+}
+
+static time_t test_get_time(void) {
+
+	return 0;
+}
+
+static bool test_decode_bytes(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+
+	test_bytes_t *bytes = (test_bytes_t *)*arg;
+
+	(void)field;
+
+	if (stream->bytes_left > sizeof(bytes->buf))
+		return false;
+
+	bytes->len = stream->bytes_left;
+
+	return pb_read(stream, bytes->buf, bytes->len);
+}
+
+static bool test_decode_record(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+
+	BatchRecord record = BatchRecord_init_zero;
+	test_record_t *out = NULL;
+
+	(void)field;
+	(void)arg;
+
+	if (decoded_count >= TEST_MAX_RECORDS)
+		return false;
+
+	out = &decoded[decoded_count];
+	memset(out, 0, sizeof(*out));
+
+	record.data.funcs.decode  = test_decode_bytes;
+	record.data.arg           = &out->data;
+	record.proof.funcs.decode = test_decode_bytes;
+	record.proof.arg          = &out->proof;
+
+	if (!pb_decode(stream, BatchRecord_fields, &record))
+		return false;
+
+	out->index = record.index;
+	decoded_count++;
+
+	return true;
+}
+
+static void test_merkle_hash(uint8_t *out, uint8_t prefix, const uint8_t *a, size_t a_len, const uint8_t *b, size_t b_len) {
+
+	struct tc_sha256_state_struct s;
+
+	tc_sha256_init(&s);
+	tc_sha256_update(&s, &prefix, 1);
+	if (a_len)
+		tc_sha256_update(&s, a, a_len);
+	if (b_len)
+		tc_sha256_update(&s, b, b_len);
+	tc_sha256_final(out, &s);
+}
+
+/* Fold a record's proof up to the root as a verifier would, from its index and the record count */
+static void test_merkle_fold(uint8_t *root, const test_record_t *record, size_t count) {
+
+	uint8_t pair[64];
+	size_t pos = record->index, n = count, off = 0;
+
+	test_merkle_hash(root, 0x00, record->data.buf, record->data.len, NULL, 0);
+
+	for (; n > 1; pos >>= 1, n = (n + 1) / 2) {
+
+		if ((pos ^ 1) >= n)
+			continue;
+
+		if (off + 32 > record->proof.len) {
+			memset(root, 0, 32);
+			return;
+		}
+
+		memcpy(pair + (pos & 1 ? 0 : 32), record->proof.buf + off, 32);
+		memcpy(pair + (pos & 1 ? 32 : 0), root, 32);
+		test_merkle_hash(root, 0x01, pair, 64, NULL, 0);
+		off += 32;
+	}
+
+	if (off != record->proof.len)
+		memset(root, 0, 32);
+}
+
+static int test_decode_upload(Upload *upload, test_bytes_t *sign) {
+
+	pb_istream_t stream = pb_istream_from_buffer(published, published_len);
+
+	memset(upload, 0, sizeof(*upload));
+	decoded_count = 0;
+
+	upload->payload.sign.funcs.decode          = test_decode_bytes;
+	upload->payload.sign.arg                   = sign;
+	upload->payload.batch.records.funcs.decode = test_decode_record;
+
+	return pb_decode(&stream, Upload_fields, upload);
+}
+
+static int test_hex_equal(const uint8_t *bytes, const char *hex, size_t len) {
+
+	unsigned int byte = 0;
+
+	for (size_t i = 0; i < len; i++) {
+		if (1 != sscanf(hex + 2 * i, "%2x", &byte) || bytes[i] != (uint8_t)byte)
+			return 0;
+	}
+
+	return 1;
+}
+
+/* Root and proofs of "rec0" ... "rec4", computed independently of the SDK */
+static int test_merkle_vector(void) {
+
+	static const char root[] = "043a69a5f8157bda2923b91adf07aede687a2cac6bd5556abb3e9791d7544959";
+	static const char proof1[] =
+		"8c8b9a2b06bdbd221184bc53e43a9ce88a3cfd4a0c58660905fde76d18fdeb40"
+		"d1af2124744cee8154245622ac654e4d243e803727c1d66a2c41bea219d6272e"
+		"a3c44c512382a953ad4bda6e7ee464f441cbc65477f8c031bf0c9c4d4d491688";
+	static const char proof4[] = "5b3f89e28d60325b6f8c732c12339a27311a471553a36b276db62698e86269d3";
+	static char data[5][5];
+	iotex_upload_record_t records[5];
+	int8_t mac[6] = {1, 2, 3, 4, 5, 6};
+	test_bytes_t sign;
+	Upload upload;
+	int result = TC_PASS;
+
+	TC_START(__func__);
+
+	for (int i = 0; i < 5; i++) {
+		sprintf(data[i], "rec%d", i);
+		records[i].buf = data[i];
+		records[i].len = 4;
+	}
+
+	if (IOTEX_DEV_ACCESS_ERR_SUCCESS != iotex_dev_access_data_upload_batch(records, 5, IOTEX_USER_DATA_TYPE_RAW, mac) ||
+		!test_decode_upload(&upload, &sign) || 5 != decoded_count) {
+		TC_ERROR("batch of 5 not uploaded\n");
+		result = TC_FAIL;
+		goto exitTest;
+	}
+
+	if (!test_hex_equal(upload.payload.batch.root.bytes, root, 32) ||
+		decoded[1].proof.len != 96 || !test_hex_equal(decoded[1].proof.buf, proof1, 96) ||
+		decoded[4].proof.len != 32 || !test_hex_equal(decoded[4].proof.buf, proof4, 32)) {
+		TC_ERROR("root or proof differs from the reference\n");
+		result = TC_FAIL;
+	}
+
+exitTest:
+	TC_END_RESULT(result);
+	return result;
+}
+
+/* Every count up to the maximum, with IOTEX_DEV_ACCESS_USER_DATA_SIZE bytes of data in total */
+static int test_max_batch_buffer_path(void) {
+
+	static uint8_t data[IOTEX_DEV_ACCESS_USER_DATA_SIZE];
+	iotex_upload_record_t records[TEST_MAX_RECORDS];
+	int8_t mac[6] = {1, 2, 3, 4, 5, 6};
+	uint8_t root[32];
+	test_bytes_t sign;
+	Upload upload;
+	int result = TC_PASS;
+
+	TC_START(__func__);
+
+	for (size_t i = 0; i < sizeof(data); i++)
+		data[i] = (uint8_t)(i * 31 + 7);
+
+	for (size_t count = 1; count <= TEST_MAX_RECORDS; count++) {
+
+		size_t share = sizeof(data) / count;
+		int ret;
+
+		for (size_t i = 0; i < count; i++) {
+			records[i].buf = data + i * share;
+			records[i].len = (i + 1 == count ? sizeof(data) - i * share : share);
+		}
+
+		published_count = 0;
+		ret = iotex_dev_access_data_upload_batch(records, count, IOTEX_USER_DATA_TYPE_RAW, mac);
+
+		if (IOTEX_DEV_ACCESS_ERR_SUCCESS != ret || 1 != published_count) {
+			TC_ERROR("batch of %zu records: ret %d, %d publishes\n", count, ret, published_count);
+			result = TC_FAIL;
+			continue;
+		}
+
+		if (!test_decode_upload(&upload, &sign) || !upload.has_payload || !upload.payload.has_batch ||
+			Payload_PackageType_USERDATA_BATCH != upload.payload.ptype ||
+			count != upload.payload.batch.count || count != decoded_count) {
+			TC_ERROR("batch of %zu records does not decode\n", count);
+			result = TC_FAIL;
+			continue;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+
+			test_merkle_fold(root, &decoded[i], count);
+
+			if (decoded[i].index != i || decoded[i].data.len != records[i].len ||
+				memcmp(decoded[i].data.buf, records[i].buf, records[i].len) ||
+				memcmp(root, upload.payload.batch.root.bytes, 32)) {
+				TC_ERROR("record %zu of %zu does not prove the root\n", i, count);
+				result = TC_FAIL;
+			}
+		}
+
+		if (PSA_SUCCESS != psa_verify_message(g_sdkcore_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256),
+											  upload.payload.batch.root.bytes, 32, sign.buf, sign.len)) {
+			TC_ERROR("signature over the root of %zu records does not verify\n", count);
+			result = TC_FAIL;
+		}
+	}
+
+	TC_END_RESULT(result);
+	return result;
+}
+
+static int test_oversized_batch(void) {
+
+	static uint8_t data[IOTEX_DEV_ACCESS_ENCODE_ARENA_SIZE];
+	iotex_upload_record_t records[2];
+	int8_t mac[6] = {1, 2, 3, 4, 5, 6};
+	int result = TC_PASS;
+	int ret;
+
+	TC_START(__func__);
+
+	records[0].buf = data;
+	records[0].len = sizeof(data) / 2;
+	records[1].buf = data + sizeof(data) / 2;
+	records[1].len = sizeof(data) / 2;
+
+	published_count = 0;
+	ret = iotex_dev_access_data_upload_batch(records, 2, IOTEX_USER_DATA_TYPE_RAW, mac);
+
+	if (IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER != ret || 0 != published_count) {
+		TC_ERROR("oversized batch: ret %d, %d publishes\n", ret, published_count);
+		result = TC_FAIL;
+	}
+
+	TC_END_RESULT(result);
+	return result;
+}
+
+int main(void) {
+
+	int result = TC_PASS;
+
+	if (NULL == iotex_deviceconnect_sdk_core_init(test_get_time, test_mqtt_pub, test_mqtt_sub)) {
+		TC_ERROR("init failed\n");
+		return TC_FAIL;
+	}
+
+	iotex_dev_access_set_mqtt_status(IOTEX_MQTT_BIND_STATUS_OK);
+
+	result |= test_merkle_vector();
+	result |= test_max_batch_buffer_path();
+	result |= test_oversized_batch();
+
+	TC_END_REPORT(result);
+
+	return result;
+}
@@ -0,0 +1,264 @@
+/*
+ * Store-and-forward spool on a RAM flash that, like NOR flash, only clears
+ * bits on write: records come back in order across remounts, a record whose
+ * CRC no longer matches or whose write was torn is skipped, and a full ring
+ * drops its oldest block.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "include/utils/iotex_spool.h"
+#include "include/backends/tinycryt/tests/test_utils.h"
+
+#define TEST_BLOCK_SIZE		256
+#define TEST_BLOCKS			4
+
+static uint8_t flash[TEST_BLOCKS * TEST_BLOCK_SIZE];
+
+/* Bytes still written before power fails, -1 for no failure */
+static int power_budget = -1;
+
+static int test_flash_earse(unsigned int address) {
+
+	if (address % TEST_BLOCK_SIZE || address >= sizeof(flash))
+		return -1;
+
+	memset(flash + address, 0xFF, TEST_BLOCK_SIZE);
+
+	return 0;
+}
+
+static int test_flash_write(unsigned int address, unsigned int offset, unsigned char *buf, int len) {
+
+	int n = len;
+
+	if (address + offset + len > sizeof(flash))
+		return -1;
+
+	if (power_budget >= 0) {
+		if (n > power_budget)
+			n = power_budget;
+		power_budget -= n;
+	}
+
+	for (int i = 0; i < n; i++)
+		flash[address + offset + i] &= buf[i];
+
+	return n;
+}
+
+static int test_flash_read(unsigned int address, unsigned int offset, unsigned char *buf, int len) {
+
+	if (address + offset + len > sizeof(flash))
+		return -1;
+
+	memcpy(buf, flash + address + offset, len);
+
+	return len;
+}
+
+static flash_drv test_drv = {
+	.start_address = 0,
+	.flash_size    = sizeof(flash),
+	.block_size    = TEST_BLOCK_SIZE,
+	.earse         = test_flash_earse,
+	.write         = test_flash_write,
+	.read          = test_flash_read,
+};
+
+static iotex_spool_t spool;
+
+static void test_flash_erase_all(void) {
+
+	memset(flash, 0xFF, sizeof(flash));
+	power_budget = -1;
+}
+
+static int test_append(uint32_t id) {
+
+	char record[32];
+
+	sprintf(record, "record %u", (unsigned)id);
+
+	return iotex_spool_append(&spool, (const uint8_t *)record, strlen(record));
+}
+
+/* Pops the oldest record, returns its id or -1 */
+static int test_pop(void) {
+
+	const uint8_t *buf = NULL;
+	size_t len = 0;
+	unsigned id = 0;
+	char record[32];
+
+	if (IOTEX_SPOOL_ERR_SUCCESS != iotex_spool_peek(&spool, &buf, &len) || len >= sizeof(record))
+		return -1;
+
+	memcpy(record, buf, len);
+	record[len] = '\0';
+
+	if (1 != sscanf(record, "record %u", &id) || IOTEX_SPOOL_ERR_SUCCESS != iotex_spool_pop(&spool))
+		return -1;
+
+	return (int)id;
+}
+
+/* Offset of the record holding id, found the way a flash dump would be read */
+static int test_find(uint32_t id) {
+
+	char record[32];
+
+	sprintf(record, "record %u", (unsigned)id);
+
+	for (size_t off = 0; off + IOTEX_SPOOL_RECORD_HEADER_SIZE + strlen(record) <= sizeof(flash); off += 4)
+		if (0 == memcmp(flash + off + IOTEX_SPOOL_RECORD_HEADER_SIZE, record, strlen(record)))
+			return (int)off;
+
+	return -1;
+}
+
+static int test_order_and_remount(void) {
+
+	int result = TC_PASS;
+
+	TC_START(__func__);
+
+	test_flash_erase_all();
+
+	if (IOTEX_SPOOL_ERR_SUCCESS != iotex_spool_mount(&spool, &test_drv)) {
+		TC_ERROR("mount of an erased flash failed\n");
+		result = TC_FAIL;
+		goto exitTest;
+	}
+
+	for (uint32_t i = 0; i < 5; i++)
+		test_append(i);
+
+	if (0 != test_pop() || 1 != test_pop()) {
+		TC_ERROR("records not replayed in order\n");
+		result = TC_FAIL;
+	}
+
+	/* Replayed records stay replayed, the others are found again */
+	iotex_spool_mount(&spool, &test_drv);
+
+	if (3 != spool.stats.pending || 2 != test_pop() || 3 != test_pop() || 4 != test_pop() || -1 != test_pop()) {
+		TC_ERROR("remount lost the replay state\n");
+		result = TC_FAIL;
+	}
+
+exitTest:
+	TC_END_RESULT(result);
+	return result;
+}
+
+static int test_crc(void) {
+
+	int result = TC_PASS, off = 0;
+
+	TC_START(__func__);
+
+	test_flash_erase_all();
+	iotex_spool_mount(&spool, &test_drv);
+
+	for (uint32_t i = 0; i < 3; i++)
+		test_append(i);
+
+	/* One bit of the data of record 1 decays */
+	off = test_find(1);
+	flash[off + IOTEX_SPOOL_RECORD_HEADER_SIZE + 2] &= 0xFE;
+
+	iotex_spool_mount(&spool, &test_drv);
+
+	if (1 != spool.stats.corrupt || 2 != spool.stats.pending || 0 != test_pop() || 2 != test_pop() || -1 != test_pop()) {
+		TC_ERROR("damaged record not skipped: %u corrupt, %u pending\n", (unsigned)spool.stats.corrupt, (unsigned)spool.stats.pending);
+		result = TC_FAIL;
+	}
+
+	TC_END_RESULT(result);
+	return result;
+}
+
+static int test_torn_write(void) {
+
+	int result = TC_PASS;
+
+	TC_START(__func__);
+
+	test_flash_erase_all();
+	iotex_spool_mount(&spool, &test_drv);
+
+	test_append(0);
+
+	/* Power fails after the header and four bytes of the data of record 1 */
+	power_budget = IOTEX_SPOOL_RECORD_HEADER_SIZE + 4;
+	test_append(1);
+	power_budget = -1;
+
+	iotex_spool_mount(&spool, &test_drv);
+	test_append(2);
+
+	iotex_spool_mount(&spool, &test_drv);
+
+	if (1 != spool.stats.corrupt || 0 != test_pop() || 2 != test_pop() || -1 != test_pop()) {
+		TC_ERROR("torn record not skipped\n");
+		result = TC_FAIL;
+	}
+
+	TC_END_RESULT(result);
+	return result;
+}
+
+static int test_ring_full(void) {
+
+	uint32_t appended = 0;
+	int result = TC_PASS, id = 0, prev = -1;
+
+	TC_START(__func__);
+
+	test_flash_erase_all();
+	iotex_spool_mount(&spool, &test_drv);
+
+	/* A record takes 28 bytes, this is about four times what the ring holds */
+	for (appended = 0; appended < 150; appended++)
+		test_append(appended);
+
+	iotex_spool_mount(&spool, &test_drv);
+
+	if (0 == spool.stats.pending || spool.stats.pending >= appended) {
+		TC_ERROR("%u pending of %u appended\n", (unsigned)spool.stats.pending, (unsigned)appended);
+		result = TC_FAIL;
+	}
+
+	/* What survives is the newest records, without gaps */
+	while (-1 != (id = test_pop())) {
+		if (prev >= 0 && id != prev + 1) {
+			TC_ERROR("record %d follows %d\n", id, prev);
+			result = TC_FAIL;
+		}
+		prev = id;
+	}
+
+	if (prev != (int)appended - 1) {
+		TC_ERROR("newest record %d, expected %u\n", prev, (unsigned)appended - 1);
+		result = TC_FAIL;
+	}
+
+	TC_END_RESULT(result);
+	return result;
+}
+
+int main(void) {
+
+	int result = TC_PASS;
+
+	result |= test_order_and_remount();
+	result |= test_crc();
+	result |= test_torn_write();
+	result |= test_ring_full();
+
+	TC_END_REPORT(result);
+
+	return result;
+}
@@ -0,0 +1,176 @@
+/*
+ * Columnar time-series encoding: a hand-encoded vector pins the wire format
+ * documented in timeseries.h, and a builder that runs out of room, moving its
+ * columns around on the way, still decodes to every sample it accepted.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "include/utils/TimeSeries/timeseries.h"
+#include "include/backends/tinycryt/tests/test_utils.h"
+
+/* Two channels with 1 and 0 decimals, sampled at 1000, 2000, 3000 and 4100 */
+static int test_vector(void) {
+
+	static const uint8_t expected[] = {
+		0x01, 0x02, 0x04, 0xE8, 0x07, 0x01, 0x00, 0x05, 0x05, 0x04,	/* version, channels, count, t0, decimals, column lengths */
+		0xD0, 0x0F, 0x00, 0xC8, 0x01,								/* deltas of delta 1000, 0, 100 */
+		0xAE, 0x03, 0x02, 0x00, 0x03,								/* deltas 215, 1, 0, -2 */
+		0x0A, 0x00, 0x02, 0x03,										/* deltas 5, 0, 1, -2 */
+	};
+	static const uint64_t ts[4] = {1000, 2000, 3000, 4100};
+	static const double values[4][2] = {{21.5, 5}, {21.6, 5}, {21.6, 6}, {21.4, 4}};
+	const uint8_t decimals[2] = {1, 0};
+	iotex_ts_builder_t builder;
+	iotex_ts_decoder_t decoder;
+	uint8_t buf[128];
+	uint64_t t = 0;
+	double v[2];
+	int result = TC_PASS, len = 0;
+
+	TC_START(__func__);
+
+	iotex_ts_builder_init(&builder, buf, sizeof(buf), 2, decimals);
+
+	for (int i = 0; i < 4; i++)
+		iotex_ts_builder_append(&builder, ts[i], values[i]);
+
+	len = iotex_ts_builder_finish(&builder);
+
+	if (sizeof(expected) != (size_t)len || memcmp(buf, expected, sizeof(expected))) {
+		TC_ERROR("encoding of %d bytes differs from the reference\n", len);
+		result = TC_FAIL;
+		goto exitTest;
+	}
+
+	if (IOTEX_TS_ERR_SUCCESS != iotex_ts_decoder_init(&decoder, expected, sizeof(expected))) {
+		TC_ERROR("reference does not decode\n");
+		result = TC_FAIL;
+		goto exitTest;
+	}
+
+	for (int i = 0; i < 4; i++) {
+		if (IOTEX_TS_ERR_SUCCESS != iotex_ts_decoder_next(&decoder, &t, v) || t != ts[i] ||
+			fabs(v[0] - values[i][0]) > 1e-9 || v[1] != values[i][1]) {
+			TC_ERROR("sample %d differs\n", i);
+			result = TC_FAIL;
+		}
+	}
+
+	if (IOTEX_TS_ERR_END != iotex_ts_decoder_next(&decoder, &t, v)) {
+		TC_ERROR("decoder runs past the last sample\n");
+		result = TC_FAIL;
+	}
+
+	/* Every truncation is caught, by the header or by a column */
+	for (size_t cut = 0; cut < sizeof(expected); cut++) {
+
+		int ret = iotex_ts_decoder_init(&decoder, expected, cut);
+
+		while (IOTEX_TS_ERR_SUCCESS == ret)
+			ret = iotex_ts_decoder_next(&decoder, &t, v);
+
+		if (IOTEX_TS_ERR_CORRUPT != ret) {
+			TC_ERROR("truncated to %zu bytes: %d\n", cut, ret);
+			result = TC_FAIL;
+		}
+	}
+
+exitTest:
+	TC_END_RESULT(result);
+	return result;
+}
+
+#define TEST_CHANNELS	3
+#define TEST_SAMPLES	512
+
+/*
+ * A steady channel, one that jumps and a timestamp with jitter grow their
+ * columns at different rates, so the regions are shared out again several
+ * times before the buffer fills.
+ */
+static int test_fill(void) {
+
+	static uint64_t ts[TEST_SAMPLES];
+	static double values[TEST_SAMPLES][TEST_CHANNELS];
+	const uint8_t decimals[TEST_CHANNELS] = {2, 0, 3};
+	iotex_ts_builder_t builder;
+	iotex_ts_decoder_t decoder;
+	uint8_t buf[300];
+	uint64_t t = 0;
+	uint32_t x = 12345;
+	double v[TEST_CHANNELS];
+	int result = TC_PASS, accepted = 0, len = 0, ret = 0;
+
+	TC_START(__func__);
+
+	for (int i = 0; i < TEST_SAMPLES; i++) {
+
+		x = x * 1103515245 + 12345;
+
+		ts[i]        = 1700000000000ULL + 1000ULL * i + (x >> 16) % 7;
+		values[i][0] = 20.0 + 0.01 * (i % 5);
+		values[i][1] = (double)((x >> 8) % 100000) - 50000;
+		values[i][2] = -1.5 + 0.001 * i;
+	}
+
+	iotex_ts_builder_init(&builder, buf, sizeof(buf), TEST_CHANNELS, decimals);
+
+	for (accepted = 0; accepted < TEST_SAMPLES; accepted++) {
+		if (IOTEX_TS_ERR_SUCCESS != (ret = iotex_ts_builder_append(&builder, ts[accepted], values[accepted])))
+			break;
+	}
+
+	if (IOTEX_TS_ERR_BUFFER_FULL != ret || accepted < 10) {
+		TC_ERROR("%d samples accepted, then %d\n", accepted, ret);
+		result = TC_FAIL;
+		goto exitTest;
+	}
+
+	len = iotex_ts_builder_finish(&builder);
+
+	if (len <= 0 || (size_t)len > sizeof(buf) || IOTEX_TS_ERR_SUCCESS != iotex_ts_decoder_init(&decoder, buf, len)) {
+		TC_ERROR("finish returned %d\n", len);
+		result = TC_FAIL;
+		goto exitTest;
+	}
+
+	for (int i = 0; i < accepted; i++) {
+
+		if (IOTEX_TS_ERR_SUCCESS != iotex_ts_decoder_next(&decoder, &t, v) || t != ts[i]) {
+			TC_ERROR("timestamp %d differs\n", i);
+			result = TC_FAIL;
+			break;
+		}
+
+		for (int c = 0; c < TEST_CHANNELS; c++) {
+			if (fabs(v[c] - values[i][c]) > 0.5 / pow(10, decimals[c])) {
+				TC_ERROR("sample %d channel %d: %f, expected %f\n", i, c, v[c], values[i][c]);
+				result = TC_FAIL;
+			}
+		}
+	}
+
+	if (IOTEX_TS_ERR_END != iotex_ts_decoder_next(&decoder, &t, v)) {
+		TC_ERROR("more samples decoded than accepted\n");
+		result = TC_FAIL;
+	}
+
+exitTest:
+	TC_END_RESULT(result);
+	return result;
+}
+
+int main(void) {
+
+	int result = TC_PASS;
+
+	result |= test_vector();
+	result |= test_fill();
+
+	TC_END_REPORT(result);
+
+	return result;
+}
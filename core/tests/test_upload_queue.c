@@ -0,0 +1,240 @@
+/*
+ * Upload queue: JSON_LZ4 records are printed outside their slot, so text
+ * larger than a slot is queued as long as its compressed frame fits, and the
+ * BLOCK policy gives up instead of waiting on the task that drains the ring.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "DeviceConnect_Core.h"
+#include "include/utils/ProtoBuf/pb_decode.h"
+#include "include/backends/tinycryt/tests/test_utils.h"
+
+extern psa_key_id_t g_sdkcore_key;
+
+typedef struct test_bytes {
+
+	size_t len;
+	uint8_t buf[IOTEX_DEV_ACCESS_ENCODE_ARENA_SIZE];
+
+}test_bytes_t;
+
+static uint8_t published[IOTEX_DEV_ACCESS_ENCODE_ARENA_SIZE];
+static unsigned int published_len;
+static int published_count;
+
+static int test_mqtt_pub(unsigned char *topic, unsigned char *buf, unsigned int buflen, int qos) {
+
+	(void)topic;
+	(void)qos;
+
+	if (buflen > sizeof(published))
+		return 0;
+
+	memcpy(published, buf, buflen);
+	published_len = buflen;
+	published_count++;
+
+	return 1;
+}
+
+static int test_mqtt_sub(unsigned char *topic) {
+
+	(void)topic;
+
+	return 1;
+}
+
+static time_t test_get_time(void) {
+
+	return 0;
+}
+
+static bool test_decode_bytes(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+
+	test_bytes_t *bytes = (test_bytes_t *)*arg;
+
+	(void)field;
+
+	if (stream->bytes_left > sizeof(bytes->buf))
+		return false;
+
+	bytes->len = stream->bytes_left;
+
+	return pb_read(stream, bytes->buf, bytes->len);
+}
+
+static int test_decode_upload(Upload *upload, test_bytes_t *user, test_bytes_t *sign) {
+
+	pb_istream_t stream = pb_istream_from_buffer(published, published_len);
+
+	memset(upload, 0, sizeof(*upload));
+
+	upload->payload.user.funcs.decode = test_decode_bytes;
+	upload->payload.user.arg          = user;
+	upload->payload.sign.funcs.decode = test_decode_bytes;
+	upload->payload.sign.arg          = sign;
+
+	return pb_decode(&stream, Upload_fields, upload);
+}
+
+/* A JSON object with one string member of len characters drawn from alphabet */
+static cJSON *test_json(size_t len, const char *alphabet) {
+
+	static char value[IOTEX_DEV_ACCESS_LZ_INPUT_SIZE];
+	size_t n = strlen(alphabet);
+	uint32_t x = 1;
+	cJSON *json = cJSON_CreateObject();
+
+	for (size_t i = 0; i < len; i++) {
+		x = x * 1103515245 + 12345;
+		value[i] = alphabet[(x >> 16) % n];
+	}
+	value[len] = '\0';
+
+	cJSON_AddStringToObject(json, "v", value);
+
+	return json;
+}
+
+static int test_json_lz4_larger_than_slot(void) {
+
+	static char text[IOTEX_DEV_ACCESS_LZ_INPUT_SIZE];
+	static uint8_t plain[IOTEX_DEV_ACCESS_LZ_INPUT_SIZE];
+	int8_t mac[6] = {1, 2, 3, 4, 5, 6};
+	cJSON *json = test_json(3 * IOTEX_DEV_ACCESS_QUEUE_RECORD_SIZE / 2, "ab");
+	test_bytes_t user, sign;
+	Upload upload;
+	size_t text_len = 0;
+	int result = TC_PASS, ret = 0, len = 0;
+
+	TC_START(__func__);
+
+	cJSON_PrintPreallocated(json, text, sizeof(text), 0);
+	text_len = strlen(text);
+
+	published_count = 0;
+	ret = iotex_dev_access_data_enqueue(json, 1, IOTEX_USER_DATA_TYPE_JSON_LZ4, mac);
+	iotex_dev_access_loop();
+
+	if (IOTEX_DEV_ACCESS_ERR_SUCCESS != ret || 1 != published_count) {
+		TC_ERROR("%zu bytes of JSON: ret %d, %d publishes\n", text_len, ret, published_count);
+		result = TC_FAIL;
+		goto exitTest;
+	}
+
+	if (!test_decode_upload(&upload, &user, &sign) || IOTEX_USER_DATA_TYPE_JSON_LZ4 != (int)upload.payload.dtype || user.len <= 4 ||
+		text_len != (size_t)(user.buf[0] | user.buf[1] << 8 | user.buf[2] << 16 | (uint32_t)user.buf[3] << 24)) {
+		TC_ERROR("queued record is not an LZ4 frame of the JSON\n");
+		result = TC_FAIL;
+		goto exitTest;
+	}
+
+	len = iotex_lz_decompress(user.buf + 4, user.len - 4, plain, sizeof(plain));
+
+	if (len < 0 || text_len != (size_t)len || memcmp(plain, text, text_len)) {
+		TC_ERROR("frame does not decompress to the JSON\n");
+		result = TC_FAIL;
+	}
+
+	if (PSA_SUCCESS != psa_verify_message(g_sdkcore_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256), user.buf, user.len, sign.buf, sign.len)) {
+		TC_ERROR("signature over the frame does not verify\n");
+		result = TC_FAIL;
+	}
+
+exitTest:
+	cJSON_Delete(json);
+	TC_END_RESULT(result);
+	return result;
+}
+
+/* Text that neither shrinks nor fits a slot is refused, the empty record is dropped as failed */
+static int test_json_lz4_incompressible(void) {
+
+	int8_t mac[6] = {1, 2, 3, 4, 5, 6};
+	cJSON *json = test_json(IOTEX_DEV_ACCESS_QUEUE_RECORD_SIZE + 64, "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ");
+	iotex_upload_queue_stats_t before, after;
+	int result = TC_PASS, ret = 0;
+
+	TC_START(__func__);
+
+	iotex_dev_access_get_queue_stats(&before);
+
+	published_count = 0;
+	ret = iotex_dev_access_data_enqueue(json, 1, IOTEX_USER_DATA_TYPE_JSON_LZ4, mac);
+	iotex_dev_access_loop();
+
+	iotex_dev_access_get_queue_stats(&after);
+
+	if (IOTEX_DEV_ACCESS_ERR_BAD_INPUT_PARAMETER != ret || 0 != published_count || before.failed + 1 != after.failed) {
+		TC_ERROR("incompressible JSON: ret %d, %d publishes\n", ret, published_count);
+		result = TC_FAIL;
+	}
+
+	cJSON_Delete(json);
+	TC_END_RESULT(result);
+	return result;
+}
+
+/* The loop last ran in this task, waiting for a free slot here could never end */
+static int test_block_in_loop_task(void) {
+
+	uint8_t data[16] = {0};
+	int8_t mac[6] = {1, 2, 3, 4, 5, 6};
+	iotex_upload_queue_stats_t stats;
+	int result = TC_PASS, ret = 0;
+
+	TC_START(__func__);
+
+	iotex_dev_access_loop();
+	iotex_dev_access_set_queue_policy(IOTEX_QUEUE_POLICY_BLOCK);
+
+	for (int i = 0; i < IOTEX_DEV_ACCESS_QUEUE_LEN; i++) {
+		if (IOTEX_DEV_ACCESS_ERR_SUCCESS != iotex_dev_access_data_enqueue(data, sizeof(data), IOTEX_USER_DATA_TYPE_RAW, mac)) {
+			TC_ERROR("enqueue %d into a free ring failed\n", i);
+			result = TC_FAIL;
+		}
+	}
+
+	ret = iotex_dev_access_data_enqueue(data, sizeof(data), IOTEX_USER_DATA_TYPE_RAW, mac);
+
+	if (IOTEX_DEV_ACCESS_ERR_QUEUE_FULL != ret) {
+		TC_ERROR("blocking enqueue on a full ring returned %d\n", ret);
+		result = TC_FAIL;
+	}
+
+	published_count = 0;
+	iotex_dev_access_loop();
+	iotex_dev_access_get_queue_stats(&stats);
+
+	if (IOTEX_DEV_ACCESS_QUEUE_LEN != published_count || 0 != stats.depth) {
+		TC_ERROR("ring not drained: %d publishes, depth %u\n", published_count, (unsigned)stats.depth);
+		result = TC_FAIL;
+	}
+
+	iotex_dev_access_set_queue_policy(IOTEX_QUEUE_POLICY_DROP_OLDEST);
+
+	TC_END_RESULT(result);
+	return result;
+}
+
+int main(void) {
+
+	int result = TC_PASS;
+
+	if (NULL == iotex_deviceconnect_sdk_core_init(test_get_time, test_mqtt_pub, test_mqtt_sub)) {
+		TC_ERROR("init failed\n");
+		return TC_FAIL;
+	}
+
+	iotex_dev_access_set_mqtt_status(IOTEX_MQTT_BIND_STATUS_OK);
+
+	result |= test_json_lz4_larger_than_slot();
+	result |= test_json_lz4_incompressible();
+	result |= test_block_in_loop_task();
+
+	TC_END_REPORT(result);
+
+	return result;
+}
@@ -0,0 +1,459 @@
+/*
+ * Batched ECDSA verification on secp256r1 and secp256k1, against signatures
+ * computed independently of the SDK. Every batch spans more than one chunk
+ * and mixes valid signatures with forged ones, including a key Q = -G whose
+ * G + Q has no affine form and sends its items to the single verification
+ * fallback of uECC_verify_batch().
+ *
+ * Ed25519 batches are checked the same way, a chunk holding a forged
+ * signature falls back to single verification to find it.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "include/psa/crypto.h"
+#include "include/backends/tinycryt/ecc.h"
+#include "include/backends/tinycryt/ecc_dsa.h"
+#include "include/backends/tinycryt/ed_dsa.h"
+#include "include/backends/tinycryt/sha256.h"
+#include "include/backends/tinycryt/tests/test_utils.h"
+
+#define TEST_KEYS		4
+#define TEST_ITEMS		20
+
+/* Item at which each kind of bad signature is placed, the others are valid */
+#define TEST_TAMPERED		5		/* one bit of s flipped */
+#define TEST_WRONG_KEY		9		/* valid signature, checked against another key */
+#define TEST_FORGED_NEG_G	15		/* Q = -G with a signature that is not its own */
+#define TEST_ZERO_R		18		/* r = 0, out of range */
+
+typedef struct test_curve_vector {
+
+	const char *name;
+	psa_ecc_family_t family;
+	const char *key[TEST_KEYS];		/* x || y, the last one is -G */
+	const char *sig[TEST_KEYS];		/* r || s of "message <i>" under key i */
+
+}test_curve_vector_t;
+
+static const test_curve_vector_t vectors[] = {
+	{
+		"secp256r1", PSA_ECC_FAMILY_SECP_R1,
+		{
+			"fbe30fdd04d1aed480b091f4b761cf0785d6d10844822637de157bb59fc37d93"
+			"3ace1f547f369f7602bd3e2bc074669479e8335cd0595365737304062d732c48",
+			"77933dba99ed9efabd9df1e22c6dd61a4a6baaa8358abe3eb77aeb9b83a17553"
+			"ad44145c7109956f4981dab3df0c0006c423272fd8180dd7764a1b766546c6b6",
+			"d4e4c02dd9373bb9df05b7ac8f1fa965d777e61c31e6b37a3ab19e1318511d0f"
+			"1f2225f52581e11ae8b861e6557f1d1c6401f7114c3bb548f5393c64b214b409",
+			"6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296"
+			"b01cbd1c01e58065711814b583f061e9d431cca994cea1313449bf97c840ae0a",
+		},
+		{
+			"cd6a195401ee12e278d02a1159c8823bccb78eca5942338319aa5bf3b718a0d5"
+			"700ca5183b5c2c5038447c2f74dae956e04855b7b5a9a7d810dbcda17afe058e",
+			"f325cb523da7f504aa856707e235fee27e8c3be150b20a85bf88ac4c5537057b"
+			"4408fdbe0a9c045c6df1ed037d3fc3e588823bcc60f2a529ee0d847aae586b1d",
+			"68415d3751ccf8e6e56f00f06649325aac36038e4a24063ec0d42bbd72508d95"
+			"7b81039a57026849cd6d8d3ee4abeceb9a332d6167a6946382ca80ad7413cd80",
+			"685a59e57c0ba92394111000b5cd14bc2ea96d47b8c9d0750726b14c7662aa12"
+			"47b8f4f9c29b6368ca12f915f32f28db4307db48914858614406c9b7b1c09332",
+		},
+	},
+	{
+		"secp256k1", PSA_ECC_FAMILY_SECP_K1,
+		{
+			"d79d416dcf6821443e5decc036a42567f44be2be72879df4100a3895c45a5b69"
+			"2d3e156381e27ded4691f0d26390669ae37c3d90eb218d0e5f66e7d3180d035a",
+			"aad5e9811a4d480b72e9523630fd7df55af251fc043ae9d16a857b1ff248358e"
+			"ef15fe24c31b570fc9fcbc49cc0dd13cdf303aa795e075c891444465ff9a61d4",
+			"203d391c06e30636235f44885da2a4caedea98fe8cf27b54886ef7a6152ab63f"
+			"8b953e02694a6711654b911b79af4db9d830a0f0ee795278a875d7cc6025161d",
+			"79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+			"b7c52588d95c3b9aa25b0403f1eef75702e84bb7597aabe663b82f6f04ef2777",
+		},
+		{
+			"2c926b83e83ad48ce1208595afdd98affb3adece86aba3023d9b669c1ac1f1c6"
+			"3e4b33f3c6a13665ec3772a4f913fe12c279080c8494ee453ec3f7d42ce46737",
+			"f5fd65112c6f7f2cb4beaedf5c02ff3f89198a2764890d71b3c0292ae20c14ef"
+			"0b803e955317121c811d5e958704a19e47fd0700cd79289c66b51112b3fc889a",
+			"07db30e47d1155bf281dd04ee8894e1e57fe448e0f060f12f7f3507f665c5938"
+			"5d6481719f92f629aa8294cf03a2ee0fb2765f4b186bf071f26be12a51648bba",
+			"71ee92b68f960568dcf58e4fe5bb4e21de38c341d2749631cd2648ea77ed92d8"
+			"6f9f4fbc5fdc52c91c8233665fa4f3eeed812242df0e748e307cbcf37d783148",
+		},
+	},
+};
+
+/* Keys, messages and signatures of one curve's batch, item i uses key i % TEST_KEYS */
+typedef struct test_batch {
+
+	uint8_t key[TEST_KEYS][64];
+	char    message[TEST_KEYS][16];
+	uint8_t hash[TEST_KEYS][32];
+
+	uint8_t sig[TEST_ITEMS][64];
+	size_t  sig_len[TEST_ITEMS];
+	const uint8_t *key_of[TEST_ITEMS];
+	int     message_of[TEST_ITEMS];
+	int     valid[TEST_ITEMS];
+
+}test_batch_t;
+
+static void test_hex(uint8_t *bytes, const char *hex, size_t len) {
+
+	unsigned int byte = 0;
+
+	for (size_t i = 0; i < len; i++) {
+		sscanf(hex + 2 * i, "%2x", &byte);
+		bytes[i] = (uint8_t)byte;
+	}
+}
+
+static void test_batch_init(test_batch_t *batch, const test_curve_vector_t *vector) {
+
+	struct tc_sha256_state_struct s;
+
+	for (int i = 0; i < TEST_KEYS; i++) {
+
+		test_hex(batch->key[i], vector->key[i], 64);
+
+		sprintf(batch->message[i], "message %d", i);
+		tc_sha256_init(&s);
+		tc_sha256_update(&s, (const uint8_t *)batch->message[i], strlen(batch->message[i]));
+		tc_sha256_final(batch->hash[i], &s);
+	}
+
+	for (int i = 0; i < TEST_ITEMS; i++) {
+
+		int k = i % TEST_KEYS;
+
+		test_hex(batch->sig[i], vector->sig[k], 64);
+		batch->sig_len[i]    = 64;
+		batch->key_of[i]     = batch->key[k];
+		batch->message_of[i] = k;
+		batch->valid[i]      = 1;
+
+		switch (i) {
+			case TEST_TAMPERED:
+				batch->sig[i][40] ^= 0x10;
+				batch->valid[i] = 0;
+				break;
+			case TEST_WRONG_KEY:
+				batch->key_of[i] = batch->key[(k + 1) % TEST_KEYS];
+				batch->valid[i] = 0;
+				break;
+			case TEST_FORGED_NEG_G:
+				test_hex(batch->sig[i], vector->sig[0], 64);
+				batch->valid[i] = 0;
+				break;
+			case TEST_ZERO_R:
+				memset(batch->sig[i], 0, 32);
+				batch->valid[i] = 0;
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+static uECC_Curve test_curve(psa_ecc_family_t family) {
+
+	return PSA_ECC_FAMILY_SECP_K1 == family ? uECC_secp256k1() : uECC_secp256r1();
+}
+
+static int test_uecc_verify_batch(const test_curve_vector_t *vector) {
+
+	static test_batch_t batch;
+	uECC_Curve curve = test_curve(vector->family);
+	uECC_word_t native[TEST_ITEMS][NUM_ECC_WORDS * 2];
+	uECC_verify_item items[TEST_ITEMS];
+	int result = TC_PASS;
+
+	TC_START(vector->name);
+
+	test_batch_init(&batch, vector);
+	memset(items, 0, sizeof(items));
+
+	for (int i = 0; i < TEST_ITEMS; i++) {
+
+		uECC_vli_bytesToNative(native[i], batch.key_of[i], 32);
+		uECC_vli_bytesToNative(native[i] + NUM_ECC_WORDS, batch.key_of[i] + 32, 32);
+
+		items[i].public_key   = native[i];
+		items[i].message_hash = batch.hash[batch.message_of[i]];
+		items[i].hash_size    = 32;
+		items[i].signature    = batch.sig[i];
+		items[i].result       = -1;
+	}
+
+	uECC_verify_batch(items, TEST_ITEMS, curve);
+
+	for (int i = 0; i < TEST_ITEMS; i++) {
+
+		int single = uECC_verify_native(native[i], items[i].message_hash, 32, batch.sig[i], curve);
+
+		if (items[i].result != batch.valid[i] || single != batch.valid[i]) {
+			TC_ERROR("item %d: batch %d, single %d, expected %d\n", i, items[i].result, single, batch.valid[i]);
+			result = TC_FAIL;
+		}
+	}
+
+	TC_END_RESULT(result);
+	return result;
+}
+
+static psa_status_t test_import(const uint8_t *point, psa_ecc_family_t family, psa_key_id_t *key) {
+
+	psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+	uint8_t data[65];
+
+	data[0] = 0x04;
+	memcpy(data + 1, point, 64);
+
+	psa_set_key_type(&attributes, PSA_KEY_TYPE_ECC_PUBLIC_KEY(family));
+	psa_set_key_bits(&attributes, 256);
+	psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_VERIFY_HASH | PSA_KEY_USAGE_VERIFY_MESSAGE);
+	psa_set_key_algorithm(&attributes, PSA_ALG_ECDSA(PSA_ALG_SHA_256));
+
+	return psa_import_key(&attributes, data, sizeof(data), key);
+}
+
+/*
+ * Both curves in one call, interleaved so every family is picked out of a
+ * mixed chunk, plus a signature of the wrong length. Every status has to be
+ * the one the single-signature call gives.
+ */
+static int test_psa_verify_batch(void) {
+
+	static test_batch_t batch[2];
+	const psa_algorithm_t alg = PSA_ALG_ECDSA(PSA_ALG_SHA_256);
+	psa_key_id_t key_id[2][TEST_KEYS];
+	psa_key_id_t key[2 * TEST_ITEMS];
+	const uint8_t *message[2 * TEST_ITEMS], *hash[2 * TEST_ITEMS], *sig[2 * TEST_ITEMS];
+	size_t message_len[2 * TEST_ITEMS], hash_len[2 * TEST_ITEMS], sig_len[2 * TEST_ITEMS];
+	psa_status_t message_status[2 * TEST_ITEMS], hash_status[2 * TEST_ITEMS];
+	psa_status_t message_ret, hash_ret, first = PSA_SUCCESS;
+	int result = TC_PASS;
+
+	TC_START(__func__);
+
+	memset(key_id, 0, sizeof(key_id));
+
+	for (int c = 0; c < 2; c++) {
+
+		test_batch_init(&batch[c], &vectors[c]);
+
+		for (int k = 0; k < TEST_KEYS; k++) {
+			psa_status_t status = test_import(batch[c].key[k], vectors[c].family, &key_id[c][k]);
+
+			if (PSA_SUCCESS != status) {
+				TC_ERROR("%s key %d not imported: %d\n", vectors[c].name, k, (int)status);
+				result = TC_FAIL;
+				goto exitTest;
+			}
+		}
+	}
+
+	for (int i = 0; i < 2 * TEST_ITEMS; i++) {
+
+		test_batch_t *b = &batch[i & 1];
+		int item = i >> 1;
+
+		key[i]         = key_id[i & 1][(b->key_of[item] - b->key[0]) / sizeof(b->key[0])];
+		message[i]     = (const uint8_t *)b->message[b->message_of[item]];
+		message_len[i] = strlen(b->message[b->message_of[item]]);
+		hash[i]        = b->hash[b->message_of[item]];
+		hash_len[i]    = 32;
+		sig[i]         = b->sig[item];
+		sig_len[i]     = b->sig_len[item];
+	}
+
+	sig_len[2 * TEST_ITEMS - 1] = 63;
+
+	message_ret = psa_verify_message_batch(key, alg, message, message_len, sig, sig_len, 2 * TEST_ITEMS, message_status);
+	hash_ret    = psa_verify_hash_batch(key, alg, hash, hash_len, sig, sig_len, 2 * TEST_ITEMS, hash_status);
+
+	for (int i = 0; i < 2 * TEST_ITEMS; i++) {
+
+		psa_status_t single = psa_verify_message(key[i], alg, message[i], message_len[i], sig[i], sig_len[i]);
+		int valid = batch[i & 1].valid[i >> 1] && 64 == sig_len[i];
+
+		if (message_status[i] != single || hash_status[i] != single || (PSA_SUCCESS == single) != valid) {
+			TC_ERROR("item %d: message %d, hash %d, single %d, expected %s\n",
+					 i, (int)message_status[i], (int)hash_status[i], (int)single, valid ? "valid" : "invalid");
+			result = TC_FAIL;
+		}
+
+		if (PSA_SUCCESS == first)
+			first = single;
+	}
+
+	if (message_ret != first || hash_ret != first) {
+		TC_ERROR("batch returned %d and %d, first failure is %d\n", (int)message_ret, (int)hash_ret, (int)first);
+		result = TC_FAIL;
+	}
+
+exitTest:
+	for (int c = 0; c < 2; c++)
+		for (int k = 0; k < TEST_KEYS; k++)
+			if (key_id[c][k])
+				psa_destroy_key(key_id[c][k]);
+
+	TC_END_RESULT(result);
+	return result;
+}
+
+/* RFC 8032 test 1, then keys from SHA-256("ed-key<i>") signing "message <i>" */
+static const struct {
+
+	const char *seed;
+	const char *key;
+	const char *message;
+	const char *sig;
+
+}ed25519_vectors[TEST_KEYS] = {
+	{
+		"9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+		"d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+		"",
+		"e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e06522490155"
+		"5fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b",
+	},
+	{
+		"47763a888ff623d9e4c5425c8d63f1027379393a4722484efd5d3e644d61a433",
+		"bb87ec134cda01a52202e6aeeb59cc770227be05a782dcc998a64e3f18d7ee5b",
+		"message 0",
+		"f0a7ce40d1da3fa2df5591ec74c1464e30fe0ac6a1ac938d4ef4bb3b9c085323"
+		"43d04137b992adad5343e34266c93e45fd43aa57dd7d41960ba2113ad0bf2208",
+	},
+	{
+		"081d3fea74fc27f57f6c7b795ad4475d1e30adb3495327c4d055e3a99c4830d5",
+		"df5b09438d0a0e405fbc115121ff6440ca5935b5617a699269a405c07d1d270b",
+		"message 1",
+		"81d2a2c047e34b876aa9ffb1f65e62945f58b71708415ed33b3af96174b641ab"
+		"e30c0530621378d94579dbdd8db48c0babe46d04d036409328103e55427bb008",
+	},
+	{
+		"6fc1aba119e02e2988d2f13fca1a3a6fa3c192aeb05963a3aefb0a6ac9e14c6f",
+		"0b065a0f5bb9d8e252bc30676559303d9a85af555eafe541777bf398149420a4",
+		"message 2",
+		"33fb66bac448e5a0ce9e498024d4dd6d6a51fe22437f353e1cefa862fa3170de"
+		"e4b121fac9d263d8b73d33df9ea30554ee02a6ad751c4c0b0d8f61dfa535b605",
+	},
+};
+
+/* Two full chunks, so both are checked with one multi-scalar multiplication */
+#define TEST_ED25519_ITEMS	(2 * ED25519_BATCH_CHUNK)
+
+/* The batch coefficients only have to be unknown to whoever made the signatures */
+static int test_rng(uint8_t *dest, unsigned int size) {
+
+	static uint32_t x = 0x9e3779b9;
+
+	while (size--) {
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		*dest++ = (uint8_t)x;
+	}
+
+	return 1;
+}
+
+static int test_ed25519_verify_batch(void) {
+
+	static uECC_ed25519_key key;
+	static uint8_t public_key[TEST_KEYS][32], sig[TEST_ED25519_ITEMS][64];
+	static uECC_ed25519_batch_item items[TEST_ED25519_ITEMS];
+	uECC_RNG_Function rng = uECC_get_rng();
+	uint8_t seed[32], expected[64];
+	int result = TC_PASS, ret = 0;
+
+	TC_START(__func__);
+
+	uECC_set_rng(test_rng);
+
+	/* The vectors are reproduced by the SDK's signing */
+	for (int k = 0; k < TEST_KEYS; k++) {
+
+		const char *message = ed25519_vectors[k].message;
+
+		test_hex(seed, ed25519_vectors[k].seed, 32);
+		test_hex(public_key[k], ed25519_vectors[k].key, 32);
+		test_hex(expected, ed25519_vectors[k].sig, 64);
+
+		if (!uECC_ed25519_key_init(&key, seed, NULL) || memcmp(key.public_key, public_key[k], 32) ||
+			!uECC_ed25519_sign_with_key(&key, (const uint8_t *)message, strlen(message), sig[k]) ||
+			memcmp(sig[k], expected, 64)) {
+			TC_ERROR("vector %d is not reproduced\n", k);
+			result = TC_FAIL;
+			goto exitTest;
+		}
+	}
+
+	for (int i = 0; i < TEST_ED25519_ITEMS; i++) {
+
+		int k = i % TEST_KEYS;
+
+		memcpy(sig[i], sig[k], 64);
+
+		items[i].public_key  = public_key[k];
+		items[i].message     = (const uint8_t *)ed25519_vectors[k].message;
+		items[i].message_len = strlen(ed25519_vectors[k].message);
+		items[i].signature   = sig[i];
+		items[i].result      = -1;
+	}
+
+	if (1 != (ret = uECC_ed25519_verify_batch(items, TEST_ED25519_ITEMS))) {
+		TC_ERROR("valid batch returned %d\n", ret);
+		result = TC_FAIL;
+	}
+
+	/* A forged R in the first chunk, a signature of another key in the second */
+	sig[TEST_TAMPERED][3] ^= 0x01;
+	items[ED25519_BATCH_CHUNK + 1].public_key = public_key[2];
+
+	if (0 != (ret = uECC_ed25519_verify_batch(items, TEST_ED25519_ITEMS))) {
+		TC_ERROR("forged batch returned %d\n", ret);
+		result = TC_FAIL;
+	}
+
+	for (int i = 0; i < TEST_ED25519_ITEMS; i++) {
+
+		int valid = (TEST_TAMPERED != i && ED25519_BATCH_CHUNK + 1 != i);
+		int single = uECC_ed25519_verify(items[i].public_key, items[i].message, items[i].message_len, items[i].signature);
+
+		if (items[i].result != valid || single != valid) {
+			TC_ERROR("item %d: batch %d, single %d, expected %d\n", i, items[i].result, single, valid);
+			result = TC_FAIL;
+		}
+	}
+
+exitTest:
+	uECC_set_rng(rng);
+
+	TC_END_RESULT(result);
+	return result;
+}
+
+int main(void) {
+
+	int result = TC_PASS;
+
+	if (PSA_SUCCESS != psa_crypto_init()) {
+		TC_ERROR("psa_crypto_init failed\n");
+		return TC_FAIL;
+	}
+
+	for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++)
+		result |= test_uecc_verify_batch(&vectors[i]);
+
+	result |= test_psa_verify_batch();
+	result |= test_ed25519_verify_batch();
+
+	TC_END_REPORT(result);
+
+	return result;
+}
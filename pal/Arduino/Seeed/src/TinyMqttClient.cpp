@@ -24,6 +24,7 @@ TinyMqttClient::TinyMqttClient(Client *client) {
     this->_client = client;
     this->_state = TINY_MQTT_DISCONNECTED;
     this->bufferSize = 0;
+    this->pubLength = 0;
     setBufferSize(TINY_MQTT_MAX_PACKET_SIZE);
     setKeepAlive(TINY_MQTT_KEEPALIVE);
     setSocketTimeout(TINY_MQTT_SOCKET_TIMEOUT);
@@ -367,32 +368,62 @@ bool TinyMqttClient::publish(const char* topic, const uint8_t* payload, unsigned
 }
 
 bool TinyMqttClient::publish(const char* topic, const uint8_t* payload, unsigned int plength, bool retained) {
+    if (!beginPublish(topic, plength, retained)) {
+        return false;
+    }
+
+    if (writePayload(payload, plength) != plength) {
+        return false;
+    }
+
+    return endPublish();
+}
+
+// Reserves the fixed header and writes the topic, the payload is then appended in place with writePayload()
+bool TinyMqttClient::beginPublish(const char* topic, unsigned int plength, bool retained) {
+    this->pubLength = 0;
+
     if (connected()) {
         if (this->bufferSize < TINY_MQTT_MAX_HEADER_SIZE + 2 + strnlen(topic, this->bufferSize) + plength) {
             return false;
         }
-        
-        uint16_t length = TINY_MQTT_MAX_HEADER_SIZE;
-        length = writeString(topic, this->buffer, length);
 
-        // Add payload
-        uint16_t i;
-        for (i = 0; i < plength; i++) {
-            this->buffer[length++] = payload[i];
-        }
+        this->pubLength = writeString(topic, this->buffer, TINY_MQTT_MAX_HEADER_SIZE);
 
         // Write the header
-        uint8_t header = TINY_MQTT_MESSAGE_TYPE_PUBLISH << 4;
+        this->pubHeader = TINY_MQTT_MESSAGE_TYPE_PUBLISH << 4;
         if (retained) {
-            header |= 1;
+            this->pubHeader |= 1;
         }
 
-        // header |= TINY_MQTT_QOS_1;
-        return write(header, this->buffer, length - TINY_MQTT_MAX_HEADER_SIZE);
+        // this->pubHeader |= TINY_MQTT_QOS_1;
+        return true;
     }
     return false;
 }
 
+size_t TinyMqttClient::writePayload(const uint8_t* payload, size_t length) {
+    if (this->pubLength == 0 || this->pubLength + length > this->bufferSize) {
+        return 0;
+    }
+
+    memcpy(this->buffer + this->pubLength, payload, length);
+    this->pubLength += length;
+
+    return length;
+}
+
+bool TinyMqttClient::endPublish() {
+    uint16_t length = this->pubLength;
+
+    if (length == 0) {
+        return false;
+    }
+
+    this->pubLength = 0;
+    return write(this->pubHeader, this->buffer, length - TINY_MQTT_MAX_HEADER_SIZE);
+}
+
 size_t TinyMqttClient::write(uint8_t data) {
     lastOutActivity = millis();
     return _client->write(data);
@@ -105,6 +105,9 @@ private:
     uint16_t port;
     int _state;
 
+    uint16_t pubLength;
+    uint8_t pubHeader;
+
 public:
     TinyMqttClient(Client *client);
     TinyMqttClient(Client& client);
@@ -131,6 +134,10 @@ public:
     bool publish(const char* topic, const uint8_t * payload, unsigned int plength);
     bool publish(const char* topic, const uint8_t * payload, unsigned int plength, bool retained);
 
+    bool beginPublish(const char* topic, unsigned int plength, bool retained);
+    size_t writePayload(const uint8_t * payload, size_t length);
+    bool endPublish();
+
     bool subscribe(const char* topic);
     bool subscribe(const char* topic, uint8_t qos);
     bool unsubscribe(const char* topic);